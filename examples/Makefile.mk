@@ -63,6 +63,39 @@ noinst_PROGRAMS += examples/geopmhash
 examples_geopmhash_SOURCES = examples/geopmhash.c
 examples_geopmhash_LDADD = libgeopmpolicy.la
 
+noinst_PROGRAMS += examples/agent_aggregate_benchmark
+examples_agent_aggregate_benchmark_SOURCES = examples/agent_aggregate_benchmark.cpp
+examples_agent_aggregate_benchmark_LDADD = libgeopmpolicy.la
+
+noinst_PROGRAMS += examples/csv_format_benchmark
+examples_csv_format_benchmark_SOURCES = examples/csv_format_benchmark.cpp
+examples_csv_format_benchmark_LDADD = libgeopmpolicy.la
+
+noinst_PROGRAMS += examples/profile_table_benchmark
+examples_profile_table_benchmark_SOURCES = examples/profile_table_benchmark.cpp
+examples_profile_table_benchmark_LDADD = libgeopmpolicy.la
+
+noinst_PROGRAMS += examples/region_aggregator_benchmark
+examples_region_aggregator_benchmark_SOURCES = examples/region_aggregator_benchmark.cpp
+examples_region_aggregator_benchmark_LDADD = libgeopmpolicy.la
+
+noinst_PROGRAMS += examples/topo_cache_benchmark
+examples_topo_cache_benchmark_SOURCES = examples/topo_cache_benchmark.cpp
+examples_topo_cache_benchmark_LDADD = libgeopmpolicy.la
+
+noinst_PROGRAMS += examples/tree_comm_benchmark
+examples_tree_comm_benchmark_SOURCES = examples/tree_comm_benchmark.cpp
+examples_tree_comm_benchmark_LDADD = libgeopmpolicy.la
+
+if ENABLE_MPI
+    noinst_PROGRAMS += examples/tree_comm_level_benchmark
+    examples_tree_comm_level_benchmark_SOURCES = examples/tree_comm_level_benchmark.cpp
+    examples_tree_comm_level_benchmark_LDADD = libgeopm.la $(MPI_CXXLIBS)
+    examples_tree_comm_level_benchmark_LDFLAGS = $(AM_LDFLAGS) $(MPI_CXXLDFLAGS)
+    examples_tree_comm_level_benchmark_CFLAGS = $(AM_CFLAGS) $(MPI_CFLAGS)
+    examples_tree_comm_level_benchmark_CXXFLAGS = $(AM_CXXFLAGS) $(MPI_CXXFLAGS)
+endif
+
 if ENABLE_MPI
     noinst_PROGRAMS += examples/timed_region
     examples_timed_region_SOURCES = examples/timed_region.cpp
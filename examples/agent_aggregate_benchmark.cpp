@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Microbenchmark for the tree aggregation of agent samples.  Each
+/// iteration reduces the NUM_SAMPLE element sample vectors of
+/// NUM_CHILDREN children into one sample vector, as a tree agent
+/// does in ascend().  The std::function based
+/// Agent::aggregate_sample() is compared with the compile time
+/// variant that uses the vectorized Agg::aggregate_column()
+/// kernels, and the results of both are checked to be identical.
+///
+/// Usage: agent_aggregate_benchmark [NUM_CHILDREN] [NUM_ITER]
+
+#include <time.h>
+#include <math.h>
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Agent.hpp"
+#include "Agg.hpp"
+#include "Exception.hpp"
+
+#define AGG_BENCH_REPEAT_8(agg) agg, agg, agg, agg, agg, agg, agg, agg
+
+namespace
+{
+    const size_t M_NUM_SAMPLE = 32;
+
+    double thread_cpu_time(void)
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return now.tv_sec + now.tv_nsec * 1e-9;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t num_children = 64;
+    size_t num_iter = 100000;
+    if (argc > 1) {
+        num_children = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+        num_iter = std::stoul(argv[2]);
+    }
+    if (num_children == 0 || num_iter == 0) {
+        std::cerr << "Error: NUM_CHILDREN and NUM_ITER must be positive" << std::endl;
+        return -1;
+    }
+    int err = 0;
+    try {
+        std::mt19937_64 generator(1);
+        std::uniform_real_distribution<double> value(0.0, 300.0);
+        std::vector<std::vector<double> > in_sample(num_children, std::vector<double>(M_NUM_SAMPLE));
+        for (auto &child_sample : in_sample) {
+            for (auto &vv : child_sample) {
+                vv = value(generator);
+            }
+        }
+        std::vector<std::function<double(const std::vector<double>&)> > agg_func;
+        agg_func.insert(agg_func.end(), 8, geopm::Agg::sum);
+        agg_func.insert(agg_func.end(), 8, geopm::Agg::average);
+        agg_func.insert(agg_func.end(), 8, geopm::Agg::min);
+        agg_func.insert(agg_func.end(), 8, geopm::Agg::max);
+
+        std::vector<double> func_sample(M_NUM_SAMPLE);
+        double check = 0.0;
+        double begin = thread_cpu_time();
+        for (size_t iter = 0; iter < num_iter; ++iter) {
+            in_sample[iter % num_children][iter % M_NUM_SAMPLE] += 1.0;
+            geopm::Agent::aggregate_sample(in_sample, agg_func, func_sample);
+            check += func_sample[iter % M_NUM_SAMPLE];
+        }
+        double func_sec = thread_cpu_time() - begin;
+
+        std::vector<double> sample_matrix;
+        std::vector<double> column_sample(M_NUM_SAMPLE);
+        double column_check = 0.0;
+        begin = thread_cpu_time();
+        for (size_t iter = 0; iter < num_iter; ++iter) {
+            in_sample[iter % num_children][iter % M_NUM_SAMPLE] -= 1.0;
+            geopm::Agent::aggregate_sample<AGG_BENCH_REPEAT_8(geopm::Agg::M_COLUMN_SUM),
+                                           AGG_BENCH_REPEAT_8(geopm::Agg::M_COLUMN_AVERAGE),
+                                           AGG_BENCH_REPEAT_8(geopm::Agg::M_COLUMN_MIN),
+                                           AGG_BENCH_REPEAT_8(geopm::Agg::M_COLUMN_MAX)>
+                (in_sample, sample_matrix, column_sample);
+            column_check += column_sample[iter % M_NUM_SAMPLE];
+        }
+        double column_sec = thread_cpu_time() - begin;
+
+        // Both loops end with the same input, so the final
+        // aggregates must match bit for bit.
+        geopm::Agent::aggregate_sample(in_sample, agg_func, func_sample);
+        if (func_sample != column_sample) {
+            throw geopm::Exception("agent_aggregate_benchmark: aggregation results differ",
+                                   GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+        std::cout << "num_children: " << num_children
+                  << " num_sample: " << M_NUM_SAMPLE
+                  << " num_iter: " << num_iter << std::endl;
+        std::cout << std::setw(10) << "backend"
+                  << std::setw(16) << "ascend (ns)"
+                  << std::setw(16) << "checksum" << std::endl;
+        std::cout << std::setw(10) << "function"
+                  << std::setw(16) << std::fixed << std::setprecision(1) << 1e9 * func_sec / num_iter
+                  << std::setw(16) << std::setprecision(0) << check << std::endl;
+        std::cout << std::setw(10) << "column"
+                  << std::setw(16) << std::setprecision(1) << 1e9 * column_sec / num_iter
+                  << std::setw(16) << std::setprecision(0) << column_check << std::endl;
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        err = -1;
+    }
+    return err;
+}
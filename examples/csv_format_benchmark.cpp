@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Microbenchmark for the cost of writing trace rows with CSVImp.  A
+/// trace of NUM_COLUMN columns sampled at 200 Hz is emulated for
+/// NUM_SECOND seconds of run time and written to /dev/null with three
+/// backends: the previous implementation which formats each value
+/// into a std::string and streams it into an ostringstream, CSVImp
+/// with custom format functions (the std::function path), and CSVImp
+/// with the standard format functions (the NumberFormat path).  The
+/// CPU time of the calling thread is reported, both in total and as
+/// a fraction of the emulated run time.
+///
+/// Usage: csv_format_benchmark [NUM_COLUMN] [NUM_SECOND]
+
+#include <time.h>
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "geopm_hash.h"
+#include "CSV.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+
+namespace
+{
+    const double M_RATE = 200.0;
+
+    double thread_cpu_time(void)
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return now.tv_sec + now.tv_nsec * 1e-9;
+    }
+
+    struct bench_result_s {
+        double cpu_sec;
+        size_t num_byte;
+    };
+
+    /// Emulate telemetry: time, counters, region hashes and noisy
+    /// power and frequency readings.
+    std::vector<std::vector<double> > make_rows(size_t num_column, size_t num_row)
+    {
+        std::mt19937_64 generator(1);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        std::vector<std::vector<double> > result(num_row, std::vector<double>(num_column));
+        for (size_t row_idx = 0; row_idx != num_row; ++row_idx) {
+            for (size_t col_idx = 0; col_idx != num_column; ++col_idx) {
+                double value = 0.0;
+                switch (col_idx % 5) {
+                    case 0:
+                        value = row_idx / M_RATE;
+                        break;
+                    case 1:
+                        value = (double)(row_idx * 1000 + col_idx);
+                        break;
+                    case 2:
+                        value = (double)(0x2a3b4c5dULL + row_idx / 100);
+                        break;
+                    default:
+                        value = 2.1e9 + 1e7 * noise(generator);
+                        break;
+                }
+                result[row_idx][col_idx] = value;
+            }
+        }
+        return result;
+    }
+
+    std::vector<std::function<std::string(double)> > make_formats(size_t num_column)
+    {
+        std::vector<std::function<std::string(double)> > result(num_column);
+        for (size_t col_idx = 0; col_idx != num_column; ++col_idx) {
+            switch (col_idx % 5) {
+                case 1:
+                    result[col_idx] = geopm::string_format_integer;
+                    break;
+                case 2:
+                    result[col_idx] = geopm::string_format_hex;
+                    break;
+                default:
+                    result[col_idx] = geopm::string_format_double;
+                    break;
+            }
+        }
+        return result;
+    }
+
+    bench_result_s run_legacy(const std::vector<std::vector<double> > &rows,
+                              const std::vector<std::function<std::string(double)> > &formats)
+    {
+        bench_result_s result {};
+        std::ofstream stream("/dev/null");
+        std::ostringstream buffer;
+        double begin = thread_cpu_time();
+        for (const auto &row : rows) {
+            for (size_t col_idx = 0; col_idx != row.size(); ++col_idx) {
+                if (col_idx) {
+                    buffer << '|';
+                }
+                buffer << formats[col_idx](row[col_idx]);
+            }
+            buffer << "\n";
+            if (buffer.tellp() > 1048576) {
+                result.num_byte += buffer.tellp();
+                stream << buffer.str();
+                buffer.str("");
+            }
+        }
+        result.num_byte += buffer.tellp();
+        stream << buffer.str();
+        stream.flush();
+        result.cpu_sec = thread_cpu_time() - begin;
+        return result;
+    }
+
+    bench_result_s run_csv(const std::vector<std::vector<double> > &rows,
+                           const std::vector<std::function<std::string(double)> > &formats,
+                           bool is_custom)
+    {
+        bench_result_s result {};
+        geopm::CSVImp csv("/dev/null", "", "", 1048576);
+        for (size_t col_idx = 0; col_idx != formats.size(); ++col_idx) {
+            if (is_custom) {
+                // Wrapping the format function hides it from NumberFormat
+                std::function<std::string(double)> format = formats[col_idx];
+                csv.add_column("COLUMN_" + std::to_string(col_idx),
+                               [format](double value) {return format(value);});
+            }
+            else {
+                csv.add_column("COLUMN_" + std::to_string(col_idx), formats[col_idx]);
+            }
+        }
+        csv.activate();
+        double begin = thread_cpu_time();
+        for (const auto &row : rows) {
+            csv.update(row);
+        }
+        csv.flush();
+        result.cpu_sec = thread_cpu_time() - begin;
+        // Approximate size of the rows without the header
+        std::ostringstream text;
+        for (const auto &row : rows) {
+            for (size_t col_idx = 0; col_idx != row.size(); ++col_idx) {
+                text << (col_idx ? "|" : "") << formats[col_idx](row[col_idx]);
+            }
+            text << "\n";
+        }
+        result.num_byte = text.str().size();
+        return result;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t num_column = 500;
+    double num_second = 10.0;
+    if (argc > 1) {
+        num_column = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+        num_second = std::stod(argv[2]);
+    }
+    if (num_column == 0 || num_second <= 0.0) {
+        std::cerr << "Error: NUM_COLUMN and NUM_SECOND must be positive" << std::endl;
+        return -1;
+    }
+    int err = 0;
+    try {
+        size_t num_row = num_second * M_RATE;
+        auto rows = make_rows(num_column, num_row);
+        auto formats = make_formats(num_column);
+        std::cout << "num_column: " << num_column
+                  << " rate (Hz): " << M_RATE
+                  << " num_row: " << num_row << std::endl;
+        std::cout << std::setw(10) << "backend"
+                  << std::setw(14) << "cpu (s)"
+                  << std::setw(14) << "cpu/row (us)"
+                  << std::setw(14) << "MB/s"
+                  << std::setw(16) << "cpu at 200 Hz" << std::endl;
+        std::vector<std::pair<std::string, bench_result_s> > results {
+            {"legacy", run_legacy(rows, formats)},
+            {"custom", run_csv(rows, formats, true)},
+            {"fast", run_csv(rows, formats, false)},
+        };
+        for (const auto &it : results) {
+            std::cout << std::setw(10) << it.first
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(14) << it.second.cpu_sec
+                      << std::setprecision(1)
+                      << std::setw(14) << 1e6 * it.second.cpu_sec / num_row
+                      << std::setw(14) << 1e-6 * it.second.num_byte / it.second.cpu_sec
+                      << std::setw(15) << 100.0 * it.second.cpu_sec / num_second << "%"
+                      << std::endl;
+        }
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        err = -1;
+    }
+    return err;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Microbenchmark comparing the insert latency of the mutex protected
+/// ProfileTableImp with the lock free ProfileRingTableImp while a
+/// consumer thread drains the table, emulating an application rank
+/// and the controller sharing a table.
+///
+/// Usage: profile_table_benchmark [NUM_INSERT] [CONSUMER_PERIOD_SEC]
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "geopm_internal.h"
+#include "geopm_time.h"
+#include "Exception.hpp"
+#include "ProfileTable.hpp"
+
+namespace
+{
+    struct bench_result_s {
+        double mean;
+        double p50;
+        double p99;
+        double max;
+        size_t num_retry;
+        size_t num_dump;
+    };
+
+    bench_result_s run_bench(bool is_lock_free, size_t num_insert, double consumer_period)
+    {
+        const size_t buffer_size = 2 * 1024 * 1024;
+        void *buffer = nullptr;
+        if (posix_memalign(&buffer, 4096, buffer_size)) {
+            throw std::runtime_error("posix_memalign() failed");
+        }
+        bench_result_s result {};
+        {
+            std::unique_ptr<geopm::ProfileTable> table =
+                geopm::ProfileTable::make_unique(buffer_size, buffer, is_lock_free);
+            std::atomic<bool> is_done(false);
+            size_t num_dump = 0;
+            std::thread consumer([&table, &is_done, &num_dump, consumer_period]() {
+                std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > content(table->capacity());
+                while (!is_done.load()) {
+                    size_t length = 0;
+                    table->dump(content.begin(), length);
+                    ++num_dump;
+                    if (consumer_period > 0.0) {
+                        usleep((useconds_t)(consumer_period * 1e6));
+                    }
+                }
+            });
+            std::vector<double> latency(num_insert);
+            struct geopm_prof_message_s message {0, 0, {{0, 0}}, 0.0};
+            struct geopm_time_s begin;
+            struct geopm_time_s end;
+            for (size_t idx = 0; idx < num_insert; ++idx) {
+                // Cycle through region entry, progress and exit messages
+                message.region_id = 1 + (idx / 3) % 16;
+                message.progress = (idx % 3) * 0.5;
+                geopm_time(&begin);
+                bool is_inserted = false;
+                while (!is_inserted) {
+                    try {
+                        table->insert(message);
+                        is_inserted = true;
+                    }
+                    catch (const geopm::Exception &) {
+                        ++result.num_retry;
+                    }
+                }
+                geopm_time(&end);
+                latency[idx] = geopm_time_diff(&begin, &end);
+            }
+            is_done.store(true);
+            consumer.join();
+            result.num_dump = num_dump;
+            double total = 0.0;
+            for (const auto &lat : latency) {
+                total += lat;
+            }
+            std::sort(latency.begin(), latency.end());
+            result.mean = total / num_insert;
+            result.p50 = latency[num_insert / 2];
+            result.p99 = latency[(num_insert * 99) / 100];
+            result.max = latency.back();
+        }
+        free(buffer);
+        return result;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t num_insert = 1000000;
+    double consumer_period = 0.0;
+    if (argc > 1) {
+        num_insert = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+        consumer_period = std::stod(argv[2]);
+    }
+    if (num_insert == 0) {
+        std::cerr << "Error: NUM_INSERT must be positive" << std::endl;
+        return -1;
+    }
+    std::cout << "num_insert: " << num_insert
+              << " consumer_period (s): " << consumer_period << std::endl;
+    std::cout << std::setw(10) << "table"
+              << std::setw(14) << "mean (ns)"
+              << std::setw(14) << "p50 (ns)"
+              << std::setw(14) << "p99 (ns)"
+              << std::setw(14) << "max (ns)"
+              << std::setw(10) << "retry"
+              << std::setw(10) << "dump" << std::endl;
+    for (bool is_lock_free : {false, true}) {
+        bench_result_s result = run_bench(is_lock_free, num_insert, consumer_period);
+        std::cout << std::setw(10) << (is_lock_free ? "ring" : "mutex")
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << result.mean * 1e9
+                  << std::setw(14) << result.p50 * 1e9
+                  << std::setw(14) << result.p99 * 1e9
+                  << std::setw(14) << result.max * 1e9
+                  << std::setw(10) << result.num_retry
+                  << std::setw(10) << result.num_dump << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Microbenchmark for the per-step cost of RegionAggregatorImp.  An
+/// application with NUM_REGION regions is emulated on a node where
+/// NUM_SIGNAL report signals are pushed with push_signal_total() over
+/// eight domains, each with its own REGION_HASH signal.  At every
+/// controller step each domain enters a region picked at random.
+/// The std::map based implementation that RegionAggregatorImp
+/// replaced is run on the same samples as a reference, and the
+/// totals of both are compared at the end of the run.
+///
+/// Usage: region_aggregator_benchmark [NUM_REGION] [NUM_SIGNAL] [NUM_STEP]
+
+#include <time.h>
+#include <math.h>
+
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "geopm_internal.h"
+#include "geopm_topo.h"
+#include "Exception.hpp"
+#include "PlatformIO.hpp"
+#include "RegionAggregatorImp.hpp"
+
+namespace
+{
+    const int M_NUM_DOMAIN = 8;
+
+    double thread_cpu_time(void)
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+        return now.tv_sec + now.tv_nsec * 1e-9;
+    }
+
+    /// PlatformIO that serves pre-computed samples for the current
+    /// step.  Pushing the same signal twice returns the same index,
+    /// as PlatformIOImp does.
+    class BenchPlatformIO : public geopm::PlatformIO
+    {
+        public:
+            BenchPlatformIO(const std::vector<std::vector<uint64_t> > &region_hash)
+                : m_region_hash(region_hash)
+                , m_step(0)
+            {
+
+            }
+            void step(size_t step)
+            {
+                m_step = step;
+            }
+            int push_signal(const std::string &signal_name,
+                            int domain_type,
+                            int domain_idx) override
+            {
+                auto key = std::make_pair(signal_name, domain_idx);
+                auto it = m_signal_idx.find(key);
+                if (it != m_signal_idx.end()) {
+                    return it->second;
+                }
+                int result = m_signal.size();
+                m_signal_idx[key] = result;
+                m_signal.push_back(key);
+                return result;
+            }
+            double sample(int signal_idx) override
+            {
+                const auto &signal = m_signal.at(signal_idx);
+                if (signal.first == "REGION_HASH") {
+                    return m_region_hash[m_step][signal.second];
+                }
+                else if (signal.first == "EPOCH_COUNT") {
+                    return m_step < 10 ? -1 : m_step / 10;
+                }
+                // monotonic counter with a distinct rate per signal
+                return m_step * (1.0 + signal_idx);
+            }
+            void register_iogroup(std::shared_ptr<geopm::IOGroup> iogroup) override {}
+            void register_profileio(std::shared_ptr<geopm::ProfileIOGroup> piogroup) override {}
+            std::shared_ptr<geopm::ProfileIOGroup> get_profileio(void) override { return nullptr; }
+            std::set<std::string> signal_names(void) const override { return {}; }
+            std::set<std::string> control_names(void) const override { return {}; }
+            int signal_domain_type(const std::string &signal_name) const override { return GEOPM_DOMAIN_BOARD; }
+            int control_domain_type(const std::string &control_name) const override { return GEOPM_DOMAIN_INVALID; }
+            int push_control(const std::string &control_name, int domain_type, int domain_idx) override { return -1; }
+            void adjust(int control_idx, double setting) override {}
+            void read_batch(void) override {}
+            void write_batch(void) override {}
+            double read_signal(const std::string &signal_name, int domain_type, int domain_idx) override { return NAN; }
+            void write_control(const std::string &control_name, int domain_type, int domain_idx, double setting) override {}
+            void save_control(void) override {}
+            void restore_control(void) override {}
+            std::function<double(const std::vector<double> &)> agg_function(const std::string &signal_name) const override { return nullptr; }
+            std::function<std::string(double)> format_function(const std::string &signal_name) const override { return nullptr; }
+            std::string signal_description(const std::string &signal_name) const override { return ""; }
+            std::string control_description(const std::string &control_name) const override { return ""; }
+        private:
+            const std::vector<std::vector<uint64_t> > &m_region_hash;
+            size_t m_step;
+            std::map<std::pair<std::string, int>, int> m_signal_idx;
+            std::vector<std::pair<std::string, int> > m_signal;
+    };
+
+    /// The previous implementation of RegionAggregatorImp
+    class LegacyRegionAggregator : public geopm::RegionAggregator
+    {
+        public:
+            LegacyRegionAggregator(geopm::PlatformIO &platio)
+                : m_platform_io(platio)
+            {
+
+            }
+            void init(void) override
+            {
+                m_epoch_count_idx = m_platform_io.push_signal("EPOCH_COUNT", GEOPM_DOMAIN_BOARD, 0);
+            }
+            int push_signal_total(const std::string &signal_name,
+                                  int domain_type,
+                                  int domain_idx) override
+            {
+                int signal_idx = m_platform_io.push_signal(signal_name, domain_type, domain_idx);
+                m_region_hash_idx[signal_idx] = m_platform_io.push_signal("REGION_HASH", domain_type, domain_idx);
+                return signal_idx;
+            }
+            double sample_total(int signal_idx, uint64_t region_hash) override
+            {
+                double current_value = 0.0;
+                uint64_t curr_hash = m_platform_io.sample(m_region_hash_idx.at(signal_idx));
+                m_tracked_region_hash.insert(curr_hash);
+                auto idx = std::make_pair(signal_idx, region_hash);
+                auto data_it = m_region_sample_data.find(idx);
+                if (data_it != m_region_sample_data.end()) {
+                    auto &data = data_it->second;
+                    if(!std::isnan(data.last_entry_value)) {
+                        if(region_hash == GEOPM_REGION_HASH_EPOCH) {
+                            data.total = m_platform_io.sample(signal_idx) - data.last_entry_value;
+                        }
+                        else if (region_hash == curr_hash) {
+                            current_value += m_platform_io.sample(signal_idx) - data.last_entry_value;
+                        }
+                    }
+                    current_value += data.total;
+                }
+                return current_value;
+            }
+            void read_batch(void) override
+            {
+                for (const auto &it : m_region_hash_idx) {
+                    double value = m_platform_io.sample(it.first);
+                    const uint64_t region_hash = m_platform_io.sample(it.second);
+                    m_tracked_region_hash.insert(region_hash);
+                    auto epoch_idx = std::make_pair(it.first, GEOPM_REGION_HASH_EPOCH);
+                    double curr_epoch_count = m_platform_io.sample(m_epoch_count_idx);
+                    if (m_region_sample_data.find(epoch_idx) == m_region_sample_data.end() &&
+                        curr_epoch_count > -1) {
+                        m_region_sample_data[epoch_idx].last_entry_value = value;
+                    }
+                    if (m_last_region_hash.find(it.first) == m_last_region_hash.end()) {
+                        m_last_region_hash[it.first] = region_hash;
+                        m_region_sample_data[std::make_pair(it.first, region_hash)].last_entry_value = value;
+                    }
+                    else {
+                        const uint64_t last_hash = m_last_region_hash[it.first];
+                        if (region_hash != last_hash) {
+                            m_region_sample_data[std::make_pair(it.first, region_hash)].last_entry_value = value;
+                            double prev_total = value - m_region_sample_data.at(std::make_pair(it.first, last_hash)).last_entry_value;
+                            m_region_sample_data[std::make_pair(it.first, last_hash)].total += prev_total;
+                            m_last_region_hash[it.first] = region_hash;
+                        }
+                    }
+                }
+            }
+            std::set<uint64_t> tracked_region_hash(void) const override
+            {
+                return m_tracked_region_hash;
+            }
+        private:
+            struct m_region_data_s
+            {
+                double total = 0.0;
+                double last_entry_value = NAN;
+            };
+            geopm::PlatformIO &m_platform_io;
+            std::map<int, int> m_region_hash_idx;
+            std::map<std::pair<int, uint64_t>, m_region_data_s> m_region_sample_data;
+            std::map<int, uint64_t> m_last_region_hash;
+            int m_epoch_count_idx;
+            std::set<uint64_t> m_tracked_region_hash;
+    };
+
+    struct bench_result_s {
+        double step_sec;
+        double report_sec;
+        std::vector<double> total;
+    };
+
+    bench_result_s run_bench(geopm::RegionAggregator &agg, BenchPlatformIO &platio,
+                             int num_signal, size_t num_step,
+                             const std::vector<uint64_t> &region)
+    {
+        bench_result_s result {};
+        agg.init();
+        std::vector<int> signal_idx;
+        for (int sig = 0; sig < num_signal; ++sig) {
+            signal_idx.push_back(agg.push_signal_total("SIGNAL_" + std::to_string(sig),
+                                                       GEOPM_DOMAIN_CPU, sig % M_NUM_DOMAIN));
+        }
+        double begin = thread_cpu_time();
+        for (size_t step = 0; step < num_step; ++step) {
+            platio.step(step);
+            agg.read_batch();
+        }
+        result.step_sec = thread_cpu_time() - begin;
+        // sample every region as the Reporter does at the end of a run
+        begin = thread_cpu_time();
+        for (const auto &hash : region) {
+            for (const auto &idx : signal_idx) {
+                result.total.push_back(agg.sample_total(idx, hash));
+            }
+        }
+        for (const auto &idx : signal_idx) {
+            result.total.push_back(agg.sample_total(idx, GEOPM_REGION_HASH_EPOCH));
+        }
+        result.report_sec = thread_cpu_time() - begin;
+        return result;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t num_region = 10000;
+    int num_signal = 50;
+    size_t num_step = 20000;
+    if (argc > 1) {
+        num_region = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+        num_signal = std::stoi(argv[2]);
+    }
+    if (argc > 3) {
+        num_step = std::stoul(argv[3]);
+    }
+    if (num_region == 0 || num_signal <= 0 || num_step == 0) {
+        std::cerr << "Error: NUM_REGION, NUM_SIGNAL and NUM_STEP must be positive" << std::endl;
+        return -1;
+    }
+    int err = 0;
+    try {
+        std::mt19937_64 generator(1);
+        std::vector<uint64_t> region(num_region);
+        for (auto &hash : region) {
+            // region hashes are 32 bit CRCs
+            hash = generator() & 0xFFFFFFFFULL;
+        }
+        std::uniform_int_distribution<size_t> pick(0, num_region - 1);
+        std::vector<std::vector<uint64_t> > step_region(num_step, std::vector<uint64_t>(M_NUM_DOMAIN));
+        for (auto &domain_region : step_region) {
+            for (auto &hash : domain_region) {
+                hash = region[pick(generator)];
+            }
+        }
+        BenchPlatformIO legacy_platio(step_region);
+        LegacyRegionAggregator legacy_agg(legacy_platio);
+        BenchPlatformIO platio(step_region);
+        geopm::RegionAggregatorImp agg(platio);
+        std::vector<std::pair<std::string, bench_result_s> > results {
+            {"legacy", run_bench(legacy_agg, legacy_platio, num_signal, num_step, region)},
+            {"flat", run_bench(agg, platio, num_signal, num_step, region)},
+        };
+        double max_diff = 0.0;
+        for (size_t idx = 0; idx < results[0].second.total.size(); ++idx) {
+            max_diff = std::max(max_diff, std::fabs(results[0].second.total[idx] -
+                                                    results[1].second.total[idx]));
+        }
+        std::cout << "num_region: " << num_region
+                  << " num_signal: " << num_signal
+                  << " num_step: " << num_step << std::endl;
+        std::cout << std::setw(10) << "backend"
+                  << std::setw(16) << "step (us)"
+                  << std::setw(16) << "report (ms)" << std::endl;
+        for (const auto &it : results) {
+            std::cout << std::setw(10) << it.first
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(16) << 1e6 * it.second.step_sec / num_step
+                      << std::setw(16) << 1e3 * it.second.report_sec << std::endl;
+        }
+        std::cout << "max total difference: " << max_diff << std::endl;
+        if (max_diff != 0.0) {
+            err = -1;
+        }
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        err = -1;
+    }
+    return err;
+}
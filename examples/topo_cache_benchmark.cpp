@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Microbenchmark comparing the cost of constructing PlatformTopoImp
+/// from each topology source: lscpu (popen, or the text cache if
+/// present), the sysfs cpu and node directories, and the binary
+/// cache file.  Each construction emulates the start up of one
+/// application rank or controller.
+///
+/// Usage: topo_cache_benchmark [NUM_CONSTRUCT] [SYSFS_PATH]
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "geopm_time.h"
+#include "geopm_topo.h"
+#include "Exception.hpp"
+#include "PlatformTopoImp.hpp"
+
+namespace
+{
+    struct bench_result_s {
+        double mean;
+        double p50;
+        double max;
+        int num_cpu;
+    };
+
+    bench_result_s run_bench(const std::string &binary_cache_path,
+                             const std::string &sysfs_path,
+                             size_t num_construct)
+    {
+        bench_result_s result {};
+        std::vector<double> latency(num_construct);
+        struct geopm_time_s begin;
+        struct geopm_time_s end;
+        for (size_t idx = 0; idx < num_construct; ++idx) {
+            geopm_time(&begin);
+            geopm::PlatformTopoImp topo(binary_cache_path, sysfs_path);
+            geopm_time(&end);
+            latency[idx] = geopm_time_diff(&begin, &end);
+            result.num_cpu = topo.num_domain(GEOPM_DOMAIN_CPU);
+        }
+        double total = 0.0;
+        for (const auto &lat : latency) {
+            total += lat;
+        }
+        std::sort(latency.begin(), latency.end());
+        result.mean = total / num_construct;
+        result.p50 = latency[num_construct / 2];
+        result.max = latency.back();
+        return result;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t num_construct = 100;
+    std::string sysfs_path = "/sys/devices/system";
+    if (argc > 1) {
+        num_construct = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+        sysfs_path = argv[2];
+    }
+    if (num_construct == 0) {
+        std::cerr << "Error: NUM_CONSTRUCT must be positive" << std::endl;
+        return -1;
+    }
+    char cache_path[] = "/tmp/topo_cache_benchmark_XXXXXX";
+    int fd = mkstemp(cache_path);
+    if (fd == -1) {
+        std::cerr << "Error: could not create temporary file" << std::endl;
+        return -1;
+    }
+    close(fd);
+    unlink(cache_path);
+    int err = 0;
+    try {
+        geopm::PlatformTopoImp::create_binary_cache(cache_path, sysfs_path);
+        std::cout << "num_construct: " << num_construct
+                  << " lscpu text cache: "
+                  << (access("/tmp/geopm-topo-cache", R_OK) ? "absent" : "present")
+                  << std::endl;
+        std::cout << std::setw(10) << "source"
+                  << std::setw(14) << "mean (us)"
+                  << std::setw(14) << "p50 (us)"
+                  << std::setw(14) << "max (us)"
+                  << std::setw(10) << "cpus" << std::endl;
+        const std::vector<std::pair<std::string, std::pair<std::string, std::string> > > source {
+            {"lscpu", {"", ""}},
+            {"sysfs", {"", sysfs_path}},
+            {"binary", {cache_path, ""}},
+        };
+        for (const auto &it : source) {
+            bench_result_s result = run_bench(it.second.first, it.second.second, num_construct);
+            std::cout << std::setw(10) << it.first
+                      << std::fixed << std::setprecision(1)
+                      << std::setw(14) << result.mean * 1e6
+                      << std::setw(14) << result.p50 * 1e6
+                      << std::setw(14) << result.max * 1e6
+                      << std::setw(10) << result.num_cpu << std::endl;
+        }
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        err = -1;
+    }
+    unlink(cache_path);
+    return err;
+}
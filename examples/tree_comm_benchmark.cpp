@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Benchmark for the controller tree with simulated nodes.  Each
+/// node is a thread of this process that communicates through the
+/// ThreadComm plugin.  In each round every node sends a sample up
+/// the tree, the root receives the sum of the samples and a policy
+/// is sent back down to every node.  The policy holds the round
+/// number followed by values of which one changes in each round,
+/// as when a single region frequency of a frequency map is updated.
+/// The tree is built the same way as for a job, so its shape follows
+/// GEOPM_MAX_FAN_OUT and GEOPM_TREE_AUTO_FAN_OUT and the message
+/// protocol follows GEOPM_TREE_LOCK_FREE and GEOPM_TREE_SPARSE.
+///
+/// Usage: tree_comm_benchmark [NUM_NODE] [NUM_ROUND] [NUM_POLICY]
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "geopm_time.h"
+#include "Exception.hpp"
+#include "ThreadComm.hpp"
+#include "TreeComm.hpp"
+
+namespace
+{
+    /// Returns the total of the samples at the root, zero elsewhere
+    double tree_round(geopm::TreeComm &tree, int round, int num_policy)
+    {
+        const int num_level_ctl = tree.num_level_controlled();
+        const bool is_root = num_level_ctl == tree.root_level();
+        std::vector<double> sample {1.0};
+        for (int level = 0; level < num_level_ctl; ++level) {
+            tree.send_up(level, sample);
+            std::vector<std::vector<double> > child(tree.level_size(level), {0.0});
+            while (!tree.receive_up(level, child)) {
+                std::this_thread::yield();
+            }
+            sample[0] = 0.0;
+            for (const auto &it : child) {
+                sample[0] += it[0];
+            }
+        }
+        std::vector<double> policy(num_policy, 1.0);
+        policy[0] = round;
+        if (num_policy > 1) {
+            policy[1 + round % (num_policy - 1)] += round;
+        }
+        if (!is_root) {
+            tree.send_up(num_level_ctl, sample);
+            while (!tree.receive_down(num_level_ctl, policy) || policy[0] != round) {
+                std::this_thread::yield();
+            }
+        }
+        for (int level = num_level_ctl - 1; level > -1; --level) {
+            tree.send_down(level, std::vector<std::vector<double> >(tree.level_size(level), policy));
+            tree.receive_down(level, policy);
+        }
+        return is_root ? sample[0] : 0.0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int num_node = 1024;
+    int num_round = 100;
+    int num_policy = 1;
+    if (argc > 1) {
+        num_node = std::stoi(argv[1]);
+    }
+    if (argc > 2) {
+        num_round = std::stoi(argv[2]);
+    }
+    if (argc > 3) {
+        num_policy = std::stoi(argv[3]);
+    }
+    if (num_node < 2 || num_round < 1 || num_policy < 1) {
+        std::cerr << "Error: NUM_NODE must be at least 2, NUM_ROUND and NUM_POLICY must be positive" << std::endl;
+        return -1;
+    }
+    int err = 0;
+    try {
+        std::vector<int> fan_out;
+        double setup_sec = 0.0;
+        double round_sec = 0.0;
+        size_t overhead_send = 0;
+        size_t overhead_saved = 0;
+        bool is_correct = true;
+        geopm::ThreadComm::run(num_node, [&] (std::shared_ptr<geopm::Comm> comm)
+        {
+            geopm_time_s setup_begin;
+            geopm_time(&setup_begin);
+            geopm::TreeCommImp tree(comm, num_policy, 1);
+            double tree_setup_sec = geopm_time_since(&setup_begin);
+            comm->barrier();
+            geopm_time_s begin;
+            geopm_time(&begin);
+            for (int round = 1; round <= num_round; ++round) {
+                double total = tree_round(tree, round, num_policy);
+                if (comm->rank() == 0 && total != num_node) {
+                    is_correct = false;
+                }
+            }
+            comm->barrier();
+            geopm_time_s end;
+            geopm_time(&end);
+            std::vector<double> send {(double)tree.overhead_send(),
+                                      (double)tree.overhead_saved()};
+            std::vector<double> total {0.0, 0.0};
+            comm->reduce_sum(send.data(), total.data(), send.size(), 0);
+            if (comm->rank() == 0) {
+                setup_sec = tree_setup_sec;
+                round_sec = geopm_time_diff(&begin, &end) / num_round;
+                overhead_send = total[0];
+                overhead_saved = total[1];
+                for (int level = tree.root_level() - 1; level >= 0; --level) {
+                    fan_out.push_back(tree.level_size(level));
+                }
+            }
+        });
+        std::cout << "num_node: " << num_node << " num_round: " << num_round
+                  << " num_policy: " << num_policy << std::endl;
+        std::cout << "fan_out:";
+        for (const auto &it : fan_out) {
+            std::cout << " " << it;
+        }
+        std::cout << std::endl;
+        std::cout << "setup (ms): " << 1e3 * setup_sec << std::endl;
+        std::cout << "round (us): " << 1e6 * round_sec << std::endl;
+        std::cout << "bytes sent per round: " << overhead_send / num_round << std::endl;
+        std::cout << "bytes saved per round: " << overhead_saved / num_round << std::endl;
+        if (!is_correct) {
+            std::cerr << "Error: root did not receive the samples of every node" << std::endl;
+            err = -1;
+        }
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        err = -1;
+    }
+    return err;
+}
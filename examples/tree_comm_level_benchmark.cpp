@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/// Microbenchmark for the message protocols of TreeCommLevel.  All
+/// ranks of MPI_COMM_WORLD form a single level of the tree with rank
+/// zero at its root.  In each round every rank sends a sample up,
+/// the root polls receive_up() until all samples have arrived and
+/// then sends a new policy down, and every other rank polls
+/// receive_down() until the new policy arrives.  The round is timed
+/// for the implementation that locks the window for each message
+/// and for the sequence numbered mailbox implementation.
+///
+/// Usage: mpiexec -n NUM_RANK tree_comm_level_benchmark [NUM_ROUND] [NUM_SEND_UP]
+
+#include <mpi.h>
+
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Exception.hpp"
+#include "MPIComm.hpp"
+#include "TreeCommLevel.hpp"
+
+namespace
+{
+    struct bench_result_s {
+        double round_sec;
+        double send_up_sec;
+        double num_poll_up;
+    };
+
+    bench_result_s run_bench(bool is_lock_free, int num_round, int num_send_up)
+    {
+        const int num_send_down = 4;
+        auto comm = std::make_shared<geopm::MPIComm>(MPI_COMM_WORLD);
+        int rank = comm->rank();
+        int num_rank = comm->num_rank();
+        auto level = geopm::TreeCommLevel::make_unique(comm, num_send_up, num_send_down, is_lock_free, false);
+        std::vector<double> sample(num_send_up, 0.0);
+        std::vector<std::vector<double> > sample_in(num_rank, std::vector<double>(num_send_up, 0.0));
+        std::vector<std::vector<double> > policy(num_rank, std::vector<double>(num_send_down, 0.0));
+        std::vector<double> policy_in;
+        bench_result_s result {};
+        uint64_t num_poll_up = 0;
+        comm->barrier();
+        double begin = MPI_Wtime();
+        for (int round = 1; round <= num_round; ++round) {
+            for (auto &val : sample) {
+                val = round;
+            }
+            double send_begin = MPI_Wtime();
+            level->send_up(sample);
+            result.send_up_sec += MPI_Wtime() - send_begin;
+            if (rank == 0) {
+                do {
+                    ++num_poll_up;
+                } while (!level->receive_up(sample_in) || sample_in.back()[0] != round);
+                for (auto &child : policy) {
+                    child[0] = round;
+                }
+                level->send_down(policy);
+            }
+            do {
+                policy_in.clear();
+            } while (!level->receive_down(policy_in) || policy_in[0] != round);
+        }
+        result.round_sec = (MPI_Wtime() - begin) / num_round;
+        result.send_up_sec /= num_round;
+        result.num_poll_up = (double)num_poll_up / num_round;
+        comm->barrier();
+        return result;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int num_round = 10000;
+    int num_send_up = 8;
+    MPI_Init(&argc, &argv);
+    if (argc > 1) {
+        num_round = std::stoi(argv[1]);
+    }
+    if (argc > 2) {
+        num_send_up = std::stoi(argv[2]);
+    }
+    int rank = 0;
+    int num_rank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_rank);
+    int err = 0;
+    try {
+        std::vector<std::pair<std::string, bench_result_s> > results {
+            {"lock", run_bench(false, num_round, num_send_up)},
+            {"sequence", run_bench(true, num_round, num_send_up)},
+        };
+        for (auto &it : results) {
+            // slowest sender in the level
+            double send_up_sec = 0.0;
+            MPI_Reduce(&it.second.send_up_sec, &send_up_sec, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+            it.second.send_up_sec = send_up_sec;
+        }
+        if (rank == 0) {
+            std::cout << "num_rank: " << num_rank
+                      << " num_round: " << num_round
+                      << " num_send_up: " << num_send_up << std::endl;
+            std::cout << std::setw(10) << "protocol"
+                      << std::setw(16) << "round (us)"
+                      << std::setw(16) << "send_up (us)"
+                      << std::setw(16) << "polls/round" << std::endl;
+            for (const auto &it : results) {
+                std::cout << std::setw(10) << it.first
+                          << std::fixed << std::setprecision(2)
+                          << std::setw(16) << 1e6 * it.second.round_sec
+                          << std::setw(16) << 1e6 * it.second.send_up_sec
+                          << std::setw(16) << it.second.num_poll_up << std::endl;
+            }
+        }
+    }
+    catch (const geopm::Exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        err = -1;
+    }
+    MPI_Finalize();
+    return err;
+}
@@ -233,9 +233,11 @@ def create_cache():
     functions in the topo module as well as any use of the GEOPM
     runtime.  File permissions of the cache file are set to
     "-rw-rw-rw-", i.e. 666. The path for the cache file is
-    /tmp/geopm-topo-cache.  If the file exists no operation will be
+    /tmp/geopm-topo-cache.bin, a versioned binary image of the
+    topology read from sysfs.  If the file exists no operation will be
     performed.  To force the creation of a new cache file call
-    os.unlink('/tmp/geopm-topo-cache') prior to calling this function.
+    os.unlink('/tmp/geopm-topo-cache.bin') prior to calling this
+    function.
 
     """
     global _dl
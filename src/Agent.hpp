@@ -37,7 +37,9 @@
 #include <map>
 #include <vector>
 #include <functional>
+#include <algorithm>
 
+#include "Agg.hpp"
 #include "PluginFactory.hpp"
 
 namespace geopm
@@ -205,6 +207,28 @@ namespace geopm
             static void aggregate_sample(const std::vector<std::vector<double> > &in_sample,
                                          const std::vector<std::function<double(const std::vector<double>&)> > &agg_func,
                                          std::vector<double> &out_sample);
+            /// @brief Aggregate a vector of samples with the
+            ///        vectorized kernels of Agg::aggregate_column().
+            ///        The aggregation of each sample element is
+            ///        fixed at compile time by the template
+            ///        arguments, so no function is called per
+            ///        element.  The child samples are copied into a
+            ///        contiguous child-major matrix that the caller
+            ///        owns so that its storage is reused between
+            ///        calls.
+            /// @tparam agg_type One Agg::m_column_e value for each
+            ///         sample element.
+            /// @param [in] in_sample Vector over children of the
+            ///        sample vector received from each child.
+            /// @param [in,out] sample_matrix Storage for the
+            ///        child-major matrix, resized as needed.
+            /// @param [out] out_sample Sample vector resulting from
+            ///        the applying the aggregation across child
+            ///        samples.
+            template <int... agg_type>
+            static void aggregate_sample(const std::vector<std::vector<double> > &in_sample,
+                                         std::vector<double> &sample_matrix,
+                                         std::vector<double> &out_sample);
             static const std::string M_PLUGIN_PREFIX;
         private:
             static const std::string m_num_sample_string;
@@ -213,6 +237,24 @@ namespace geopm
             static const std::string m_policy_prefix;
     };
 
+    template <int... agg_type>
+    void Agent::aggregate_sample(const std::vector<std::vector<double> > &in_sample,
+                                 std::vector<double> &sample_matrix,
+                                 std::vector<double> &out_sample)
+    {
+        static const int M_AGG_TYPE[] = {agg_type...};
+        const size_t num_sample = sizeof...(agg_type);
+        const size_t num_children = in_sample.size();
+        sample_matrix.resize(num_children * num_sample);
+        auto row_it = sample_matrix.begin();
+        for (const auto &child_sample : in_sample) {
+            row_it = std::copy(child_sample.begin(), child_sample.begin() + num_sample, row_it);
+        }
+        out_sample.resize(num_sample);
+        Agg::aggregate_column(sample_matrix.data(), num_children, num_sample,
+                              M_AGG_TYPE, out_sample.data());
+    }
+
     class AgentFactory : public PluginFactory<Agent>
     {
         public:
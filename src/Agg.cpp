@@ -40,10 +40,169 @@
 #include "geopm_internal.h"
 #include "geopm_hash.h"
 
+#include "Exception.hpp"
 #include "config.h"
 
+#if defined(GEOPM_HAS_XMMINTRIN) && defined(__SSE2__)
+#include <emmintrin.h>
+#define GEOPM_AGG_SSE2
+#endif
+
 namespace geopm
 {
+    namespace {
+        /// Each reduction provides first() to convert the value in
+        /// the first row into an accumulator and next() to fold the
+        /// value of a later row into the accumulator.  The
+        /// operations are ordered so that the result matches the
+        /// std::vector functions bit for bit.
+        struct column_sum {
+            static double first(double xx)
+            {
+                return 0.0 + xx;
+            }
+            static double next(double acc, double xx)
+            {
+                return acc + xx;
+            }
+#ifdef GEOPM_AGG_SSE2
+            static __m128d first(__m128d xx)
+            {
+                return _mm_add_pd(_mm_setzero_pd(), xx);
+            }
+            static __m128d next(__m128d acc, __m128d xx)
+            {
+                return _mm_add_pd(acc, xx);
+            }
+#endif
+        };
+
+        struct column_min {
+            static double first(double xx)
+            {
+                return xx;
+            }
+            static double next(double acc, double xx)
+            {
+                return xx < acc ? xx : acc;
+            }
+#ifdef GEOPM_AGG_SSE2
+            static __m128d first(__m128d xx)
+            {
+                return xx;
+            }
+            static __m128d next(__m128d acc, __m128d xx)
+            {
+                return _mm_min_pd(xx, acc);
+            }
+#endif
+        };
+
+        struct column_max {
+            static double first(double xx)
+            {
+                return xx;
+            }
+            static double next(double acc, double xx)
+            {
+                return xx > acc ? xx : acc;
+            }
+#ifdef GEOPM_AGG_SSE2
+            static __m128d first(__m128d xx)
+            {
+                return xx;
+            }
+            static __m128d next(__m128d acc, __m128d xx)
+            {
+                return _mm_max_pd(xx, acc);
+            }
+#endif
+        };
+
+        struct column_logical_and {
+            static double first(double xx)
+            {
+                return xx != 0.0 ? 1.0 : 0.0;
+            }
+            static double next(double acc, double xx)
+            {
+                return acc != 0.0 && xx != 0.0 ? 1.0 : 0.0;
+            }
+#ifdef GEOPM_AGG_SSE2
+            static __m128d first(__m128d xx)
+            {
+                return _mm_and_pd(_mm_cmpneq_pd(xx, _mm_setzero_pd()), _mm_set1_pd(1.0));
+            }
+            static __m128d next(__m128d acc, __m128d xx)
+            {
+                return _mm_and_pd(acc, first(xx));
+            }
+#endif
+        };
+
+        struct column_logical_or {
+            static double first(double xx)
+            {
+                return xx != 0.0 ? 1.0 : 0.0;
+            }
+            static double next(double acc, double xx)
+            {
+                return acc != 0.0 || xx != 0.0 ? 1.0 : 0.0;
+            }
+#ifdef GEOPM_AGG_SSE2
+            static __m128d first(__m128d xx)
+            {
+                return column_logical_and::first(xx);
+            }
+            static __m128d next(__m128d acc, __m128d xx)
+            {
+                return _mm_or_pd(acc, first(xx));
+            }
+#endif
+        };
+
+        /// Reduce num_col adjacent columns of a row-major matrix
+        /// with row_stride elements per row.
+        template <typename reduce_t>
+        void column_reduce(const double *matrix, size_t num_row, size_t row_stride,
+                           size_t num_col, double *result)
+        {
+            size_t col_idx = 0;
+#ifdef GEOPM_AGG_SSE2
+            for (; col_idx + 4 <= num_col; col_idx += 4) {
+                const double *elem = matrix + col_idx;
+                __m128d acc_lo = reduce_t::first(_mm_loadu_pd(elem));
+                __m128d acc_hi = reduce_t::first(_mm_loadu_pd(elem + 2));
+                for (size_t row_idx = 1; row_idx < num_row; ++row_idx) {
+                    elem += row_stride;
+                    acc_lo = reduce_t::next(acc_lo, _mm_loadu_pd(elem));
+                    acc_hi = reduce_t::next(acc_hi, _mm_loadu_pd(elem + 2));
+                }
+                _mm_storeu_pd(result + col_idx, acc_lo);
+                _mm_storeu_pd(result + col_idx + 2, acc_hi);
+            }
+            for (; col_idx + 2 <= num_col; col_idx += 2) {
+                const double *elem = matrix + col_idx;
+                __m128d acc = reduce_t::first(_mm_loadu_pd(elem));
+                for (size_t row_idx = 1; row_idx < num_row; ++row_idx) {
+                    elem += row_stride;
+                    acc = reduce_t::next(acc, _mm_loadu_pd(elem));
+                }
+                _mm_storeu_pd(result + col_idx, acc);
+            }
+#endif
+            for (; col_idx < num_col; ++col_idx) {
+                const double *elem = matrix + col_idx;
+                double acc = reduce_t::first(*elem);
+                for (size_t row_idx = 1; row_idx < num_row; ++row_idx) {
+                    elem += row_stride;
+                    acc = reduce_t::next(acc, *elem);
+                }
+                result[col_idx] = acc;
+            }
+        }
+    }
+
     double Agg::sum(const std::vector<double> &operand)
     {
         double result = NAN;
@@ -182,4 +341,57 @@ namespace geopm
         }
         return value;
     }
+
+    void Agg::aggregate_column(const double *matrix,
+                               size_t num_row,
+                               size_t num_col,
+                               const int *agg_type,
+                               double *result)
+    {
+        if (num_row == 0) {
+            std::fill(result, result + num_col, NAN);
+            return;
+        }
+        // Reduce each run of neighboring columns that share an
+        // aggregation type with a single kernel call.
+        size_t run_end = 0;
+        for (size_t run_begin = 0; run_begin < num_col; run_begin = run_end) {
+            int type = agg_type[run_begin];
+            run_end = run_begin + 1;
+            while (run_end < num_col && agg_type[run_end] == type) {
+                ++run_end;
+            }
+            const double *run_matrix = matrix + run_begin;
+            size_t run_size = run_end - run_begin;
+            double *run_result = result + run_begin;
+            switch (type) {
+                case M_COLUMN_SUM:
+                    column_reduce<column_sum>(run_matrix, num_row, num_col, run_size, run_result);
+                    break;
+                case M_COLUMN_AVERAGE:
+                    column_reduce<column_sum>(run_matrix, num_row, num_col, run_size, run_result);
+                    for (size_t col_idx = 0; col_idx < run_size; ++col_idx) {
+                        run_result[col_idx] /= num_row;
+                    }
+                    break;
+                case M_COLUMN_MIN:
+                    column_reduce<column_min>(run_matrix, num_row, num_col, run_size, run_result);
+                    break;
+                case M_COLUMN_MAX:
+                    column_reduce<column_max>(run_matrix, num_row, num_col, run_size, run_result);
+                    break;
+                case M_COLUMN_LOGICAL_AND:
+                    column_reduce<column_logical_and>(run_matrix, num_row, num_col, run_size, run_result);
+                    break;
+                case M_COLUMN_LOGICAL_OR:
+                    column_reduce<column_logical_or>(run_matrix, num_row, num_col, run_size, run_result);
+                    break;
+                default:
+                    throw Exception("Agg::aggregate_column(): invalid aggregation type: " +
+                                    std::to_string(type),
+                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                    break;
+            }
+        }
+    }
 }
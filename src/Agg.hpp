@@ -33,6 +33,7 @@
 #ifndef AGG_HPP_INCLUDE
 #define AGG_HPP_INCLUDE
 
+#include <cstddef>
 #include <vector>
 
 namespace geopm
@@ -42,6 +43,16 @@ namespace geopm
     class Agg
     {
         public:
+            /// @brief Aggregation applied to one column by
+            ///        aggregate_column().
+            enum m_column_e {
+                M_COLUMN_SUM,
+                M_COLUMN_AVERAGE,
+                M_COLUMN_MIN,
+                M_COLUMN_MAX,
+                M_COLUMN_LOGICAL_AND,
+                M_COLUMN_LOGICAL_OR,
+            };
             /// @brief Returns the sum of the input operands.
             static double sum(const std::vector<double> &operand);
             /// @brief Returns the average of the input operands.
@@ -88,6 +99,30 @@ namespace geopm
             ///        to aggregate values that may be interpreted as NAN
             ///        such as raw register values.
             static double expect_same(const std::vector<double> &operand);
+            /// @brief Reduces each column of a row-major matrix with
+            ///        the Agg function named by agg_type.  Rows are
+            ///        read contiguously so that the reduction is
+            ///        vectorized across neighboring columns that
+            ///        share the same agg_type.  The result of each
+            ///        column is identical to the result of the
+            ///        corresponding std::vector function: sum(),
+            ///        average(), min(), max(), logical_and() or
+            ///        logical_or().
+            /// @param [in] matrix Pointer to the first element of
+            ///        the matrix.
+            /// @param [in] num_row Number of rows, each row is
+            ///        reduced into the result.  If zero, every
+            ///        result is NAN.
+            /// @param [in] num_col Number of columns in each row.
+            /// @param [in] agg_type Array of num_col m_column_e
+            ///        values, one for each column.
+            /// @param [out] result Array of num_col values where the
+            ///        reduction of each column is written.
+            static void aggregate_column(const double *matrix,
+                                         size_t num_row,
+                                         size_t num_col,
+                                         const int *agg_type,
+                                         double *result);
     };
 }
 
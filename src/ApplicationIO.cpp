@@ -311,6 +311,30 @@ namespace geopm
         return result;
     }
 
+    std::vector<uint64_t> ApplicationIOImp::profile_table_coalesced(void) const
+    {
+#ifdef GEOPM_DEBUG
+        if (!m_is_connected) {
+            throw Exception("ApplicationIOImp::" + std::string(__func__) +
+                            " called before connect().",
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+#endif
+        return m_application_sampler.get_sampler()->rank_num_coalesced();
+    }
+
+    std::vector<uint64_t> ApplicationIOImp::profile_table_dropped(void) const
+    {
+#ifdef GEOPM_DEBUG
+        if (!m_is_connected) {
+            throw Exception("ApplicationIOImp::" + std::string(__func__) +
+                            " called before connect().",
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+#endif
+        return m_application_sampler.get_sampler()->rank_num_dropped();
+    }
+
     void ApplicationIOImp::update(std::shared_ptr<Comm> comm)
     {
 #ifdef GEOPM_DEBUG
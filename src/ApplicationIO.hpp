@@ -100,6 +100,14 @@ namespace geopm
             ///        entered and exited.
             /// @param [in] region_id The region ID.
             virtual int total_count(uint64_t region_id) const = 0;
+            /// @brief Returns the number of progress records
+            ///        coalesced by each rank's profile table because
+            ///        it was full, indexed by node local rank.
+            virtual std::vector<uint64_t> profile_table_coalesced(void) const = 0;
+            /// @brief Returns the number of progress records
+            ///        dropped by each rank's profile table because
+            ///        it was full, indexed by node local rank.
+            virtual std::vector<uint64_t> profile_table_dropped(void) const = 0;
             /// @brief Check for updates from the application and
             ///        adjust totals accordingly.
             /// @param [in] comm Shared pointer to the comm used by
@@ -150,6 +158,8 @@ namespace geopm
             double total_epoch_energy_pkg(void) const override;
             double total_epoch_energy_dram(void) const override;
             int total_count(uint64_t region_id) const override;
+            std::vector<uint64_t> profile_table_coalesced(void) const override;
+            std::vector<uint64_t> profile_table_dropped(void) const override;
             void update(std::shared_ptr<Comm> comm) override;
             std::list<geopm_region_info_s> region_info(void) const override;
             void clear_region_info(void) override;
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "AsyncWriter.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    AsyncWriter &async_writer(void)
+    {
+        static AsyncWriter instance;
+        return instance;
+    }
+
+    AsyncWriter::AsyncWriter()
+        : m_is_stop(false)
+    {
+
+    }
+
+    AsyncWriter::~AsyncWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_is_stop = true;
+        }
+        m_work_cv.notify_one();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        for (const auto &it : m_file) {
+            (void)::close(it.first);
+        }
+    }
+
+    int AsyncWriter::open(const std::string &path, size_t max_pending)
+    {
+        if (max_pending == 0) {
+            throw Exception("AsyncWriter::open(): max_pending must be positive",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int result = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        if (result == -1) {
+            throw Exception("AsyncWriter::open(): Unable to open file '" + path + "'",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_file[result] = {path, max_pending, 0, nullptr, {}};
+        if (!m_thread.joinable()) {
+            m_thread = std::thread(&AsyncWriter::run, this);
+        }
+        return result;
+    }
+
+    AsyncWriter::m_file_s &AsyncWriter::file(int handle)
+    {
+        auto it = m_file.find(handle);
+        if (it == m_file.end()) {
+            throw Exception("AsyncWriter: invalid file handle: " + std::to_string(handle),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return it->second;
+    }
+
+    void AsyncWriter::check_error(m_file_s &file)
+    {
+        if (file.error) {
+            std::exception_ptr error = file.error;
+            file.error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    void AsyncWriter::write(int handle, std::string &chunk)
+    {
+        if (chunk.empty()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_file_s &curr = file(handle);
+        check_error(curr);
+        // Back pressure: wait for the I/O thread to catch up
+        m_done_cv.wait(lock, [&curr]() {return curr.num_pending < curr.max_pending;});
+        m_queue.push_back({handle, std::string()});
+        m_queue.back().data.swap(chunk);
+        if (!curr.free_chunk.empty()) {
+            chunk.swap(curr.free_chunk.back());
+            curr.free_chunk.pop_back();
+        }
+        ++curr.num_pending;
+        lock.unlock();
+        m_work_cv.notify_one();
+    }
+
+    void AsyncWriter::flush(int handle)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_file_s &curr = file(handle);
+        m_done_cv.wait(lock, [&curr]() {return curr.num_pending == 0;});
+        check_error(curr);
+    }
+
+    void AsyncWriter::close(int handle)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto it = m_file.find(handle);
+        if (it != m_file.end()) {
+            m_file_s &curr = it->second;
+            m_done_cv.wait(lock, [&curr]() {return curr.num_pending == 0;});
+            m_file.erase(it);
+            (void)::close(handle);
+        }
+    }
+
+    void AsyncWriter::run(void)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_work_cv.wait(lock, [this]() {return m_is_stop || !m_queue.empty();});
+            if (m_queue.empty()) {
+                break;
+            }
+            m_chunk_s chunk;
+            chunk.handle = m_queue.front().handle;
+            chunk.data.swap(m_queue.front().data);
+            m_queue.pop_front();
+            const std::string &path = m_file.at(chunk.handle).path;
+            lock.unlock();
+            std::exception_ptr error;
+            size_t offset = 0;
+            while (offset != chunk.data.size()) {
+                ssize_t num_write = ::write(chunk.handle, chunk.data.data() + offset,
+                                            chunk.data.size() - offset);
+                if (num_write == -1 && errno != EINTR) {
+                    error = std::make_exception_ptr(
+                        Exception("AsyncWriter: Unable to write to file '" + path + "'",
+                                  errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__));
+                    break;
+                }
+                else if (num_write > 0) {
+                    offset += num_write;
+                }
+            }
+            chunk.data.clear();
+            lock.lock();
+            m_file_s &curr = m_file.at(chunk.handle);
+            if (error && !curr.error) {
+                curr.error = error;
+            }
+            if (curr.free_chunk.size() < curr.max_pending) {
+                curr.free_chunk.push_back(std::move(chunk.data));
+            }
+            --curr.num_pending;
+            m_done_cv.notify_all();
+        }
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ASYNCWRITER_HPP_INCLUDE
+#define ASYNCWRITER_HPP_INCLUDE
+
+#include <stddef.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace geopm
+{
+    /// @brief Writes buffered file output on a dedicated I/O thread.
+    ///
+    /// A producer fills a chunk of text or binary data and hands it
+    /// to write(), which swaps it with an empty chunk (recycled from
+    /// an earlier write when possible) and returns without waiting
+    /// for the file system.  Each file may have a limited number of
+    /// chunks in flight; write() blocks when that limit is reached,
+    /// so the memory used is bounded by the chunk size times the
+    /// limit.  Errors raised on the I/O thread are thrown by the next
+    /// write() or flush() for the same file.  One I/O thread serves
+    /// every open file; it is started by the first call to open().
+    class AsyncWriter
+    {
+        public:
+            AsyncWriter();
+            virtual ~AsyncWriter();
+            /// @brief Create or truncate a file for writing.
+            /// @param [in] path Path to the file.
+            /// @param [in] max_pending Number of chunks that may be
+            ///        queued or in the process of being written
+            ///        before write() blocks.
+            /// @return Handle used for the other methods.
+            int open(const std::string &path, size_t max_pending);
+            /// @brief Queue a chunk to be written to the end of the
+            ///        file.
+            /// @param [in] handle Value returned by open().
+            /// @param [in,out] chunk Data to write; replaced with an
+            ///        empty string that may have reserved capacity.
+            void write(int handle, std::string &chunk);
+            /// @brief Wait until all queued chunks for the file have
+            ///        been written.
+            /// @param [in] handle Value returned by open().
+            void flush(int handle);
+            /// @brief Write any queued chunks and close the file.
+            ///        Errors are not reported.
+            /// @param [in] handle Value returned by open().
+            void close(int handle);
+        private:
+            struct m_file_s {
+                std::string path;
+                size_t max_pending;
+                size_t num_pending;
+                std::exception_ptr error;
+                std::vector<std::string> free_chunk;
+            };
+            struct m_chunk_s {
+                int handle;
+                std::string data;
+            };
+            void run(void);
+            m_file_s &file(int handle);
+            void check_error(m_file_s &file);
+
+            std::mutex m_mutex;
+            std::condition_variable m_work_cv;
+            std::condition_variable m_done_cv;
+            std::deque<m_chunk_s> m_queue;
+            std::map<int, m_file_s> m_file;
+            bool m_is_stop;
+            std::thread m_thread;
+    };
+
+    /// @brief Writer shared by the trace and profile trace files of
+    ///        the process.
+    AsyncWriter &async_writer(void);
+}
+
+#endif
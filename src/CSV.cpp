@@ -38,10 +38,14 @@
 #include "CSV.hpp"
 #include "Exception.hpp"
 #include "Environment.hpp"
+#include "AsyncWriter.hpp"
+#include "NumberFormat.hpp"
 #include "config.h"
 
 namespace geopm
 {
+    constexpr size_t CSVImp::M_MAX_PENDING;
+
     CSVImp::CSVImp(const std::string &file_path,
                    const std::string &host_name,
                    const std::string &start_time,
@@ -53,23 +57,32 @@ namespace geopm
                              {"raw64", string_format_raw64}}
         , M_SEPARATOR('|')
         , m_file_path(file_path)
+        , m_file_handle(-1)
         , m_buffer_limit(buffer_size)
         , m_is_active(false)
     {
         if (host_name.size()) {
             m_file_path += "-" + host_name;
         }
-        m_stream.open(m_file_path);
-        if (!m_stream.good()) {
+        try {
+            m_file_handle = async_writer().open(m_file_path, M_MAX_PENDING);
+        }
+        catch (const Exception &ex) {
             throw Exception("Unable to open CSV file '" + m_file_path + "'",
-                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                            ex.err_value(), __FILE__, __LINE__);
         }
         write_header(start_time, host_name);
     }
 
     CSVImp::~CSVImp()
     {
-        flush();
+        try {
+            flush();
+        }
+        catch (...) {
+            exception_handler(std::current_exception(), true);
+        }
+        async_writer().close(m_file_handle);
     }
 
     void CSVImp::add_column(const std::string &name)
@@ -90,6 +103,7 @@ namespace geopm
         }
         m_column_name.push_back(name);
         m_column_format.push_back(it->second);
+        m_column_type.push_back(NumberFormat::format_type(it->second));
     }
 
     void CSVImp::add_column(const std::string &name, std::function<std::string(double)> format)
@@ -100,6 +114,16 @@ namespace geopm
         }
         m_column_name.push_back(name);
         m_column_format.push_back(format);
+        m_column_type.push_back(NumberFormat::format_type(format));
+    }
+
+    void CSVImp::add_meta_data(const std::string &key, const std::string &value)
+    {
+        if (m_is_active) {
+            throw Exception("CSVImp::add_meta_data() cannot be called after activate()",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_buffer += "# " + key + ": " + value + "\n";
     }
 
     void CSVImp::update(const std::vector<double> &sample)
@@ -112,34 +136,42 @@ namespace geopm
             throw Exception("CSVImp::update(): Input vector incorrectly sized",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        char value[NumberFormat::M_MAX_SIZE];
         for (size_t sample_idx = 0; sample_idx != sample.size(); ++sample_idx) {
             if (sample_idx) {
-                m_buffer << M_SEPARATOR;
+                m_buffer += M_SEPARATOR;
+            }
+            int type = m_column_type[sample_idx];
+            if (type != NumberFormat::M_FORMAT_CUSTOM) {
+                m_buffer.append(value, NumberFormat::format(type, sample[sample_idx], value));
+            }
+            else {
+                m_buffer += m_column_format[sample_idx](sample[sample_idx]);
             }
-            m_buffer << m_column_format[sample_idx](sample[sample_idx]);
         }
-        m_buffer << "\n";
+        m_buffer += '\n';
 
-        // if buffer is full, flush to file
-        if (m_buffer.tellp() > m_buffer_limit) {
-            flush();
+        // if buffer is full, hand it to the I/O thread
+        if (m_buffer.size() > m_buffer_limit) {
+            async_writer().write(m_file_handle, m_buffer);
         }
     }
 
     void CSVImp::flush(void)
     {
-        m_stream << m_buffer.str();
-        m_stream.flush();
-        m_buffer.str("");
+        async_writer().write(m_file_handle, m_buffer);
+        async_writer().flush(m_file_handle);
     }
 
     void CSVImp::write_header(const std::string &start_time, const std::string &host_name)
     {
-        m_buffer << "# geopm_version: " << geopm_version() << "\n"
-                 << "# start_time: " << start_time << "\n"
-                 << "# profile_name: " << environment().profile() << "\n"
-                 << "# node_name: " << host_name << "\n"
-                 << "# agent: " << environment().agent() << "\n";
+        std::ostringstream header;
+        header << "# geopm_version: " << geopm_version() << "\n"
+               << "# start_time: " << start_time << "\n"
+               << "# profile_name: " << environment().profile() << "\n"
+               << "# node_name: " << host_name << "\n"
+               << "# agent: " << environment().agent() << "\n";
+        m_buffer += header.str();
     }
 
     void CSVImp::activate(void)
@@ -158,10 +190,10 @@ namespace geopm
                is_once = false;
             }
             else {
-                m_buffer << M_SEPARATOR;
+                m_buffer += M_SEPARATOR;
             }
-            m_buffer << it;
+            m_buffer += it;
         }
-        m_buffer << '\n';
+        m_buffer += '\n';
     }
 }
@@ -87,6 +87,12 @@ namespace geopm
             ///        this column in the CSV file.
             virtual void add_column(const std::string &name,
                                     std::function<std::string(double)> format) = 0;
+            /// @brief Add a line to the meta-data at the top of the
+            ///        file.  Must be called prior to activate().
+            /// @param [in] key Name of the field.
+            /// @param [in] value Value printed after the name.
+            virtual void add_meta_data(const std::string &key,
+                                       const std::string &value) = 0;
             /// @brief Calling activate indicates that all columns
             ///        have been added to the object and calls to
             ///        update() are enabled.
@@ -100,6 +106,14 @@ namespace geopm
             virtual void flush(void) = 0;
     };
 
+    /// @brief CSV file written in chunks by the shared AsyncWriter
+    ///        I/O thread.  Rows are formatted into a chunk of up to
+    ///        buffer_size bytes which is handed off to the I/O thread
+    ///        when it is full, so the caller only waits on the file
+    ///        system when two earlier chunks are still being written.
+    ///        Columns that use one of the geopm::string_format_*()
+    ///        functions are printed directly into the chunk by
+    ///        NumberFormat.
     class CSVImp : public CSV
     {
         public:
@@ -113,6 +127,8 @@ namespace geopm
                             const std::string &format) override;
             void add_column(const std::string &name,
                             std::function<std::string(double)> format) override;
+            void add_meta_data(const std::string &key,
+                               const std::string &value) override;
             void activate(void) override;
             void update(const std::vector<double> &sample) override;
             void flush(void) override;
@@ -120,14 +136,16 @@ namespace geopm
             void write_header(const std::string &host_name, const std::string &start_time);
             void write_names(void);
 
+            static constexpr size_t M_MAX_PENDING = 2;
             const std::map<std::string, std::function<std::string(double)> > M_NAME_FORMAT_MAP;
             const char M_SEPARATOR;
             std::string m_file_path;
             std::vector<std::string> m_column_name;
             std::vector<std::function<std::string(double)> > m_column_format;
-            std::ofstream m_stream;
-            std::ostringstream m_buffer;
-            off_t m_buffer_limit;
+            std::vector<int> m_column_type;
+            int m_file_handle;
+            std::string m_buffer;
+            size_t m_buffer_limit;
             bool m_is_active;
     };
 }
@@ -61,8 +61,7 @@ namespace geopm
 
     DerivativeCombinedSignal::DerivativeCombinedSignal()
         : M_NUM_SAMPLE_HISTORY(8)
-        , m_history(M_NUM_SAMPLE_HISTORY)
-        , m_derivative_num_fit(0)
+        , m_history(M_NUM_SAMPLE_HISTORY, DerivativeHistory::M_MODE_RUNNING)
     {
 
     }
@@ -76,38 +75,7 @@ namespace geopm
                             GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
         }
 #endif
-        double ins_time = values[0];
-        double ins_signal = values[1];
-        // insert time and signal
-        m_history.insert({ins_time, ins_signal});
-        if (m_derivative_num_fit < M_NUM_SAMPLE_HISTORY) {
-            ++m_derivative_num_fit;
-        }
-
-        // Least squares linear regression to approximate the
-        // derivative with noisy data.
-        double result = NAN;
-        if (m_derivative_num_fit >= 2) {
-            size_t buf_size = m_history.size();
-            double A = 0.0, B = 0.0, C = 0.0, D = 0.0;
-            double E = 1.0 / m_derivative_num_fit;
-            double time_0 = m_history.value(buf_size - m_derivative_num_fit).time;
-            const double sig_0 = m_history.value(buf_size - m_derivative_num_fit).sample;
-            for (size_t buf_off = buf_size - m_derivative_num_fit;
-                 buf_off < buf_size; ++buf_off) {
-                double tt = m_history.value(buf_off).time;
-                double time = tt - time_0;
-                double sig = m_history.value(buf_off).sample - sig_0;
-                A += time * sig;
-                B += time;
-                C += sig;
-                D += time * time;
-            }
-            double ssxx = D - B * B * E;
-            double ssxy = A - B * C * E;
-            result = ssxy / ssxx;
-        }
-        return result;
+        return m_history.insert(values[0], values[1]);
     }
 
     double DifferenceCombinedSignal::sample(const std::vector<double> &values)
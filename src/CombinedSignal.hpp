@@ -37,7 +37,7 @@
 #include <functional>
 #include <vector>
 
-#include "CircularBuffer.hpp"
+#include "DerivativeHistory.hpp"
 
 namespace geopm
 {
@@ -64,14 +64,9 @@ namespace geopm
             virtual ~DerivativeCombinedSignal() = default;
             double sample(const std::vector<double> &values) override;
         private:
-            struct m_sample_s {
-                double time;
-                double sample;
-            };
             const int M_NUM_SAMPLE_HISTORY;
             // time + energy history
-            CircularBuffer<m_sample_s> m_history;
-            int m_derivative_num_fit;
+            DerivativeHistory m_history;
     };
 
     /// @brief Used by PlatformIO for CombinedSignals based on a
@@ -41,6 +41,7 @@
 #include <mutex>
 #include <Environment.hpp>
 #include <geopm_plugin.hpp>
+#include "ThreadComm.hpp"
 #include "config.h"
 #ifdef GEOPM_ENABLE_MPI
 #include "MPIComm.hpp"
@@ -52,6 +53,8 @@ namespace geopm
 
     CommFactory::CommFactory()
     {
+        register_plugin(geopm::ThreadComm::plugin_name(),
+                        geopm::ThreadComm::make_plugin);
 #ifdef GEOPM_ENABLE_MPI
         register_plugin(geopm::MPIComm::plugin_name(),
                         geopm::MPIComm::make_plugin);
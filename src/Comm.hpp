@@ -130,6 +130,36 @@ namespace geopm
             ///
             /// @param [in] rank Rank of the locked window.
             virtual void window_unlock(size_t window_id, int rank) const = 0;
+            /// @brief Begin a shared epoch for message passing and
+            ///        RMA on all ranks of the window.  The epoch may
+            ///        be held for the lifetime of the window, and
+            ///        completion of individual puts is controlled
+            ///        with window_flush().
+            ///
+            /// @param [in] window_id The window handle for the target window.
+            ///
+            /// @param [in] assert Used to optimize call.
+            virtual void window_lock_all(size_t window_id, int assert) const = 0;
+            /// @brief End the epoch started with window_lock_all().
+            ///
+            /// @param [in] window_id The window handle for the target window.
+            virtual void window_unlock_all(size_t window_id) const = 0;
+            /// @brief Complete all outstanding puts issued by the
+            ///        calling rank to the target rank at both the
+            ///        origin and the target.
+            ///
+            /// @param [in] window_id The window handle for the target window.
+            ///
+            /// @param [in] rank Rank that was the target of the puts.
+            virtual void window_flush(size_t window_id, int rank) const = 0;
+            /// @brief Synchronize the local copy of the window memory
+            ///        with updates made by remote puts.  Called by
+            ///        the target before reading memory that is
+            ///        written with window_put() under an epoch
+            ///        started by window_lock_all().
+            ///
+            /// @param [in] window_id The window handle for the target window.
+            virtual void window_sync(size_t window_id) const = 0;
             /// @brief Coordinate in Cartesian grid for specified rank
             ///
             /// @param [in] rank Rank for which coordinates should be calculated
@@ -164,6 +194,16 @@ namespace geopm
             /// @param [in] count Size of buffer in bytes to be transmitted.
             ///
             virtual void reduce_max(double *send_buf, double *recv_buf, size_t count, int root) const = 0;
+            /// @brief Sum distributed messages across all ranks, store result on the root rank
+            ///
+            /// @param [in] send_buf Start address of memory buffer to be trasnmitted.
+            ///
+            /// @param [out] recv_buf Start address of memory buffer to receive data.
+            ///
+            /// @param [in] count Number of doubles in the buffer.
+            ///
+            /// @param [in] root Rank that receives the result.
+            virtual void reduce_sum(double *send_buf, double *recv_buf, size_t count, int root) const = 0;
             /// @brief Gather bytes from all processes
             ///
             /// @param [in] send_buf Start address of memory buffer to be trasnmitted.
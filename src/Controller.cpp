@@ -50,7 +50,9 @@
 #include "TreeComm.hpp"
 #include "EndpointUser.hpp"
 #include "FilePolicy.hpp"
+#include "LatencyHistogram.hpp"
 #include "Helper.hpp"
+#include "geopm_time.h"
 #include "config.h"
 
 extern "C"
@@ -193,7 +195,8 @@ namespace geopm
                      environment().do_policy(),
                      nullptr,
                      environment().endpoint(),
-                     environment().do_endpoint())
+                     environment().do_endpoint(),
+                     environment().do_ctl_pipeline())
     {
 
     }
@@ -214,7 +217,8 @@ namespace geopm
                            bool do_policy,
                            std::unique_ptr<EndpointUser> endpoint,
                            const std::string &endpoint_path,
-                           bool do_endpoint)
+                           bool do_endpoint,
+                           bool do_pipeline)
         : m_comm(comm)
         , m_platform_io(plat_io)
         , m_agent_name(agent_name)
@@ -238,6 +242,15 @@ namespace geopm
         , m_endpoint(std::move(endpoint))
         , m_do_endpoint(do_endpoint)
         , m_do_policy(do_policy)
+        , m_do_pipeline(do_pipeline)
+        , m_phase_time(M_NUM_PHASE, 0.0)
+        , m_num_step(0)
+        , m_latency(controller_latency())
+        , m_platform_sample(m_num_send_up, NAN)
+        , m_do_send_platform(false)
+        , m_is_platform_ready(false)
+        , m_is_pipeline_busy(false)
+        , m_is_pipeline_stop(false)
     {
         if (m_num_send_down > 0 && !(m_do_policy || m_do_endpoint)) {
             throw Exception("Controller(): at least one of policy or endpoint path"
@@ -268,6 +281,7 @@ namespace geopm
 
     Controller::~Controller()
     {
+        stop_pipeline();
         m_platform_io.restore_control();
     }
 
@@ -366,6 +380,12 @@ namespace geopm
         }
 
         auto agent_host_report = m_agent[0]->report_host();
+        auto phase_report = report_phase();
+        agent_host_report.insert(agent_host_report.end(),
+                                 phase_report.begin(), phase_report.end());
+        auto latency_report = m_latency.report();
+        agent_host_report.insert(agent_host_report.end(),
+                                 latency_report.begin(), latency_report.end());
 
         m_reporter->generate(m_agent_name,
                              agent_report_header,
@@ -379,10 +399,148 @@ namespace geopm
 
     void Controller::step(void)
     {
-        walk_down();
+        if (m_do_pipeline) {
+            step_pipeline();
+        }
+        else {
+            struct geopm_time_s last;
+            geopm_time(&last);
+            walk_down();
+            m_latency.update(ControllerLatency::M_PHASE_WALK_DOWN,
+                             phase_time(M_PHASE_WALK_DOWN, last));
+            walk_up();
+            geopm_time(&last);
+            m_agent[0]->wait();
+            phase_time(M_PHASE_WAIT, last);
+        }
+        ++m_num_step;
+    }
 
-        walk_up();
+    void Controller::step_pipeline(void)
+    {
+        struct geopm_time_s last;
+        if (!m_is_platform_ready) {
+            geopm_time(&last);
+            m_application_io->update(m_comm);
+            m_latency.update(ControllerLatency::M_PHASE_APPLICATION_UPDATE,
+                             phase_time(M_PHASE_APPLICATION, last));
+            m_do_send_platform = update_platform(m_platform_sample);
+            m_is_platform_ready = true;
+        }
+        if (!m_pipeline_thread.joinable()) {
+            m_pipeline_thread = std::thread(&Controller::run_pipeline, this);
+        }
+        geopm_time(&last);
+        walk_down();
+        m_latency.update(ControllerLatency::M_PHASE_WALK_DOWN,
+                         phase_time(M_PHASE_WALK_DOWN, last));
+        // The application update may use the Comm, so it stays on
+        // this thread.
+        m_application_io->update(m_comm);
+        m_latency.update(ControllerLatency::M_PHASE_APPLICATION_UPDATE,
+                         phase_time(M_PHASE_APPLICATION, last));
+        // Hand the previous platform sample to the tree while the
+        // pipeline thread reads the next one.
+        m_out_sample.swap(m_platform_sample);
+        bool do_send = m_do_send_platform;
+        {
+            std::lock_guard<std::mutex> lock(m_pipeline_mutex);
+            m_is_pipeline_busy = true;
+            m_pipeline_error = nullptr;
+        }
+        m_pipeline_start_cv.notify_one();
+        // The pipeline thread must be finished with the platform
+        // before any error is raised, so hold this thread's error
+        // until then.
+        std::exception_ptr error;
+        try {
+            walk_up_tree(do_send);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        geopm_time(&last);
+        {
+            std::unique_lock<std::mutex> lock(m_pipeline_mutex);
+            m_pipeline_done_cv.wait(lock, [this]() {return !m_is_pipeline_busy;});
+            if (!error) {
+                error = m_pipeline_error;
+            }
+        }
+        phase_time(M_PHASE_PIPELINE, last);
+        if (error) {
+            std::rethrow_exception(error);
+        }
         m_agent[0]->wait();
+        phase_time(M_PHASE_WAIT, last);
+    }
+
+    void Controller::run_pipeline(void)
+    {
+        std::unique_lock<std::mutex> lock(m_pipeline_mutex);
+        while (true) {
+            m_pipeline_start_cv.wait(lock, [this]() {
+                return m_is_pipeline_stop || m_is_pipeline_busy;
+            });
+            if (m_is_pipeline_stop) {
+                break;
+            }
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                m_do_send_platform = update_platform(m_platform_sample);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            m_pipeline_error = error;
+            m_is_pipeline_busy = false;
+            m_pipeline_done_cv.notify_one();
+        }
+    }
+
+    void Controller::stop_pipeline(void)
+    {
+        if (m_pipeline_thread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_pipeline_mutex);
+                m_is_pipeline_stop = true;
+            }
+            m_pipeline_start_cv.notify_one();
+            m_pipeline_thread.join();
+        }
+    }
+
+    double Controller::phase_time(int phase, struct geopm_time_s &last)
+    {
+        struct geopm_time_s curr;
+        geopm_time(&curr);
+        double result = geopm_time_diff(&last, &curr);
+        m_phase_time[phase] += result;
+        last = curr;
+        return result;
+    }
+
+    std::vector<std::pair<std::string, std::string> > Controller::report_phase(void) const
+    {
+        static const std::vector<std::string> phase_name = {
+            "walk down",
+            "application update",
+            "read batch",
+            "agent sample",
+            "report and trace",
+            "walk up",
+            "pipeline wait",
+            "agent wait",
+        };
+        std::vector<std::pair<std::string, std::string> > result;
+        result.emplace_back("Controller step count", std::to_string(m_num_step));
+        for (int phase = 0; phase < M_NUM_PHASE; ++phase) {
+            result.emplace_back("Controller " + phase_name[phase] + " time (s)",
+                                string_format_double(m_phase_time[phase]));
+        }
+        return result;
     }
 
     void Controller::walk_down(void)
@@ -436,15 +594,36 @@ namespace geopm
 
     void Controller::walk_up(void)
     {
+        struct geopm_time_s last;
+        geopm_time(&last);
         m_application_io->update(m_comm);
+        m_latency.update(ControllerLatency::M_PHASE_APPLICATION_UPDATE,
+                         phase_time(M_PHASE_APPLICATION, last));
+        bool do_send = update_platform(m_out_sample);
+        walk_up_tree(do_send);
+    }
+
+    bool Controller::update_platform(std::vector<double> &sample)
+    {
+        struct geopm_time_s last;
+        geopm_time(&last);
         m_platform_io.read_batch();
-        m_agent[0]->sample_platform(m_out_sample);
+        phase_time(M_PHASE_READ_BATCH, last);
+        m_agent[0]->sample_platform(sample);
         bool do_send = m_agent[0]->do_send_sample();
+        phase_time(M_PHASE_SAMPLE, last);
         m_reporter->update();
         m_agent[0]->trace_values(m_trace_sample);
         m_tracer->update(m_trace_sample, m_application_io->region_info());
         m_application_io->clear_region_info();
+        phase_time(M_PHASE_TRACE, last);
+        return do_send;
+    }
 
+    void Controller::walk_up_tree(bool do_send)
+    {
+        struct geopm_time_s last;
+        geopm_time(&last);
         for (int level = 0; level < m_num_level_ctl; ++level) {
             if (do_send) {
                 m_tree_comm->send_up(level, m_out_sample);
@@ -465,6 +644,8 @@ namespace geopm
                 }
             }
         }
+        m_latency.update(ControllerLatency::M_PHASE_WALK_UP,
+                         phase_time(M_PHASE_WALK_UP, last));
     }
 
     void Controller::pthread(const pthread_attr_t *attr, pthread_t *thread)
@@ -40,6 +40,12 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+struct geopm_time_s;
 
 namespace geopm
 {
@@ -53,6 +59,7 @@ namespace geopm
     class EndpointPolicyTracer;
     class TreeComm;
     class Agent;
+    class ControllerLatency;
 
     class Controller
     {
@@ -81,7 +88,8 @@ namespace geopm
                        bool do_policy,
                        std::unique_ptr<EndpointUser> endpoint,
                        const std::string &endpoint_path,
-                       bool do_endpoint);
+                       bool do_endpoint,
+                       bool do_pipeline);
             virtual ~Controller();
             /// @brief Run control algorithm.
             ///
@@ -96,6 +104,14 @@ namespace geopm
             /// the resource manager, sending them to every other
             /// controller that the node is a parent of, and reading
             /// hardware telemetry.
+            ///
+            /// In pipelined mode the hardware telemetry for the next
+            /// step is read on a helper thread while the samples from
+            /// the previous read are sent up the tree.  Samples sent
+            /// up the tree therefore lag the local telemetry by one
+            /// step, and the first step reads the platform twice to
+            /// fill the pipeline.  All tree communication stays on
+            /// the calling thread.
             void step(void);
             /// @brief Propagate policy information from the resource
             ///        manager at the root of the tree down to the
@@ -113,6 +129,10 @@ namespace geopm
             /// parents.
             void walk_up(void);
             /// @brief Write the report file and finalize the trace.
+            ///
+            /// The host section of the report includes the number of
+            /// steps taken and the total time spent in each phase of
+            /// step().
             void generate(void);
             /// @brief Run control algorithm as a separate thread.
             ///
@@ -152,6 +172,43 @@ namespace geopm
             /// @brief Call init() on every agent.  Agents can push
             ///        signals and controls.
             void init_agents(void);
+            /// @brief Read the platform, sample the leaf Agent and
+            ///        update the report and trace.
+            /// @param [out] sample Sample from the leaf Agent.
+            /// @return Whether the leaf Agent has a sample to send.
+            bool update_platform(std::vector<double> &sample);
+            /// @brief Send m_out_sample up the tree, aggregating at
+            ///        each level controlled.
+            void walk_up_tree(bool do_send);
+            /// @brief Accumulate the time since last into the phase
+            ///        and advance last to now.
+            /// @return The time since last in seconds.
+            double phase_time(int phase, struct geopm_time_s &last);
+            /// @brief Step with update_platform() on the pipeline
+            ///        thread.
+            void step_pipeline(void);
+            /// @brief Body of the pipeline thread: runs
+            ///        update_platform() each time step_pipeline()
+            ///        signals it.
+            void run_pipeline(void);
+            /// @brief Stop and join the pipeline thread if it was
+            ///        started.
+            void stop_pipeline(void);
+            /// @brief Step count and time per phase formatted for
+            ///        the host section of the report.
+            std::vector<std::pair<std::string, std::string> > report_phase(void) const;
+
+            enum m_phase_e {
+                M_PHASE_WALK_DOWN,
+                M_PHASE_APPLICATION,
+                M_PHASE_READ_BATCH,
+                M_PHASE_SAMPLE,
+                M_PHASE_TRACE,
+                M_PHASE_WALK_UP,
+                M_PHASE_PIPELINE,
+                M_PHASE_WAIT,
+                M_NUM_PHASE,
+            };
 
             std::shared_ptr<Comm> m_comm;
             PlatformIO &m_platform_io;
@@ -182,6 +239,21 @@ namespace geopm
 
             std::vector<std::string> m_agent_policy_names;
             std::vector<std::string> m_agent_sample_names;
+
+            const bool m_do_pipeline;
+            std::vector<double> m_phase_time;
+            size_t m_num_step;
+            ControllerLatency &m_latency;
+            std::vector<double> m_platform_sample;
+            bool m_do_send_platform;
+            bool m_is_platform_ready;
+            std::thread m_pipeline_thread;
+            std::mutex m_pipeline_mutex;
+            std::condition_variable m_pipeline_start_cv;
+            std::condition_variable m_pipeline_done_cv;
+            bool m_is_pipeline_busy;
+            bool m_is_pipeline_stop;
+            std::exception_ptr m_pipeline_error;
     };
 }
 #endif
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ControllerIOGroup.hpp"
+
+#include <cmath>
+
+#include "LatencyHistogram.hpp"
+#include "PlatformTopo.hpp"
+#include "Helper.hpp"
+#include "Exception.hpp"
+#include "Agg.hpp"
+#include "config.h"
+
+#define GEOPM_CONTROLLER_IO_GROUP_PLUGIN_NAME "CONTROLLER"
+
+namespace geopm
+{
+    ControllerIOGroup::ControllerIOGroup()
+        : ControllerIOGroup(controller_latency())
+    {
+
+    }
+
+    ControllerIOGroup::ControllerIOGroup(const ControllerLatency &latency)
+        : m_latency(latency)
+        , m_is_batch_read(false)
+    {
+        static const std::vector<std::string> stat_suffix = {"", "_P50", "_P99", "_MAX"};
+        const auto &phase_names = ControllerLatency::phase_names();
+        for (int phase = 0; phase < ControllerLatency::M_NUM_PHASE; ++phase) {
+            for (int stat = 0; stat < M_NUM_STAT; ++stat) {
+                std::string name = plugin_name() + "::" + phase_names[phase] +
+                                   "_LATENCY" + stat_suffix[stat];
+                m_signal_map[name] = {phase, stat};
+            }
+        }
+    }
+
+    std::set<std::string> ControllerIOGroup::signal_names(void) const
+    {
+        std::set<std::string> result;
+        for (const auto &it : m_signal_map) {
+            result.insert(it.first);
+        }
+        return result;
+    }
+
+    std::set<std::string> ControllerIOGroup::control_names(void) const
+    {
+        return {};
+    }
+
+    bool ControllerIOGroup::is_valid_signal(const std::string &signal_name) const
+    {
+        return m_signal_map.find(signal_name) != m_signal_map.end();
+    }
+
+    bool ControllerIOGroup::is_valid_control(const std::string &control_name) const
+    {
+        return false;
+    }
+
+    int ControllerIOGroup::signal_domain_type(const std::string &signal_name) const
+    {
+        int result = GEOPM_DOMAIN_INVALID;
+        if (is_valid_signal(signal_name)) {
+            result = GEOPM_DOMAIN_BOARD;
+        }
+        return result;
+    }
+
+    int ControllerIOGroup::control_domain_type(const std::string &control_name) const
+    {
+        return GEOPM_DOMAIN_INVALID;
+    }
+
+    void ControllerIOGroup::check_signal(const std::string &signal_name, int domain_type,
+                                         const std::string &func) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("ControllerIOGroup::" + func + "(): signal_name " + signal_name +
+                            " not valid for ControllerIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_type != GEOPM_DOMAIN_BOARD) {
+            throw Exception("ControllerIOGroup::" + func + "(): signal_name " + signal_name +
+                            " not defined for domain " + std::to_string(domain_type),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    int ControllerIOGroup::push_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        check_signal(signal_name, domain_type, __func__);
+        if (m_is_batch_read) {
+            throw Exception("ControllerIOGroup::push_signal(): cannot push signal after call to read_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        const m_signal_s &signal = m_signal_map.at(signal_name);
+        int result = 0;
+        for (const auto &it : m_pushed_signal) {
+            if (it.phase == signal.phase && it.stat == signal.stat) {
+                return result;
+            }
+            ++result;
+        }
+        m_pushed_signal.push_back(signal);
+        m_pushed_value.push_back(NAN);
+        return result;
+    }
+
+    int ControllerIOGroup::push_control(const std::string &control_name, int domain_type, int domain_idx)
+    {
+        throw Exception("ControllerIOGroup::push_control(): there are no controls supported by the ControllerIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    double ControllerIOGroup::read_stat(const m_signal_s &signal) const
+    {
+        const LatencyHistogram &hist = m_latency.histogram(signal.phase);
+        double result = NAN;
+        switch (signal.stat) {
+            case M_STAT_LAST:
+                result = hist.last();
+                break;
+            case M_STAT_P50:
+                result = hist.percentile(0.50);
+                break;
+            case M_STAT_P99:
+                result = hist.percentile(0.99);
+                break;
+            case M_STAT_MAX:
+                result = hist.max();
+                break;
+            default:
+                break;
+        }
+        return result;
+    }
+
+    void ControllerIOGroup::read_batch(void)
+    {
+        for (size_t idx = 0; idx < m_pushed_signal.size(); ++idx) {
+            m_pushed_value[idx] = read_stat(m_pushed_signal[idx]);
+        }
+        m_is_batch_read = true;
+    }
+
+    void ControllerIOGroup::write_batch(void)
+    {
+
+    }
+
+    double ControllerIOGroup::sample(int batch_idx)
+    {
+        if (batch_idx < 0 || (size_t)batch_idx >= m_pushed_signal.size()) {
+            throw Exception("ControllerIOGroup::sample(): batch_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!m_is_batch_read) {
+            throw Exception("ControllerIOGroup::sample(): signal has not been read",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_pushed_value[batch_idx];
+    }
+
+    void ControllerIOGroup::adjust(int batch_idx, double setting)
+    {
+        throw Exception("ControllerIOGroup::adjust(): there are no controls supported by the ControllerIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    double ControllerIOGroup::read_signal(const std::string &signal_name, int domain_type, int domain_idx)
+    {
+        check_signal(signal_name, domain_type, __func__);
+        return read_stat(m_signal_map.at(signal_name));
+    }
+
+    void ControllerIOGroup::write_control(const std::string &control_name, int domain_type, int domain_idx, double setting)
+    {
+        throw Exception("ControllerIOGroup::write_control(): there are no controls supported by the ControllerIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+
+    void ControllerIOGroup::save_control(void)
+    {
+
+    }
+
+    void ControllerIOGroup::restore_control(void)
+    {
+
+    }
+
+    std::string ControllerIOGroup::plugin_name(void)
+    {
+        return GEOPM_CONTROLLER_IO_GROUP_PLUGIN_NAME;
+    }
+
+    std::unique_ptr<IOGroup> ControllerIOGroup::make_plugin(void)
+    {
+        return std::unique_ptr<IOGroup>(new ControllerIOGroup);
+    }
+
+    std::function<double(const std::vector<double> &)> ControllerIOGroup::agg_function(const std::string &signal_name) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("ControllerIOGroup::agg_function(): " + signal_name +
+                            " not valid for ControllerIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return Agg::max;
+    }
+
+    std::function<std::string(double)> ControllerIOGroup::format_function(const std::string &signal_name) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("ControllerIOGroup::format_function(): " + signal_name +
+                            " not valid for ControllerIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return string_format_double;
+    }
+
+    std::string ControllerIOGroup::signal_description(const std::string &signal_name) const
+    {
+        if (!is_valid_signal(signal_name)) {
+            throw Exception("ControllerIOGroup::signal_description(): " + signal_name +
+                            " not valid for ControllerIOGroup",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        static const std::vector<std::string> stat_description = {
+            "Most recent latency",
+            "Median latency",
+            "99th percentile latency",
+            "Maximum latency",
+        };
+        const m_signal_s &signal = m_signal_map.at(signal_name);
+        return stat_description[signal.stat] + " in seconds of the controller " +
+               ControllerLatency::phase_names()[signal.phase] + " phase.";
+    }
+
+    std::string ControllerIOGroup::control_description(const std::string &control_name) const
+    {
+        throw Exception("ControllerIOGroup::control_description(): there are no controls supported by the ControllerIOGroup",
+                        GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+    }
+}
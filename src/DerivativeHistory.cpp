@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "DerivativeHistory.hpp"
+
+#include <cmath>
+
+#include "Exception.hpp"
+
+namespace geopm
+{
+    DerivativeHistory::DerivativeHistory(int num_history, int mode)
+        : m_mode(mode)
+        , m_history(num_history)
+        , m_num_since_sync(0)
+        , m_sum_time(0.0)
+        , m_sum_sample(0.0)
+        , m_sum_time_sample(0.0)
+        , m_sum_time_time(0.0)
+    {
+        if (num_history < 1) {
+            throw Exception("DerivativeHistory(): num_history must be positive",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (mode != M_MODE_EXACT && mode != M_MODE_RUNNING) {
+            throw Exception("DerivativeHistory(): invalid mode: " + std::to_string(mode),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    double DerivativeHistory::insert(double time, double sample)
+    {
+        double result = NAN;
+        if (m_mode == M_MODE_RUNNING) {
+            result = insert_running(time, sample);
+        }
+        else {
+            m_history.insert({time, sample});
+            result = insert_exact();
+        }
+        return result;
+    }
+
+    void DerivativeHistory::clear(void)
+    {
+        m_history.clear();
+        m_num_since_sync = 0;
+        m_sum_time = 0.0;
+        m_sum_sample = 0.0;
+        m_sum_time_sample = 0.0;
+        m_sum_time_time = 0.0;
+    }
+
+    double DerivativeHistory::slope(int num_fit, double sum_time,
+                                    double sum_sample, double sum_time_sample,
+                                    double sum_time_time)
+    {
+        double result = NAN;
+        if (num_fit >= 2) {
+            double E = 1.0 / num_fit;
+            double ssxx = sum_time_time - sum_time * sum_time * E;
+            double ssxy = sum_time_sample - sum_time * sum_sample * E;
+            result = ssxy / ssxx;
+        }
+        return result;
+    }
+
+    double DerivativeHistory::insert_exact(void)
+    {
+        // Least squares linear regression to approximate the
+        // derivative with noisy data.
+        int num_fit = m_history.size();
+        double A = 0.0, B = 0.0, C = 0.0, D = 0.0;
+        if (num_fit >= 2) {
+            const double time_0 = m_history.value(0).time;
+            const double sig_0 = m_history.value(0).sample;
+            for (int buf_off = 0; buf_off < num_fit; ++buf_off) {
+                double time = m_history.value(buf_off).time - time_0;
+                double sig = m_history.value(buf_off).sample - sig_0;
+                A += time * sig;
+                B += time;
+                C += sig;
+                D += time * time;
+            }
+        }
+        return slope(num_fit, B, C, A, D);
+    }
+
+    void DerivativeHistory::sync_sums(void)
+    {
+        m_sum_time = 0.0;
+        m_sum_sample = 0.0;
+        m_sum_time_sample = 0.0;
+        m_sum_time_time = 0.0;
+        int num_fit = m_history.size();
+        if (num_fit != 0) {
+            const double time_0 = m_history.value(0).time;
+            const double sig_0 = m_history.value(0).sample;
+            for (int buf_off = 0; buf_off < num_fit; ++buf_off) {
+                double time = m_history.value(buf_off).time - time_0;
+                double sig = m_history.value(buf_off).sample - sig_0;
+                m_sum_time_sample += time * sig;
+                m_sum_time += time;
+                m_sum_sample += sig;
+                m_sum_time_time += time * time;
+            }
+        }
+        m_num_since_sync = 0;
+    }
+
+    double DerivativeHistory::insert_running(double time, double sample)
+    {
+        int capacity = m_history.capacity();
+        if (m_history.size() == capacity && capacity > 1) {
+            // The oldest entry is the origin, so removing it leaves
+            // the sums unchanged.  Move the origin to the next
+            // oldest entry at (dt, ds) relative to the current one.
+            int num_remain = capacity - 1;
+            double dt = m_history.value(1).time - m_history.value(0).time;
+            double ds = m_history.value(1).sample - m_history.value(0).sample;
+            m_sum_time_sample += num_remain * dt * ds - dt * m_sum_sample - ds * m_sum_time;
+            m_sum_time_time += num_remain * dt * dt - 2.0 * dt * m_sum_time;
+            m_sum_time -= num_remain * dt;
+            m_sum_sample -= num_remain * ds;
+        }
+        m_history.insert({time, sample});
+        ++m_num_since_sync;
+        if (m_num_since_sync >= M_NUM_SYNC || m_history.size() == 1) {
+            sync_sums();
+        }
+        else {
+            double rel_time = time - m_history.value(0).time;
+            double rel_sample = sample - m_history.value(0).sample;
+            m_sum_time_sample += rel_time * rel_sample;
+            m_sum_time += rel_time;
+            m_sum_sample += rel_sample;
+            m_sum_time_time += rel_time * rel_time;
+        }
+        return slope(m_history.size(), m_sum_time, m_sum_sample,
+                     m_sum_time_sample, m_sum_time_time);
+    }
+}
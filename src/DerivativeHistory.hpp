@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DERIVATIVEHISTORY_HPP_INCLUDE
+#define DERIVATIVEHISTORY_HPP_INCLUDE
+
+#include "CircularBuffer.hpp"
+
+namespace geopm
+{
+    /// @brief Sliding window of (time, sample) pairs used to estimate
+    ///        the derivative of a signal with a least squares linear
+    ///        fit over the window.
+    class DerivativeHistory
+    {
+        public:
+            enum m_mode_e {
+                /// Recompute the fit from every sample in the window
+                /// on each insert: O(window) per sample.
+                M_MODE_EXACT,
+                /// Maintain running sums that are updated as samples
+                /// enter and leave the window: O(1) per sample.
+                M_MODE_RUNNING,
+            };
+            /// @param [in] num_history Number of samples in the
+            ///        window.
+            /// @param [in] mode One of the m_mode_e values.
+            DerivativeHistory(int num_history, int mode);
+            virtual ~DerivativeHistory() = default;
+            /// @brief Add a sample to the window, dropping the oldest
+            ///        if the window is full.
+            /// @return Slope of the least squares fit over the
+            ///         window, or NAN if fewer than two samples have
+            ///         been inserted.
+            double insert(double time, double sample);
+            /// @brief Remove all samples from the window.
+            void clear(void);
+        private:
+            struct m_sample_s {
+                double time;
+                double sample;
+            };
+            double insert_exact(void);
+            double insert_running(double time, double sample);
+            /// Recompute the running sums from the window contents
+            /// to discard accumulated rounding error.
+            void sync_sums(void);
+            static double slope(int num_fit, double sum_time,
+                                double sum_sample, double sum_time_sample,
+                                double sum_time_time);
+
+            /// Number of running updates between exact
+            /// recomputations of the sums.
+            static constexpr int M_NUM_SYNC = 1024;
+            const int m_mode;
+            CircularBuffer<m_sample_s> m_history;
+            int m_num_since_sync;
+            // Sums over the window with time and sample measured
+            // relative to the oldest entry of the window.
+            double m_sum_time;
+            double m_sum_sample;
+            double m_sum_time_sample;
+            double m_sum_time_time;
+    };
+}
+
+#endif
@@ -47,8 +47,7 @@ namespace geopm
         : m_time_sig(time_sig)
         , m_y_sig(y_sig)
         , M_NUM_SAMPLE_HISTORY(num_sample_history)
-        , m_history(M_NUM_SAMPLE_HISTORY)
-        , m_derivative_num_fit(0)
+        , m_history(M_NUM_SAMPLE_HISTORY, DerivativeHistory::M_MODE_RUNNING)
         , m_is_batch_ready(false)
         , m_sleep_time(sleep_time)
     {
@@ -65,42 +64,6 @@ namespace geopm
         }
     }
 
-    double DerivativeSignal::compute_next(CircularBuffer<m_sample_s> &history,
-                                          int &num_fit,
-                                          double time, double signal)
-    {
-        // insert time and signal
-        history.insert({time, signal});
-        if (num_fit < history.capacity()) {
-            ++num_fit;
-        }
-
-        // Least squares linear regression to approximate the
-        // derivative with noisy data.
-        double result = NAN;
-        if (num_fit >= 2) {
-            size_t buf_size = history.size();
-            double A = 0.0, B = 0.0, C = 0.0, D = 0.0;
-            double E = 1.0 / num_fit;
-            double time_0 = history.value(buf_size - num_fit).time;
-            const double sig_0 = history.value(buf_size - num_fit).sample;
-            for (size_t buf_off = buf_size - num_fit;
-                 buf_off < buf_size; ++buf_off) {
-                double tt = history.value(buf_off).time;
-                double time = tt - time_0;
-                double sig = history.value(buf_off).sample - sig_0;
-                A += time * sig;
-                B += time;
-                C += sig;
-                D += time * time;
-            }
-            double ssxx = D - B * B * E;
-            double ssxy = A - B * C * E;
-            result = ssxy / ssxx;
-        }
-        return result;
-    }
-
     double DerivativeSignal::sample(void)
     {
         if (!m_is_batch_ready) {
@@ -109,18 +72,18 @@ namespace geopm
         }
         double time = m_time_sig->sample();
         double signal = m_y_sig->sample();
-        return compute_next(m_history, m_derivative_num_fit, time, signal);
+        return m_history.insert(time, signal);
     }
 
     double DerivativeSignal::read(void) const
     {
         double result = NAN;
-        CircularBuffer<m_sample_s> temp_history(M_NUM_SAMPLE_HISTORY);
-        int num_fit = 0;
+        DerivativeHistory temp_history(M_NUM_SAMPLE_HISTORY,
+                                       DerivativeHistory::M_MODE_RUNNING);
         for (int ii = 0; ii < M_NUM_SAMPLE_HISTORY; ++ii) {
             double time = m_time_sig->read();
             double signal = m_y_sig->read();
-            result = compute_next(temp_history, num_fit, time, signal);
+            result = temp_history.insert(time, signal);
             if (ii < M_NUM_SAMPLE_HISTORY - 1) {
                 usleep(m_sleep_time * 1e6);
             }
@@ -36,7 +36,7 @@
 #include <memory>
 
 #include "Signal.hpp"
-#include "CircularBuffer.hpp"
+#include "DerivativeHistory.hpp"
 
 namespace geopm
 {
@@ -52,23 +52,13 @@ namespace geopm
             double sample(void) override;
             double read(void) const override;
         private:
-            struct m_sample_s {
-                double time;
-                double sample;
-            };
-
-            /// Update the history buffer and compute the new derivative.
-            /// The read() and sample() methods have separate history.
-            static double compute_next(CircularBuffer<m_sample_s> &history,
-                                       int &num_fit,
-                                       double time, double signal);
-
             std::shared_ptr<Signal> m_time_sig;
             std::shared_ptr<Signal> m_y_sig;
 
             const int M_NUM_SAMPLE_HISTORY;
-            CircularBuffer<m_sample_s> m_history;
-            int m_derivative_num_fit;
+            /// History used by sample(); read() uses a temporary
+            /// history of the same length.
+            DerivativeHistory m_history;
             bool m_is_batch_ready;
             double m_sleep_time;
     };
@@ -46,6 +46,7 @@
 #include "FrequencyGovernor.hpp"
 #include "PlatformIO.hpp"
 #include "PlatformTopo.hpp"
+#include "Waiter.hpp"
 #include "Helper.hpp"
 #include "Exception.hpp"
 #include "config.h"
@@ -65,6 +66,15 @@ namespace geopm
     EnergyEfficientAgent::EnergyEfficientAgent(PlatformIO &plat_io, const PlatformTopo &topo,
                                                std::shared_ptr<FrequencyGovernor> gov,
                                                std::map<uint64_t, std::shared_ptr<EnergyEfficientRegion> > region_map)
+        : EnergyEfficientAgent(plat_io, topo, gov, region_map, nullptr)
+    {
+
+    }
+
+    EnergyEfficientAgent::EnergyEfficientAgent(PlatformIO &plat_io, const PlatformTopo &topo,
+                                               std::shared_ptr<FrequencyGovernor> gov,
+                                               std::map<uint64_t, std::shared_ptr<EnergyEfficientRegion> > region_map,
+                                               std::unique_ptr<Waiter> waiter)
         : M_PRECISION(16)
         , M_WAIT_SEC(0.002)
         , M_POLICY_PERF_MARGIN_DEFAULT(0.10)  // max 10% performance degradation
@@ -74,7 +84,7 @@ namespace geopm
         , m_freq_ctl_domain_type(m_freq_governor->frequency_domain_type())
         , m_num_freq_ctl_domain(m_platform_topo.num_domain(m_freq_ctl_domain_type))
         , m_region_map(m_num_freq_ctl_domain, region_map)
-        , m_last_wait(GEOPM_TIME_REF)
+        , m_waiter(waiter ? std::move(waiter) : Waiter::make_unique(M_WAIT_SEC))
         , m_level(-1)
         , m_num_children(0)
         , m_do_send_policy(false)
@@ -83,6 +93,8 @@ namespace geopm
 
     }
 
+    EnergyEfficientAgent::~EnergyEfficientAgent() = default;
+
     std::string EnergyEfficientAgent::plugin_name(void)
     {
         return "energy_efficient";
@@ -264,10 +276,7 @@ namespace geopm
 
     void EnergyEfficientAgent::wait(void)
     {
-        while(geopm_time_since(&m_last_wait) < M_WAIT_SEC) {
-
-        }
-        geopm_time(&m_last_wait);
+        m_waiter->wait();
     }
 
     std::vector<std::string> EnergyEfficientAgent::policy_names(void)
@@ -299,6 +308,8 @@ namespace geopm
         }
         oss << "\n";
         result.push_back({"Final online freq map", oss.str()});
+        auto wait_report = m_waiter->report();
+        result.insert(result.end(), wait_report.begin(), wait_report.end());
 
         return result;
     }
@@ -46,6 +46,7 @@
 
 namespace geopm
 {
+    class Waiter;
     class PlatformIO;
     class PlatformTopo;
     class EnergyEfficientRegion;
@@ -58,7 +59,11 @@ namespace geopm
             EnergyEfficientAgent(PlatformIO &plat_io, const PlatformTopo &topo,
                                  std::shared_ptr<FrequencyGovernor> gov,
                                  std::map<uint64_t, std::shared_ptr<EnergyEfficientRegion> > region_map);
-            virtual ~EnergyEfficientAgent() = default;
+            EnergyEfficientAgent(PlatformIO &plat_io, const PlatformTopo &topo,
+                                 std::shared_ptr<FrequencyGovernor> gov,
+                                 std::map<uint64_t, std::shared_ptr<EnergyEfficientRegion> > region_map,
+                                 std::unique_ptr<Waiter> waiter);
+            virtual ~EnergyEfficientAgent();
             void init(int level, const std::vector<int> &fan_in, bool is_level_root) override;
             void validate_policy(std::vector<double> &policy) const override;
             void split_policy(const std::vector<double> &in_policy,
@@ -122,7 +127,7 @@ namespace geopm
             std::vector<struct m_region_info_s> m_last_region_info;
             std::vector<double> m_target_freq;
             std::vector<std::map<uint64_t, std::shared_ptr<EnergyEfficientRegion> > > m_region_map;
-            geopm_time_s m_last_wait;
+            std::unique_ptr<Waiter> m_waiter;
             std::vector<std::vector<int> > m_signal_idx;
             int m_level;
             int m_num_children;
@@ -134,6 +134,7 @@ namespace geopm
         return {"GEOPM_CTL",
                 "GEOPM_REPORT",
                 "GEOPM_REPORT_SIGNALS",
+                "GEOPM_REPORT_MODE",
                 "GEOPM_COMM",
                 "GEOPM_POLICY",
                 "GEOPM_ENDPOINT",
@@ -141,6 +142,8 @@ namespace geopm
                 "GEOPM_SHMKEY",
                 "GEOPM_TRACE",
                 "GEOPM_TRACE_SIGNALS",
+                "GEOPM_TRACE_FORMAT",
+                "GEOPM_TRACE_MODE",
                 "GEOPM_TRACE_PROFILE",
                 "GEOPM_TRACE_ENDPOINT_POLICY",
                 "GEOPM_PLUGIN_PATH",
@@ -148,6 +151,12 @@ namespace geopm
                 "GEOPM_TIMEOUT",
                 "GEOPM_DEBUG_ATTACH",
                 "GEOPM_PROFILE",
+                "GEOPM_PROFILE_LOCK_FREE",
+                "GEOPM_TREE_LOCK_FREE",
+                "GEOPM_TREE_SPARSE",
+                "GEOPM_TREE_AUTO_FAN_OUT",
+                "GEOPM_MSR_PREFETCH",
+                "GEOPM_CTL_PIPELINE",
                 "GEOPM_FREQUENCY_MAP",
                 "GEOPM_MAX_FAN_OUT",
                 "GEOPM_OMPT_DISABLE"};
@@ -299,11 +308,26 @@ namespace geopm
         return lookup("GEOPM_TRACE_SIGNALS");
     }
 
+    std::string EnvironmentImp::trace_format(void) const
+    {
+        return lookup("GEOPM_TRACE_FORMAT");
+    }
+
+    std::string EnvironmentImp::trace_mode(void) const
+    {
+        return lookup("GEOPM_TRACE_MODE");
+    }
+
     std::string EnvironmentImp::report_signals(void) const
     {
         return lookup("GEOPM_REPORT_SIGNALS");
     }
 
+    std::string EnvironmentImp::report_mode(void) const
+    {
+        return lookup("GEOPM_REPORT_MODE");
+    }
+
     int EnvironmentImp::max_fan_out(void) const
     {
         return std::stoi(lookup("GEOPM_MAX_FAN_OUT"));
@@ -367,6 +391,36 @@ namespace geopm
                            [this](std::string var) {return (is_set(var));});
     }
 
+    bool EnvironmentImp::do_profile_lock_free(void) const
+    {
+        return is_set("GEOPM_PROFILE_LOCK_FREE");
+    }
+
+    bool EnvironmentImp::do_tree_lock_free(void) const
+    {
+        return is_set("GEOPM_TREE_LOCK_FREE");
+    }
+
+    bool EnvironmentImp::do_tree_sparse(void) const
+    {
+        return is_set("GEOPM_TREE_SPARSE");
+    }
+
+    bool EnvironmentImp::do_tree_auto_fan_out(void) const
+    {
+        return is_set("GEOPM_TREE_AUTO_FAN_OUT");
+    }
+
+    bool EnvironmentImp::do_msr_prefetch(void) const
+    {
+        return is_set("GEOPM_MSR_PREFETCH");
+    }
+
+    bool EnvironmentImp::do_ctl_pipeline(void) const
+    {
+        return is_set("GEOPM_CTL_PIPELINE");
+    }
+
     int EnvironmentImp::timeout(void) const
     {
         return std::stoi(lookup("GEOPM_TIMEOUT"));
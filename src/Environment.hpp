@@ -59,7 +59,10 @@ namespace geopm
             virtual std::string frequency_map(void) const = 0;
             virtual std::string agent(void) const = 0;
             virtual std::string trace_signals(void) const = 0;
+            virtual std::string trace_format(void) const = 0;
+            virtual std::string trace_mode(void) const = 0;
             virtual std::string report_signals(void) const = 0;
+            virtual std::string report_mode(void) const = 0;
             virtual int max_fan_out(void) const = 0;
             virtual int pmpi_ctl(void) const = 0;
             virtual bool do_policy(void) const = 0;
@@ -69,6 +72,12 @@ namespace geopm
             virtual bool do_trace_profile(void) const = 0;
             virtual bool do_trace_endpoint_policy(void) const = 0;
             virtual bool do_profile(void) const = 0;
+            virtual bool do_profile_lock_free(void) const = 0;
+            virtual bool do_tree_lock_free(void) const = 0;
+            virtual bool do_tree_sparse(void) const = 0;
+            virtual bool do_tree_auto_fan_out(void) const = 0;
+            virtual bool do_msr_prefetch(void) const = 0;
+            virtual bool do_ctl_pipeline(void) const = 0;
             virtual int timeout(void) const = 0;
             virtual int debug_attach(void) const = 0;
             virtual bool do_ompt(void) const = 0;
@@ -96,7 +105,10 @@ namespace geopm
             std::string frequency_map(void) const override;
             std::string agent(void) const override;
             std::string trace_signals(void) const override;
+            std::string trace_format(void) const override;
+            std::string trace_mode(void) const override;
             std::string report_signals(void) const override;
+            std::string report_mode(void) const override;
             int max_fan_out(void) const override;
             int pmpi_ctl(void) const override;
             bool do_policy(void) const override;
@@ -106,6 +118,12 @@ namespace geopm
             bool do_trace_profile(void) const override;
             bool do_trace_endpoint_policy(void) const override;
             bool do_profile() const override;
+            bool do_profile_lock_free(void) const override;
+            bool do_tree_lock_free(void) const override;
+            bool do_tree_sparse(void) const override;
+            bool do_tree_auto_fan_out(void) const override;
+            bool do_msr_prefetch(void) const override;
+            bool do_ctl_pipeline(void) const override;
             int timeout(void) const override;
             int debug_attach(void) const override;
             static std::set<std::string> get_all_vars(void);
@@ -48,6 +48,7 @@
 #include "PlatformIO.hpp"
 #include "PlatformTopo.hpp"
 #include "FrequencyGovernor.hpp"
+#include "Waiter.hpp"
 #include "Helper.hpp"
 #include "Exception.hpp"
 #include "geopm_debug.hpp"
@@ -64,11 +65,18 @@ namespace geopm
     }
 
     FrequencyMapAgent::FrequencyMapAgent(PlatformIO &plat_io, const PlatformTopo &topo)
+        : FrequencyMapAgent(plat_io, topo, nullptr)
+    {
+
+    }
+
+    FrequencyMapAgent::FrequencyMapAgent(PlatformIO &plat_io, const PlatformTopo &topo,
+                                         std::unique_ptr<Waiter> waiter)
         : M_PRECISION(16)
         , M_WAIT_SEC(0.002)
         , m_platform_io(plat_io)
         , m_platform_topo(topo)
-        , m_wait_time(GEOPM_TIME_REF)
+        , m_waiter(waiter ? std::move(waiter) : Waiter::make_unique(M_WAIT_SEC))
         , m_uncore_min_ctl_idx(-1)
         , m_uncore_max_ctl_idx(-1)
         , m_last_uncore_freq(NAN)
@@ -89,6 +97,8 @@ namespace geopm
 
     }
 
+    FrequencyMapAgent::~FrequencyMapAgent() = default;
+
     std::string FrequencyMapAgent::plugin_name(void)
     {
         return "frequency_map";
@@ -331,10 +341,7 @@ namespace geopm
 
     void FrequencyMapAgent::wait(void)
     {
-        while(geopm_time_since(&m_wait_time) < M_WAIT_SEC) {
-
-        }
-        geopm_time(&m_wait_time);
+        m_waiter->wait();
     }
 
     std::vector<std::string> FrequencyMapAgent::policy_names(void)
@@ -374,6 +381,8 @@ namespace geopm
         }
         oss << "\n";
         result.push_back(std::make_pair("Frequency map", oss.str()));
+        auto wait_report = m_waiter->report();
+        result.insert(result.end(), wait_report.begin(), wait_report.end());
 
         return result;
     }
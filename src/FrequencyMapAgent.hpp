@@ -45,6 +45,7 @@
 
 namespace geopm
 {
+    class Waiter;
     class PlatformIO;
     class PlatformTopo;
 
@@ -53,7 +54,9 @@ namespace geopm
         public:
             FrequencyMapAgent();
             FrequencyMapAgent(PlatformIO &plat_io, const PlatformTopo &topo);
-            virtual ~FrequencyMapAgent() = default;
+            FrequencyMapAgent(PlatformIO &plat_io, const PlatformTopo &topo,
+                              std::unique_ptr<Waiter> waiter);
+            virtual ~FrequencyMapAgent();
             void init(int level, const std::vector<int> &fan_in, bool is_level_root) override;
             void validate_policy(std::vector<double> &policy) const override;
             void split_policy(const std::vector<double> &in_policy,
@@ -97,7 +100,7 @@ namespace geopm
             const double M_WAIT_SEC;
             PlatformIO &m_platform_io;
             const PlatformTopo &m_platform_topo;
-            geopm_time_s m_wait_time;
+            std::unique_ptr<Waiter> m_waiter;
             std::map<uint64_t, double> m_hash_freq_map;
             std::vector<int> m_hash_signal_idx;
             std::vector<int> m_freq_control_idx;
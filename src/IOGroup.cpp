@@ -40,6 +40,7 @@
 #include "CpuinfoIOGroup.hpp"
 #include "TimeIOGroup.hpp"
 #include "ProfileIOGroup.hpp"
+#include "ControllerIOGroup.hpp"
 #include "Helper.hpp"
 #include "config.h"
 #ifdef GEOPM_CNL_IOGROUP
@@ -65,6 +66,8 @@ namespace geopm
                         CpuinfoIOGroup::make_plugin);
         register_plugin(ProfileIOGroup::plugin_name(),
                         ProfileIOGroup::make_plugin);
+        register_plugin(ControllerIOGroup::plugin_name(),
+                        ControllerIOGroup::make_plugin);
 #ifdef GEOPM_CNL_IOGROUP
         register_plugin(CNLIOGroup::plugin_name(),
                         CNLIOGroup::make_plugin);
@@ -97,6 +100,16 @@ namespace geopm
     }
 
 
+    void IOGroup::set_batch_time(const struct geopm_time_s &batch_time)
+    {
+
+    }
+
+    bool IOGroup::is_batch_independent(void) const
+    {
+        return false;
+    }
+
     std::function<std::string(double)> IOGroup::format_function(const std::string &signal_name) const
     {
 #ifdef GEOPM_DEBUG
@@ -40,6 +40,8 @@
 
 #include "PluginFactory.hpp"
 
+struct geopm_time_s;
+
 namespace geopm
 {
     class IOGroup
@@ -104,6 +106,21 @@ namespace geopm
             ///        that the next call to sample() will reflect the
             ///        updated data.
             virtual void read_batch(void) = 0;
+            /// @brief Called by PlatformIO before each read_batch()
+            ///        with the time at which that batch began.  An
+            ///        IOGroup that timestamps its samples should use
+            ///        this time rather than reading the clock itself
+            ///        so that all signals in a batch share one time
+            ///        base.  The default implementation ignores it.
+            /// @param [in] batch_time Time at which PlatformIO began
+            ///        the batch read.
+            virtual void set_batch_time(const struct geopm_time_s &batch_time);
+            /// @brief Returns true if read_batch() touches no state
+            ///        shared with other IOGroups, in which case
+            ///        PlatformIO may call it on a worker thread
+            ///        concurrently with other IOGroups.  The default
+            ///        implementation returns false.
+            virtual bool is_batch_independent(void) const;
             /// @brief Write all of the pushed controls so that values
             ///        previously given to adjust() are written to the
             ///        platform.
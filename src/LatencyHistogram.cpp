@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "LatencyHistogram.hpp"
+
+#include <cmath>
+#include <cctype>
+
+#include <algorithm>
+
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    LatencyHistogram::LatencyHistogram()
+        : m_bucket_count(M_NUM_BUCKET)
+    {
+        reset();
+    }
+
+    int LatencyHistogram::bucket(uint64_t nsec)
+    {
+        int result = nsec;
+        if (nsec >= M_NUM_SUB_BUCKET) {
+            int exponent = 63 - __builtin_clzll(nsec);
+            if (exponent >= M_MAX_EXPONENT) {
+                result = M_NUM_BUCKET - 1;
+            }
+            else {
+                int shift = exponent - M_SUB_BUCKET_BITS;
+                result = shift * M_NUM_SUB_BUCKET + (int)(nsec >> shift);
+            }
+        }
+        return result;
+    }
+
+    uint64_t LatencyHistogram::bucket_max(int bucket_idx)
+    {
+        uint64_t result = bucket_idx;
+        if (bucket_idx == M_NUM_BUCKET - 1) {
+            // Last bucket also holds every latency beyond the range
+            result = UINT64_MAX;
+        }
+        else if (bucket_idx >= M_NUM_SUB_BUCKET) {
+            int shift = bucket_idx / M_NUM_SUB_BUCKET - 1;
+            uint64_t sub_bucket = bucket_idx % M_NUM_SUB_BUCKET + M_NUM_SUB_BUCKET;
+            result = ((sub_bucket + 1) << shift) - 1;
+        }
+        return result;
+    }
+
+    void LatencyHistogram::update(double latency)
+    {
+        uint64_t nsec = 0;
+        if (latency > 0.0) {
+            nsec = latency < 1E9 ? (uint64_t)(latency * 1E9) : UINT64_MAX;
+        }
+        m_bucket_count[bucket(nsec)].fetch_add(1, std::memory_order_relaxed);
+        m_last.store(nsec, std::memory_order_relaxed);
+        uint64_t prev_max = m_max.load(std::memory_order_relaxed);
+        while (nsec > prev_max &&
+               !m_max.compare_exchange_weak(prev_max, nsec, std::memory_order_relaxed)) {
+
+        }
+        // Count last so a reader never sees more samples than the
+        // buckets hold.
+        m_count.fetch_add(1, std::memory_order_release);
+    }
+
+    void LatencyHistogram::reset(void)
+    {
+        for (auto &it : m_bucket_count) {
+            it.store(0, std::memory_order_relaxed);
+        }
+        m_last.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+        m_count.store(0, std::memory_order_release);
+    }
+
+    size_t LatencyHistogram::count(void) const
+    {
+        return m_count.load(std::memory_order_acquire);
+    }
+
+    double LatencyHistogram::last(void) const
+    {
+        return count() ? 1E-9 * m_last.load(std::memory_order_relaxed) : NAN;
+    }
+
+    double LatencyHistogram::max(void) const
+    {
+        return count() ? 1E-9 * m_max.load(std::memory_order_relaxed) : NAN;
+    }
+
+    double LatencyHistogram::percentile(double quantile) const
+    {
+        if (!(quantile >= 0.0 && quantile <= 1.0)) {
+            throw Exception("LatencyHistogram::percentile(): quantile must be between 0 and 1",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        uint64_t num_sample = count();
+        if (num_sample == 0) {
+            return NAN;
+        }
+        uint64_t rank = std::ceil(quantile * num_sample);
+        if (rank == 0) {
+            rank = 1;
+        }
+        uint64_t max_nsec = m_max.load(std::memory_order_relaxed);
+        uint64_t result = max_nsec;
+        uint64_t total = 0;
+        for (int bucket_idx = 0; bucket_idx < M_NUM_BUCKET; ++bucket_idx) {
+            total += m_bucket_count[bucket_idx].load(std::memory_order_relaxed);
+            if (total >= rank) {
+                result = bucket_max(bucket_idx);
+                break;
+            }
+        }
+        if (result > max_nsec) {
+            result = max_nsec;
+        }
+        return 1E-9 * result;
+    }
+
+    ControllerLatency::ControllerLatency()
+        : m_histogram(M_NUM_PHASE)
+    {
+
+    }
+
+    void ControllerLatency::check_phase(int phase, const std::string &func) const
+    {
+        if (phase < 0 || phase >= M_NUM_PHASE) {
+            throw Exception("ControllerLatency::" + func + "(): phase out of range: " +
+                            std::to_string(phase),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    void ControllerLatency::update(int phase, double latency)
+    {
+#ifdef GEOPM_DEBUG
+        check_phase(phase, __func__);
+#endif
+        m_histogram[phase].update(latency);
+    }
+
+    const LatencyHistogram &ControllerLatency::histogram(int phase) const
+    {
+        check_phase(phase, __func__);
+        return m_histogram[phase];
+    }
+
+    void ControllerLatency::reset(void)
+    {
+        for (auto &it : m_histogram) {
+            it.reset();
+        }
+    }
+
+    std::vector<std::pair<std::string, std::string> > ControllerLatency::report(void) const
+    {
+        std::vector<std::pair<std::string, std::string> > result;
+        for (int phase = 0; phase < M_NUM_PHASE; ++phase) {
+            const LatencyHistogram &hist = m_histogram[phase];
+            if (hist.count() != 0) {
+                // e.g. "Controller read batch latency p50 (s)"
+                std::string name = phase_names()[phase];
+                std::transform(name.begin(), name.end(), name.begin(), [](char cc) {
+                    return cc == '_' ? ' ' : std::tolower(cc);
+                });
+                std::string prefix = "Controller " + name + " latency ";
+                result.emplace_back(prefix + "p50 (s)", string_format_double(hist.percentile(0.50)));
+                result.emplace_back(prefix + "p99 (s)", string_format_double(hist.percentile(0.99)));
+                result.emplace_back(prefix + "max (s)", string_format_double(hist.max()));
+            }
+        }
+        return result;
+    }
+
+    const std::vector<std::string> &ControllerLatency::phase_names(void)
+    {
+        static const std::vector<std::string> result = {
+            "WALK_DOWN",
+            "WALK_UP",
+            "APPLICATION_UPDATE",
+            "READ_BATCH",
+            "WRITE_BATCH",
+            "TRACE_UPDATE",
+        };
+        return result;
+    }
+
+    ControllerLatency &controller_latency(void)
+    {
+        static ControllerLatency instance;
+        return instance;
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LATENCYHISTOGRAM_HPP_INCLUDE
+#define LATENCYHISTOGRAM_HPP_INCLUDE
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace geopm
+{
+    /// @brief Fixed size log-linear histogram of latencies in the
+    ///        style of an HDR histogram.
+    ///
+    /// Latencies are binned in nanoseconds with 32 linear sub-buckets
+    /// for each power of two, so any percentile is reported with a
+    /// relative error of at most 1/32.  Latencies of 2^40 ns (about
+    /// 18 minutes) or more land in the last bucket.  Recording a value
+    /// is a handful of relaxed atomic operations and never allocates,
+    /// and a value may be recorded on one thread while another thread
+    /// reads the statistics.
+    class LatencyHistogram
+    {
+        public:
+            LatencyHistogram();
+            virtual ~LatencyHistogram() = default;
+            /// @brief Record one latency.
+            /// @param [in] latency Latency in seconds.
+            void update(double latency);
+            /// @brief Forget all recorded latencies.
+            void reset(void);
+            /// @brief Number of latencies recorded.
+            size_t count(void) const;
+            /// @brief Most recent latency recorded in seconds, or
+            ///        NAN if there are none.
+            double last(void) const;
+            /// @brief Largest latency recorded in seconds, or NAN if
+            ///        there are none.
+            double max(void) const;
+            /// @brief Latency in seconds that is greater than or
+            ///        equal to the given fraction of recorded
+            ///        latencies, or NAN if there are none.
+            /// @param [in] quantile Fraction between 0 and 1, e.g.
+            ///        0.99 for the 99th percentile.
+            double percentile(double quantile) const;
+        private:
+            static int bucket(uint64_t nsec);
+            static uint64_t bucket_max(int bucket_idx);
+
+            static constexpr int M_SUB_BUCKET_BITS = 5;
+            static constexpr int M_NUM_SUB_BUCKET = 1 << M_SUB_BUCKET_BITS;
+            static constexpr int M_MAX_EXPONENT = 40;
+            static constexpr int M_NUM_BUCKET = (M_MAX_EXPONENT - M_SUB_BUCKET_BITS + 1) * M_NUM_SUB_BUCKET;
+
+            std::vector<std::atomic<uint64_t> > m_bucket_count;
+            std::atomic<uint64_t> m_count;
+            std::atomic<uint64_t> m_last;
+            std::atomic<uint64_t> m_max;
+    };
+
+    /// @brief Latency histograms for the phases of the Controller
+    ///        loop, shared by the objects that record them and the
+    ///        ControllerIOGroup that exposes them as signals.
+    class ControllerLatency
+    {
+        public:
+            enum m_phase_e {
+                /// @brief Controller::walk_down(): policy from the
+                ///        tree to the platform.
+                M_PHASE_WALK_DOWN,
+                /// @brief Sending samples up the tree at the end of
+                ///        Controller::walk_up().
+                M_PHASE_WALK_UP,
+                /// @brief ApplicationIO::update().
+                M_PHASE_APPLICATION_UPDATE,
+                /// @brief PlatformIO::read_batch().
+                M_PHASE_READ_BATCH,
+                /// @brief PlatformIO::write_batch().
+                M_PHASE_WRITE_BATCH,
+                /// @brief Tracer::update().
+                M_PHASE_TRACE_UPDATE,
+                M_NUM_PHASE,
+            };
+            ControllerLatency();
+            virtual ~ControllerLatency() = default;
+            /// @brief Record the latency of one occurrence of a phase.
+            /// @param [in] phase One of the m_phase_e values.
+            /// @param [in] latency Latency in seconds.
+            void update(int phase, double latency);
+            /// @brief Histogram of latencies recorded for a phase.
+            const LatencyHistogram &histogram(int phase) const;
+            /// @brief Forget all recorded latencies.
+            void reset(void);
+            /// @brief Median, 99th percentile and maximum latency of
+            ///        each phase that has been recorded, formatted as
+            ///        report key/value pairs.
+            std::vector<std::pair<std::string, std::string> > report(void) const;
+            /// @brief Upper case names of the phases, indexed by
+            ///        m_phase_e, e.g. "READ_BATCH".
+            static const std::vector<std::string> &phase_names(void);
+        private:
+            void check_phase(int phase, const std::string &func) const;
+            std::vector<LatencyHistogram> m_histogram;
+    };
+
+    /// @brief Latency histograms shared by the Controller, PlatformIO
+    ///        and Tracer of this process.
+    ControllerLatency &controller_latency(void);
+}
+
+#endif
@@ -58,6 +58,10 @@ namespace geopm
             virtual ~CommWindow();
             void lock(bool is_exclusive, int rank, int assert);
             void unlock(int rank);
+            void lock_all(int assert);
+            void unlock_all(void);
+            void flush(int rank);
+            void sync(void);
             void put(const void *send_buf, size_t send_size, int rank, off_t disp);
 #ifndef GEOPM_TEST
         private:
@@ -323,6 +327,30 @@ namespace geopm
         ((CommWindow *) window_id)->unlock(rank);
     }
 
+    void MPIComm::window_lock_all(size_t window_id, int assert) const
+    {
+        check_window(window_id);
+        ((CommWindow *) window_id)->lock_all(assert);
+    }
+
+    void MPIComm::window_unlock_all(size_t window_id) const
+    {
+        check_window(window_id);
+        ((CommWindow *) window_id)->unlock_all();
+    }
+
+    void MPIComm::window_flush(size_t window_id, int rank) const
+    {
+        check_window(window_id);
+        ((CommWindow *) window_id)->flush(rank);
+    }
+
+    void MPIComm::window_sync(size_t window_id) const
+    {
+        check_window(window_id);
+        ((CommWindow *) window_id)->sync();
+    }
+
     void MPIComm::coordinate(int rank, std::vector<int> &coord) const
     {
         size_t in_size = coord.size();
@@ -365,6 +393,13 @@ namespace geopm
         }
     }
 
+    void MPIComm::reduce_sum(double *send_buf, double *recv_buf, size_t count, int root) const
+    {
+        if (is_valid()) {
+            check_mpi(PMPI_Reduce(send_buf, recv_buf, count, MPI_DOUBLE, MPI_SUM, root, m_comm));
+        }
+    }
+
     bool MPIComm::test(bool is_true) const
     {
         int is_all_true = 0;
@@ -434,6 +469,26 @@ namespace geopm
         check_mpi(PMPI_Win_unlock(rank, m_window));
     }
 
+    void CommWindow::lock_all(int assert)
+    {
+        check_mpi(PMPI_Win_lock_all(assert, m_window));
+    }
+
+    void CommWindow::unlock_all(void)
+    {
+        check_mpi(PMPI_Win_unlock_all(m_window));
+    }
+
+    void CommWindow::flush(int rank)
+    {
+        check_mpi(PMPI_Win_flush(rank, m_window));
+    }
+
+    void CommWindow::sync(void)
+    {
+        check_mpi(PMPI_Win_sync(m_window));
+    }
+
     void CommWindow::put(const void *send_buf, size_t send_size, int rank, off_t disp)
     {
         check_mpi(PMPI_Put(GEOPM_MPI_CONST_CAST(void *)(send_buf), send_size, MPI_BYTE, rank, disp,
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include "MSRBatchDecoder.hpp"
+
+#include <cmath>
+
+#include "geopm_hash.h"
+#include "geopm_debug.hpp"
+#include "Exception.hpp"
+#include "MSRIO.hpp"
+#include "MSR.hpp"  // for enums
+
+namespace geopm
+{
+    MSRBatchDecoder::MSRBatchDecoder()
+        : m_field_group(MSR::M_FUNCTION_OVERFLOW + 1)
+    {
+
+    }
+
+    int MSRBatchDecoder::raw_slot(int batch_idx)
+    {
+        auto it = m_raw_slot_map.find(batch_idx);
+        if (it != m_raw_slot_map.end()) {
+            return it->second;
+        }
+        int result = m_raw_batch_idx.size();
+        m_raw_slot_map[batch_idx] = result;
+        m_raw_batch_idx.push_back(batch_idx);
+        m_raw_value.push_back(0);
+        return result;
+    }
+
+    int MSRBatchDecoder::push_raw(int batch_idx)
+    {
+        int result = m_value.size();
+        m_raw_signal_slot.push_back(raw_slot(batch_idx));
+        m_raw_signal_value_idx.push_back(result);
+        m_value.push_back(NAN);
+        return result;
+    }
+
+    int MSRBatchDecoder::push_field(int batch_idx, int begin_bit, int end_bit,
+                                    int function, double scalar)
+    {
+        if (function < MSR::M_FUNCTION_SCALE ||
+            function > MSR::M_FUNCTION_OVERFLOW) {
+            throw Exception("MSRBatchDecoder::push_field(): invalid encoding function",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (begin_bit < 0 || begin_bit > end_bit || end_bit - begin_bit >= 63) {
+            throw Exception("MSRBatchDecoder::push_field(): invalid bit range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int result = m_value.size();
+        uint64_t subfield_max = (1ULL << (end_bit - begin_bit + 1)) - 1;
+        m_field_group_s &group = m_field_group[function];
+        group.raw_slot.push_back(raw_slot(batch_idx));
+        group.mask.push_back(subfield_max << begin_bit);
+        group.shift.push_back(begin_bit);
+        group.scalar.push_back(scalar);
+        group.value_idx.push_back(result);
+        group.subfield_max.push_back(subfield_max);
+        group.last_subfield.push_back(0);
+        group.num_overflow.push_back(0.0);
+        group.subfield.push_back(0);
+        group.result.push_back(NAN);
+        m_value.push_back(NAN);
+        return result;
+    }
+
+    void MSRBatchDecoder::decode(const MSRIO &msrio)
+    {
+        size_t num_raw = m_raw_batch_idx.size();
+        for (size_t slot = 0; slot != num_raw; ++slot) {
+            m_raw_value[slot] = msrio.sample(m_raw_batch_idx[slot]);
+        }
+        size_t num_raw_signal = m_raw_signal_slot.size();
+        for (size_t ii = 0; ii != num_raw_signal; ++ii) {
+            m_value[m_raw_signal_value_idx[ii]] =
+                geopm_field_to_signal(m_raw_value[m_raw_signal_slot[ii]]);
+        }
+        for (int function = 0; function != (int)m_field_group.size(); ++function) {
+            decode_group(function, m_field_group[function]);
+        }
+    }
+
+    void MSRBatchDecoder::decode_group(int function, m_field_group_s &group)
+    {
+        size_t num_field = group.raw_slot.size();
+        if (num_field == 0) {
+            return;
+        }
+        const uint64_t *raw_value = m_raw_value.data();
+        const int *raw_slot = group.raw_slot.data();
+        const uint64_t *mask = group.mask.data();
+        const uint64_t *shift = group.shift.data();
+        const double *scalar = group.scalar.data();
+        uint64_t *subfield = group.subfield.data();
+        double *result = group.result.data();
+
+        // Gather each field's MSR and extract the bits
+        for (size_t ii = 0; ii < num_field; ++ii) {
+            subfield[ii] = (raw_value[raw_slot[ii]] & mask[ii]) >> shift[ii];
+        }
+        switch (function) {
+            case MSR::M_FUNCTION_SCALE:
+                for (size_t ii = 0; ii < num_field; ++ii) {
+                    result[ii] = subfield[ii] * scalar[ii];
+                }
+                break;
+            case MSR::M_FUNCTION_OVERFLOW: {
+                const uint64_t *subfield_max = group.subfield_max.data();
+                uint64_t *last_subfield = group.last_subfield.data();
+                double *num_overflow = group.num_overflow.data();
+                for (size_t ii = 0; ii < num_field; ++ii) {
+                    num_overflow[ii] += last_subfield[ii] > subfield[ii];
+                    result[ii] = (subfield[ii] + (subfield_max[ii] + 1.0) * num_overflow[ii]) * scalar[ii];
+                    last_subfield[ii] = subfield[ii];
+                }
+                break;
+            }
+            case MSR::M_FUNCTION_LOG_HALF:
+                // F = S * 2.0 ^ -X
+                for (size_t ii = 0; ii < num_field; ++ii) {
+                    result[ii] = scalar[ii] / (1ULL << subfield[ii]);
+                }
+                break;
+            case MSR::M_FUNCTION_7_BIT_FLOAT:
+                // F = S * 2 ^ Y * (1.0 + Z / 4.0)
+                // Y in bits [0:5) and Z in bits [5:7)
+                for (size_t ii = 0; ii < num_field; ++ii) {
+                    uint64_t float_y = subfield[ii] & 0x1F;
+                    uint64_t float_z = subfield[ii] >> 5;
+                    result[ii] = scalar[ii] * (1ULL << float_y) * (1.0 + float_z / 4.0);
+                }
+                break;
+            default:
+                GEOPM_DEBUG_ASSERT(false, "invalid function type for MSRBatchDecoder");
+                break;
+        }
+        // Scatter into the pushed signal order
+        const int *value_idx = group.value_idx.data();
+        for (size_t ii = 0; ii < num_field; ++ii) {
+            m_value[value_idx[ii]] = result[ii];
+        }
+    }
+
+    double MSRBatchDecoder::value(int value_idx) const
+    {
+        return m_value[value_idx];
+    }
+
+    int MSRBatchDecoder::num_value(void) const
+    {
+        return m_value.size();
+    }
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MSRBATCHDECODER_HPP_INCLUDE
+#define MSRBATCHDECODER_HPP_INCLUDE
+
+#include <cstdint>
+
+#include <map>
+#include <vector>
+
+namespace geopm
+{
+    class MSRIO;
+
+    /// Decodes every pushed MSR signal once per batch.  Raw MSR
+    /// values are fetched from the MSRIO a single time per batch
+    /// index, and all bit fields that share an encoding function are
+    /// converted together in one pass over contiguous arrays.  The
+    /// result of each pushed signal is then available as a plain
+    /// array lookup.  Field conversion matches MSRFieldSignal.
+    class MSRBatchDecoder
+    {
+        public:
+            MSRBatchDecoder();
+            virtual ~MSRBatchDecoder() = default;
+            /// @brief Add a signal that reports the full 64-bit MSR
+            ///        value, as RawMSRSignal does.
+            /// @param [in] batch_idx Index returned by
+            ///        MSRIO::add_read() for the MSR.
+            /// @return Index to pass to value().
+            int push_raw(int batch_idx);
+            /// @brief Add a signal that decodes a bit field of an
+            ///        MSR, as MSRFieldSignal does.
+            /// @param [in] batch_idx Index returned by
+            ///        MSRIO::add_read() for the MSR.
+            /// @param [in] begin_bit First bit of the field.
+            /// @param [in] end_bit Last bit of the field.
+            /// @param [in] function One of the MSR::m_function_e
+            ///        encoding functions.
+            /// @param [in] scalar Factor applied after decoding.
+            /// @return Index to pass to value().
+            int push_field(int batch_idx, int begin_bit, int end_bit,
+                           int function, double scalar);
+            /// @brief Fetch all raw MSR values from the MSRIO after
+            ///        its read_batch() and decode every signal.
+            void decode(const MSRIO &msrio);
+            /// @brief Decoded value from the last call to decode().
+            double value(int value_idx) const;
+            /// @brief Number of signals pushed.
+            int num_value(void) const;
+        private:
+            /// Fields that share an encoding function, stored as
+            /// structure of arrays.
+            struct m_field_group_s {
+                std::vector<int> raw_slot;
+                std::vector<uint64_t> mask;
+                std::vector<uint64_t> shift;
+                std::vector<double> scalar;
+                std::vector<int> value_idx;
+                // Only used by M_FUNCTION_OVERFLOW
+                std::vector<uint64_t> subfield_max;
+                std::vector<uint64_t> last_subfield;
+                std::vector<double> num_overflow;
+                // Scratch space for the decoded fields
+                std::vector<uint64_t> subfield;
+                std::vector<double> result;
+            };
+            int raw_slot(int batch_idx);
+            void decode_group(int function, m_field_group_s &group);
+
+            std::map<int, int> m_raw_slot_map;
+            std::vector<int> m_raw_batch_idx;
+            std::vector<uint64_t> m_raw_value;
+            std::vector<int> m_raw_signal_slot;
+            std::vector<int> m_raw_signal_value_idx;
+            std::vector<m_field_group_s> m_field_group;
+            std::vector<double> m_value;
+    };
+}
+
+#endif
@@ -135,4 +135,29 @@ namespace geopm
         int num_overflow = 0;
         return convert_raw_value(m_raw_msr->read(), last_field, num_overflow);
     }
+
+    std::shared_ptr<Signal> MSRFieldSignal::raw_msr(void) const
+    {
+        return m_raw_msr;
+    }
+
+    int MSRFieldSignal::begin_bit(void) const
+    {
+        return m_shift;
+    }
+
+    int MSRFieldSignal::end_bit(void) const
+    {
+        return m_shift + m_num_bit - 1;
+    }
+
+    int MSRFieldSignal::function(void) const
+    {
+        return m_function;
+    }
+
+    double MSRFieldSignal::scalar(void) const
+    {
+        return m_scalar;
+    }
 }
@@ -61,6 +61,16 @@ namespace geopm
             void setup_batch(void) override;
             double sample(void) override;
             double read(void) const override;
+            /// @brief Signal for the MSR that contains the field.
+            std::shared_ptr<Signal> raw_msr(void) const;
+            /// @brief First bit of the field within the MSR.
+            int begin_bit(void) const;
+            /// @brief Last bit of the field within the MSR.
+            int end_bit(void) const;
+            /// @brief Encoding function from MSR::m_function_e.
+            int function(void) const;
+            /// @brief Factor applied after decoding the field.
+            double scalar(void) const;
         private:
             double convert_raw_value(double val,
                                      uint64_t &last_field,
@@ -41,6 +41,7 @@
 #include <string.h>
 #include <sstream>
 #include <map>
+#include <algorithm>
 
 #include "geopm_sched.h"
 #include "geopm_debug.hpp"
@@ -69,6 +70,16 @@ namespace geopm
     }
 
     MSRIOImp::MSRIOImp(int num_cpu, std::shared_ptr<MSRPath> path)
+        // Each pread() of /dev/cpu/N/msr blocks on an IPI to CPU N, so
+        // a handful of threads hides most of the latency even when
+        // the controller is pinned to a single core.
+        : MSRIOImp(num_cpu, path, 8)
+    {
+
+    }
+
+    MSRIOImp::MSRIOImp(int num_cpu, std::shared_ptr<MSRPath> path,
+                       int num_worker)
         : m_num_cpu(num_cpu)
         , m_file_desc(m_num_cpu + 1, -1) // Last file descriptor is for the batch file
         , m_is_batch_enabled(true)
@@ -81,12 +92,19 @@ namespace geopm
         , m_write_batch_idx_map(m_num_cpu)
         , m_is_open(false)
         , m_path(path)
+        , m_num_worker_max(num_worker > 1 ? num_worker : 1)
+        , m_read_cpu_group_num_op(0)
+        , m_worker_generation(0)
+        , m_num_worker_busy(0)
+        , m_is_worker_stop(false)
+        , m_next_cpu_group(0)
     {
         open_all();
     }
 
     MSRIOImp::~MSRIOImp()
     {
+        stop_worker();
         close_all();
     }
 
@@ -237,18 +255,30 @@ namespace geopm
 
     int MSRIOImp::add_read(int cpu_idx, uint64_t offset)
     {
-        /// @todo return same index for repeated calls with same inputs.
-        m_msr_batch_op_s rd {
-            .cpu = (uint16_t)cpu_idx,
-            .isrdmsr = 1,
-            .err = 0,
-            .msr = (uint32_t)offset,
-            .msrdata = 0,
-            .wmask = 0
-        };
-        int idx = m_read_batch_op.size();
-        m_read_batch_op.push_back(rd);
-        return idx;
+        if (cpu_idx < 0 || cpu_idx >= m_num_cpu) {
+            throw Exception("MSRIOImp::add_read(): cpu_idx=" + std::to_string(cpu_idx) +
+                            " out of range, num_cpu=" + std::to_string(m_num_cpu),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int result = -1;
+        auto batch_it = m_read_batch_idx_map[cpu_idx].find(offset);
+        if (batch_it == m_read_batch_idx_map[cpu_idx].end()) {
+            result = m_read_batch_op.size();
+            m_msr_batch_op_s rd {
+                .cpu = (uint16_t)cpu_idx,
+                .isrdmsr = 1,
+                .err = 0,
+                .msr = (uint32_t)offset,
+                .msrdata = 0,
+                .wmask = 0
+            };
+            m_read_batch_op.push_back(rd);
+            m_read_batch_idx_map[cpu_idx][offset] = result;
+        }
+        else {
+            result = batch_it->second;
+        }
+        return result;
     }
 
     uint64_t MSRIOImp::sample(int batch_idx) const
@@ -325,17 +355,138 @@ namespace geopm
             msr_ioctl_read();
         }
         else {
-            for (uint32_t batch_idx = 0;
-                 batch_idx != m_read_batch.numops;
-                 ++batch_idx) {
-                m_read_batch.ops[batch_idx].msrdata =
-                    read_msr(m_read_batch_op[batch_idx].cpu,
-                             m_read_batch_op[batch_idx].msr);
-            }
+            read_batch_fallback();
         }
         m_is_batch_read = true;
     }
 
+    void MSRIOImp::read_batch_fallback(void)
+    {
+        update_read_cpu_group();
+        size_t num_group = m_read_cpu_group.size();
+        size_t num_worker = std::min(m_num_worker_max, num_group);
+        if (num_worker <= 1) {
+            for (size_t group_idx = 0; group_idx != num_group; ++group_idx) {
+                read_cpu_group(group_idx);
+            }
+            return;
+        }
+        // The calling thread takes part in the reads, so the pool
+        // holds one fewer thread than the number of workers.
+        start_worker(num_worker - 1);
+        {
+            std::lock_guard<std::mutex> lock(m_worker_mutex);
+            m_next_cpu_group = 0;
+            m_worker_error = nullptr;
+            m_num_worker_busy = m_worker.size();
+            ++m_worker_generation;
+        }
+        m_worker_start_cond.notify_all();
+        std::exception_ptr error;
+        try {
+            for (size_t group_idx = m_next_cpu_group++;
+                 group_idx < num_group;
+                 group_idx = m_next_cpu_group++) {
+                read_cpu_group(group_idx);
+            }
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        std::unique_lock<std::mutex> lock(m_worker_mutex);
+        m_worker_done_cond.wait(lock, [this]{ return m_num_worker_busy == 0; });
+        if (!error) {
+            error = m_worker_error;
+        }
+        m_worker_error = nullptr;
+        lock.unlock();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    void MSRIOImp::update_read_cpu_group(void)
+    {
+        if (m_read_cpu_group_num_op == m_read_batch_op.size()) {
+            return;
+        }
+        std::map<int, std::vector<int> > cpu_group;
+        for (size_t batch_idx = 0; batch_idx != m_read_batch_op.size(); ++batch_idx) {
+            cpu_group[m_read_batch_op[batch_idx].cpu].push_back(batch_idx);
+        }
+        m_read_cpu_group.clear();
+        for (auto &group_it : cpu_group) {
+            m_read_cpu_group.push_back(std::move(group_it.second));
+        }
+        m_read_cpu_group_num_op = m_read_batch_op.size();
+    }
+
+    void MSRIOImp::read_cpu_group(size_t group_idx)
+    {
+        for (int batch_idx : m_read_cpu_group[group_idx]) {
+            m_read_batch_op[batch_idx].msrdata =
+                read_msr(m_read_batch_op[batch_idx].cpu,
+                         m_read_batch_op[batch_idx].msr);
+        }
+    }
+
+    void MSRIOImp::start_worker(size_t num_worker)
+    {
+        while (m_worker.size() < num_worker) {
+            // Hand over the current generation so that a thread which
+            // is slow to start still picks up the next batch.
+            m_worker.emplace_back(&MSRIOImp::run_worker, this, m_worker_generation);
+        }
+    }
+
+    void MSRIOImp::stop_worker(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_worker_mutex);
+            m_is_worker_stop = true;
+        }
+        m_worker_start_cond.notify_all();
+        for (auto &worker : m_worker) {
+            worker.join();
+        }
+        m_worker.clear();
+    }
+
+    void MSRIOImp::run_worker(uint64_t generation)
+    {
+        std::unique_lock<std::mutex> lock(m_worker_mutex);
+        while (true) {
+            m_worker_start_cond.wait(lock, [this, generation] {
+                return m_is_worker_stop || m_worker_generation != generation;
+            });
+            if (m_is_worker_stop) {
+                break;
+            }
+            generation = m_worker_generation;
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                size_t num_group = m_read_cpu_group.size();
+                for (size_t group_idx = m_next_cpu_group++;
+                     group_idx < num_group;
+                     group_idx = m_next_cpu_group++) {
+                    read_cpu_group(group_idx);
+                }
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !m_worker_error) {
+                m_worker_error = error;
+            }
+            --m_num_worker_busy;
+            if (m_num_worker_busy == 0) {
+                m_worker_done_cond.notify_one();
+            }
+        }
+    }
+
     void MSRIOImp::write_batch(void)
     {
         m_write_batch.numops = m_write_batch_op.size();
@@ -51,10 +51,12 @@
 #include "Exception.hpp"
 #include "Agg.hpp"
 #include "MSRIOImp.hpp"
+#include "MSRIOPrefetch.hpp"
 #include "MSR.hpp"
 #include "Signal.hpp"
 #include "RawMSRSignal.hpp"
 #include "MSRFieldSignal.hpp"
+#include "MSRBatchDecoder.hpp"
 #include "DifferenceSignal.hpp"
 #include "TimeSignal.hpp"
 #include "DerivativeSignal.hpp"
@@ -82,8 +84,17 @@ namespace geopm
     const std::string MSRIOGroup::M_PLUGIN_NAME = "MSR";
     const std::string MSRIOGroup::M_NAME_PREFIX = M_PLUGIN_NAME + "::";
 
+    static std::shared_ptr<MSRIO> default_msrio(void)
+    {
+        std::shared_ptr<MSRIO> result = std::make_shared<MSRIOImp>();
+        if (environment().do_msr_prefetch()) {
+            result = std::make_shared<MSRIOPrefetchImp>(result);
+        }
+        return result;
+    }
+
     MSRIOGroup::MSRIOGroup()
-        : MSRIOGroup(platform_topo(), std::make_shared<MSRIOImp>(), cpuid(), geopm_sched_num_cpu())
+        : MSRIOGroup(platform_topo(), default_msrio(), cpuid(), geopm_sched_num_cpu())
     {
 
     }
@@ -91,6 +102,7 @@ namespace geopm
     MSRIOGroup::MSRIOGroup(const PlatformTopo &topo, std::shared_ptr<MSRIO> msrio, int cpuid, int num_cpu)
         : m_platform_topo(topo)
         , m_msrio(std::move(msrio))
+        , m_msrio_prefetch(std::dynamic_pointer_cast<MSRIOPrefetchImp>(m_msrio))
         , m_cpuid(cpuid)
         , m_num_cpu(num_cpu)
         , m_is_active(false)
@@ -98,6 +110,8 @@ namespace geopm
         , m_is_fixed_enabled(false)
         , m_time_zero(std::make_shared<geopm_time_s>())
         , m_time_batch(std::make_shared<double>(NAN))
+        , m_is_batch_start_set(false)
+        , m_decoder(geopm::make_unique<MSRBatchDecoder>())
     {
         geopm_time(m_time_zero.get());
 
@@ -303,6 +317,8 @@ namespace geopm
         }
     }
 
+    MSRIOGroup::~MSRIOGroup() = default;
+
     std::set<std::string> MSRIOGroup::signal_names(void) const
     {
         std::set<std::string> result;
@@ -394,6 +410,26 @@ namespace geopm
             result = m_signal_pushed.size();
             m_signal_pushed.push_back(signal);
             signal->setup_batch();
+            m_signal_decode_idx.push_back(push_decode(signal));
+        }
+        return result;
+    }
+
+    int MSRIOGroup::push_decode(std::shared_ptr<Signal> signal)
+    {
+        int result = -1;
+        auto raw_msr = std::dynamic_pointer_cast<RawMSRSignal>(signal);
+        auto field = std::dynamic_pointer_cast<MSRFieldSignal>(signal);
+        if (raw_msr != nullptr) {
+            result = m_decoder->push_raw(raw_msr->batch_idx());
+        }
+        else if (field != nullptr) {
+            raw_msr = std::dynamic_pointer_cast<RawMSRSignal>(field->raw_msr());
+            if (raw_msr != nullptr) {
+                result = m_decoder->push_field(raw_msr->batch_idx(),
+                                               field->begin_bit(), field->end_bit(),
+                                               field->function(), field->scalar());
+            }
         }
         return result;
     }
@@ -449,14 +485,37 @@ namespace geopm
     void MSRIOGroup::read_batch(void)
     {
         m_msrio->read_batch();
+        m_decoder->decode(*m_msrio);
 
         // update timesignal value
-        *m_time_batch = geopm_time_since(m_time_zero.get());
+        if (m_msrio_prefetch) {
+            // use the time that the prefetched values were read
+            struct geopm_time_s sample_time = m_msrio_prefetch->sample_time();
+            *m_time_batch = geopm_time_diff(m_time_zero.get(), &sample_time);
+        }
+        else if (m_is_batch_start_set) {
+            *m_time_batch = geopm_time_diff(m_time_zero.get(), &m_batch_start);
+        }
+        else {
+            *m_time_batch = geopm_time_since(m_time_zero.get());
+        }
 
         m_is_read = true;
         m_is_active = true;
     }
 
+    void MSRIOGroup::set_batch_time(const struct geopm_time_s &batch_time)
+    {
+        m_batch_start = batch_time;
+        m_is_batch_start_set = true;
+    }
+
+    bool MSRIOGroup::is_batch_independent(void) const
+    {
+        // Reads only through m_msrio, which no other IOGroup uses
+        return true;
+    }
+
     void MSRIOGroup::write_batch(void)
     {
         if (m_control_pushed.size()) {
@@ -480,6 +539,10 @@ namespace geopm
             throw Exception("MSRIOGroup::sample() called before signal was read.",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
+        int decode_idx = m_signal_decode_idx[signal_idx];
+        if (decode_idx != -1) {
+            return m_decoder->value(decode_idx);
+        }
         return m_signal_pushed[signal_idx]->sample();
     }
 
@@ -995,9 +1058,7 @@ namespace geopm
         std::vector<std::shared_ptr<Signal> > result;
         for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
             // get index of a single representative CPU for this domain
-            std::set<int> cpus = m_platform_topo.domain_nested(GEOPM_DOMAIN_CPU,
-                                                               domain_type, domain_idx);
-            int cpu_idx = *(cpus.begin());
+            int cpu_idx = m_platform_topo.domain_cpu_list(domain_type, domain_idx).front();
             std::shared_ptr<Signal> raw_msr =
                 std::make_shared<RawMSRSignal>(m_msrio, cpu_idx, msr_offset);
             result.push_back(raw_msr);
@@ -1046,9 +1107,7 @@ namespace geopm
         std::vector<std::shared_ptr<Control> > result_field_control;
         for (int domain_idx = 0; domain_idx < num_domain; ++domain_idx) {
             std::vector<std::shared_ptr<Control> > cpu_controls;
-            std::set<int> cpus = m_platform_topo.domain_nested(GEOPM_DOMAIN_CPU,
-                                                               domain_type, domain_idx);
-            for (auto cpu_idx : cpus) {
+            for (auto cpu_idx : m_platform_topo.domain_cpu_list(domain_type, domain_idx)) {
                 cpu_controls.push_back(std::make_shared<MSRFieldControl>(
                     m_msrio, cpu_idx, msr_offset,
                     begin_bit, end_bit, function,
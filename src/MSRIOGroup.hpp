@@ -46,6 +46,8 @@
 namespace geopm
 {
     class MSRIO;
+    class MSRIOPrefetchImp;
+    class MSRBatchDecoder;
     class PlatformTopo;
     class Signal;
     class Control;
@@ -68,7 +70,7 @@ namespace geopm
                        std::shared_ptr<MSRIO> msrio,
                        int cpuid,
                        int num_cpu);
-            virtual ~MSRIOGroup() = default;
+            virtual ~MSRIOGroup();
             std::set<std::string> signal_names(void) const override;
             std::set<std::string> control_names(void) const override;
             bool is_valid_signal(const std::string &signal_name) const override;
@@ -82,6 +84,8 @@ namespace geopm
                              int domain_type,
                              int domain_idx) override;
             void read_batch(void) override;
+            void set_batch_time(const struct geopm_time_s &batch_time) override;
+            bool is_batch_independent(void) const override;
             void write_batch(void) override;
             double sample(int sample_idx) override;
             void adjust(int control_idx,
@@ -160,6 +164,11 @@ namespace geopm
             /// @brief Check system configuration and warn if it ma
             ///        interfere with the given control.
             void check_control(const std::string &control_name);
+            /// @brief Register a pushed signal with the batch decoder
+            ///        if it is a raw MSR or an MSR field.
+            /// @return Index into the decoder or -1 if the signal
+            ///        must be sampled through the Signal interface.
+            int push_decode(std::shared_ptr<Signal> signal);
 
             /// Helpers for JSON parsing
             static void check_top_level(const json11::Json &root);
@@ -195,6 +204,9 @@ namespace geopm
             static const std::string M_NAME_PREFIX;
             const PlatformTopo &m_platform_topo;
             std::shared_ptr<MSRIO> m_msrio;
+            // Set if m_msrio reads on a helper thread, provides the
+            // time of the sampled values.
+            std::shared_ptr<MSRIOPrefetchImp> m_msrio_prefetch;
             int m_cpuid;
             int m_num_cpu;
             bool m_is_active;
@@ -205,6 +217,9 @@ namespace geopm
             // time for derivative signals
             std::shared_ptr<geopm_time_s> m_time_zero;
             std::shared_ptr<double> m_time_batch;
+            // Start of the current PlatformIO batch, if provided
+            bool m_is_batch_start_set;
+            geopm_time_s m_batch_start;
 
             // All available signals: map from name to signal_info.
             // The signals vector is over the indices for the domain.
@@ -231,6 +246,10 @@ namespace geopm
 
             // Mapping of signal index to pushed signals.
             std::vector<std::shared_ptr<Signal> > m_signal_pushed;
+            // Raw MSR and field signals are decoded once per batch;
+            // maps signal index to decoder index or -1.
+            std::unique_ptr<MSRBatchDecoder> m_decoder;
+            std::vector<int> m_signal_decode_idx;
             // Mapping of control index to pushed controls
             std::vector<std::shared_ptr<Control> > m_control_pushed;
     };
@@ -35,6 +35,12 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
 
 #include "MSRIO.hpp"
 
@@ -47,6 +53,15 @@ namespace geopm
         public:
             MSRIOImp();
             MSRIOImp(int num_cpu, std::shared_ptr<MSRPath> path);
+            /// @brief Constructor that sets the maximum number of
+            ///        threads used to read MSRs in parallel when the
+            ///        msr-safe batch interface is not available.
+            /// @param [in] num_worker Maximum number of threads,
+            ///        including the calling thread, used by
+            ///        read_batch() in the fallback path.  A value of
+            ///        one reads every MSR serially on the caller.
+            MSRIOImp(int num_cpu, std::shared_ptr<MSRPath> path,
+                     int num_worker);
             virtual ~MSRIOImp();
             uint64_t read_msr(int cpu_idx,
                               uint64_t offset) override;
@@ -87,6 +102,14 @@ namespace geopm
             void msr_ioctl_read(void);
             void msr_ioctl_write(void);
             uint64_t system_write_mask(uint64_t offset);
+            /// @brief Read all batch ops one pread() at a time,
+            ///        spreading the CPU groups across the worker pool.
+            void read_batch_fallback(void);
+            void update_read_cpu_group(void);
+            void read_cpu_group(size_t group_idx);
+            void start_worker(size_t num_worker);
+            void stop_worker(void);
+            void run_worker(uint64_t generation);
 
             const int m_num_cpu;
             std::vector<int> m_file_desc;
@@ -103,6 +126,20 @@ namespace geopm
             std::vector<uint64_t> m_write_mask;
             bool m_is_open;
             std::shared_ptr<MSRPath> m_path;
+            const size_t m_num_worker_max;
+            /// @brief Batch op indices grouped by CPU; each group is
+            ///        read serially by a single thread.
+            std::vector<std::vector<int> > m_read_cpu_group;
+            size_t m_read_cpu_group_num_op;
+            std::vector<std::thread> m_worker;
+            std::mutex m_worker_mutex;
+            std::condition_variable m_worker_start_cond;
+            std::condition_variable m_worker_done_cond;
+            uint64_t m_worker_generation;
+            size_t m_num_worker_busy;
+            bool m_is_worker_stop;
+            std::atomic<size_t> m_next_cpu_group;
+            std::exception_ptr m_worker_error;
     };
 }
 
@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "MSRIOPrefetch.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <chrono>
+
+#include "geopm_sched.h"
+#include "Exception.hpp"
+
+namespace geopm
+{
+    MSRIOPrefetchImp::MSRIOPrefetchImp(std::shared_ptr<MSRIO> msrio)
+        : MSRIOPrefetchImp(msrio, 0.001, helper_cpu())
+    {
+
+    }
+
+    MSRIOPrefetchImp::MSRIOPrefetchImp(std::shared_ptr<MSRIO> msrio, double period, int cpu_idx)
+        : m_msrio(msrio)
+        , m_period(period)
+        , m_cpu_idx(cpu_idx)
+        , m_num_read(0)
+        , m_front_time{{0, 0}}
+        , m_back_time{{0, 0}}
+        , m_is_back_ready(false)
+        , m_do_stop(false)
+        , m_is_batch_read(false)
+    {
+
+    }
+
+    MSRIOPrefetchImp::~MSRIOPrefetchImp()
+    {
+        if (m_thread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_buffer_mutex);
+                m_do_stop = true;
+            }
+            m_stop_cond.notify_one();
+            m_thread.join();
+        }
+    }
+
+    uint64_t MSRIOPrefetchImp::read_msr(int cpu_idx, uint64_t offset)
+    {
+        std::lock_guard<std::mutex> lock(m_msrio_mutex);
+        return m_msrio->read_msr(cpu_idx, offset);
+    }
+
+    void MSRIOPrefetchImp::write_msr(int cpu_idx, uint64_t offset,
+                                     uint64_t raw_value, uint64_t write_mask)
+    {
+        std::lock_guard<std::mutex> lock(m_msrio_mutex);
+        m_msrio->write_msr(cpu_idx, offset, raw_value, write_mask);
+    }
+
+    int MSRIOPrefetchImp::add_read(int cpu_idx, uint64_t offset)
+    {
+        if (m_thread.joinable()) {
+            throw Exception("MSRIOPrefetchImp::add_read(): cannot add a read after read_batch() has been called",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int result = m_msrio->add_read(cpu_idx, offset);
+        if (result >= m_num_read) {
+            m_num_read = result + 1;
+        }
+        return result;
+    }
+
+    void MSRIOPrefetchImp::read_batch(void)
+    {
+        if (!m_thread.joinable()) {
+            m_front.resize(m_num_read);
+            m_back.resize(m_num_read);
+            snapshot(m_front, m_front_time);
+            m_thread = std::thread(&MSRIOPrefetchImp::run, this);
+        }
+        else {
+            std::lock_guard<std::mutex> lock(m_buffer_mutex);
+            if (m_error) {
+                std::rethrow_exception(m_error);
+            }
+            if (m_is_back_ready) {
+                std::swap(m_front, m_back);
+                m_front_time = m_back_time;
+                m_is_back_ready = false;
+            }
+        }
+        m_is_batch_read = true;
+    }
+
+    uint64_t MSRIOPrefetchImp::sample(int batch_idx) const
+    {
+        if (!m_is_batch_read) {
+            throw Exception("MSRIOPrefetchImp::sample(): cannot call sample() before read_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (batch_idx < 0 || batch_idx >= m_num_read) {
+            throw Exception("MSRIOPrefetchImp::sample(): batch_idx out of range: " + std::to_string(batch_idx),
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_front[batch_idx];
+    }
+
+    struct geopm_time_s MSRIOPrefetchImp::sample_time(void) const
+    {
+        if (!m_is_batch_read) {
+            throw Exception("MSRIOPrefetchImp::sample_time(): cannot call sample_time() before read_batch().",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_front_time;
+    }
+
+    void MSRIOPrefetchImp::write_batch(void)
+    {
+        std::lock_guard<std::mutex> lock(m_msrio_mutex);
+        m_msrio->write_batch();
+    }
+
+    int MSRIOPrefetchImp::add_write(int cpu_idx, uint64_t offset)
+    {
+        std::lock_guard<std::mutex> lock(m_msrio_mutex);
+        return m_msrio->add_write(cpu_idx, offset);
+    }
+
+    void MSRIOPrefetchImp::adjust(int batch_idx, uint64_t value, uint64_t write_mask)
+    {
+        std::lock_guard<std::mutex> lock(m_msrio_mutex);
+        m_msrio->adjust(batch_idx, value, write_mask);
+    }
+
+    void MSRIOPrefetchImp::snapshot(std::vector<uint64_t> &value, struct geopm_time_s &time)
+    {
+        std::lock_guard<std::mutex> lock(m_msrio_mutex);
+        m_msrio->read_batch();
+        geopm_time(&time);
+        for (int batch_idx = 0; batch_idx < m_num_read; ++batch_idx) {
+            value[batch_idx] = m_msrio->sample(batch_idx);
+        }
+    }
+
+    void MSRIOPrefetchImp::run(void)
+    {
+        if (m_cpu_idx >= 0) {
+            // Pinning is best effort, the thread inherits the
+            // affinity of the caller on failure.
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(m_cpu_idx, &cpu_set);
+            (void)pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+        }
+        std::vector<uint64_t> work(m_num_read);
+        struct geopm_time_s work_time;
+        std::chrono::duration<double> period(m_period);
+        std::unique_lock<std::mutex> lock(m_buffer_mutex);
+        while (!m_do_stop) {
+            lock.unlock();
+            try {
+                snapshot(work, work_time);
+            }
+            catch (...) {
+                lock.lock();
+                m_error = std::current_exception();
+                break;
+            }
+            lock.lock();
+            std::swap(work, m_back);
+            m_back_time = work_time;
+            m_is_back_ready = true;
+            m_stop_cond.wait_for(lock, period, [this]() {
+                return m_do_stop;
+            });
+        }
+    }
+
+    int MSRIOPrefetchImp::helper_cpu(void)
+    {
+        // Use the highest numbered CPU available to the caller that
+        // the caller is not currently running on.
+        int result = -1;
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        if (!sched_getaffinity(0, sizeof(cpu_set), &cpu_set)) {
+            int curr_cpu = geopm_sched_get_cpu();
+            for (int cpu_idx = CPU_SETSIZE - 1; result == -1 && cpu_idx >= 0; --cpu_idx) {
+                if (cpu_idx != curr_cpu && CPU_ISSET(cpu_idx, &cpu_set)) {
+                    result = cpu_idx;
+                }
+            }
+        }
+        return result;
+    }
+}
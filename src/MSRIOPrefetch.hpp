@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MSRIOPREFETCH_HPP_INCLUDE
+#define MSRIOPREFETCH_HPP_INCLUDE
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+#include "MSRIO.hpp"
+#include "geopm_time.h"
+
+namespace geopm
+{
+    /// @brief MSRIO that reads the batch of MSRs on a helper
+    ///        thread.
+    ///
+    /// All calls are forwarded to an underlying MSRIO object except
+    /// for read_batch() and sample().  On the first call to
+    /// read_batch() the batch is read synchronously and a helper
+    /// thread is started which repeatedly reads the batch into a
+    /// back buffer.  Subsequent calls to read_batch() swap the most
+    /// recent complete snapshot into the front buffer without doing
+    /// any I/O, and sample() returns values from the front buffer.
+    /// Each snapshot carries the time at which it was read so that
+    /// derived signals remain coherent.  No reads may be added after
+    /// the first call to read_batch().
+    class MSRIOPrefetchImp : public MSRIO
+    {
+        public:
+            /// @brief Construct with the default refresh period and
+            ///        pin the helper thread to a CPU that the calling
+            ///        thread may run on.
+            ///
+            /// @param [in] msrio Object used to access the MSRs.
+            MSRIOPrefetchImp(std::shared_ptr<MSRIO> msrio);
+            /// @brief Constructor used for testing.
+            ///
+            /// @param [in] msrio Object used to access the MSRs.
+            ///
+            /// @param [in] period Time in seconds that the helper
+            ///        thread waits between snapshots.
+            ///
+            /// @param [in] cpu_idx CPU the helper thread is pinned
+            ///        to, or -1 to inherit the affinity of the
+            ///        calling thread.
+            MSRIOPrefetchImp(std::shared_ptr<MSRIO> msrio, double period, int cpu_idx);
+            /// @brief Stops the helper thread.
+            virtual ~MSRIOPrefetchImp();
+            uint64_t read_msr(int cpu_idx,
+                              uint64_t offset) override;
+            void write_msr(int cpu_idx,
+                           uint64_t offset,
+                           uint64_t raw_value,
+                           uint64_t write_mask) override;
+            int add_read(int cpu_idx, uint64_t offset) override;
+            void read_batch(void) override;
+            uint64_t sample(int batch_idx) const override;
+            void write_batch(void) override;
+            int add_write(int cpu_idx, uint64_t offset) override;
+            void adjust(int batch_idx, uint64_t value, uint64_t write_mask) override;
+            /// @brief Time at which the snapshot returned by sample()
+            ///        was read.
+            struct geopm_time_s sample_time(void) const;
+        private:
+            void run(void);
+            void snapshot(std::vector<uint64_t> &value, struct geopm_time_s &time);
+            static int helper_cpu(void);
+
+            std::shared_ptr<MSRIO> m_msrio;
+            const double m_period;
+            const int m_cpu_idx;
+            int m_num_read;
+            /// Serializes all calls into m_msrio.
+            std::mutex m_msrio_mutex;
+            /// Protects the back buffer and helper thread state.
+            std::mutex m_buffer_mutex;
+            std::condition_variable m_stop_cond;
+            std::vector<uint64_t> m_front;
+            struct geopm_time_s m_front_time;
+            std::vector<uint64_t> m_back;
+            struct geopm_time_s m_back_time;
+            bool m_is_back_ready;
+            bool m_do_stop;
+            std::exception_ptr m_error;
+            bool m_is_batch_read;
+            std::thread m_thread;
+    };
+}
+
+#endif
@@ -34,6 +34,7 @@
 
 #include "PlatformIO.hpp"
 #include "PlatformTopo.hpp"
+#include "Waiter.hpp"
 #include "Helper.hpp"
 #include "Exception.hpp"
 #include "config.h"
@@ -47,12 +48,21 @@ namespace geopm
     }
 
     MonitorAgent::MonitorAgent(PlatformIO &plat_io, const PlatformTopo &topo)
-        : m_last_wait(GEOPM_TIME_REF)
-        , M_WAIT_SEC(0.005)
+        : MonitorAgent(plat_io, topo, nullptr)
     {
-        geopm_time(&m_last_wait);
+
+    }
+
+    MonitorAgent::MonitorAgent(PlatformIO &plat_io, const PlatformTopo &topo,
+                               std::unique_ptr<Waiter> waiter)
+        : M_WAIT_SEC(0.005)
+        , m_waiter(waiter ? std::move(waiter) : Waiter::make_unique(M_WAIT_SEC))
+    {
+
     }
 
+    MonitorAgent::~MonitorAgent() = default;
+
     std::string MonitorAgent::plugin_name(void)
     {
         return "monitor";
@@ -112,10 +122,7 @@ namespace geopm
 
     void MonitorAgent::wait(void)
     {
-        while(geopm_time_since(&m_last_wait) < M_WAIT_SEC) {
-
-        }
-        geopm_time(&m_last_wait);
+        m_waiter->wait();
     }
 
     std::vector<std::string> MonitorAgent::policy_names(void)
@@ -135,7 +142,7 @@ namespace geopm
 
     std::vector<std::pair<std::string, std::string> > MonitorAgent::report_host(void) const
     {
-        return {};
+        return m_waiter->report();
     }
 
     std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > MonitorAgent::report_region(void) const
@@ -44,6 +44,7 @@
 
 namespace geopm
 {
+    class Waiter;
     class PlatformIO;
     class PlatformTopo;
 
@@ -53,7 +54,9 @@ namespace geopm
         public:
             MonitorAgent();
             MonitorAgent(PlatformIO &plat_io, const PlatformTopo &topo);
-            virtual ~MonitorAgent() = default;
+            MonitorAgent(PlatformIO &plat_io, const PlatformTopo &topo,
+                         std::unique_ptr<Waiter> waiter);
+            virtual ~MonitorAgent();
             void init(int level, const std::vector<int> &fan_in, bool is_level_root) override;
             void validate_policy(std::vector<double> &policy) const override;
             void split_policy(const std::vector<double> &in_policy,
@@ -79,8 +82,8 @@ namespace geopm
             static std::vector<std::string> policy_names(void);
             static std::vector<std::string> sample_names(void);
         private:
-            geopm_time_s m_last_wait;
             const double M_WAIT_SEC;
+            std::unique_ptr<Waiter> m_waiter;
     };
 }
 
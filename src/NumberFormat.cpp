@@ -0,0 +1,476 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "NumberFormat.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "geopm_hash.h"
+#include "Helper.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    constexpr size_t NumberFormat::M_MAX_SIZE;
+
+    namespace
+    {
+        // Grisu2 from F. Loitsch, "Printing Floating-Point Numbers
+        // Quickly and Accurately with Integers", PLDI 2010.
+
+        /// A value f * 2^e with a 64 bit significand.
+        struct diy_fp_s {
+            uint64_t f;
+            int e;
+        };
+
+        diy_fp_s diy_fp_sub(const diy_fp_s &x, const diy_fp_s &y)
+        {
+            return {x.f - y.f, x.e};
+        }
+
+        /// Product rounded to the upper 64 bits.
+        diy_fp_s diy_fp_mul(const diy_fp_s &x, const diy_fp_s &y)
+        {
+            unsigned __int128 product = (unsigned __int128)x.f * y.f;
+            uint64_t high = (uint64_t)(product >> 64);
+            uint64_t low = (uint64_t)product;
+            high += low >> 63;
+            return {high, x.e + y.e + 64};
+        }
+
+        diy_fp_s diy_fp_normalize(diy_fp_s x)
+        {
+            int shift = __builtin_clzll(x.f);
+            return {x.f << shift, x.e - shift};
+        }
+
+        /// Cached normalized approximations of 10^k:
+        /// {significand, binary exponent, k}.
+        struct cached_power_s {
+            uint64_t f;
+            int e;
+            int k;
+        };
+
+        const int M_CACHED_POWER_MIN_EXP = -300;
+        const int M_CACHED_POWER_STEP = 8;
+        const cached_power_s M_CACHED_POWER[] = {
+            {0xAB70FE17C79AC6CA, -1060,  -300},
+            {0xFF77B1FCBEBCDC4F, -1034,  -292},
+            {0xBE5691EF416BD60C, -1007,  -284},
+            {0x8DD01FAD907FFC3C,  -980,  -276},
+            {0xD3515C2831559A83,  -954,  -268},
+            {0x9D71AC8FADA6C9B5,  -927,  -260},
+            {0xEA9C227723EE8BCB,  -901,  -252},
+            {0xAECC49914078536D,  -874,  -244},
+            {0x823C12795DB6CE57,  -847,  -236},
+            {0xC21094364DFB5637,  -821,  -228},
+            {0x9096EA6F3848984F,  -794,  -220},
+            {0xD77485CB25823AC7,  -768,  -212},
+            {0xA086CFCD97BF97F4,  -741,  -204},
+            {0xEF340A98172AACE5,  -715,  -196},
+            {0xB23867FB2A35B28E,  -688,  -188},
+            {0x84C8D4DFD2C63F3B,  -661,  -180},
+            {0xC5DD44271AD3CDBA,  -635,  -172},
+            {0x936B9FCEBB25C996,  -608,  -164},
+            {0xDBAC6C247D62A584,  -582,  -156},
+            {0xA3AB66580D5FDAF6,  -555,  -148},
+            {0xF3E2F893DEC3F126,  -529,  -140},
+            {0xB5B5ADA8AAFF80B8,  -502,  -132},
+            {0x87625F056C7C4A8B,  -475,  -124},
+            {0xC9BCFF6034C13053,  -449,  -116},
+            {0x964E858C91BA2655,  -422,  -108},
+            {0xDFF9772470297EBD,  -396,  -100},
+            {0xA6DFBD9FB8E5B88F,  -369,   -92},
+            {0xF8A95FCF88747D94,  -343,   -84},
+            {0xB94470938FA89BCF,  -316,   -76},
+            {0x8A08F0F8BF0F156B,  -289,   -68},
+            {0xCDB02555653131B6,  -263,   -60},
+            {0x993FE2C6D07B7FAC,  -236,   -52},
+            {0xE45C10C42A2B3B06,  -210,   -44},
+            {0xAA242499697392D3,  -183,   -36},
+            {0xFD87B5F28300CA0E,  -157,   -28},
+            {0xBCE5086492111AEB,  -130,   -20},
+            {0x8CBCCC096F5088CC,  -103,   -12},
+            {0xD1B71758E219652C,   -77,    -4},
+            {0x9C40000000000000,   -50,     4},
+            {0xE8D4A51000000000,   -24,    12},
+            {0xAD78EBC5AC620000,     3,    20},
+            {0x813F3978F8940984,    30,    28},
+            {0xC097CE7BC90715B3,    56,    36},
+            {0x8F7E32CE7BEA5C70,    83,    44},
+            {0xD5D238A4ABE98068,   109,    52},
+            {0x9F4F2726179A2245,   136,    60},
+            {0xED63A231D4C4FB27,   162,    68},
+            {0xB0DE65388CC8ADA8,   189,    76},
+            {0x83C7088E1AAB65DB,   216,    84},
+            {0xC45D1DF942711D9A,   242,    92},
+            {0x924D692CA61BE758,   269,   100},
+            {0xDA01EE641A708DEA,   295,   108},
+            {0xA26DA3999AEF774A,   322,   116},
+            {0xF209787BB47D6B85,   348,   124},
+            {0xB454E4A179DD1877,   375,   132},
+            {0x865B86925B9BC5C2,   402,   140},
+            {0xC83553C5C8965D3D,   428,   148},
+            {0x952AB45CFA97A0B3,   455,   156},
+            {0xDE469FBD99A05FE3,   481,   164},
+            {0xA59BC234DB398C25,   508,   172},
+            {0xF6C69A72A3989F5C,   534,   180},
+            {0xB7DCBF5354E9BECE,   561,   188},
+            {0x88FCF317F22241E2,   588,   196},
+            {0xCC20CE9BD35C78A5,   614,   204},
+            {0x98165AF37B2153DF,   641,   212},
+            {0xE2A0B5DC971F303A,   667,   220},
+            {0xA8D9D1535CE3B396,   694,   228},
+            {0xFB9B7CD9A4A7443C,   720,   236},
+            {0xBB764C4CA7A44410,   747,   244},
+            {0x8BAB8EEFB6409C1A,   774,   252},
+            {0xD01FEF10A657842C,   800,   260},
+            {0x9B10A4E5E9913129,   827,   268},
+            {0xE7109BFBA19C0C9D,   853,   276},
+            {0xAC2820D9623BF429,   880,   284},
+            {0x80444B5E7AA7CF85,   907,   292},
+            {0xBF21E44003ACDD2D,   933,   300},
+            {0x8E679C2F5E44FF8F,   960,   308},
+            {0xD433179D9C8CB841,   986,   316},
+            {0x9E19DB92B4E31BA9,  1013,   324},
+            {0xEB96BF6EBADF77D9,  1039,   332},
+            {0xAF87023B9BF0EE6B,  1066,   340},
+        };
+
+        /// Select 10^k so that the scaled upper boundary has a binary
+        /// exponent in [M_ALPHA, M_GAMMA]; the integral part of the
+        /// scaled value then fits in 32 bits.
+        const int M_ALPHA = -60;
+        const int M_GAMMA = -32;
+
+        const cached_power_s &cached_power(int e)
+        {
+            // ceil((M_ALPHA - e - 1) * log10(2))
+            int f = M_ALPHA - e - 1;
+            int k = (f * 78913) / (1 << 18) + (f > 0);
+            int index = (-M_CACHED_POWER_MIN_EXP + k + (M_CACHED_POWER_STEP - 1)) /
+                        M_CACHED_POWER_STEP;
+            return M_CACHED_POWER[index];
+        }
+
+        int largest_pow10(uint32_t value, uint32_t &pow10)
+        {
+            static const uint32_t table[] = {1, 10, 100, 1000, 10000, 100000,
+                                             1000000, 10000000, 100000000,
+                                             1000000000};
+            int result = 10;
+            while (result > 1 && value < table[result - 1]) {
+                --result;
+            }
+            pow10 = table[result - 1];
+            return result;
+        }
+
+        void grisu2_round(char *digits, int num_digit, uint64_t dist, uint64_t delta,
+                          uint64_t rest, uint64_t ten_k)
+        {
+            // Move the last digit toward the exact value while the
+            // result stays inside the rounding interval.
+            while (rest < dist && delta - rest >= ten_k &&
+                   (rest + ten_k < dist || dist - rest > rest + ten_k - dist)) {
+                --digits[num_digit - 1];
+                rest += ten_k;
+            }
+        }
+
+        /// Generate the digits of the shortest decimal in the
+        /// interval (m_minus, m_plus); the value is digits * 10^exp10.
+        void grisu2_digits(char *digits, int &num_digit, int &exp10,
+                           diy_fp_s m_minus, diy_fp_s w, diy_fp_s m_plus)
+        {
+            uint64_t delta = diy_fp_sub(m_plus, m_minus).f;
+            uint64_t dist = diy_fp_sub(m_plus, w).f;
+            const diy_fp_s one = {uint64_t(1) << -m_plus.e, m_plus.e};
+            uint32_t p1 = (uint32_t)(m_plus.f >> -one.e);
+            uint64_t p2 = m_plus.f & (one.f - 1);
+            uint32_t pow10;
+            int n = largest_pow10(p1, pow10);
+            num_digit = 0;
+            while (n > 0) {
+                digits[num_digit] = (char)('0' + p1 / pow10);
+                ++num_digit;
+                p1 %= pow10;
+                --n;
+                uint64_t rest = ((uint64_t)p1 << -one.e) + p2;
+                if (rest <= delta) {
+                    exp10 += n;
+                    grisu2_round(digits, num_digit, dist, delta, rest,
+                                 (uint64_t)pow10 << -one.e);
+                    return;
+                }
+                pow10 /= 10;
+            }
+            int m = 0;
+            while (true) {
+                p2 *= 10;
+                digits[num_digit] = (char)('0' + (p2 >> -one.e));
+                ++num_digit;
+                p2 &= one.f - 1;
+                ++m;
+                delta *= 10;
+                dist *= 10;
+                if (p2 <= delta) {
+                    break;
+                }
+            }
+            exp10 -= m;
+            grisu2_round(digits, num_digit, dist, delta, p2, one.f);
+        }
+
+        /// Shortest digits for a finite positive value.
+        void grisu2(double value, char *digits, int &num_digit, int &exp10)
+        {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            uint64_t fraction = bits & ((uint64_t(1) << 52) - 1);
+            int biased_exp = (int)(bits >> 52) & 0x7FF;
+            diy_fp_s v;
+            if (biased_exp == 0) {
+                v = {fraction, 1 - 1075};
+            }
+            else {
+                v = {fraction + (uint64_t(1) << 52), biased_exp - 1075};
+            }
+            // Boundaries half way to the neighboring doubles
+            bool is_lower_closer = fraction == 0 && biased_exp > 1;
+            diy_fp_s m_plus = diy_fp_normalize({2 * v.f + 1, v.e - 1});
+            diy_fp_s m_minus = is_lower_closer ?
+                               diy_fp_s {4 * v.f - 1, v.e - 2} :
+                               diy_fp_s {2 * v.f - 1, v.e - 1};
+            m_minus = {m_minus.f << (m_minus.e - m_plus.e), m_plus.e};
+            diy_fp_s w = diy_fp_normalize(v);
+
+            const cached_power_s &cached = cached_power(m_plus.e);
+            const diy_fp_s c_minus_k = {cached.f, cached.e};
+            diy_fp_s w_scaled = diy_fp_mul(w, c_minus_k);
+            diy_fp_s minus_scaled = diy_fp_mul(m_minus, c_minus_k);
+            diy_fp_s plus_scaled = diy_fp_mul(m_plus, c_minus_k);
+            // Shrink the interval by one unit to absorb the error
+            // of the cached power.
+            minus_scaled.f += 1;
+            plus_scaled.f -= 1;
+            exp10 = -cached.k;
+            grisu2_digits(digits, num_digit, exp10, minus_scaled, w_scaled, plus_scaled);
+        }
+
+        char *write_exponent(int exp10, char *out)
+        {
+            *out++ = 'e';
+            if (exp10 < 0) {
+                *out++ = '-';
+                exp10 = -exp10;
+            }
+            else {
+                *out++ = '+';
+            }
+            if (exp10 >= 100) {
+                *out++ = (char)('0' + exp10 / 100);
+                exp10 %= 100;
+            }
+            *out++ = (char)('0' + exp10 / 10);
+            *out++ = (char)('0' + exp10 % 10);
+            return out;
+        }
+
+        const char M_HEX_DIGIT[] = "0123456789abcdef";
+
+        size_t write_hex(uint64_t value, char *buffer)
+        {
+            buffer[0] = '0';
+            buffer[1] = 'x';
+            for (int idx = 17; idx != 1; --idx) {
+                buffer[idx] = M_HEX_DIGIT[value & 0xF];
+                value >>= 4;
+            }
+            return 18;
+        }
+    }
+
+    int NumberFormat::format_type(const std::function<std::string(double)> &format)
+    {
+        typedef std::string (*format_ptr_t)(double);
+        int result = M_FORMAT_CUSTOM;
+        const format_ptr_t *target = format.target<format_ptr_t>();
+        if (target != nullptr) {
+            if (*target == string_format_double) {
+                result = M_FORMAT_DOUBLE;
+            }
+            else if (*target == string_format_float) {
+                result = M_FORMAT_FLOAT;
+            }
+            else if (*target == string_format_integer) {
+                result = M_FORMAT_INTEGER;
+            }
+            else if (*target == string_format_hex) {
+                result = M_FORMAT_HEX;
+            }
+            else if (*target == string_format_raw64) {
+                result = M_FORMAT_RAW64;
+            }
+        }
+        return result;
+    }
+
+    size_t NumberFormat::format(int format_type, double value, char *buffer)
+    {
+        size_t result = 0;
+        switch (format_type) {
+            case M_FORMAT_DOUBLE:
+                result = format_double(value, buffer);
+                break;
+            case M_FORMAT_FLOAT:
+                result = format_float(value, buffer);
+                break;
+            case M_FORMAT_INTEGER:
+                result = format_integer(value, buffer);
+                break;
+            case M_FORMAT_HEX:
+                result = format_hex(value, buffer);
+                break;
+            case M_FORMAT_RAW64:
+                result = format_raw64(value, buffer);
+                break;
+            default:
+                throw Exception("NumberFormat::format(): invalid format type: " +
+                                std::to_string(format_type),
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    size_t NumberFormat::format_double(double value, char *buffer)
+    {
+        char *out = buffer;
+        if (signbit(value)) {
+            *out++ = '-';
+            value = -value;
+        }
+        if (isnan(value)) {
+            memcpy(out, "nan", 3);
+            return out + 3 - buffer;
+        }
+        if (isinf(value)) {
+            memcpy(out, "inf", 3);
+            return out + 3 - buffer;
+        }
+        if (value == 0.0) {
+            *out++ = '0';
+            return out - buffer;
+        }
+        char digits[20];
+        int num_digit = 0;
+        int exp10 = 0;
+        grisu2(value, digits, num_digit, exp10);
+        // Decimal exponent of the leading digit; choose the fixed or
+        // exponential layout with the rule that "%.16g" uses.
+        int sci_exp = num_digit + exp10 - 1;
+        if (sci_exp < -4 || sci_exp >= 16) {
+            *out++ = digits[0];
+            if (num_digit > 1) {
+                *out++ = '.';
+                memcpy(out, digits + 1, num_digit - 1);
+                out += num_digit - 1;
+            }
+            out = write_exponent(sci_exp, out);
+        }
+        else if (sci_exp < 0) {
+            *out++ = '0';
+            *out++ = '.';
+            memset(out, '0', -sci_exp - 1);
+            out += -sci_exp - 1;
+            memcpy(out, digits, num_digit);
+            out += num_digit;
+        }
+        else if (num_digit <= sci_exp + 1) {
+            memcpy(out, digits, num_digit);
+            out += num_digit;
+            memset(out, '0', sci_exp + 1 - num_digit);
+            out += sci_exp + 1 - num_digit;
+        }
+        else {
+            memcpy(out, digits, sci_exp + 1);
+            out += sci_exp + 1;
+            *out++ = '.';
+            memcpy(out, digits + sci_exp + 1, num_digit - sci_exp - 1);
+            out += num_digit - sci_exp - 1;
+        }
+        return out - buffer;
+    }
+
+    size_t NumberFormat::format_float(double value, char *buffer)
+    {
+        return snprintf(buffer, M_MAX_SIZE, "%g", value);
+    }
+
+    size_t NumberFormat::format_integer(double value, char *buffer)
+    {
+        long long signed_value = (long long)value;
+        uint64_t abs_value = signed_value < 0 ? 0 - (uint64_t)signed_value : signed_value;
+        char digits[20];
+        int num_digit = 0;
+        do {
+            digits[num_digit] = (char)('0' + abs_value % 10);
+            abs_value /= 10;
+            ++num_digit;
+        } while (abs_value != 0);
+        char *out = buffer;
+        if (signed_value < 0) {
+            *out++ = '-';
+        }
+        while (num_digit != 0) {
+            --num_digit;
+            *out++ = digits[num_digit];
+        }
+        return out - buffer;
+    }
+
+    size_t NumberFormat::format_hex(double value, char *buffer)
+    {
+        return write_hex((uint64_t)value, buffer);
+    }
+
+    size_t NumberFormat::format_raw64(double value, char *buffer)
+    {
+        return write_hex(geopm_signal_to_field(value), buffer);
+    }
+}
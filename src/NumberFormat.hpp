@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef NUMBERFORMAT_HPP_INCLUDE
+#define NUMBERFORMAT_HPP_INCLUDE
+
+#include <stddef.h>
+
+#include <functional>
+#include <string>
+
+namespace geopm
+{
+    /// @brief Allocation free counterparts of the
+    ///        geopm::string_format_*() functions used to print the
+    ///        columns of CSV files.
+    ///
+    /// Each method prints a value into a caller provided buffer of at
+    /// least M_MAX_SIZE bytes and returns the number of characters
+    /// written; the result is not null terminated.  The float,
+    /// integer, hex and raw64 formats print the same text as the
+    /// matching string_format_*() function.  The double format prints
+    /// the shortest decimal string that reads back as the same double
+    /// (using the Grisu2 algorithm), laid out like printf's "%g".
+    /// Unlike the "%.16g" of string_format_double() no precision is
+    /// lost.
+    class NumberFormat
+    {
+        public:
+            enum m_format_e {
+                M_FORMAT_DOUBLE,
+                M_FORMAT_FLOAT,
+                M_FORMAT_INTEGER,
+                M_FORMAT_HEX,
+                M_FORMAT_RAW64,
+                M_FORMAT_CUSTOM,
+            };
+            /// @brief Buffer size required by the format methods.
+            static constexpr size_t M_MAX_SIZE = 32;
+            /// @brief Determine which format matches one of the
+            ///        geopm::string_format_*() functions.
+            /// @param [in] format Format function for a column.
+            /// @return One of the m_format_e values, or
+            ///         M_FORMAT_CUSTOM for any other function.
+            static int format_type(const std::function<std::string(double)> &format);
+            /// @brief Print a value with the given format.
+            /// @param [in] format_type One of the m_format_e values
+            ///        other than M_FORMAT_CUSTOM.
+            /// @param [in] value Value to print.
+            /// @param [out] buffer At least M_MAX_SIZE bytes.
+            /// @return Number of characters written.
+            static size_t format(int format_type, double value, char *buffer);
+            static size_t format_double(double value, char *buffer);
+            static size_t format_float(double value, char *buffer);
+            static size_t format_integer(double value, char *buffer);
+            static size_t format_hex(double value, char *buffer);
+            static size_t format_raw64(double value, char *buffer);
+    };
+}
+
+#endif
@@ -42,15 +42,18 @@
 
 #include "geopm_sched.h"
 #include "geopm_hash.h"
+#include "geopm_time.h"
 #include "geopm.h"
 #include "PlatformTopo.hpp"
 #include "MSRIOGroup.hpp"
 #include "TimeIOGroup.hpp"
 #include "ProfileIOGroup.hpp"
 #include "CombinedSignal.hpp"
+#include "LatencyHistogram.hpp"
 #include "Exception.hpp"
 #include "Helper.hpp"
 #include "Agg.hpp"
+#include "geopm_debug.hpp"
 
 #include "config.h"
 
@@ -62,6 +65,15 @@ namespace geopm
         return instance;
     }
 
+    void PlatformIO::sample_all(const std::vector<int> &signal_idx,
+                                std::vector<double> &sample)
+    {
+        sample.resize(signal_idx.size());
+        for (size_t ii = 0; ii < signal_idx.size(); ++ii) {
+            sample[ii] = this->sample(signal_idx[ii]);
+        }
+    }
+
     PlatformIOImp::PlatformIOImp()
         : PlatformIOImp({}, platform_topo())
     {
@@ -74,6 +86,11 @@ namespace geopm
         , m_platform_topo(topo)
         , m_iogroup_list(iogroup_list)
         , m_do_restore(false)
+        , m_is_plan_ready(false)
+        , m_batch_num_group(0)
+        , m_batch_generation(0)
+        , m_batch_num_busy(0)
+        , m_is_batch_stop(false)
     {
         if (m_iogroup_list.size() == 0) {
             for (const auto &it : IOGroup::iogroup_names()) {
@@ -99,6 +116,11 @@ namespace geopm
         }
     }
 
+    PlatformIOImp::~PlatformIOImp()
+    {
+        stop_batch_worker();
+    }
+
     void PlatformIOImp::register_iogroup(std::shared_ptr<IOGroup> iogroup)
     {
         if (m_do_restore) {
@@ -259,8 +281,8 @@ namespace geopm
         int result = -1;
         int base_domain_type = signal_domain_type(signal_name);
         if (m_platform_topo.is_nested_domain(base_domain_type, domain_type)) {
-            std::set<int> base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
-                                                                          domain_type, domain_idx);
+            std::vector<int> base_domain_idx = nested_domain_idx(base_domain_type,
+                                                                 domain_type, domain_idx);
             std::vector<int> signal_idx;
             for (auto it : base_domain_idx) {
                 signal_idx.push_back(push_signal(signal_name, base_domain_type, it));
@@ -270,6 +292,23 @@ namespace geopm
         return result;
     }
 
+    std::vector<int> PlatformIOImp::nested_domain_idx(int inner_domain,
+                                                      int outer_domain,
+                                                      int outer_idx) const
+    {
+        const std::vector<int> &cpus = m_platform_topo.domain_cpu_list(outer_domain, outer_idx);
+        if (inner_domain == GEOPM_DOMAIN_CPU) {
+            return cpus;
+        }
+        std::vector<int> result;
+        for (auto cpu_idx : cpus) {
+            result.push_back(m_platform_topo.domain_idx(inner_domain, cpu_idx));
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
     int PlatformIOImp::push_combined_signal(const std::string &signal_name,
                                             int domain_type,
                                             int domain_idx,
@@ -345,8 +384,8 @@ namespace geopm
         int result = -1;
         int base_domain_type = control_domain_type(control_name);
         if (m_platform_topo.is_nested_domain(base_domain_type, domain_type)) {
-            std::set<int> base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
-                                                                          domain_type, domain_idx);
+            std::vector<int> base_domain_idx = nested_domain_idx(base_domain_type,
+                                                                 domain_type, domain_idx);
             std::vector<int> control_idx;
             for (auto it : base_domain_idx) {
                 control_idx.push_back(push_control(control_name, base_domain_type, it));
@@ -370,7 +409,6 @@ namespace geopm
 
     double PlatformIOImp::sample(int signal_idx)
     {
-        double result = NAN;
         if (signal_idx < 0 || signal_idx >= num_signal_pushed()) {
             throw Exception("PlatformIOImp::sample(): signal_idx out of range",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
@@ -379,30 +417,123 @@ namespace geopm
             throw Exception("PlatformIOImp::sample(): read_batch() not called prior to call to sample()",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
         }
-        auto &group_idx_pair = m_active_signal[signal_idx];
-        if (group_idx_pair.first) {
-            result = group_idx_pair.first->sample(group_idx_pair.second);
+        if (!m_is_plan_ready) {
+            compile_signal_plan();
         }
-        else {
-            result = sample_combined(group_idx_pair.second);
+        return sample_plan(signal_idx);
+    }
+
+    void PlatformIOImp::sample_all(std::vector<double> &sample)
+    {
+        if (!m_is_active) {
+            throw Exception("PlatformIOImp::sample_all(): read_batch() not called prior to call to sample_all()",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (!m_is_plan_ready) {
+            compile_signal_plan();
+        }
+        sample.resize(m_active_signal.size());
+        double *value = sample.data();
+        size_t num_group_signal = m_plan_group.size();
+        for (size_t ii = 0; ii < num_group_signal; ++ii) {
+            value[m_plan_group_result_idx[ii]] =
+                m_plan_group[ii]->sample(m_plan_group_signal_idx[ii]);
+        }
+        size_t num_combined = m_plan_combined.size();
+        for (size_t ii = 0; ii < num_combined; ++ii) {
+            std::vector<double> &operand_value = m_plan_operand_value[ii];
+            const int *operand_idx = m_plan_operand_idx.data() + m_plan_operand_offset[ii];
+            for (size_t op_idx = 0; op_idx < operand_value.size(); ++op_idx) {
+                operand_value[op_idx] = value[operand_idx[op_idx]];
+            }
+            value[m_plan_combined_result_idx[ii]] =
+                m_plan_combined[ii]->sample(operand_value);
         }
-        return result;
     }
 
-    double PlatformIOImp::sample_combined(int signal_idx)
+    void PlatformIOImp::sample_all(const std::vector<int> &signal_idx,
+                                   std::vector<double> &sample)
+    {
+        if (!m_is_active) {
+            throw Exception("PlatformIOImp::sample_all(): read_batch() not called prior to call to sample_all()",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        if (!m_is_plan_ready) {
+            compile_signal_plan();
+        }
+        for (auto idx : signal_idx) {
+            if (idx < 0 || idx >= num_signal_pushed()) {
+                throw Exception("PlatformIOImp::sample_all(): signal_idx out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+        }
+        // Only the requested signals and their operands are sampled
+        // since some signals update their state when sampled.
+        sample.resize(signal_idx.size());
+        for (size_t ii = 0; ii < signal_idx.size(); ++ii) {
+            sample[ii] = sample_plan(signal_idx[ii]);
+        }
+    }
+
+    double PlatformIOImp::sample_plan(int signal_idx)
     {
         double result = NAN;
-        auto &op_func_pair = m_combined_signal.at(signal_idx);
-        std::vector<int> &operand_idx = op_func_pair.first;
-        auto &signal = op_func_pair.second;
-        std::vector<double> operands(operand_idx.size());
-        for (size_t ii = 0; ii < operands.size(); ++ii) {
-            operands[ii] = sample(operand_idx[ii]);
-        }
-        result = signal->sample(operands);
+        int plan_idx = m_plan_position[signal_idx];
+        if (plan_idx >= 0) {
+            result = m_plan_group[plan_idx]->sample(m_plan_group_signal_idx[plan_idx]);
+        }
+        else {
+            plan_idx = -1 - plan_idx;
+            std::vector<double> &operand_value = m_plan_operand_value[plan_idx];
+            const int *operand_idx = m_plan_operand_idx.data() + m_plan_operand_offset[plan_idx];
+            for (size_t op_idx = 0; op_idx < operand_value.size(); ++op_idx) {
+                operand_value[op_idx] = sample_plan(operand_idx[op_idx]);
+            }
+            result = m_plan_combined[plan_idx]->sample(operand_value);
+        }
         return result;
     }
 
+    void PlatformIOImp::compile_signal_plan(void)
+    {
+        m_plan_group.clear();
+        m_plan_group_signal_idx.clear();
+        m_plan_group_result_idx.clear();
+        m_plan_combined.clear();
+        m_plan_combined_result_idx.clear();
+        m_plan_operand_offset.assign(1, 0);
+        m_plan_operand_idx.clear();
+        m_plan_operand_value.clear();
+        m_plan_position.resize(m_active_signal.size());
+        for (int signal_idx = 0; signal_idx < num_signal_pushed(); ++signal_idx) {
+            auto &group_idx_pair = m_active_signal[signal_idx];
+            if (group_idx_pair.first) {
+                m_plan_position[signal_idx] = m_plan_group.size();
+                m_plan_group.push_back(group_idx_pair.first.get());
+                m_plan_group_signal_idx.push_back(group_idx_pair.second);
+                m_plan_group_result_idx.push_back(signal_idx);
+            }
+            else {
+                auto &op_func_pair = m_combined_signal.at(group_idx_pair.second);
+                GEOPM_DEBUG_ASSERT(std::all_of(op_func_pair.first.begin(),
+                                               op_func_pair.first.end(),
+                                               [signal_idx](int op_idx) {
+                                                   return op_idx < signal_idx;
+                                               }),
+                                   "Combined signal operands must be pushed before the combined signal");
+                m_plan_position[signal_idx] = -1 - (int)m_plan_combined.size();
+                m_plan_combined.push_back(op_func_pair.second.get());
+                m_plan_combined_result_idx.push_back(signal_idx);
+                m_plan_operand_idx.insert(m_plan_operand_idx.end(),
+                                          op_func_pair.first.begin(),
+                                          op_func_pair.first.end());
+                m_plan_operand_offset.push_back(m_plan_operand_idx.size());
+                m_plan_operand_value.emplace_back(op_func_pair.first.size());
+            }
+        }
+        m_is_plan_ready = true;
+    }
+
     void PlatformIOImp::adjust(int control_idx,
                                double setting)
     {
@@ -429,17 +560,132 @@ namespace geopm
 
     void PlatformIOImp::read_batch(void)
     {
+        // One time stamp for every IOGroup in the batch
+        struct geopm_time_s batch_time;
+        geopm_time(&batch_time);
         for (auto &it : m_iogroup_list) {
-            it->read_batch();
+            it->set_batch_time(batch_time);
+        }
+        if (m_batch_num_group != m_iogroup_list.size()) {
+            update_batch_group();
+        }
+        if (m_batch_worker.empty()) {
+            for (auto &it : m_batch_caller_group) {
+                it->read_batch();
+            }
+        }
+        else {
+            {
+                std::lock_guard<std::mutex> lock(m_batch_mutex);
+                ++m_batch_generation;
+                m_batch_num_busy = m_batch_worker.size();
+                m_batch_error = nullptr;
+            }
+            m_batch_start_cv.notify_all();
+            // Workers must be finished with the batch before any
+            // error is raised, so hold the caller's error until then.
+            std::exception_ptr caller_error;
+            try {
+                for (auto &it : m_batch_caller_group) {
+                    it->read_batch();
+                }
+            }
+            catch (...) {
+                caller_error = std::current_exception();
+            }
+            std::unique_lock<std::mutex> lock(m_batch_mutex);
+            m_batch_done_cv.wait(lock, [this]() {return m_batch_num_busy == 0;});
+            if (caller_error) {
+                std::rethrow_exception(caller_error);
+            }
+            if (m_batch_error) {
+                std::rethrow_exception(m_batch_error);
+            }
         }
         m_is_active = true;
+        controller_latency().update(ControllerLatency::M_PHASE_READ_BATCH,
+                                    geopm_time_since(&batch_time));
+    }
+
+    void PlatformIOImp::update_batch_group(void)
+    {
+        stop_batch_worker();
+        m_batch_caller_group.clear();
+        m_batch_worker_group.clear();
+        for (auto &it : m_iogroup_list) {
+            if (it->is_batch_independent()) {
+                m_batch_worker_group.push_back(it.get());
+            }
+            else {
+                m_batch_caller_group.push_back(it.get());
+            }
+        }
+        // The calling thread always reads something: take an
+        // independent IOGroup if there is no other work for it.
+        if (m_batch_caller_group.empty() && !m_batch_worker_group.empty()) {
+            m_batch_caller_group.push_back(m_batch_worker_group.back());
+            m_batch_worker_group.pop_back();
+        }
+        m_is_batch_stop = false;
+        for (auto &group : m_batch_worker_group) {
+            m_batch_worker.emplace_back(&PlatformIOImp::run_batch_worker, this,
+                                        group, m_batch_generation);
+        }
+        m_batch_num_group = m_iogroup_list.size();
+    }
+
+    void PlatformIOImp::run_batch_worker(IOGroup *group, uint64_t generation)
+    {
+        std::unique_lock<std::mutex> lock(m_batch_mutex);
+        while (true) {
+            m_batch_start_cv.wait(lock, [this, generation]() {
+                return m_is_batch_stop || m_batch_generation != generation;
+            });
+            if (m_is_batch_stop) {
+                break;
+            }
+            generation = m_batch_generation;
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                group->read_batch();
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !m_batch_error) {
+                m_batch_error = error;
+            }
+            --m_batch_num_busy;
+            if (m_batch_num_busy == 0) {
+                m_batch_done_cv.notify_one();
+            }
+        }
+    }
+
+    void PlatformIOImp::stop_batch_worker(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_batch_mutex);
+            m_is_batch_stop = true;
+        }
+        m_batch_start_cv.notify_all();
+        for (auto &it : m_batch_worker) {
+            it.join();
+        }
+        m_batch_worker.clear();
     }
 
     void PlatformIOImp::write_batch(void)
     {
+        struct geopm_time_s begin;
+        geopm_time(&begin);
         for (auto &it : m_iogroup_list) {
             it->write_batch();
         }
+        controller_latency().update(ControllerLatency::M_PHASE_WRITE_BATCH,
+                                    geopm_time_since(&begin));
     }
 
     double PlatformIOImp::read_signal(const std::string &signal_name,
@@ -477,8 +723,8 @@ namespace geopm
         double result = NAN;
         int base_domain_type = signal_domain_type(signal_name);
         if (m_platform_topo.is_nested_domain(base_domain_type, domain_type)) {
-            std::set<int> base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
-                                                                          domain_type, domain_idx);
+            std::vector<int> base_domain_idx = nested_domain_idx(base_domain_type,
+                                                                 domain_type, domain_idx);
             std::vector<double> values;
             for (auto idx : base_domain_idx) {
                 values.push_back(read_signal(signal_name, base_domain_type, idx));
@@ -527,8 +773,8 @@ namespace geopm
     {
         int base_domain_type = control_domain_type(control_name);
         if (m_platform_topo.is_nested_domain(base_domain_type, domain_type)) {
-            std::set<int> base_domain_idx = m_platform_topo.domain_nested(base_domain_type,
-                                                                          domain_type, domain_idx);
+            std::vector<int> base_domain_idx = nested_domain_idx(base_domain_type,
+                                                                 domain_type, domain_idx);
             for (auto idx : base_domain_idx) {
                 write_control(control_name, base_domain_type, idx, setting);
             }
@@ -133,6 +133,17 @@ namespace geopm
             ///        to the push_signal() method.
             /// @return Signal value measured from the platform in SI units.
             virtual double sample(int signal_idx) = 0;
+            /// @brief Sample a subset of the pushed signals.  Must be
+            ///        called after a call to read_batch(void).  The
+            ///        default implementation calls sample() for each
+            ///        index.
+            /// @param [in] signal_idx Indices returned by previous
+            ///        calls to the push_signal() method.
+            /// @param [out] sample Resized to the length of
+            ///        signal_idx; element i is the value of signal
+            ///        signal_idx[i].
+            virtual void sample_all(const std::vector<int> &signal_idx,
+                                    std::vector<double> &sample);
             /// @brief Adjust a single control that has been pushed on
             ///        to the control stack.  This control will not
             ///        take effect until the next call to
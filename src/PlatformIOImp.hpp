@@ -35,6 +35,10 @@
 
 #include <list>
 #include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 
 #include "PlatformIO.hpp"
 
@@ -53,7 +57,7 @@ namespace geopm
                           const PlatformTopo &topo);
             PlatformIOImp(const PlatformIOImp &other) = delete;
             PlatformIOImp & operator=(const PlatformIOImp&) = delete;
-            virtual ~PlatformIOImp() = default;
+            virtual ~PlatformIOImp();
             void register_iogroup(std::shared_ptr<IOGroup> iogroup) override;
             void register_profileio(std::shared_ptr<ProfileIOGroup> piogroup) override;
             std::shared_ptr<ProfileIOGroup> get_profileio(void) override;
@@ -68,6 +72,17 @@ namespace geopm
                              int domain_type,
                              int domain_idx) override;
             double sample(int signal_idx) override;
+            /// @brief Sample every signal that has been pushed on to
+            ///        the signal stack.  Must be called after a call
+            ///        to read_batch(void).  Equivalent to calling
+            ///        sample() for each pushed signal, but evaluates
+            ///        each signal exactly once per call.
+            /// @param [out] sample Resized to the number of pushed
+            ///        signals and filled with the value of each
+            ///        signal at the index returned by push_signal().
+            void sample_all(std::vector<double> &sample);
+            void sample_all(const std::vector<int> &signal_idx,
+                            std::vector<double> &sample) override;
             void adjust(int control_idx, double setting) override;
             void read_batch(void) override;
             void write_batch(void) override;
@@ -129,8 +144,36 @@ namespace geopm
                                               int domain_type,
                                               int domain_idx,
                                               double setting);
-            /// @brief Sample a combined signal using the saved function and operands.
-            double sample_combined(int signal_idx);
+            /// @brief Indices of the inner_domain domains contained in
+            ///        the indexed outer domain, in ascending order.
+            ///        Computed from the contiguous CPU list of the
+            ///        outer domain rather than a std::set.
+            std::vector<int> nested_domain_idx(int inner_domain,
+                                               int outer_domain,
+                                               int outer_idx) const;
+            /// @brief Flatten the pushed signals into the evaluation
+            ///        plan used by sample() and sample_all().  Called
+            ///        once, after pushing is no longer allowed.
+            void compile_signal_plan(void);
+            /// @brief Sample one pushed signal through the evaluation
+            ///        plan.  Combined signals gather their operands
+            ///        into preallocated scratch, so nothing is
+            ///        allocated.
+            double sample_plan(int signal_idx);
+            /// @brief Split the registered IOGroups into those read
+            ///        by the calling thread and those read on worker
+            ///        threads, and start one worker per independent
+            ///        IOGroup.  Called whenever the number of
+            ///        registered IOGroups has changed.
+            void update_batch_group(void);
+            /// @brief Body of the worker thread that reads one
+            ///        independent IOGroup each batch.
+            /// @param [in] group IOGroup owned by the worker.
+            /// @param [in] generation Batch generation at the time
+            ///        the worker was started.
+            void run_batch_worker(IOGroup *group, uint64_t generation);
+            /// @brief Signal all batch workers to exit and join them.
+            void stop_batch_worker(void);
             /// @brief Look up the IOGroup that provides the given signal.
             std::shared_ptr<IOGroup> find_signal_iogroup(const std::string &signal_name) const;
             /// @brief Look up the IOGroup that provides the given control.
@@ -147,6 +190,38 @@ namespace geopm
             std::map<int, std::vector<int> > m_combined_control;
             bool m_do_restore;
             std::shared_ptr<ProfileIOGroup> m_piogroup;
+            // Evaluation plan for sample() and sample_all() stored
+            // as structure of arrays.  IOGroup signals are sampled
+            // first, then combined signals in push order; operands
+            // of a combined signal are always pushed before it.
+            bool m_is_plan_ready;
+            std::vector<IOGroup *> m_plan_group;
+            std::vector<int> m_plan_group_signal_idx;
+            std::vector<int> m_plan_group_result_idx;
+            std::vector<CombinedSignal *> m_plan_combined;
+            std::vector<int> m_plan_combined_result_idx;
+            // Operands of combined signal i are
+            // m_plan_operand_idx[m_plan_operand_offset[i]] up to
+            // m_plan_operand_idx[m_plan_operand_offset[i + 1]].
+            std::vector<int> m_plan_operand_offset;
+            std::vector<int> m_plan_operand_idx;
+            std::vector<std::vector<double> > m_plan_operand_value;
+            // Index into the IOGroup arrays for IOGroup signals, or
+            // -1 - index into the combined arrays.
+            std::vector<int> m_plan_position;
+            // IOGroups read by the calling thread in read_batch() and
+            // IOGroups that are each read by a dedicated worker.
+            size_t m_batch_num_group;
+            std::vector<IOGroup *> m_batch_caller_group;
+            std::vector<IOGroup *> m_batch_worker_group;
+            std::vector<std::thread> m_batch_worker;
+            std::mutex m_batch_mutex;
+            std::condition_variable m_batch_start_cv;
+            std::condition_variable m_batch_done_cv;
+            uint64_t m_batch_generation;
+            int m_batch_num_busy;
+            bool m_is_batch_stop;
+            std::exception_ptr m_batch_error;
     };
 }
 
@@ -35,9 +35,12 @@
 #include <signal.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <cpuid.h>
 #include <string.h>
+#include <stdlib.h>
 
 #include <map>
 #include <sstream>
@@ -83,6 +86,71 @@ int geopm_read_cpuid(void)
 namespace geopm
 {
     const std::string PlatformTopoImp::M_CACHE_FILE_NAME = "/tmp/geopm-topo-cache";
+    const std::string PlatformTopoImp::M_BINARY_CACHE_FILE_NAME = "/tmp/geopm-topo-cache.bin";
+    const std::string PlatformTopoImp::M_SYSFS_PATH = "/sys/devices/system";
+
+    // Binary cache layout: the header is followed by num_numa + 1
+    // offsets into the CPU list, then the CPU list of each NUMA
+    // node.  All fields are native endian uint32_t.
+    struct geopm_topo_cache_header_s {
+        char magic[8];
+        uint32_t version;
+        uint32_t num_package;
+        uint32_t core_per_package;
+        uint32_t thread_per_core;
+        uint32_t num_numa;
+        uint32_t num_numa_cpu;
+    };
+
+    static const char GEOPM_TOPO_CACHE_MAGIC[8] = {'G', 'E', 'O', 'P', 'M', 'T', 'O', 'P'};
+    static const uint32_t GEOPM_TOPO_CACHE_VERSION = 1;
+
+    /// @brief Read a small sysfs file without the overhead of
+    ///        ifstream; sysfs files report a size of one page.
+    static bool read_sysfs_file(const std::string &path, std::string &contents)
+    {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return false;
+        }
+        char buffer[4096];
+        ssize_t num_read = read(fd, buffer, sizeof(buffer) - 1);
+        close(fd);
+        if (num_read < 0) {
+            return false;
+        }
+        contents.assign(buffer, num_read);
+        return true;
+    }
+
+    /// @brief Parse a Linux CPU list such as "0-3,8-11".
+    static std::set<int> parse_cpu_list(const std::string &cpu_list)
+    {
+        std::set<int> result;
+        size_t pos = 0;
+        while (pos < cpu_list.size()) {
+            size_t end = cpu_list.find_first_of(",\n", pos);
+            if (end == std::string::npos) {
+                end = cpu_list.size();
+            }
+            std::string range = cpu_list.substr(pos, end - pos);
+            if (!range.empty()) {
+                size_t dash_pos = range.find('-');
+                int first = std::stoi(range.substr(0, dash_pos));
+                int last = dash_pos == std::string::npos ?
+                           first : std::stoi(range.substr(dash_pos + 1));
+                if (first < 0 || last < first) {
+                    throw Exception("PlatformTopoImp: invalid CPU list: \"" + cpu_list + "\"",
+                                    GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+                }
+                for (int cpu_idx = first; cpu_idx <= last; ++cpu_idx) {
+                    result.insert(cpu_idx);
+                }
+            }
+            pos = end + 1;
+        }
+        return result;
+    }
 
     const PlatformTopo &platform_topo(void)
     {
@@ -91,7 +159,7 @@ namespace geopm
     }
 
     PlatformTopoImp::PlatformTopoImp()
-        : PlatformTopoImp("")
+        : PlatformTopoImp(M_BINARY_CACHE_FILE_NAME, M_SYSFS_PATH)
     {
 
     }
@@ -99,14 +167,100 @@ namespace geopm
     PlatformTopoImp::PlatformTopoImp(const std::string &test_cache_file_name)
         : M_TEST_CACHE_FILE_NAME(test_cache_file_name)
         , m_do_fclose(true)
+        , m_num_package(0)
+        , m_core_per_package(0)
+        , m_thread_per_core(0)
     {
-        std::map<std::string, std::string> lscpu_map;
-        lscpu(lscpu_map);
-        parse_lscpu(lscpu_map, m_num_package, m_core_per_package, m_thread_per_core);
-        parse_lscpu_numa(lscpu_map, m_numa_map);
+        load_lscpu();
+        build_lookup();
+    }
+
+    PlatformTopoImp::PlatformTopoImp(const std::string &binary_cache_file_name,
+                                     const std::string &sysfs_path)
+        : M_TEST_CACHE_FILE_NAME("")
+        , m_do_fclose(true)
+        , m_num_package(0)
+        , m_core_per_package(0)
+        , m_thread_per_core(0)
+    {
+        bool is_loaded = false;
+        if (!binary_cache_file_name.empty()) {
+            is_loaded = load_binary_cache(binary_cache_file_name);
+        }
+        if (!is_loaded && !sysfs_path.empty()) {
+            is_loaded = load_sysfs(sysfs_path);
+        }
+        if (!is_loaded) {
+            load_lscpu();
+        }
+        build_lookup();
+    }
+
+    bool PlatformTopoImp::is_lookup_domain(int domain_type)
+    {
+        return domain_type == GEOPM_DOMAIN_BOARD ||
+               domain_type == GEOPM_DOMAIN_PACKAGE ||
+               domain_type == GEOPM_DOMAIN_CORE ||
+               domain_type == GEOPM_DOMAIN_CPU ||
+               domain_type == GEOPM_DOMAIN_BOARD_MEMORY;
+    }
+
+    void PlatformTopoImp::build_lookup(void)
+    {
+        m_num_domain.assign(GEOPM_NUM_DOMAIN, 0);
+        for (int domain_type = 0; domain_type != GEOPM_NUM_DOMAIN; ++domain_type) {
+            m_num_domain[domain_type] = compute_num_domain(domain_type);
+        }
+        int num_cpu = m_num_domain[GEOPM_DOMAIN_CPU];
+        m_domain_cpu.assign(GEOPM_NUM_DOMAIN, {});
+        m_cpu_domain_idx.assign(GEOPM_NUM_DOMAIN, {});
+        for (int domain_type = 0; domain_type != GEOPM_NUM_DOMAIN; ++domain_type) {
+            if (!is_lookup_domain(domain_type)) {
+                continue;
+            }
+            auto &domain_cpu = m_domain_cpu[domain_type];
+            domain_cpu.resize(m_num_domain[domain_type]);
+            for (int domain_idx = 0; domain_idx != m_num_domain[domain_type]; ++domain_idx) {
+                std::set<int> cpus = domain_cpus(domain_type, domain_idx);
+                domain_cpu[domain_idx].assign(cpus.begin(), cpus.end());
+            }
+            auto &cpu_domain_idx = m_cpu_domain_idx[domain_type];
+            cpu_domain_idx.resize(num_cpu);
+            for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+                cpu_domain_idx[cpu_idx] = compute_domain_idx(domain_type, cpu_idx);
+            }
+        }
+        m_domain_nested.assign(GEOPM_NUM_DOMAIN * GEOPM_NUM_DOMAIN, {});
+        for (int inner_domain = 0; inner_domain != GEOPM_NUM_DOMAIN; ++inner_domain) {
+            for (int outer_domain = 0; outer_domain != GEOPM_NUM_DOMAIN; ++outer_domain) {
+                if (!is_lookup_domain(inner_domain) ||
+                    !is_lookup_domain(outer_domain) ||
+                    !is_nested_domain(inner_domain, outer_domain)) {
+                    continue;
+                }
+                auto &nested = m_domain_nested[inner_domain * GEOPM_NUM_DOMAIN + outer_domain];
+                nested.resize(m_num_domain[outer_domain]);
+                for (int outer_idx = 0; outer_idx != m_num_domain[outer_domain]; ++outer_idx) {
+                    std::set<int> inner_idx;
+                    for (int cpu_idx : m_domain_cpu[outer_domain][outer_idx]) {
+                        inner_idx.insert(m_cpu_domain_idx[inner_domain][cpu_idx]);
+                    }
+                    nested[outer_idx].assign(inner_idx.begin(), inner_idx.end());
+                }
+            }
+        }
     }
 
     int PlatformTopoImp::num_domain(int domain_type) const
+    {
+        if (domain_type < 0 || domain_type >= GEOPM_NUM_DOMAIN) {
+            throw Exception("PlatformTopoImp::num_domain(): invalid domain specified",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return m_num_domain[domain_type];
+    }
+
+    int PlatformTopoImp::compute_num_domain(int domain_type) const
     {
         int result = 0;
         switch (domain_type) {
@@ -209,8 +363,46 @@ namespace geopm
         return cpu_idx;
     }
 
+    const std::vector<int> &PlatformTopoImp::domain_cpu_list(int domain_type,
+                                                             int domain_idx) const
+    {
+        if (domain_type < 0 || domain_type >= GEOPM_NUM_DOMAIN) {
+            throw Exception("PlatformTopoImp::domain_cpu_list(): domain_type out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (domain_idx < 0 || domain_idx >= m_num_domain[domain_type]) {
+            throw Exception("PlatformTopoImp::domain_cpu_list(): domain_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (!is_lookup_domain(domain_type)) {
+            throw Exception("PlatformTopoImp::domain_cpu_list(domain_type=" +
+                            std::to_string(domain_type) +
+                            ") support not yet implemented",
+                            GEOPM_ERROR_NOT_IMPLEMENTED, __FILE__, __LINE__);
+        }
+        return m_domain_cpu[domain_type][domain_idx];
+    }
+
     int PlatformTopoImp::domain_idx(int domain_type,
                                     int cpu_idx) const
+    {
+        if (domain_type < 0 || domain_type >= GEOPM_NUM_DOMAIN) {
+            throw Exception("PlatformTopoImp::domain_idx(): domain_type out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (cpu_idx < 0 || cpu_idx >= m_num_domain[GEOPM_DOMAIN_CPU]) {
+            throw Exception("PlatformTopoImp::domain_idx(): cpu_idx out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_cpu_domain_idx[domain_type].empty()) {
+            // Reports the unsupported domain type
+            return compute_domain_idx(domain_type, cpu_idx);
+        }
+        return m_cpu_domain_idx[domain_type][cpu_idx];
+    }
+
+    int PlatformTopoImp::compute_domain_idx(int domain_type,
+                                            int cpu_idx) const
     {
         int result = -1;
         int num_cpu = num_domain(GEOPM_DOMAIN_CPU);
@@ -323,6 +515,14 @@ namespace geopm
                             " is not contained within domain type " + std::to_string(outer_domain),
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        if (is_lookup_domain(inner_domain) && is_lookup_domain(outer_domain)) {
+            if (outer_idx < 0 || outer_idx >= m_num_domain[outer_domain]) {
+                throw Exception("PlatformTopoImp::domain_nested(): outer_idx out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            const auto &nested = m_domain_nested[inner_domain * GEOPM_NUM_DOMAIN + outer_domain][outer_idx];
+            return std::set<int>(nested.begin(), nested.end());
+        }
         std::set<int> inner_domain_idx;
         std::set<int> cpus = domain_cpus(outer_domain, outer_idx);
         for (auto cc : cpus) {
@@ -331,6 +531,17 @@ namespace geopm
         return inner_domain_idx;
     }
 
+    const std::vector<int> &PlatformTopo::domain_cpu_list(int domain_type, int domain_idx) const
+    {
+        auto key = std::make_pair(domain_type, domain_idx);
+        auto it = m_domain_cpu_list.find(key);
+        if (it == m_domain_cpu_list.end()) {
+            std::set<int> cpus = domain_nested(GEOPM_DOMAIN_CPU, domain_type, domain_idx);
+            it = m_domain_cpu_list.emplace(key, std::vector<int>(cpus.begin(), cpus.end())).first;
+        }
+        return it->second;
+    }
+
     std::vector<std::string> PlatformTopo::domain_names(void)
     {
         std::vector<std::string> result(GEOPM_NUM_DOMAIN);
@@ -383,7 +594,181 @@ namespace geopm
 
     void PlatformTopoImp::create_cache(void)
     {
-        PlatformTopoImp::create_cache(M_CACHE_FILE_NAME);
+        PlatformTopoImp::create_binary_cache(M_BINARY_CACHE_FILE_NAME, M_SYSFS_PATH);
+    }
+
+    void PlatformTopoImp::create_binary_cache(const std::string &cache_file_name,
+                                              const std::string &sysfs_path)
+    {
+        struct stat cache_stat;
+        if (stat(cache_file_name.c_str(), &cache_stat)) {
+            PlatformTopoImp topo("", sysfs_path);
+            topo.write_binary_cache(cache_file_name);
+        }
+    }
+
+    void PlatformTopoImp::write_binary_cache(const std::string &cache_file_name) const
+    {
+        struct geopm_topo_cache_header_s header {};
+        memcpy(header.magic, GEOPM_TOPO_CACHE_MAGIC, sizeof(header.magic));
+        header.version = GEOPM_TOPO_CACHE_VERSION;
+        header.num_package = m_num_package;
+        header.core_per_package = m_core_per_package;
+        header.thread_per_core = m_thread_per_core;
+        header.num_numa = m_numa_map.size();
+        std::vector<uint32_t> body;
+        body.reserve(m_numa_map.size() + 1);
+        uint32_t offset = 0;
+        for (const auto &numa_cpus : m_numa_map) {
+            body.push_back(offset);
+            offset += numa_cpus.size();
+        }
+        body.push_back(offset);
+        for (const auto &numa_cpus : m_numa_map) {
+            body.insert(body.end(), numa_cpus.begin(), numa_cpus.end());
+        }
+        header.num_numa_cpu = offset;
+
+        std::string temp_name = cache_file_name + "XXXXXX";
+        int fd = mkstemp(&temp_name[0]);
+        if (fd == -1) {
+            throw Exception("PlatformTopoImp::write_binary_cache(): Could not create temporary file: " + temp_name,
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        size_t body_size = body.size() * sizeof(uint32_t);
+        bool is_written = write(fd, &header, sizeof(header)) == (ssize_t)sizeof(header) &&
+                          write(fd, body.data(), body_size) == (ssize_t)body_size &&
+                          fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH) == 0;
+        int err = errno;
+        close(fd);
+        if (!is_written || rename(temp_name.c_str(), cache_file_name.c_str())) {
+            err = is_written ? errno : err;
+            unlink(temp_name.c_str());
+            throw Exception("PlatformTopoImp::write_binary_cache(): Could not write cache file: " + cache_file_name,
+                            err ? err : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    bool PlatformTopoImp::load_binary_cache(const std::string &cache_file_name)
+    {
+        int fd = open(cache_file_name.c_str(), O_RDONLY);
+        if (fd == -1) {
+            return false;
+        }
+        struct stat cache_stat;
+        void *map = MAP_FAILED;
+        if (!fstat(fd, &cache_stat) &&
+            (size_t)cache_stat.st_size >= sizeof(geopm_topo_cache_header_s)) {
+            map = mmap(NULL, cache_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (map == MAP_FAILED) {
+            return false;
+        }
+        size_t map_size = cache_stat.st_size;
+        const geopm_topo_cache_header_s *header = (const geopm_topo_cache_header_s *)map;
+        const uint32_t *offset = (const uint32_t *)(header + 1);
+        bool result = memcmp(header->magic, GEOPM_TOPO_CACHE_MAGIC, sizeof(header->magic)) == 0 &&
+                      header->version == GEOPM_TOPO_CACHE_VERSION &&
+                      header->num_package != 0 &&
+                      header->core_per_package != 0 &&
+                      header->thread_per_core != 0 &&
+                      map_size == sizeof(*header) + sizeof(uint32_t) *
+                                  ((size_t)header->num_numa + 1 + header->num_numa_cpu) &&
+                      offset[header->num_numa] == header->num_numa_cpu;
+        if (result) {
+            const uint32_t *numa_cpu = offset + header->num_numa + 1;
+            uint32_t num_cpu = header->num_package * header->core_per_package * header->thread_per_core;
+            std::vector<std::set<int> > numa_map(header->num_numa);
+            for (uint32_t numa_idx = 0; result && numa_idx != header->num_numa; ++numa_idx) {
+                if (offset[numa_idx] > offset[numa_idx + 1]) {
+                    result = false;
+                    break;
+                }
+                for (uint32_t pos = offset[numa_idx]; pos != offset[numa_idx + 1]; ++pos) {
+                    if (numa_cpu[pos] >= num_cpu) {
+                        result = false;
+                        break;
+                    }
+                    numa_map[numa_idx].insert(numa_cpu[pos]);
+                }
+            }
+            if (result) {
+                m_num_package = header->num_package;
+                m_core_per_package = header->core_per_package;
+                m_thread_per_core = header->thread_per_core;
+                m_numa_map = std::move(numa_map);
+            }
+        }
+        munmap(map, map_size);
+        return result;
+    }
+
+    bool PlatformTopoImp::load_sysfs(const std::string &sysfs_path)
+    {
+        bool result = false;
+        try {
+            std::string contents;
+            if (!read_sysfs_file(sysfs_path + "/cpu/online", contents)) {
+                return false;
+            }
+            std::set<int> online_cpu = parse_cpu_list(contents);
+            // Linux CPU indices are used directly as CPU domain indices
+            if (online_cpu.empty() || *online_cpu.rbegin() != (int)online_cpu.size() - 1) {
+                return false;
+            }
+            // Count hardware threads per (package, core) pair
+            std::map<std::pair<int, int>, int> core_thread_count;
+            std::set<int> package_id;
+            for (int cpu_idx : online_cpu) {
+                std::string topo_path = sysfs_path + "/cpu/cpu" + std::to_string(cpu_idx) + "/topology/";
+                std::string package_str;
+                std::string core_str;
+                if (!read_sysfs_file(topo_path + "physical_package_id", package_str) ||
+                    !read_sysfs_file(topo_path + "core_id", core_str)) {
+                    return false;
+                }
+                int package = std::stoi(package_str);
+                package_id.insert(package);
+                ++core_thread_count[std::make_pair(package, std::stoi(core_str))];
+            }
+            int num_package = package_id.size();
+            int num_core = core_thread_count.size();
+            if (num_package == 0 || num_core % num_package) {
+                return false;
+            }
+            int thread_per_core = core_thread_count.begin()->second;
+            for (const auto &it : core_thread_count) {
+                if (it.second != thread_per_core) {
+                    return false;
+                }
+            }
+            // Nodes are enumerated until the first missing index, as
+            // lscpu reports them.
+            std::vector<std::set<int> > numa_map;
+            std::string cpu_list;
+            while (read_sysfs_file(sysfs_path + "/node/node" + std::to_string(numa_map.size()) + "/cpulist",
+                                   cpu_list)) {
+                numa_map.push_back(parse_cpu_list(cpu_list));
+            }
+            m_num_package = num_package;
+            m_core_per_package = num_core / num_package;
+            m_thread_per_core = thread_per_core;
+            m_numa_map = std::move(numa_map);
+            result = true;
+        }
+        catch (const std::exception &) {
+            result = false;
+        }
+        return result;
+    }
+
+    void PlatformTopoImp::load_lscpu(void)
+    {
+        std::map<std::string, std::string> lscpu_map;
+        lscpu(lscpu_map);
+        parse_lscpu(lscpu_map, m_num_package, m_core_per_package, m_thread_per_core);
+        parse_lscpu_numa(lscpu_map, m_numa_map);
     }
 
     void PlatformTopoImp::create_cache(const std::string &cache_file_name)
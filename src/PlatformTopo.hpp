@@ -77,6 +77,19 @@ namespace geopm
             /// @return The set of domain indices for the inner domain that are
             ///         within the indexed outer domain.
             virtual std::set<int> domain_nested(int inner_domain, int outer_domain, int outer_idx) const = 0;
+            /// @brief Get the Linux logical CPUs contained in a
+            ///        domain without building a set.  The default
+            ///        implementation converts the result of
+            ///        domain_nested() on the first request for a
+            ///        domain and keeps it; implementations may
+            ///        override it to answer from their own table.
+            /// @param [in] domain_type One of the values from the
+            ///        m_domain_e enum.
+            /// @param [in] domain_idx The index of the domain.
+            /// @return Sorted, contiguous array of CPU indices that
+            ///         remains valid for the lifetime of the
+            ///         PlatformTopo.
+            virtual const std::vector<int> &domain_cpu_list(int domain_type, int domain_idx) const;
             /// @brief Convert a domain type enum to a string.
             /// @param [in] domain_type Domain type from the
             ///        m_domain_e enum.
@@ -95,6 +108,7 @@ namespace geopm
         private:
             static std::vector<std::string> domain_names(void);
             static std::map<std::string, int> domain_types(void);
+            mutable std::map<std::pair<int, int>, std::vector<int> > m_domain_cpu_list;
     };
 
     const PlatformTopo &platform_topo(void);
@@ -42,22 +42,67 @@ namespace geopm
     {
         public:
             PlatformTopoImp();
+            /// @brief Construct from lscpu output read from the
+            ///        given file.
             PlatformTopoImp(const std::string &test_cache_file_name);
+            /// @brief Construct from the first source available:
+            ///        the binary cache file, then the sysfs cpu and
+            ///        node directories under sysfs_path, then lscpu.
+            ///        An empty path skips that source.
+            PlatformTopoImp(const std::string &binary_cache_file_name,
+                            const std::string &sysfs_path);
             virtual ~PlatformTopoImp() = default;
             int num_domain(int domain_type) const override;
             int domain_idx(int domain_type,
                            int cpu_idx) const override;
             bool is_nested_domain(int inner_domain, int outer_domain) const override;
             std::set<int> domain_nested(int inner_domain, int outer_domain, int outer_idx) const override;
+            const std::vector<int> &domain_cpu_list(int domain_type, int domain_idx) const override;
             static void create_cache();
             static void create_cache(const std::string &cache_file_name);
+            /// @brief Create the binary cache file from sysfs, or
+            ///        from lscpu if sysfs is not usable, unless the
+            ///        file already exists.
+            static void create_binary_cache(const std::string &cache_file_name,
+                                            const std::string &sysfs_path);
+            /// @brief Write the topology to a binary cache file that
+            ///        can be mapped by later processes.  The file is
+            ///        written under a temporary name and renamed so
+            ///        readers never observe a partial file.
+            void write_binary_cache(const std::string &cache_file_name) const;
         private:
             static const std::string M_CACHE_FILE_NAME;
+            static const std::string M_BINARY_CACHE_FILE_NAME;
+            static const std::string M_SYSFS_PATH;
+            /// @brief Fill the lookup tables used by the public
+            ///        query methods.  Called once the topology has
+            ///        been loaded.
+            void build_lookup(void);
+            /// @brief Returns true if the lookup tables cover the
+            ///        domain type.
+            static bool is_lookup_domain(int domain_type);
+            /// @brief Compute the number of domains from the loaded
+            ///        topology.
+            int compute_num_domain(int domain_type) const;
+            /// @brief Compute the domain containing a CPU from the
+            ///        loaded topology.
+            int compute_domain_idx(int domain_type,
+                                   int cpu_idx) const;
             /// @brief Get the set of Linux logical CPUs associated
             ///        with the indexed domain.
             std::set<int> domain_cpus(int domain_type,
                                       int domain_idx) const;
 
+            /// @brief Load the topology from a binary cache file.
+            /// @return False if the file is missing, truncated or
+            ///         written by another version.
+            bool load_binary_cache(const std::string &cache_file_name);
+            /// @brief Load the topology from the cpu and node
+            ///        directories under sysfs_path.
+            /// @return False if sysfs is not readable or describes
+            ///         a topology that cannot be represented.
+            bool load_sysfs(const std::string &sysfs_path);
+            void load_lscpu(void);
             void lscpu(std::map<std::string, std::string> &lscpu_map);
             void parse_lscpu(const std::map<std::string, std::string> &lscpu_map,
                              int &num_package,
@@ -74,6 +119,17 @@ namespace geopm
             int m_core_per_package;
             int m_thread_per_core;
             std::vector<std::set<int> > m_numa_map;
+            // Lookup tables filled by build_lookup().  The tables
+            // indexed by domain type are empty for types that
+            // domain_idx() and domain_cpus() do not support.
+            std::vector<int> m_num_domain;
+            // CPUs of each domain: [domain_type][domain_idx]
+            std::vector<std::vector<std::vector<int> > > m_domain_cpu;
+            // Domain containing each CPU: [domain_type][cpu_idx]
+            std::vector<std::vector<int> > m_cpu_domain_idx;
+            // Result of domain_nested():
+            // [inner_domain * GEOPM_NUM_DOMAIN + outer_domain][outer_idx]
+            std::vector<std::vector<std::vector<int> > > m_domain_nested;
     };
 }
 #endif
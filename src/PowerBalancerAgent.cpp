@@ -44,6 +44,7 @@
 #include "Exception.hpp"
 #include "Agg.hpp"
 #include "Helper.hpp"
+#include "Waiter.hpp"
 #include "config.h"
 
 namespace geopm
@@ -249,20 +250,8 @@ namespace geopm
 
     PowerBalancerAgent::TreeRole::TreeRole(int level, const std::vector<int> &fan_in)
         : Role()
-        , M_AGG_FUNC({
-              Agg::min, // M_SAMPLE_STEP_COUNT
-              Agg::max, // M_SAMPLE_MAX_EPOCH_RUNTIME
-              Agg::sum, // M_SAMPLE_SUM_POWER_SLACK
-              Agg::min, // M_SAMPLE_MIN_POWER_HEADROOM
-          })
         , M_NUM_CHILDREN(fan_in[level - 1])
     {
-#ifdef GEOPM_DEBUG
-        if (M_AGG_FUNC.size() != M_NUM_SAMPLE) {
-            throw Exception("PowerBalancerAgent::TreeRole::" + std::string(__func__) + "(): aggregation function vector is not the size of the policy vector",
-                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
-        }
-#endif
         m_is_step_complete = true;
     }
 
@@ -313,7 +302,11 @@ namespace geopm
         }
 #endif
         bool result = false;
-        Agent::aggregate_sample(in_sample, M_AGG_FUNC, out_sample);
+        Agent::aggregate_sample<Agg::M_COLUMN_MIN, // M_SAMPLE_STEP_COUNT
+                                Agg::M_COLUMN_MAX, // M_SAMPLE_MAX_EPOCH_RUNTIME
+                                Agg::M_COLUMN_SUM, // M_SAMPLE_SUM_POWER_SLACK
+                                Agg::M_COLUMN_MIN> // M_SAMPLE_MIN_POWER_HEADROOM
+            (in_sample, m_sample_matrix, out_sample);
         if (!m_is_step_complete && out_sample[M_SAMPLE_STEP_COUNT] == m_step_count) {
             // Method returns true if all children have completed the step
             // for the first time.
@@ -496,19 +489,29 @@ namespace geopm
                                            const PlatformTopo &platform_topo,
                                            std::unique_ptr<PowerGovernor> power_governor,
                                            std::unique_ptr<PowerBalancer> power_balancer)
+        : PowerBalancerAgent(platform_io, platform_topo, std::move(power_governor),
+                             std::move(power_balancer), nullptr)
+    {
+
+    }
+
+    PowerBalancerAgent::PowerBalancerAgent(PlatformIO &platform_io,
+                                           const PlatformTopo &platform_topo,
+                                           std::unique_ptr<PowerGovernor> power_governor,
+                                           std::unique_ptr<PowerBalancer> power_balancer,
+                                           std::unique_ptr<Waiter> waiter)
         : m_platform_io(platform_io)
         , m_platform_topo(platform_topo)
         , m_role(nullptr)
         , m_power_governor(std::move(power_governor))
         , m_power_balancer(std::move(power_balancer))
-        , m_last_wait(GEOPM_TIME_REF)
         , M_WAIT_SEC(0.005)
+        , m_waiter(waiter ? std::move(waiter) : Waiter::make_unique(M_WAIT_SEC))
         , m_power_tdp(NAN)
         , m_do_send_sample(false)
         , m_do_send_policy(false)
         , m_do_write_batch(false)
     {
-        geopm_time(&m_last_wait);
         m_power_tdp = m_platform_io.read_signal("POWER_PACKAGE_TDP", GEOPM_DOMAIN_BOARD, 0);
     }
 
@@ -585,11 +588,9 @@ namespace geopm
         m_do_send_sample = m_role->sample_platform(out_sample);
     }
 
-    void PowerBalancerAgent::wait(void)    {
-        while(geopm_time_since(&m_last_wait) < M_WAIT_SEC) {
-
-        }
-        geopm_time(&m_last_wait);
+    void PowerBalancerAgent::wait(void)
+    {
+        m_waiter->wait();
     }
 
     std::vector<std::pair<std::string, std::string> > PowerBalancerAgent::report_header(void) const
@@ -599,7 +600,7 @@ namespace geopm
 
     std::vector<std::pair<std::string, std::string> > PowerBalancerAgent::report_host(void) const
     {
-        return {};
+        return m_waiter->report();
     }
 
     std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > PowerBalancerAgent::report_region(void) const
@@ -41,6 +41,7 @@
 
 namespace geopm
 {
+    class Waiter;
     class PlatformIO;
     class PlatformTopo;
     class PowerBalancer;
@@ -159,6 +160,11 @@ namespace geopm
                                const PlatformTopo &platform_topo,
                                std::unique_ptr<PowerGovernor> power_governor,
                                std::unique_ptr<PowerBalancer> power_balancer);
+            PowerBalancerAgent(PlatformIO &platform_io,
+                               const PlatformTopo &platform_topo,
+                               std::unique_ptr<PowerGovernor> power_governor,
+                               std::unique_ptr<PowerBalancer> power_balancer,
+                               std::unique_ptr<Waiter> waiter);
             PowerBalancerAgent();
             virtual ~PowerBalancerAgent();
             void init(int level, const std::vector<int> &fan_in, bool is_level_root) override;
@@ -214,8 +220,8 @@ namespace geopm
             std::shared_ptr<Role> m_role;
             std::unique_ptr<PowerGovernor> m_power_governor;   /// temporary ownership, std::move'd to Role on init
             std::unique_ptr<PowerBalancer> m_power_balancer;   /// temporary ownership, std::move'd to Role on init
-            struct geopm_time_s m_last_wait;
             const double M_WAIT_SEC;
+            std::unique_ptr<Waiter> m_waiter;
             double m_power_tdp;
             bool m_do_send_sample;
             bool m_do_send_policy;
@@ -273,8 +279,8 @@ namespace geopm
                     virtual bool ascend(const std::vector<std::vector<double> > &in_sample,
                                         std::vector<double> &out_sample) override;
                 protected:
-                    const std::vector<std::function<double(const std::vector<double>&)> > M_AGG_FUNC;
                     const int M_NUM_CHILDREN;
+                    std::vector<double> m_sample_matrix;
             };
 
             class RootRole : public TreeRole {
@@ -43,6 +43,7 @@
 #include "CircularBuffer.hpp"
 #include "Agg.hpp"
 #include "Helper.hpp"
+#include "Waiter.hpp"
 #include "config.h"
 
 namespace geopm
@@ -54,6 +55,13 @@ namespace geopm
     }
 
     PowerGovernorAgent::PowerGovernorAgent(PlatformIO &platform_io, const PlatformTopo &platform_topo, std::unique_ptr<PowerGovernor> power_gov)
+        : PowerGovernorAgent(platform_io, platform_topo, std::move(power_gov), nullptr)
+    {
+
+    }
+
+    PowerGovernorAgent::PowerGovernorAgent(PlatformIO &platform_io, const PlatformTopo &platform_topo, std::unique_ptr<PowerGovernor> power_gov,
+                                           std::unique_ptr<Waiter> waiter)
         : m_platform_io(platform_io)
         , m_platform_topo(platform_topo)
         , m_level(-1)
@@ -65,7 +73,6 @@ namespace geopm
         , m_tdp_power_setting(m_platform_io.read_signal("POWER_PACKAGE_TDP", GEOPM_DOMAIN_BOARD, 0))
         , m_power_gov(std::move(power_gov))
         , m_pio_idx(M_PLAT_NUM_SIGNAL)
-        , m_agg_func(M_NUM_SAMPLE)
         , m_num_children(0)
         , m_last_power_budget(NAN)
         , m_power_budget_changed(false)
@@ -75,10 +82,10 @@ namespace geopm
         , m_ascend_period(10)
         , m_min_num_converged(15)
         , m_adjusted_power(0.0)
-        , m_last_wait(GEOPM_TIME_REF)
         , M_WAIT_SEC(0.005)
+        , m_waiter(waiter ? std::move(waiter) : Waiter::make_unique(M_WAIT_SEC))
     {
-        geopm_time(&m_last_wait);
+
     }
 
     PowerGovernorAgent::~PowerGovernorAgent() = default;
@@ -103,11 +110,6 @@ namespace geopm
         else {
             m_num_children = fan_in[level - 1];
         }
-
-        // Setup sample aggregation for data going up the tree
-        m_agg_func[M_SAMPLE_POWER] = Agg::average;
-        m_agg_func[M_SAMPLE_IS_CONVERGED] = Agg::logical_and;
-        m_agg_func[M_SAMPLE_POWER_ENFORCED] = Agg::average;
     }
 
     void PowerGovernorAgent::init_platform_io(void)
@@ -216,7 +218,10 @@ namespace geopm
         // them up the tree.
         if (m_is_sample_stable && m_ascend_count == 0) {
             m_do_send_sample = true;
-            Agent::aggregate_sample(in_sample, m_agg_func, out_sample);
+            Agent::aggregate_sample<Agg::M_COLUMN_AVERAGE,     // M_SAMPLE_POWER
+                                    Agg::M_COLUMN_LOGICAL_AND, // M_SAMPLE_IS_CONVERGED
+                                    Agg::M_COLUMN_AVERAGE>     // M_SAMPLE_POWER_ENFORCED
+                (in_sample, m_sample_matrix, out_sample);
         }
         else {
             m_do_send_sample = false;
@@ -289,10 +294,7 @@ namespace geopm
 
     void PowerGovernorAgent::wait()
     {
-        while(geopm_time_since(&m_last_wait) < M_WAIT_SEC) {
-
-        }
-        geopm_time(&m_last_wait);
+        m_waiter->wait();
     }
 
     std::vector<std::pair<std::string, std::string> > PowerGovernorAgent::report_header(void) const
@@ -302,7 +304,7 @@ namespace geopm
 
     std::vector<std::pair<std::string, std::string> > PowerGovernorAgent::report_host(void) const
     {
-        return {};
+        return m_waiter->report();
     }
 
     std::map<uint64_t, std::vector<std::pair<std::string, std::string> > > PowerGovernorAgent::report_region(void) const
@@ -41,6 +41,7 @@
 
 namespace geopm
 {
+    class Waiter;
     class PlatformIO;
     class PlatformTopo;
     template <class type>
@@ -73,6 +74,10 @@ namespace geopm
             PowerGovernorAgent(PlatformIO &platform_io,
                                const PlatformTopo &platform_topo,
                                std::unique_ptr<PowerGovernor> power_gov);
+            PowerGovernorAgent(PlatformIO &platform_io,
+                               const PlatformTopo &platform_topo,
+                               std::unique_ptr<PowerGovernor> power_gov,
+                               std::unique_ptr<Waiter> waiter);
             virtual ~PowerGovernorAgent();
             void init(int level, const std::vector<int> &fan_in, bool is_level_root) override;
             void validate_policy(std::vector<double> &policy) const override;
@@ -111,18 +116,18 @@ namespace geopm
             double m_tdp_power_setting;
             std::unique_ptr<PowerGovernor> m_power_gov;
             std::vector<int> m_pio_idx;
-            std::vector<std::function<double(const std::vector<double>&)> > m_agg_func;
             int m_num_children;
             double m_last_power_budget;
             bool m_power_budget_changed;
             std::unique_ptr<CircularBuffer<double> > m_epoch_power_buf;
             std::vector<double> m_sample;
+            std::vector<double> m_sample_matrix;
             int m_ascend_count;
             const int m_ascend_period;
             const int m_min_num_converged;
             double m_adjusted_power;
-            geopm_time_s m_last_wait;
             const double M_WAIT_SEC;
+            std::unique_ptr<Waiter> m_waiter;
     };
 }
 
@@ -40,6 +40,7 @@
 #include <string.h>
 #include <errno.h>
 #include <limits.h>
+#include <sched.h>
 
 #include <algorithm>
 #include <iostream>
@@ -309,7 +310,8 @@ namespace geopm
             table_shm_key += "-" + std::to_string(m_rank);
             m_table_shmem = geopm::make_unique<SharedMemoryUserImp>(table_shm_key, m_timeout);
             m_table_shmem->unlink();
-            m_table = geopm::make_unique<ProfileTableImp>(m_table_shmem->size(), m_table_shmem->pointer());
+            m_table = ProfileTable::make_unique(m_table_shmem->size(), m_table_shmem->pointer(),
+                                                environment().do_profile_lock_free());
         }
 
         m_shm_comm->barrier();
@@ -333,6 +335,7 @@ namespace geopm
         geopm_time(&overhead_entry);
 #endif
 
+        flush_table();
         m_shm_comm->barrier();
         m_ctl_msg->step();  // M_SAMPLE_END
         m_ctl_msg->wait();  // M_SAMPLE_END
@@ -495,6 +498,11 @@ namespace geopm
             sample();
             m_scheduler->record_exit();
         }
+        else {
+            // Calls that are not sampled still publish any records
+            // held back from earlier samples
+            m_table->flush();
+        }
 
 #ifdef GEOPM_OVERHEAD
         m_overhead_time += geopm_time_since(&overhead_entry);
@@ -552,6 +560,21 @@ namespace geopm
 
     }
 
+    void ProfileImp::flush_table(void)
+    {
+        geopm_time_s start;
+        geopm_time(&start);
+        bool is_flushed = m_table->flush();
+        while (!is_flushed && geopm_time_since(&start) < m_timeout) {
+            sched_yield();
+            is_flushed = m_table->flush();
+        }
+        if (!is_flushed) {
+            throw Exception("ProfileImp::flush_table(): Timed out waiting for the controller to read profile records held back by a full table",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
     void ProfileImp::print(const std::string file_name)
     {
         if (!m_is_enabled || !m_table_shmem) {
@@ -267,6 +267,14 @@ namespace geopm
             /// information collected.  This sample is posted to the
             /// geopm::Controller through shared memory.
             void sample(void);
+            /// @brief Publish the profile records held back by the
+            ///        table because it was full.
+            ///
+            /// Called before the final handshake with the
+            /// geopm::Controller, while it still reads the table, so
+            /// that region exits and epochs are not lost.  Throws if
+            /// the records are not published within the timeout.
+            void flush_table(void);
             /// @brief Print profile report to a file.
             ///
             /// Writes a profile report to a file with the given
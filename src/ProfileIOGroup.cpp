@@ -38,6 +38,7 @@
 #include "EpochRuntimeRegulator.hpp"
 #include "RuntimeRegulator.hpp"
 #include "ProfileIOSample.hpp"
+#include "ProfileSampler.hpp"
 #include "Exception.hpp"
 #include "Agg.hpp"
 #include "geopm_hash.h"
@@ -76,7 +77,11 @@ namespace geopm
                            {plugin_name() + "::EPOCH_RUNTIME_NETWORK", M_SIGNAL_EPOCH_RUNTIME_NETWORK},
                            {"EPOCH_RUNTIME_NETWORK", M_SIGNAL_EPOCH_RUNTIME_NETWORK},
                            {plugin_name() + "::EPOCH_RUNTIME_IGNORE", M_SIGNAL_EPOCH_RUNTIME_IGNORE},
-                           {"EPOCH_RUNTIME_IGNORE", M_SIGNAL_EPOCH_RUNTIME_IGNORE}}
+                           {"EPOCH_RUNTIME_IGNORE", M_SIGNAL_EPOCH_RUNTIME_IGNORE},
+                           {plugin_name() + "::TABLE_COALESCE_COUNT", M_SIGNAL_TABLE_COALESCE_COUNT},
+                           {"TABLE_COALESCE_COUNT", M_SIGNAL_TABLE_COALESCE_COUNT},
+                           {plugin_name() + "::TABLE_DROP_COUNT", M_SIGNAL_TABLE_DROP_COUNT},
+                           {"TABLE_DROP_COUNT", M_SIGNAL_TABLE_DROP_COUNT}}
         , m_platform_topo(topo)
         , m_do_read(M_SIGNAL_MAX, false)
         , m_is_batch_read(false)
@@ -88,8 +93,11 @@ namespace geopm
         , m_epoch_runtime_ignore(topo.num_domain(GEOPM_DOMAIN_CPU), 0.0)
         , m_epoch_runtime(topo.num_domain(GEOPM_DOMAIN_CPU), 0.0)
         , m_epoch_count(topo.num_domain(GEOPM_DOMAIN_CPU), 0.0)
+        , m_table_coalesce_count(topo.num_domain(GEOPM_DOMAIN_CPU), 0.0)
+        , m_table_drop_count(topo.num_domain(GEOPM_DOMAIN_CPU), 0.0)
         , m_is_connected(false)
         , m_is_pushed(false)
+        , m_is_batch_start_set(false)
     {
 
     }
@@ -198,8 +206,10 @@ namespace geopm
             m_per_cpu_region_id = m_application_sampler.get_io_sample()->per_cpu_region_id();
         }
         if (m_do_read[M_SIGNAL_REGION_PROGRESS]) {
-            struct geopm_time_s read_time;
-            geopm_time(&read_time);
+            struct geopm_time_s read_time = m_batch_start;
+            if (!m_is_batch_start_set) {
+                geopm_time(&read_time);
+            }
             m_per_cpu_progress = m_application_sampler.get_io_sample()->per_cpu_progress(read_time);
         }
         if (m_do_read[M_SIGNAL_REGION_COUNT]) {
@@ -250,9 +260,27 @@ namespace geopm
                 m_epoch_runtime_ignore[cpu_idx] = per_rank_epoch_runtime_ignore[m_cpu_rank[cpu_idx]];
             }
         }
+        if (m_do_read[M_SIGNAL_TABLE_COALESCE_COUNT]) {
+            std::vector<uint64_t> per_rank_coalesce = m_application_sampler.get_sampler()->rank_num_coalesced();
+            for (size_t cpu_idx = 0; cpu_idx != m_cpu_rank.size(); ++cpu_idx) {
+                m_table_coalesce_count[cpu_idx] = per_rank_coalesce[m_cpu_rank[cpu_idx]];
+            }
+        }
+        if (m_do_read[M_SIGNAL_TABLE_DROP_COUNT]) {
+            std::vector<uint64_t> per_rank_drop = m_application_sampler.get_sampler()->rank_num_dropped();
+            for (size_t cpu_idx = 0; cpu_idx != m_cpu_rank.size(); ++cpu_idx) {
+                m_table_drop_count[cpu_idx] = per_rank_drop[m_cpu_rank[cpu_idx]];
+            }
+        }
         m_is_batch_read = true;
     }
 
+    void ProfileIOGroup::set_batch_time(const struct geopm_time_s &batch_time)
+    {
+        m_batch_start = batch_time;
+        m_is_batch_start_set = true;
+    }
+
     void ProfileIOGroup::write_batch(void)
     {
 
@@ -303,6 +331,12 @@ namespace geopm
             case M_SIGNAL_EPOCH_RUNTIME_IGNORE:
                 result = m_epoch_runtime_ignore[cpu_idx];
                 break;
+            case M_SIGNAL_TABLE_COALESCE_COUNT:
+                result = m_table_coalesce_count[cpu_idx];
+                break;
+            case M_SIGNAL_TABLE_DROP_COUNT:
+                result = m_table_drop_count[cpu_idx];
+                break;
             default:
 #ifdef GEOPM_DEBUG
                 throw Exception("ProfileIOGroup:sample(): Signal was pushed with an invalid signal type",
@@ -365,6 +399,12 @@ namespace geopm
             case M_SIGNAL_EPOCH_RUNTIME_IGNORE:
                 result = m_application_sampler.get_regulator()->last_epoch_runtime_ignore()[cpu_idx];
                 break;
+            case M_SIGNAL_TABLE_COALESCE_COUNT:
+                result = m_application_sampler.get_sampler()->rank_num_coalesced()[m_cpu_rank[cpu_idx]];
+                break;
+            case M_SIGNAL_TABLE_DROP_COUNT:
+                result = m_application_sampler.get_sampler()->rank_num_dropped()[m_cpu_rank[cpu_idx]];
+                break;
             default:
 #ifdef GEOPM_DEBUG
                 throw Exception("ProfileIOGroup:read_signal(): Invalid signal type bug check_signal did not throw",
@@ -415,7 +455,11 @@ namespace geopm
             {"EPOCH_RUNTIME_NETWORK", Agg::max},
             {"PROFILE::EPOCH_RUNTIME_NETWORK", Agg::max},
             {"EPOCH_RUNTIME_IGNORE", Agg::max},
-            {"PROFILE::EPOCH_RUNTIME_IGNORE", Agg::max}
+            {"PROFILE::EPOCH_RUNTIME_IGNORE", Agg::max},
+            {"TABLE_COALESCE_COUNT", Agg::max},
+            {"PROFILE::TABLE_COALESCE_COUNT", Agg::max},
+            {"TABLE_DROP_COUNT", Agg::max},
+            {"PROFILE::TABLE_DROP_COUNT", Agg::max}
         };
         auto it = fn_map.find(signal_name);
         if (it == fn_map.end()) {
@@ -449,7 +493,11 @@ namespace geopm
             {"EPOCH_RUNTIME_NETWORK", string_format_double},
             {"PROFILE::EPOCH_RUNTIME_NETWORK", string_format_double},
             {"EPOCH_RUNTIME_IGNORE", string_format_double},
-            {"PROFILE::EPOCH_RUNTIME_IGNORE", string_format_double}
+            {"PROFILE::EPOCH_RUNTIME_IGNORE", string_format_double},
+            {"TABLE_COALESCE_COUNT", string_format_integer},
+            {"PROFILE::TABLE_COALESCE_COUNT", string_format_integer},
+            {"TABLE_DROP_COUNT", string_format_integer},
+            {"PROFILE::TABLE_DROP_COUNT", string_format_integer}
         };
         auto it = fmt_map.find(signal_name);
         if (it == fmt_map.end()) {
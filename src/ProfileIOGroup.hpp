@@ -38,6 +38,7 @@
 #include <functional>
 
 #include "IOGroup.hpp"
+#include "geopm_time.h"
 
 namespace geopm
 {
@@ -61,6 +62,7 @@ namespace geopm
             int push_signal(const std::string &signal_name, int domain_type, int domain_idx) override;
             int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
             void read_batch(void) override;
+            void set_batch_time(const struct geopm_time_s &batch_time) override;
             void write_batch(void) override;
             double sample(int signal_idx) override;
             void adjust(int control_idx, double setting) override;
@@ -88,6 +90,8 @@ namespace geopm
                 M_SIGNAL_EPOCH_RUNTIME,
                 M_SIGNAL_EPOCH_RUNTIME_NETWORK,
                 M_SIGNAL_EPOCH_RUNTIME_IGNORE,
+                M_SIGNAL_TABLE_COALESCE_COUNT,
+                M_SIGNAL_TABLE_DROP_COUNT,
                 M_SIGNAL_MAX,
             };
             struct m_signal_config {
@@ -115,10 +119,14 @@ namespace geopm
             std::vector<double> m_epoch_runtime_ignore;
             std::vector<double> m_epoch_runtime;
             std::vector<double> m_epoch_count;
+            std::vector<double> m_table_coalesce_count;
+            std::vector<double> m_table_drop_count;
             std::map<int, int> m_rid_idx; // map from runtime signal index to the region id signal it uses
             std::vector<int> m_cpu_rank;
             bool m_is_connected;
             bool m_is_pushed;
+            bool m_is_batch_start_set;
+            struct geopm_time_s m_batch_start;
     };
 }
 
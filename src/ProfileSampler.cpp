@@ -278,17 +278,42 @@ namespace geopm
         return m_cache;
     }
 
+    std::vector<uint64_t> ProfileSamplerImp::rank_num_coalesced(void) const
+    {
+        // m_rank_sampler is in descending rank order
+        std::vector<uint64_t> result(m_rank_per_node, 0);
+        auto result_it = result.rbegin();
+        for (auto it = m_rank_sampler.begin(); it != m_rank_sampler.end(); ++it, ++result_it) {
+            *result_it = (*it)->num_coalesced();
+        }
+        return result;
+    }
+
+    std::vector<uint64_t> ProfileSamplerImp::rank_num_dropped(void) const
+    {
+        // m_rank_sampler is in descending rank order
+        std::vector<uint64_t> result(m_rank_per_node, 0);
+        auto result_it = result.rbegin();
+        for (auto it = m_rank_sampler.begin(); it != m_rank_sampler.end(); ++it, ++result_it) {
+            *result_it = (*it)->num_dropped();
+        }
+        return result;
+    }
+
     ProfileRankSamplerImp::ProfileRankSamplerImp(const std::string shm_key, size_t table_size)
         : m_table_shmem(nullptr)
         , m_table(nullptr)
         , m_region_entry(GEOPM_INVALID_PROF_MSG)
         , m_is_name_finished(false)
+        , m_num_coalesced(0)
+        , m_num_dropped(0)
     {
         std::string key_path("/dev/shm/" + shm_key);
         (void)unlink(key_path.c_str());
         errno = 0; // Ignore errors from the unlink call.
         m_table_shmem = geopm::make_unique<SharedMemoryImp>(shm_key, table_size);
-        m_table = geopm::make_unique<ProfileTableImp>(m_table_shmem->size(), m_table_shmem->pointer());
+        m_table = ProfileTable::make_unique(m_table_shmem->size(), m_table_shmem->pointer(),
+                                            environment().do_profile_lock_free());
     }
 
     ProfileRankSamplerImp::~ProfileRankSamplerImp()
@@ -306,6 +331,18 @@ namespace geopm
     void ProfileRankSamplerImp::sample(std::vector<std::pair<uint64_t, struct geopm_prof_message_s> >::iterator content_begin, size_t &length)
     {
         m_table->dump(content_begin, length);
+        m_num_coalesced = m_table->num_coalesced();
+        m_num_dropped = m_table->num_dropped();
+    }
+
+    uint64_t ProfileRankSamplerImp::num_coalesced(void) const
+    {
+        return m_num_coalesced;
+    }
+
+    uint64_t ProfileRankSamplerImp::num_dropped(void) const
+    {
+        return m_num_dropped;
     }
 
     bool ProfileRankSamplerImp::name_fill(std::set<std::string> &name_set)
@@ -80,6 +80,14 @@ namespace geopm
             virtual bool name_fill(std::set<std::string> &name_set) = 0;
             virtual void report_name(std::string &report_str) const = 0;
             virtual void profile_name(std::string &prof_str) const = 0;
+            /// @brief Number of progress records coalesced by the
+            ///        rank's table when it was full, as of the last
+            ///        call to sample().
+            virtual uint64_t num_coalesced(void) const = 0;
+            /// @brief Number of progress records dropped by the
+            ///        rank's table when it was full, as of the last
+            ///        call to sample().
+            virtual uint64_t num_dropped(void) const = 0;
     };
 
     class Comm;
@@ -161,6 +169,16 @@ namespace geopm
             /// @brief Signal application of failure.
             virtual void abort(void) = 0;
             virtual std::vector<struct geopm_prof_message_s> sample_cache(void) = 0;
+            /// @brief Number of progress records coalesced by each
+            ///        rank's table because it was full.
+            ///
+            /// @return Vector indexed by the node local rank.
+            virtual std::vector<uint64_t> rank_num_coalesced(void) const = 0;
+            /// @brief Number of progress records dropped by each
+            ///        rank's table because it was full.
+            ///
+            /// @return Vector indexed by the node local rank.
+            virtual std::vector<uint64_t> rank_num_dropped(void) const = 0;
     };
 
 
@@ -213,6 +231,8 @@ namespace geopm
             bool name_fill(std::set<std::string> &name_set) override;
             void report_name(std::string &report_str) const override;
             void profile_name(std::string &prof_str) const override;
+            uint64_t num_coalesced(void) const override;
+            uint64_t num_dropped(void) const override;
             std::shared_ptr<ProfileThreadTable> tprof_table(void) const;
         private:
             /// Holds the shared memory region used for sampling from the
@@ -235,6 +255,10 @@ namespace geopm
             /// Holds the status of the name_fill operation.
             bool m_is_name_finished;
             int rank_per_node;
+            /// Table overflow counts read at the last sample, the
+            /// table buffer is reused for names at shutdown.
+            uint64_t m_num_coalesced;
+            uint64_t m_num_dropped;
     };
 
     class PlatformTopo;
@@ -290,6 +314,8 @@ namespace geopm
             void controller_ready(void) override;
             void abort(void) override;
             std::vector<struct geopm_prof_message_s> sample_cache(void) override;
+            std::vector<uint64_t> rank_num_coalesced(void) const override;
+            std::vector<uint64_t> rank_num_dropped(void) const override;
         private:
             /// Holds the shared memory region used for application coordination
             /// and control.
@@ -40,18 +40,97 @@
 
 #include <algorithm>
 #include <string>
+#include <set>
+#include <vector>
+#include <new>
 
 #include "geopm_internal.h"
 #include "geopm_hash.h"
 #include "Exception.hpp"
+#include "Helper.hpp"
 
 #include "config.h"
 
 
 namespace geopm
 {
+    static bool is_boundary(const struct geopm_prof_message_s &value)
+    {
+        return value.progress == 0.0 || value.progress == 1.0;
+    }
+
+    /// Remove all but the latest progress record for each region
+    /// between region boundaries and return the number removed.
+    static size_t coalesce_progress(struct geopm_prof_message_s *table, size_t &curr_size)
+    {
+        // Walk backward so that the latest progress record is kept
+        std::vector<bool> is_keep(curr_size, true);
+        std::set<uint64_t> progress_region;
+        for (size_t idx = curr_size; idx != 0; --idx) {
+            const struct geopm_prof_message_s &value = table[idx - 1];
+            if (is_boundary(value)) {
+                progress_region.erase(value.region_id);
+            }
+            else if (!progress_region.insert(value.region_id).second) {
+                is_keep[idx - 1] = false;
+            }
+        }
+        size_t out_idx = 0;
+        for (size_t in_idx = 0; in_idx != curr_size; ++in_idx) {
+            if (is_keep[in_idx]) {
+                table[out_idx] = table[in_idx];
+                ++out_idx;
+            }
+        }
+        size_t result = curr_size - out_idx;
+        curr_size = out_idx;
+        return result;
+    }
+
+    /// Apply the overflow policy to a full table: coalesce progress
+    /// records, and if that does not free a slot, drop the oldest
+    /// progress record.  Returns false if the table holds only
+    /// region boundary records.
+    static bool make_room(struct geopm_prof_message_s *table, size_t &curr_size,
+                          uint64_t &num_coalesced, uint64_t &num_dropped)
+    {
+        size_t orig_size = curr_size;
+        num_coalesced += coalesce_progress(table, curr_size);
+        if (curr_size == orig_size) {
+            auto drop_it = std::find_if(table, table + curr_size,
+                                        [](const struct geopm_prof_message_s &value) {
+                                            return !is_boundary(value);
+                                        });
+            if (drop_it != table + curr_size) {
+                std::copy(drop_it + 1, table + curr_size, drop_it);
+                --curr_size;
+                ++num_dropped;
+            }
+        }
+        return curr_size < orig_size;
+    }
+
+    std::unique_ptr<ProfileTable> ProfileTable::make_unique(size_t size, void *buffer, bool is_lock_free)
+    {
+        std::unique_ptr<ProfileTable> result;
+        if (is_lock_free) {
+            result = geopm::make_unique<ProfileRingTableImp>(size, buffer);
+        }
+        else {
+            result = geopm::make_unique<ProfileTableImp>(size, buffer);
+        }
+        return result;
+    }
+
     ProfileTableImp::ProfileTableImp(size_t size, void *buffer)
-        : m_buffer_size(size)
+        : ProfileTableImp(size, buffer, true)
+    {
+
+    }
+
+    ProfileTableImp::ProfileTableImp(size_t size, void *buffer, bool is_locked)
+        : m_table_value(nullptr)
+        , m_buffer_size(size)
         , m_table((struct table_s *)buffer)
         , m_key_map_lock(PTHREAD_MUTEX_INITIALIZER)
         , m_is_pshared(true)
@@ -60,6 +139,10 @@ namespace geopm
         if (buffer == NULL) {
             throw Exception("ProfileTableImp: Buffer pointer is NULL", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        if (!is_locked) {
+            // Derived class is responsible for the buffer layout
+            return;
+        }
         if (size < (sizeof(struct table_s) + 4 * sizeof(struct geopm_prof_message_s))) {
             throw Exception("ProfileTableImp: table size too small",
                             GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
@@ -69,6 +152,8 @@ namespace geopm
         memset(buffer, 0, size);
         m_table->max_size = (m_buffer_size - sizeof(struct table_s)) / sizeof(struct geopm_prof_message_s);
         m_table->curr_size = 0;
+        m_table->num_coalesced = 0;
+        m_table->num_dropped = 0;
 
         // set up lock
         pthread_mutexattr_t lock_attr;
@@ -110,13 +195,21 @@ namespace geopm
         }
         if (!is_inserted) {
             // check for overflow
-            if (m_table->curr_size >= m_table->max_size) {
-                throw Exception("ProfileTableImp::insert(): table overflowed.",
-                                GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+            if (m_table->curr_size >= m_table->max_size &&
+                !make_room(m_table_value, m_table->curr_size,
+                           m_table->num_coalesced, m_table->num_dropped)) {
+                if (is_boundary(value)) {
+                    (void)pthread_mutex_unlock(&(m_table->lock));
+                    throw Exception("ProfileTableImp::insert(): table overflowed with region entry and exit records.",
+                                    GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+                // Table holds only boundaries, discard the new progress record
+                ++m_table->num_dropped;
+            }
+            else {
+                m_table_value[m_table->curr_size] = value;
+                ++m_table->curr_size;
             }
-
-            m_table_value[m_table->curr_size] = value;
-            ++m_table->curr_size;
         }
         err = pthread_mutex_unlock(&(m_table->lock));
         if (err) {
@@ -206,6 +299,41 @@ namespace geopm
         }
     }
 
+    uint64_t ProfileTableImp::num_coalesced(void) const
+    {
+        int err = pthread_mutex_lock(&(m_table->lock));
+        if (err) {
+            throw Exception("ProfileTableImp::num_coalesced(): pthread_mutex_lock()", err, __FILE__, __LINE__);
+        }
+        uint64_t result = m_table->num_coalesced;
+        err = pthread_mutex_unlock(&(m_table->lock));
+        if (err) {
+            throw Exception("ProfileTableImp::num_coalesced(): pthread_mutex_unlock()", err, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    uint64_t ProfileTableImp::num_dropped(void) const
+    {
+        int err = pthread_mutex_lock(&(m_table->lock));
+        if (err) {
+            throw Exception("ProfileTableImp::num_dropped(): pthread_mutex_lock()", err, __FILE__, __LINE__);
+        }
+        uint64_t result = m_table->num_dropped;
+        err = pthread_mutex_unlock(&(m_table->lock));
+        if (err) {
+            throw Exception("ProfileTableImp::num_dropped(): pthread_mutex_unlock()", err, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    bool ProfileTableImp::flush(void)
+    {
+        // Records are coalesced or dropped within the table, none are
+        // held back by the producer
+        return true;
+    }
+
     bool ProfileTableImp::name_fill(size_t header_offset)
     {
         bool result = false;
@@ -254,4 +382,141 @@ namespace geopm
         }
         return result;
     }
+
+    ProfileRingTableImp::ProfileRingTableImp(size_t size, void *buffer)
+        : ProfileTableImp(size, buffer, false)
+        , m_ring(nullptr)
+        , m_ring_value(nullptr)
+        , m_head_cache(0)
+        , m_backlog_size(0)
+        , m_num_coalesced(0)
+        , m_num_dropped(0)
+    {
+        if (size < (sizeof(struct ring_s) + 4 * sizeof(struct geopm_prof_message_s))) {
+            throw Exception("ProfileRingTableImp: table size too small",
+                            GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        memset(buffer, 0, size);
+        m_ring = new (buffer) ring_s;
+        m_ring->head.store(0);
+        m_ring->tail.store(0);
+        m_ring->num_coalesced.store(0);
+        m_ring->num_dropped.store(0);
+        m_ring->max_size = (size - sizeof(struct ring_s)) / sizeof(struct geopm_prof_message_s);
+        m_ring_value = (struct geopm_prof_message_s *)((char *)buffer + sizeof(struct ring_s));
+    }
+
+    void ProfileRingTableImp::insert(const struct geopm_prof_message_s &value)
+    {
+        // Records held back by an earlier overflow are published first
+        if (m_backlog_size == 0 || flush()) {
+            // Only the producer writes the tail, so a relaxed load is sufficient
+            uint64_t tail = m_ring->tail.load(std::memory_order_relaxed);
+            if (num_free(tail, 1) != 0) {
+                m_ring_value[tail % m_ring->max_size] = value;
+                // Publish the record to the consumer
+                m_ring->tail.store(tail + 1, std::memory_order_release);
+                return;
+            }
+        }
+        backlog_insert(value);
+    }
+
+    bool ProfileRingTableImp::flush(void)
+    {
+        if (m_backlog_size != 0) {
+            uint64_t tail = m_ring->tail.load(std::memory_order_relaxed);
+            uint64_t num_copy = std::min<uint64_t>(num_free(tail, m_backlog_size), m_backlog_size);
+            for (uint64_t idx = 0; idx != num_copy; ++idx) {
+                m_ring_value[(tail + idx) % m_ring->max_size] = m_backlog[idx];
+            }
+            if (num_copy != 0) {
+                std::copy(m_backlog.begin() + num_copy, m_backlog.begin() + m_backlog_size,
+                          m_backlog.begin());
+                m_backlog_size -= num_copy;
+                m_ring->tail.store(tail + num_copy, std::memory_order_release);
+            }
+        }
+        return m_backlog_size == 0;
+    }
+
+    uint64_t ProfileRingTableImp::num_free(uint64_t tail, uint64_t num_request)
+    {
+        uint64_t result = m_ring->max_size - (tail - m_head_cache);
+        if (result < num_request) {
+            m_head_cache = m_ring->head.load(std::memory_order_acquire);
+            result = m_ring->max_size - (tail - m_head_cache);
+        }
+        return result;
+    }
+
+    void ProfileRingTableImp::backlog_insert(const struct geopm_prof_message_s &value)
+    {
+        if (m_backlog.empty()) {
+            m_backlog.resize(m_ring->max_size);
+        }
+        bool is_inserted = false;
+        if (m_backlog_size != 0 && !is_boundary(value)) {
+            struct geopm_prof_message_s &last = m_backlog[m_backlog_size - 1];
+            if (last.region_id == value.region_id && !is_boundary(last)) {
+                last = value;
+                ++m_num_coalesced;
+                is_inserted = true;
+            }
+        }
+        if (!is_inserted) {
+            if (m_backlog_size >= m_backlog.size() &&
+                !make_room(m_backlog.data(), m_backlog_size, m_num_coalesced, m_num_dropped)) {
+                if (is_boundary(value)) {
+                    throw Exception("ProfileRingTableImp::insert(): table overflowed with region entry and exit records.",
+                                    GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+                }
+                ++m_num_dropped;
+            }
+            else {
+                m_backlog[m_backlog_size] = value;
+                ++m_backlog_size;
+            }
+        }
+        m_ring->num_coalesced.store(m_num_coalesced, std::memory_order_relaxed);
+        m_ring->num_dropped.store(m_num_dropped, std::memory_order_relaxed);
+    }
+
+    size_t ProfileRingTableImp::capacity(void) const
+    {
+        return m_ring->max_size;
+    }
+
+    size_t ProfileRingTableImp::size(void) const
+    {
+        uint64_t head = m_ring->head.load(std::memory_order_acquire);
+        uint64_t tail = m_ring->tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    void ProfileRingTableImp::dump(std::vector<std::pair<uint64_t, struct geopm_prof_message_s> >::iterator content, size_t &length)
+    {
+        // Only the consumer writes the head, so a relaxed load is sufficient
+        uint64_t head = m_ring->head.load(std::memory_order_relaxed);
+        uint64_t tail = m_ring->tail.load(std::memory_order_acquire);
+        for (uint64_t idx = head; idx != tail; ++idx) {
+            const struct geopm_prof_message_s &value = m_ring_value[idx % m_ring->max_size];
+            content->first = value.region_id;
+            content->second = value;
+            ++content;
+        }
+        length = tail - head;
+        // Release the slots back to the producer
+        m_ring->head.store(tail, std::memory_order_release);
+    }
+
+    uint64_t ProfileRingTableImp::num_coalesced(void) const
+    {
+        return m_ring->num_coalesced.load(std::memory_order_relaxed);
+    }
+
+    uint64_t ProfileRingTableImp::num_dropped(void) const
+    {
+        return m_ring->num_dropped.load(std::memory_order_relaxed);
+    }
 }
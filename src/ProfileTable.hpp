@@ -36,6 +36,9 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <string>
+#include <atomic>
+#include <memory>
 
 #include "geopm_internal.h"
 
@@ -88,6 +91,16 @@ namespace geopm
             /// hashed to the same entry in the table, the entry will
             /// be emptied of it's current data which will be lost.
             ///
+            /// If the table is full when a value is inserted, the
+            /// progress records held in the table are first coalesced
+            /// so that only the latest progress record for each
+            /// region is kept.  If this does not free any space, the
+            /// oldest record that is not a region entry or exit is
+            /// dropped.  A geopm::Exception is thrown only if the
+            /// table is entirely filled with region entry and exit
+            /// records and the value is also an entry or exit.  See
+            /// num_coalesced() and num_dropped().
+            ///
             /// @param [in] value Entry that is to be inserted into
             ///        the table.
             ///
@@ -167,6 +180,40 @@ namespace geopm
             /// @param [out] name Set of names read from output of the
             ///        producer's call to name_fill().
             virtual bool name_set(size_t header_offset, std::set<std::string> &name) = 0;
+            /// @brief Number of progress records removed from the
+            ///        table by coalescing when the table was full.
+            ///
+            /// @return Count of coalesced records since the table
+            ///         was created.
+            virtual uint64_t num_coalesced(void) const = 0;
+            /// @brief Number of progress records discarded because
+            ///        the table was full.
+            ///
+            /// @return Count of dropped records since the table was
+            ///         created.
+            virtual uint64_t num_dropped(void) const = 0;
+            /// @brief Publish records that were held back by the
+            ///        producer because the table was full, as far as
+            ///        there is space for them.  Called by the
+            ///        producer when it may not insert again soon,
+            ///        e.g. before the application shuts down.
+            ///
+            /// @return True if no records remain held back.
+            virtual bool flush(void) = 0;
+            /// @brief Returns a unique_ptr to a concrete object
+            ///        constructed using the underlying implementation
+            ///        selected by the is_lock_free parameter.
+            ///
+            /// @param [in] size The length of the buffer in bytes.
+            ///
+            /// @param [in] buffer Pointer to beginning of virtual
+            ///        address range used for storing the data.
+            ///
+            /// @param [in] is_lock_free If true a single producer
+            ///        single consumer ring buffer is used, otherwise
+            ///        the table is protected by a process shared
+            ///        mutex.
+            static std::unique_ptr<ProfileTable> make_unique(size_t size, void *buffer, bool is_lock_free);
     };
 
     class ProfileTableImp : public ProfileTable
@@ -193,12 +240,29 @@ namespace geopm
             void dump(std::vector<std::pair<uint64_t, struct geopm_prof_message_s> >::iterator content, size_t &length) override;
             bool name_fill(size_t header_offset) override;
             bool name_set(size_t header_offset, std::set<std::string> &name) override;
+            uint64_t num_coalesced(void) const override;
+            uint64_t num_dropped(void) const override;
+            bool flush(void) override;
+        protected:
+            /// @brief Constructor used by derived classes that
+            ///        provide an alternate layout of the buffer.
+            ///
+            /// @param size [in] The length of the buffer in bytes.
+            ///
+            /// @param buffer [in] Pointer to beginning of virtual
+            ///        address range used for storing the data.
+            ///
+            /// @param is_locked [in] If false the mutex protected
+            ///        table is not created in the buffer.
+            ProfileTableImp(size_t size, void *buffer, bool is_locked);
         private:
              /// @brief structure to hold state for a single table entry.
             struct table_s {
                 pthread_mutex_t lock;
                 size_t max_size;
                 size_t curr_size;
+                uint64_t num_coalesced;
+                uint64_t num_dropped;
                 struct geopm_prof_message_s *value;
             };
             struct geopm_prof_message_s *m_table_value;
@@ -210,5 +274,90 @@ namespace geopm
             bool m_is_pshared;
             std::map<const std::string, uint64_t>::iterator m_key_map_last;
     };
+
+    /// @brief ProfileTable implementation based on a lock free
+    ///        single producer single consumer ring buffer.
+    ///
+    /// The application rank is the only producer and the controller
+    /// is the only consumer of a ProfileTable, so the mutex used by
+    /// the ProfileTableImp is not required to synchronize access.
+    /// The head index is only written by the consumer and the tail
+    /// index is only written by the producer.  Each index is kept on
+    /// a separate cache line so that the producer and the consumer
+    /// do not contend for the same line.  Unlike the
+    /// ProfileTableImp, progress messages are not coalesced within
+    /// the ring since a published record may be read by the consumer
+    /// at any time.  When the ring is full, records are held in a
+    /// backlog that is private to the producer and the overflow
+    /// policy described in ProfileTable::insert() is applied to the
+    /// backlog.  The backlog is published by the next call to
+    /// insert() or flush() once the consumer has made space, and the
+    /// geopm::Profile flushes it before the application shuts down.
+    class ProfileRingTableImp : public ProfileTableImp
+    {
+        public:
+            /// @brief Constructor for the ProfileRingTableImp.
+            ///
+            /// @param size [in] The length of the buffer in bytes.
+            ///
+            /// @param buffer [in] Pointer to beginning of virtual
+            ///        address range used for storing the data.
+            ProfileRingTableImp(size_t size, void *buffer);
+            /// ProfileRingTableImp destructor, virtual.
+            virtual ~ProfileRingTableImp() = default;
+            void insert(const struct geopm_prof_message_s &value) override;
+            size_t capacity(void) const override;
+            size_t size(void) const override;
+            void dump(std::vector<std::pair<uint64_t, struct geopm_prof_message_s> >::iterator content, size_t &length) override;
+            uint64_t num_coalesced(void) const override;
+            uint64_t num_dropped(void) const override;
+            /// @brief Publish as much of the producer's backlog to
+            ///        the ring as there is space for.
+            ///
+            /// @return True if the backlog is empty.
+            bool flush(void) override;
+        private:
+            /// @brief Number of free slots in the ring, re-reads the
+            ///        head index only if the cached value does not
+            ///        provide enough space.
+            ///
+            /// @param [in] tail Current value of the tail index.
+            ///
+            /// @param [in] num_request Number of slots required.
+            uint64_t num_free(uint64_t tail, uint64_t num_request);
+            /// @brief Insert a value into the producer's backlog.
+            void backlog_insert(const struct geopm_prof_message_s &value);
+            /// @brief Header for the ring buffer stored at the
+            ///        beginning of the buffer.  Each member is
+            ///        aligned to a 64 byte cache line.
+            struct ring_s {
+                /// @brief Index of the next record to be read,
+                ///        written only by the consumer.
+                alignas(64) std::atomic<uint64_t> head;
+                /// @brief Index of the next record to be written,
+                ///        written only by the producer.
+                alignas(64) std::atomic<uint64_t> tail;
+                /// @brief Number of coalesced records, written
+                ///        only by the producer.
+                std::atomic<uint64_t> num_coalesced;
+                /// @brief Number of dropped records, written only
+                ///        by the producer.
+                std::atomic<uint64_t> num_dropped;
+                /// @brief Number of records in the ring.
+                alignas(64) uint64_t max_size;
+            };
+            struct ring_s *m_ring;
+            struct geopm_prof_message_s *m_ring_value;
+            /// @brief Producer's last observed value of the head
+            ///        index, avoids reading the consumer's cache
+            ///        line on every insert.
+            uint64_t m_head_cache;
+            /// @brief Records that did not fit in the ring, in
+            ///        insertion order.  Allocated on first overflow.
+            std::vector<struct geopm_prof_message_s> m_backlog;
+            size_t m_backlog_size;
+            uint64_t m_num_coalesced;
+            uint64_t m_num_dropped;
+    };
 }
 #endif
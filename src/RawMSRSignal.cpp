@@ -85,4 +85,9 @@ namespace geopm
         // convert to double
         return geopm_field_to_signal(m_msrio->read_msr(m_cpu, m_offset));
     }
+
+    int RawMSRSignal::batch_idx(void) const
+    {
+        return m_data_idx;
+    }
 }
@@ -57,6 +57,9 @@ namespace geopm
             void setup_batch(void) override;
             double sample(void) override;
             double read(void) const override;
+            /// @brief Index of the MSR within the MSRIO batch, or -1
+            ///        if setup_batch() has not been called.
+            int batch_idx(void) const;
         private:
             /// MSRIO object shared by all MSR signals in the same
             /// batch.  This object should outlive all other data in
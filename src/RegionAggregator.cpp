@@ -61,6 +61,8 @@ namespace geopm
 
     RegionAggregatorImp::RegionAggregatorImp(PlatformIO &platio)
         : m_platform_io(platio)
+        , m_epoch_count_idx(-1)
+        , m_region_table(M_MIN_TABLE_SIZE, -1)
     {
 
     }
@@ -75,7 +77,17 @@ namespace geopm
                                                int domain_idx)
     {
         int signal_idx = m_platform_io.push_signal(signal_name, domain_type, domain_idx);
-        m_region_hash_idx[signal_idx] = m_platform_io.push_signal("REGION_HASH", domain_type, domain_idx);
+        int region_hash_idx = m_platform_io.push_signal("REGION_HASH", domain_type, domain_idx);
+        if (signal_idx >= (int)m_signal_pos.size()) {
+            m_signal_pos.resize(signal_idx + 1, -1);
+        }
+        if (m_signal_pos[signal_idx] == -1) {
+            m_signal_pos[signal_idx] = m_signal.size();
+            m_signal.push_back({signal_idx, region_hash_idx, -1, false, {}, {}});
+        }
+        else {
+            m_signal[m_signal_pos[signal_idx]].region_hash_idx = region_hash_idx;
+        }
         return signal_idx;
     }
 
@@ -85,72 +97,127 @@ namespace geopm
             throw Exception("RegionAggregatorImp::sample_total(): Invalid signal index",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
-        if (m_region_hash_idx.find(signal_idx) == m_region_hash_idx.end()) {
+        if (signal_idx >= (int)m_signal_pos.size() ||
+            m_signal_pos[signal_idx] == -1) {
             throw Exception("RegionAggregatorImp::sample_total(): Cannot call sample_total "
                             "for signal index not pushed with push_signal_total.",
                             GEOPM_ERROR_INVALID, __FILE__, __LINE__);
         }
+        m_signal_s &signal = m_signal[m_signal_pos[signal_idx]];
         double current_value = 0.0;
-        uint64_t curr_hash = m_platform_io.sample(m_region_hash_idx.at(signal_idx));
-        m_tracked_region_hash.insert(curr_hash);
-        // Look up the data for this combination of signal and region ID
-        auto idx = std::make_pair(signal_idx, region_hash);
-        auto data_it = m_region_sample_data.find(idx);
-        if (data_it != m_region_sample_data.end()) {
-            auto &data = data_it->second;
-            if(!std::isnan(data.last_entry_value)) {
-                // if the region is Epoch, calculate the total now
-                if(region_hash == GEOPM_REGION_HASH_EPOCH) {
-                    data.total = m_platform_io.sample(signal_idx) - data.last_entry_value;
-                }
+        int curr_region = region_insert(m_platform_io.sample(signal.region_hash_idx));
+        if (region_hash == GEOPM_REGION_HASH_EPOCH) {
+            if (signal.is_epoch_started) {
+                // for the Epoch, calculate the total now
+                signal.epoch.total = m_platform_io.sample(signal_idx) - signal.epoch.last_entry_value;
+                current_value = signal.epoch.total;
+            }
+        }
+        else {
+            // Look up the data for this combination of signal and region ID
+            int region = region_find(region_hash);
+            if (region != -1 && region < (int)signal.region.size()) {
+                const m_region_data_s &data = signal.region[region];
                 // if currently in this region, add current value to total
-                else if (region_hash == curr_hash) {
+                if (region == curr_region && !std::isnan(data.last_entry_value)) {
                     current_value += m_platform_io.sample(signal_idx) - data.last_entry_value;
                 }
+                current_value += data.total;
             }
-            current_value += data.total;
         }
         return current_value;
     }
 
     void RegionAggregatorImp::read_batch(void)
     {
-        for (const auto &it : m_region_hash_idx) {
-            double value = m_platform_io.sample(it.first);
-            const uint64_t region_hash = m_platform_io.sample(it.second);
-            m_tracked_region_hash.insert(region_hash);
-
-            // Wait for the first Epoch and insert 1 sample at the beginning of time
-            auto epoch_idx = std::make_pair(it.first, GEOPM_REGION_HASH_EPOCH);
-            double curr_epoch_count = m_platform_io.sample(m_epoch_count_idx);
-            if (m_region_sample_data.find(epoch_idx) == m_region_sample_data.end() &&
-                curr_epoch_count > -1) {
-                m_region_sample_data[epoch_idx].last_entry_value = value;
-            }
-
-            // first time sampling this signal
-            if (m_last_region_hash.find(it.first) == m_last_region_hash.end()) {
-                m_last_region_hash[it.first] = region_hash;
-                // set start value for first region to be recording this signal
-                m_region_sample_data[std::make_pair(it.first, region_hash)].last_entry_value = value;
+        if (m_signal.empty()) {
+            return;
+        }
+        // Wait for the first Epoch and insert 1 sample at the beginning of time
+        bool is_epoch = m_platform_io.sample(m_epoch_count_idx) > -1;
+        for (auto &signal : m_signal) {
+            double value = m_platform_io.sample(signal.signal_idx);
+            int region = region_insert(m_platform_io.sample(signal.region_hash_idx));
+            if (is_epoch && !signal.is_epoch_started) {
+                signal.epoch.last_entry_value = value;
+                signal.is_epoch_started = true;
             }
-            else {
-                const uint64_t last_hash = m_last_region_hash[it.first];
-                // region boundary
-                if (region_hash != last_hash) {
-                    // add entry to new region
-                    m_region_sample_data[std::make_pair(it.first, region_hash)].last_entry_value = value;
+            // first time sampling this signal or region boundary
+            if (region != signal.last_region) {
+                // add entry to new region
+                region_data(signal, region).last_entry_value = value;
+                if (signal.last_region != -1) {
                     // update total for previous region
-                    double prev_total = value - m_region_sample_data.at(std::make_pair(it.first, last_hash)).last_entry_value;
-                    m_region_sample_data[std::make_pair(it.first, last_hash)].total += prev_total;
-                    m_last_region_hash[it.first] = region_hash;
+                    m_region_data_s &last = signal.region[signal.last_region];
+                    last.total += value - last.last_entry_value;
                 }
+                signal.last_region = region;
             }
         }
     }
 
     std::set<uint64_t> RegionAggregatorImp::tracked_region_hash(void) const
     {
-        return m_tracked_region_hash;
+        return std::set<uint64_t>(m_region_hash.begin(), m_region_hash.end());
+    }
+
+    size_t RegionAggregatorImp::region_bucket(uint64_t region_hash) const
+    {
+        // Mix the bits so that hashes differing only in the high bits
+        // do not collide
+        region_hash ^= region_hash >> 33;
+        region_hash *= 0xff51afd7ed558ccdULL;
+        region_hash ^= region_hash >> 33;
+        return region_hash & (m_region_table.size() - 1);
+    }
+
+    int RegionAggregatorImp::region_find(uint64_t region_hash) const
+    {
+        size_t mask = m_region_table.size() - 1;
+        for (size_t bucket = region_bucket(region_hash);
+             m_region_table[bucket] != -1;
+             bucket = (bucket + 1) & mask) {
+            if (m_region_hash[m_region_table[bucket]] == region_hash) {
+                return m_region_table[bucket];
+            }
+        }
+        return -1;
+    }
+
+    int RegionAggregatorImp::region_insert(uint64_t region_hash)
+    {
+        size_t mask = m_region_table.size() - 1;
+        size_t bucket = region_bucket(region_hash);
+        for (; m_region_table[bucket] != -1; bucket = (bucket + 1) & mask) {
+            if (m_region_hash[m_region_table[bucket]] == region_hash) {
+                return m_region_table[bucket];
+            }
+        }
+        int result = m_region_hash.size();
+        m_region_hash.push_back(region_hash);
+        if (m_region_hash.size() * 2 > m_region_table.size()) {
+            // grow and rehash every region, including the new one
+            m_region_table.assign(m_region_table.size() * 2, -1);
+            mask = m_region_table.size() - 1;
+            for (size_t region = 0; region < m_region_hash.size(); ++region) {
+                bucket = region_bucket(m_region_hash[region]);
+                while (m_region_table[bucket] != -1) {
+                    bucket = (bucket + 1) & mask;
+                }
+                m_region_table[bucket] = region;
+            }
+        }
+        else {
+            m_region_table[bucket] = result;
+        }
+        return result;
+    }
+
+    RegionAggregatorImp::m_region_data_s &RegionAggregatorImp::region_data(m_signal_s &signal, int region)
+    {
+        if (region >= (int)signal.region.size()) {
+            signal.region.resize(m_region_hash.size());
+        }
+        return signal.region[region];
     }
 }
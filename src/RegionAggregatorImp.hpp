@@ -35,7 +35,7 @@
 
 #include <cmath>
 
-#include <map>
+#include <vector>
 
 #include "RegionAggregator.hpp"
 
@@ -56,18 +56,47 @@ namespace geopm
             void read_batch(void) override;
             std::set<uint64_t> tracked_region_hash(void) const override;
         private:
-            PlatformIO &m_platform_io;
-            std::map<int, int> m_region_hash_idx;
             struct m_region_data_s
             {
                 double total = 0.0;
                 double last_entry_value = NAN;
             };
-            // Data for each combination of signal index and region hash
-            std::map<std::pair<int, uint64_t>, m_region_data_s> m_region_sample_data;
-            std::map<int, uint64_t> m_last_region_hash;
+            struct m_signal_s
+            {
+                int signal_idx;
+                int region_hash_idx;
+                // Position in m_region_hash of the region observed
+                // at the last read_batch(), or -1 before the first
+                int last_region;
+                bool is_epoch_started;
+                m_region_data_s epoch;
+                // Data for each region, indexed by position in
+                // m_region_hash and grown on demand
+                std::vector<m_region_data_s> region;
+            };
+            /// @brief Position of a region hash in m_region_hash,
+            ///        adding it if it has not been observed.
+            int region_insert(uint64_t region_hash);
+            /// @brief Position of a region hash in m_region_hash, or
+            ///        -1 if it has not been observed.
+            int region_find(uint64_t region_hash) const;
+            size_t region_bucket(uint64_t region_hash) const;
+            m_region_data_s &region_data(m_signal_s &signal, int region);
+
+            static constexpr size_t M_MIN_TABLE_SIZE = 64;
+            PlatformIO &m_platform_io;
             int m_epoch_count_idx;
-            std::set<uint64_t> m_tracked_region_hash;
+            std::vector<m_signal_s> m_signal;
+            // Position in m_signal for each PlatformIO signal index,
+            // or -1 for signals not pushed with push_signal_total()
+            std::vector<int> m_signal_pos;
+            // Every region hash observed, in order of observation
+            std::vector<uint64_t> m_region_hash;
+            // Open addressing table with linear probing that maps a
+            // region hash to its position in m_region_hash; empty
+            // buckets hold -1.  The size is a power of two and is
+            // kept at least twice the number of regions.
+            std::vector<int> m_region_table;
     };
 }
 
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ReportModel.hpp"
+
+#include <math.h>
+#include <stdio.h>
+
+#include <sstream>
+#include <iomanip>
+
+#include "contrib/json11/json11.hpp"
+
+#include "NumberFormat.hpp"
+#include "Exception.hpp"
+#include "geopm_internal.h"
+
+using json11::Json;
+
+namespace geopm
+{
+    ReportModel::field_s::field_s(const std::string &name, double value, int type)
+        : name(name)
+        , type(type)
+        , value(value)
+    {
+
+    }
+
+    ReportModel::field_s::field_s(const std::string &name, const std::string &text)
+        : name(name)
+        , type(M_FIELD_STRING)
+        , value(NAN)
+        , text(text)
+    {
+
+    }
+
+    static void text_fields(const std::vector<ReportModel::field_s> &field, std::ostream &os)
+    {
+        for (const auto &ff : field) {
+            os << "    " << ff.name << ": ";
+            switch (ff.type) {
+                case ReportModel::M_FIELD_INTEGER:
+                    os << (long long)ff.value;
+                    break;
+                case ReportModel::M_FIELD_STRING:
+                    os << ff.text;
+                    break;
+                default:
+                    os << ff.value;
+                    break;
+            }
+            os << std::endl;
+        }
+    }
+
+    std::string ReportModel::text_header(const header_s &header)
+    {
+        std::ostringstream os;
+        os << "##### geopm " << header.version << " #####" << std::endl;
+        os << "Start Time: " << header.start_time << std::endl;
+        os << "Profile: " << header.profile << std::endl;
+        os << "Agent: " << header.agent << std::endl;
+        os << "Policy: " << header.policy << std::endl;
+        if (!header.fan_out.empty()) {
+            os << "Tree Fan Out: ";
+            for (auto it = header.fan_out.begin(); it != header.fan_out.end(); ++it) {
+                os << (it != header.fan_out.begin() ? ", " : "") << *it;
+            }
+            os << std::endl;
+        }
+        for (const auto &kv : header.agent_header) {
+            os << kv.first << ": " << kv.second << std::endl;
+        }
+        return os.str();
+    }
+
+    std::string ReportModel::text_host(const host_s &host)
+    {
+        std::ostringstream os;
+        os << "\nHost: " << host.host << std::endl;
+        for (const auto &kv : host.agent_host) {
+            os << kv.first << ": " << kv.second << std::endl;
+        }
+        for (const auto &region : host.region) {
+            if (GEOPM_REGION_HASH_EPOCH != region.hash) {
+                os << "Region " << region.name << " (0x" << std::hex
+                   << std::setfill('0') << std::setw(16)
+                   << region.hash << std::dec << "):"
+                   << std::setfill('\0') << std::setw(0)
+                   << std::endl;
+            }
+            else {
+                os << "Epoch Totals:" << std::endl;
+            }
+            text_fields(region.field, os);
+        }
+        os << "Application Totals:" << std::endl;
+        text_fields(host.app_totals, os);
+        return os.str();
+    }
+
+    static void json_string(const std::string &str, std::string &out)
+    {
+        Json(str).dump(out);
+    }
+
+    static void json_fields(const std::vector<ReportModel::field_s> &field, std::string &out)
+    {
+        char buffer[NumberFormat::M_MAX_SIZE];
+        out += "[";
+        for (auto it = field.begin(); it != field.end(); ++it) {
+            if (it != field.begin()) {
+                out += ", ";
+            }
+            out += "{\"name\": ";
+            json_string(it->name, out);
+            out += ", \"value\": ";
+            if (it->type == ReportModel::M_FIELD_STRING) {
+                json_string(it->text, out);
+            }
+            else if (!isfinite(it->value)) {
+                out += "null";
+            }
+            else if (it->type == ReportModel::M_FIELD_INTEGER) {
+                out.append(buffer, NumberFormat::format_integer(it->value, buffer));
+            }
+            else {
+                out.append(buffer, NumberFormat::format_double(it->value, buffer));
+            }
+            if (it->type == ReportModel::M_FIELD_INTEGER) {
+                out += ", \"type\": \"integer\"";
+            }
+            out += "}";
+        }
+        out += "]";
+    }
+
+    static void json_pairs(const std::vector<std::pair<std::string, std::string> > &pairs, std::string &out)
+    {
+        out += "[";
+        for (auto it = pairs.begin(); it != pairs.end(); ++it) {
+            if (it != pairs.begin()) {
+                out += ", ";
+            }
+            out += "{\"name\": ";
+            json_string(it->first, out);
+            out += ", \"value\": ";
+            json_string(it->second, out);
+            out += "}";
+        }
+        out += "]";
+    }
+
+    std::string ReportModel::json_header(const header_s &header)
+    {
+        std::string out = "{\"geopm_version\": ";
+        json_string(header.version, out);
+        out += ", \"start_time\": ";
+        json_string(header.start_time, out);
+        out += ", \"profile\": ";
+        json_string(header.profile, out);
+        out += ", \"agent\": ";
+        json_string(header.agent, out);
+        out += ", \"policy\": ";
+        json_string(header.policy, out);
+        out += ", \"fan_out\": [";
+        for (auto it = header.fan_out.begin(); it != header.fan_out.end(); ++it) {
+            out += (it != header.fan_out.begin() ? ", " : "") + std::to_string(*it);
+        }
+        out += "], \"agent_header\": ";
+        json_pairs(header.agent_header, out);
+        out += "}";
+        return out;
+    }
+
+    std::string ReportModel::json_host(const host_s &host)
+    {
+        std::string out = "{\"host\": ";
+        json_string(host.host, out);
+        out += ", \"agent\": ";
+        json_pairs(host.agent_host, out);
+        out += ", \"regions\": [";
+        for (auto it = host.region.begin(); it != host.region.end(); ++it) {
+            if (it != host.region.begin()) {
+                out += ", ";
+            }
+            char hash_str[NumberFormat::M_MAX_SIZE];
+            snprintf(hash_str, sizeof(hash_str), "0x%016llx", (unsigned long long)it->hash);
+            out += "{\"name\": ";
+            json_string(it->name, out);
+            out += ", \"hash\": \"";
+            out += hash_str;
+            out += "\", \"fields\": ";
+            json_fields(it->field, out);
+            out += "}";
+        }
+        out += "], \"application_totals\": ";
+        json_fields(host.app_totals, out);
+        out += "}";
+        return out;
+    }
+
+    std::string ReportModel::json_report(const std::string &header_json,
+                                         const std::string &host_list_json)
+    {
+        return "{\"header\": " + header_json + ",\n\"hosts\": [" + host_list_json + "]}\n";
+    }
+
+    static const Json &load_member(const Json &obj, const std::string &key, Json::Type type)
+    {
+        const Json &result = obj[key];
+        if (result.type() != type) {
+            throw Exception("ReportModel::load_json(): missing or malformed report entry: \"" + key + "\"",
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    static std::vector<ReportModel::field_s> load_fields(const Json &arr)
+    {
+        std::vector<ReportModel::field_s> result;
+        for (const auto &field_obj : arr.array_items()) {
+            const std::string &name = load_member(field_obj, "name", Json::STRING).string_value();
+            const Json &value = field_obj["value"];
+            int type = field_obj["type"].string_value() == "integer" ?
+                       ReportModel::M_FIELD_INTEGER : ReportModel::M_FIELD_DOUBLE;
+            switch (value.type()) {
+                case Json::NUMBER:
+                    result.emplace_back(name, value.number_value(), type);
+                    break;
+                case Json::STRING:
+                    result.emplace_back(name, value.string_value());
+                    break;
+                case Json::NUL:
+                    result.emplace_back(name, NAN, type);
+                    break;
+                default:
+                    throw Exception("ReportModel::load_json(): report field is not a number or string: \"" + name + "\"",
+                                    GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+        }
+        return result;
+    }
+
+    static std::vector<std::pair<std::string, std::string> > load_pairs(const Json &arr)
+    {
+        std::vector<std::pair<std::string, std::string> > result;
+        for (const auto &pair_obj : arr.array_items()) {
+            const std::string &name = load_member(pair_obj, "name", Json::STRING).string_value();
+            const Json &value = pair_obj["value"];
+            if (!value.is_string()) {
+                throw Exception("ReportModel::load_json(): agent report value is not a string: \"" + name + "\"",
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            result.emplace_back(name, value.string_value());
+        }
+        return result;
+    }
+
+    void ReportModel::load_json(const std::string &json_str,
+                                header_s &header,
+                                std::vector<host_s> &host)
+    {
+        std::string err;
+        Json root = Json::parse(json_str, err);
+        if (!err.empty() || !root.is_object()) {
+            throw Exception("ReportModel::load_json(): report is not valid JSON: " + err,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        const Json &header_obj = load_member(root, "header", Json::OBJECT);
+        header.version = load_member(header_obj, "geopm_version", Json::STRING).string_value();
+        header.start_time = load_member(header_obj, "start_time", Json::STRING).string_value();
+        header.profile = load_member(header_obj, "profile", Json::STRING).string_value();
+        header.agent = load_member(header_obj, "agent", Json::STRING).string_value();
+        header.policy = load_member(header_obj, "policy", Json::STRING).string_value();
+        // "fan_out" is absent from reports written before it was added
+        header.fan_out.clear();
+        for (const auto &size : header_obj["fan_out"].array_items()) {
+            if (!size.is_number()) {
+                throw Exception("ReportModel::load_json(): tree fan out is not a number",
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            header.fan_out.push_back(size.int_value());
+        }
+        header.agent_header = load_pairs(load_member(header_obj, "agent_header", Json::ARRAY));
+
+        host.clear();
+        for (const auto &host_obj : load_member(root, "hosts", Json::ARRAY).array_items()) {
+            host_s curr;
+            curr.host = load_member(host_obj, "host", Json::STRING).string_value();
+            curr.agent_host = load_pairs(load_member(host_obj, "agent", Json::ARRAY));
+            for (const auto &region_obj : load_member(host_obj, "regions", Json::ARRAY).array_items()) {
+                region_s region;
+                region.name = load_member(region_obj, "name", Json::STRING).string_value();
+                std::string hash_str = load_member(region_obj, "hash", Json::STRING).string_value();
+                size_t pos = 0;
+                try {
+                    region.hash = std::stoull(hash_str, &pos, 16);
+                }
+                catch (const std::exception &) {
+                    pos = 0;
+                }
+                if (pos == 0 || pos != hash_str.size()) {
+                    throw Exception("ReportModel::load_json(): invalid region hash: \"" + hash_str + "\"",
+                                    GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+                }
+                region.field = load_fields(load_member(region_obj, "fields", Json::ARRAY));
+                curr.region.push_back(region);
+            }
+            curr.app_totals = load_fields(load_member(host_obj, "application_totals", Json::ARRAY));
+            host.push_back(curr);
+        }
+    }
+}
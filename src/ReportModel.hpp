@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef REPORTMODEL_HPP_INCLUDE
+#define REPORTMODEL_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace geopm
+{
+    /// @brief Intermediate representation of the report written by
+    ///        the Reporter.
+    ///
+    /// The Reporter fills in one header_s for the job and one host_s
+    /// per node, and both the text report and the structured JSON
+    /// report are printed from these.  The JSON report has the form:
+    ///
+    ///     {"header": {"geopm_version": ..., "start_time": ...,
+    ///                 "profile": ..., "agent": ..., "policy": ...,
+    ///                 "fan_out": [...], "agent_header": [...]},
+    ///      "hosts": [{"host": ..., "agent": [...],
+    ///                 "regions": [{"name": ..., "hash": "0x...",
+    ///                              "fields": [...]}, ...],
+    ///                 "application_totals": [...]}, ...]}
+    ///
+    /// where the epoch totals are the region named "epoch".  The
+    /// agent values and the fields are arrays of
+    /// {"name": ..., "value": ...} objects in report order.
+    /// Numeric values are JSON numbers printed with the shortest
+    /// representation that reads back exactly, values that are not
+    /// finite are null, and integer fields carry
+    /// "type": "integer".
+    class ReportModel
+    {
+        public:
+            enum m_field_type_e {
+                M_FIELD_DOUBLE,
+                M_FIELD_INTEGER,
+                M_FIELD_STRING,
+            };
+            struct field_s {
+                field_s(const std::string &name, double value, int type = M_FIELD_DOUBLE);
+                field_s(const std::string &name, const std::string &text);
+                std::string name;
+                int type;
+                double value;
+                std::string text;
+            };
+            struct region_s {
+                std::string name;
+                uint64_t hash;
+                std::vector<field_s> field;
+            };
+            struct header_s {
+                std::string version;
+                std::string start_time;
+                std::string profile;
+                std::string agent;
+                std::string policy;
+                /// Number of children at each level of the tree
+                /// from the root to the leaves when the shape was
+                /// chosen by GEOPM_TREE_AUTO_FAN_OUT, otherwise
+                /// empty
+                std::vector<int> fan_out;
+                std::vector<std::pair<std::string, std::string> > agent_header;
+            };
+            struct host_s {
+                std::string host;
+                std::vector<std::pair<std::string, std::string> > agent_host;
+                std::vector<region_s> region;
+                std::vector<field_s> app_totals;
+            };
+            /// @brief Format the header of the text report.
+            static std::string text_header(const header_s &header);
+            /// @brief Format the section of the text report for one
+            ///        host.
+            static std::string text_host(const host_s &host);
+            /// @brief Format the "header" object of the JSON report.
+            static std::string json_header(const header_s &header);
+            /// @brief Format one element of the "hosts" array of the
+            ///        JSON report.
+            static std::string json_host(const host_s &host);
+            /// @brief Assemble a JSON report from the output of
+            ///        json_header() and a comma separated list of
+            ///        json_host() outputs.
+            static std::string json_report(const std::string &header_json,
+                                           const std::string &host_list_json);
+            /// @brief Parse a JSON report.  The fields and agent
+            ///        values are loaded in report order with their
+            ///        types, so the text report printed from the
+            ///        result matches the original.
+            /// @param [in] json_str Contents of a JSON report.
+            /// @param [out] header Report header.
+            /// @param [out] host One entry for each host in the
+            ///        report.
+            static void load_json(const std::string &json_str,
+                                  header_s &header,
+                                  std::vector<host_s> &host);
+    };
+}
+
+#endif
@@ -55,6 +55,7 @@
 #include "ApplicationIO.hpp"
 #include "Comm.hpp"
 #include "TreeComm.hpp"
+#include "ReportModel.hpp"
 #include "Exception.hpp"
 #include "Helper.hpp"
 #include "geopm.h"
@@ -78,7 +79,10 @@ namespace geopm
                       std::unique_ptr<RegionAggregator>(new RegionAggregatorImp),
                       environment().report_signals(),
                       environment().policy(),
-                      environment().do_endpoint())
+                      environment().do_endpoint(),
+                      environment().report_mode(),
+                      environment().do_tree_auto_fan_out(),
+                      environment().do_tree_sparse())
     {
 
     }
@@ -91,7 +95,10 @@ namespace geopm
                              std::unique_ptr<RegionAggregator> agg,
                              const std::string &env_signals,
                              const std::string &policy_path,
-                             bool do_endpoint)
+                             bool do_endpoint,
+                             const std::string &report_mode,
+                             bool do_tree_auto_fan_out,
+                             bool do_tree_sparse)
         : m_start_time(start_time)
         , m_report_name(report_name)
         , m_platform_io(platform_io)
@@ -101,6 +108,11 @@ namespace geopm
         , m_env_signals(env_signals)
         , m_policy_path(policy_path)
         , m_do_endpoint(do_endpoint)
+        , m_do_tree_auto_fan_out(do_tree_auto_fan_out)
+        , m_do_tree_sparse(do_tree_sparse)
+        , m_is_per_node(false)
+        , m_is_summary(false)
+        , m_is_json(false)
         , m_app_energy_pkg_idx(-1)
         , m_app_energy_dram_idx(-1)
         , m_app_time_signal_idx(-1)
@@ -108,7 +120,29 @@ namespace geopm
         , m_start_energy_dram(NAN)
         , m_start_time_signal(NAN)
     {
+        parse_report_mode(report_mode);
+    }
 
+    void ReporterImp::parse_report_mode(const std::string &report_mode)
+    {
+        if (report_mode.empty()) {
+            return;
+        }
+        for (const auto &option : string_split(report_mode, ",")) {
+            if (option == "per-node") {
+                m_is_per_node = true;
+            }
+            else if (option == "summary") {
+                m_is_summary = true;
+            }
+            else if (option == "json") {
+                m_is_json = true;
+            }
+            else if (option != "gather") {
+                throw Exception("ReporterImp::parse_report_mode(): invalid report mode option: \"" + option + "\"",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+        }
     }
 
     void ReporterImp::init(void)
@@ -187,11 +221,15 @@ namespace geopm
             if (!master_report.good()) {
                 throw Exception("Failed to open report file", GEOPM_ERROR_INVALID, __FILE__, __LINE__);
             }
-            // make header
-            master_report << "##### geopm " << geopm_version() << " #####" << std::endl;
-            master_report << "Start Time: " << m_start_time << std::endl;
-            master_report << "Profile: " << application_io.profile_name() << std::endl;
-            master_report << "Agent: " << agent_name << std::endl;
+        }
+        // make header; per-node report files each carry a copy
+        ReportModel::header_s header_model;
+        std::string header;
+        if (!rank || m_is_per_node) {
+            header_model.version = geopm_version();
+            header_model.start_time = m_start_time;
+            header_model.profile = application_io.profile_name();
+            header_model.agent = agent_name;
             std::string policy_str = "{}";
             if (m_do_endpoint) {
                 policy_str = "DYNAMIC";
@@ -204,17 +242,22 @@ namespace geopm
                     policy_str = m_policy_path;
                 }
             }
-            master_report << "Policy: " << policy_str << std::endl;
-            for (const auto &kv : agent_report_header) {
-                master_report << kv.first << ": " << kv.second << std::endl;
+            header_model.policy = policy_str;
+            if (m_do_tree_auto_fan_out) {
+                for (int level = tree_comm.root_level() - 1; level >= 0; --level) {
+                    header_model.fan_out.push_back(tree_comm.level_size(level));
+                }
             }
+            header_model.agent_header = agent_report_header;
+            header = ReportModel::text_header(header_model);
         }
-        // per-host report
-        std::ostringstream report;
-        report << "\nHost: " << hostname() << std::endl;
-        for (const auto &kv : agent_host_report) {
-            report << kv.first << ": " << kv.second << std::endl;
+        if (!rank) {
+            master_report << header;
         }
+        // per-host report
+        ReportModel::host_s host_model;
+        host_model.host = hostname();
+        host_model.agent_host = agent_host_report;
         // vector of region data, in descending order by runtime
         struct region_info {
                 std::string name;
@@ -256,102 +299,288 @@ namespace geopm
                                   application_io.total_epoch_runtime(),
                                   application_io.total_epoch_count()});
 
+        std::map<uint64_t, std::vector<double> > region_metric;
         for (const auto &region : region_ordered) {
-            if (GEOPM_REGION_HASH_EPOCH != region.hash) {
 #ifdef GEOPM_DEBUG
-                if (GEOPM_REGION_HASH_INVALID == region.hash) {
-                    throw Exception("ReporterImp::generate(): Invalid hash value detected.",
-                                    GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
-                }
-#endif
-                report << "Region " << region.name << " (0x" << std::hex
-                       << std::setfill('0') << std::setw(16)
-                       << region.hash << std::dec << "):"
-                       << std::setfill('\0') << std::setw(0)
-                       << std::endl;
-            }
-            else {
-                report << "Epoch Totals:"
-                       << std::endl;
+            if (GEOPM_REGION_HASH_INVALID == region.hash) {
+                throw Exception("ReporterImp::generate(): Invalid hash value detected.",
+                                GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
             }
+#endif
+            host_model.region.push_back({region.name, region.hash, {}});
+            std::vector<ReportModel::field_s> &field = host_model.region.back().field;
             double sync_rt = m_region_agg->sample_total(m_region_bulk_runtime_idx, region.hash);
             double package_energy = m_region_agg->sample_total(m_energy_pkg_idx, region.hash);
+            double dram_energy = m_region_agg->sample_total(m_energy_dram_idx, region.hash);
             double power = sync_rt == 0 ? 0 : package_energy / sync_rt;
-            report << "    runtime (sec): " << region.per_rank_avg_runtime << std::endl;
-            report << "    sync-runtime (sec): " << sync_rt << std::endl;
-            report << "    package-energy (joules): " << package_energy << std::endl;
-            report << "    dram-energy (joules): " << m_region_agg->sample_total(m_energy_dram_idx, region.hash) << std::endl;
-            report << "    power (watts): " << power << std::endl;
+            field.emplace_back("runtime (sec)", region.per_rank_avg_runtime);
+            field.emplace_back("sync-runtime (sec)", sync_rt);
+            field.emplace_back("package-energy (joules)", package_energy);
+            field.emplace_back("dram-energy (joules)", dram_energy);
+            field.emplace_back("power (watts)", power);
             double numer = m_region_agg->sample_total(m_clk_core_idx, region.hash);
             double denom = m_region_agg->sample_total(m_clk_ref_idx, region.hash);
             double freq = denom != 0 ? 100.0 * numer / denom : 0.0;
-            report << "    frequency (%): " << freq << std::endl;
-            report << "    frequency (Hz): " << freq / 100.0 * m_platform_io.read_signal("CPUINFO::FREQ_STICKER", GEOPM_DOMAIN_BOARD, 0) << std::endl;
+            field.emplace_back("frequency (%)", freq);
+            field.emplace_back("frequency (Hz)", freq / 100.0 * m_platform_io.read_signal("CPUINFO::FREQ_STICKER", GEOPM_DOMAIN_BOARD, 0));
             double network_time = (region.hash == GEOPM_REGION_HASH_EPOCH) ?
                                    application_io.total_epoch_runtime_network() :
                                    application_io.total_region_runtime_mpi(region.hash);
-            report << "    network-time (sec): " << network_time << std::endl;
-            report << "    count: " << region.count << std::endl;
+            field.emplace_back("network-time (sec)", network_time);
+            field.emplace_back("count", region.count, ReportModel::M_FIELD_INTEGER);
+            if (m_is_summary) {
+                std::vector<double> &metric = region_metric[region.hash];
+                metric.resize(M_NUM_SUMMARY_METRIC);
+                metric[M_SUMMARY_RUNTIME] = region.per_rank_avg_runtime;
+                metric[M_SUMMARY_SYNC_RUNTIME] = sync_rt;
+                metric[M_SUMMARY_ENERGY_PKG] = package_energy;
+                metric[M_SUMMARY_ENERGY_DRAM] = dram_energy;
+                metric[M_SUMMARY_POWER] = power;
+                metric[M_SUMMARY_FREQUENCY] = freq;
+                metric[M_SUMMARY_NETWORK_TIME] = network_time;
+                metric[M_SUMMARY_COUNT] = region.count;
+            }
             for (const auto &env_it : m_env_signal_name_idx) {
-                report << "    " << env_it.first << ": " << m_region_agg->sample_total(env_it.second, region.hash) << std::endl;
+                field.emplace_back(env_it.first, m_region_agg->sample_total(env_it.second, region.hash));
             }
             const auto &it = agent_region_report.find(region.hash);
             if (it != agent_region_report.end()) {
                 for (const auto &kv : agent_region_report.at(region.hash)) {
-                    report << "    " << kv.first << ": " << kv.second << std::endl;
+                    field.emplace_back(kv.first, kv.second);
                 }
             }
         }
         // extra runtimes for epoch region
-        report << "    epoch-runtime-ignore (sec): " << application_io.total_epoch_runtime_ignore() << std::endl;
+        host_model.region.back().field.emplace_back("epoch-runtime-ignore (sec)", application_io.total_epoch_runtime_ignore());
 
         double total_runtime = m_platform_io.sample(m_app_time_signal_idx) - m_start_time_signal;
         double app_energy_pkg = m_platform_io.sample(m_app_energy_pkg_idx) - m_start_energy_pkg;
         double avg_power = total_runtime == 0 ? 0 : app_energy_pkg / total_runtime;
         double app_energy_dram = m_platform_io.sample(m_app_energy_dram_idx) - m_start_energy_dram;
-        report << "Application Totals:" << std::endl
-               << "    runtime (sec): " << total_runtime << std::endl
-               << "    package-energy (joules): " << app_energy_pkg << std::endl
-               << "    dram-energy (joules): " << app_energy_dram << std::endl
-               << "    power (watts): " << avg_power << std::endl
-               << "    network-time (sec): " << application_io.total_app_runtime_mpi() << std::endl
-               << "    ignore-time (sec): " << application_io.total_app_runtime_ignore() << std::endl;
-
-        std::string max_memory = get_max_memory();
-        report << "    geopmctl memory HWM: " << max_memory << std::endl;
-        report << "    geopmctl network BW (B/sec): " << tree_comm.overhead_send() / total_runtime << std::endl;
-
-        // aggregate reports from every node
-        report.seekp(0, std::ios::end);
-        size_t buffer_size = (size_t) report.tellp();
-        report.seekp(0, std::ios::beg);
+        double app_network_time = application_io.total_app_runtime_mpi();
+        std::vector<ReportModel::field_s> &app_totals = host_model.app_totals;
+        app_totals.emplace_back("runtime (sec)", total_runtime);
+        app_totals.emplace_back("package-energy (joules)", app_energy_pkg);
+        app_totals.emplace_back("dram-energy (joules)", app_energy_dram);
+        app_totals.emplace_back("power (watts)", avg_power);
+        app_totals.emplace_back("network-time (sec)", app_network_time);
+        app_totals.emplace_back("ignore-time (sec)", application_io.total_app_runtime_ignore());
+        // Largest per-rank profile table overflow counts on the node
+        std::vector<uint64_t> table_coalesced = application_io.profile_table_coalesced();
+        std::vector<uint64_t> table_dropped = application_io.profile_table_dropped();
+        app_totals.emplace_back("profile-table-coalesced (max per-rank)",
+                                table_coalesced.empty() ? 0 : *std::max_element(table_coalesced.begin(), table_coalesced.end()),
+                                ReportModel::M_FIELD_INTEGER);
+        app_totals.emplace_back("profile-table-dropped (max per-rank)",
+                                table_dropped.empty() ? 0 : *std::max_element(table_dropped.begin(), table_dropped.end()),
+                                ReportModel::M_FIELD_INTEGER);
+        app_totals.emplace_back("geopmctl memory HWM", get_max_memory());
+        if (m_do_tree_sparse) {
+            // Reported ahead of the network BW, which ends the
+            // totals for existing parsers
+            app_totals.emplace_back("geopmctl network saved (B/sec)", tree_comm.overhead_saved() / total_runtime);
+        }
+        app_totals.emplace_back("geopmctl network BW (B/sec)", tree_comm.overhead_send() / total_runtime);
+        std::string report = ReportModel::text_host(host_model);
+        std::string report_json;
+        if (m_is_json) {
+            // hosts after the first are prefixed with the separator
+            // of the JSON array so that the gathered text can be
+            // written as-is
+            report_json = (rank && !m_is_per_node ? ",\n" : "") + ReportModel::json_host(host_model);
+        }
+
+        std::string summary_str;
+        if (m_is_summary) {
+            std::vector<std::pair<std::string, uint64_t> > region_name_hash;
+            for (const auto &region : region_ordered) {
+                region_name_hash.emplace_back(region.name, region.hash);
+            }
+            std::vector<double> app_metric(M_NUM_SUMMARY_METRIC, 0.0);
+            app_metric[M_SUMMARY_RUNTIME] = total_runtime;
+            app_metric[M_SUMMARY_ENERGY_PKG] = app_energy_pkg;
+            app_metric[M_SUMMARY_ENERGY_DRAM] = app_energy_dram;
+            app_metric[M_SUMMARY_POWER] = avg_power;
+            app_metric[M_SUMMARY_NETWORK_TIME] = app_network_time;
+            // reduce before any per-node file is opened so that a
+            // failure on one node cannot leave the others blocked
+            summary_str = summary(region_name_hash, region_metric, app_metric, *comm, rank);
+        }
+
+        if (m_is_per_node) {
+            std::string host_report_name = report_name + "-" + hostname();
+            std::ofstream host_report(host_report_name);
+            if (!host_report.good()) {
+                throw Exception("ReporterImp::generate(): Failed to open report file: " + host_report_name,
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            host_report << header << report << std::endl;
+            if (m_is_json) {
+                write_json(host_report_name + ".json", header_model, report_json);
+            }
+            if (!rank) {
+                master_report << std::endl;
+            }
+        }
+        else {
+            // aggregate reports from every node
+            int num_rank = comm->num_rank();
+            std::string all_report = gather_report(report, *comm, rank, num_rank);
+            std::string all_report_json;
+            if (m_is_json) {
+                all_report_json = gather_report(report_json, *comm, rank, num_rank);
+            }
+            if (!rank) {
+                master_report << all_report;
+                master_report << std::endl;
+                if (m_is_json) {
+                    write_json(report_name + ".json", header_model, all_report_json);
+                }
+            }
+        }
+
+        if (!rank) {
+            master_report << summary_str;
+            master_report.close();
+        }
+    }
+
+    std::string ReporterImp::gather_report(const std::string &report, const Comm &comm,
+                                           int rank, int num_rank) const
+    {
+        size_t buffer_size = report.size();
         std::vector<char> report_buffer;
-        std::vector<size_t> buffer_size_array;
-        std::vector<off_t> buffer_displacement;
-        int num_ranks = comm->num_rank();
-        buffer_size_array.resize(num_ranks);
-        buffer_displacement.resize(num_ranks);
-        comm->gather(&buffer_size, sizeof(size_t), buffer_size_array.data(),
-                     sizeof(size_t), 0);
+        std::vector<size_t> buffer_size_array(num_rank);
+        std::vector<off_t> buffer_displacement(num_rank);
+        comm.gather(&buffer_size, sizeof(size_t), buffer_size_array.data(),
+                    sizeof(size_t), 0);
 
         if (!rank) {
-            int full_report_size = std::accumulate(buffer_size_array.begin(), buffer_size_array.end(), 0) + 1;
+            size_t full_report_size = std::accumulate(buffer_size_array.begin(), buffer_size_array.end(), (size_t)0) + 1;
             report_buffer.resize(full_report_size);
             buffer_displacement[0] = 0;
-            for (int i = 1; i < num_ranks; ++i) {
+            for (int i = 1; i < num_rank; ++i) {
                 buffer_displacement[i] = buffer_displacement[i-1] + buffer_size_array[i-1];
             }
         }
 
-        comm->gatherv((void *) (report.str().data()), sizeof(char) * buffer_size,
-                      (void *) report_buffer.data(), buffer_size_array, buffer_displacement, 0);
+        comm.gatherv((void *) (report.data()), sizeof(char) * buffer_size,
+                     (void *) report_buffer.data(), buffer_size_array, buffer_displacement, 0);
 
+        std::string result;
         if (!rank) {
             report_buffer.back() = '\0';
-            master_report << report_buffer.data();
-            master_report << std::endl;
-            master_report.close();
+            result = report_buffer.data();
+        }
+        return result;
+    }
+
+    void ReporterImp::write_json(const std::string &path,
+                                 const ReportModel::header_s &header_model,
+                                 const std::string &host_list_json) const
+    {
+        std::ofstream json_report(path);
+        if (!json_report.good()) {
+            throw Exception("ReporterImp::generate(): Failed to open report file: " + path,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        json_report << ReportModel::json_report(ReportModel::json_header(header_model),
+                                                host_list_json);
+    }
+
+    std::string ReporterImp::summary(const std::vector<std::pair<std::string, uint64_t> > &region_name_hash,
+                                     const std::map<uint64_t, std::vector<double> > &region_metric,
+                                     const std::vector<double> &app_metric,
+                                     const Comm &comm,
+                                     int rank) const
+    {
+        static const std::vector<std::string> metric_name = {
+            "runtime (sec)",
+            "sync-runtime (sec)",
+            "package-energy (joules)",
+            "dram-energy (joules)",
+            "power (watts)",
+            "frequency (%)",
+            "network-time (sec)",
+            "count",
+        };
+        // the root controller's regions select the rows of the summary
+        uint64_t num_region = region_name_hash.size();
+        comm.broadcast(&num_region, sizeof(num_region), 0);
+        std::vector<uint64_t> region_hash(num_region);
+        if (!rank) {
+            for (size_t region_idx = 0; region_idx < num_region; ++region_idx) {
+                region_hash[region_idx] = region_name_hash[region_idx].second;
+            }
+        }
+        comm.broadcast(region_hash.data(), num_region * sizeof(uint64_t), 0);
+
+        // Each row holds the metrics followed by a count of the
+        // nodes that observed the region.  Nodes that did not
+        // observe a region leave the identity of each reduction.
+        // The minimum is computed as the maximum of the negation.
+        const size_t num_row = num_region + 1;
+        const size_t sum_width = M_NUM_SUMMARY_METRIC + 1;
+        std::vector<double> local_sum(num_row * sum_width, 0.0);
+        std::vector<double> local_max(num_row * M_NUM_SUMMARY_METRIC, -INFINITY);
+        std::vector<double> local_neg_min(num_row * M_NUM_SUMMARY_METRIC, -INFINITY);
+        for (size_t row_idx = 0; row_idx < num_row; ++row_idx) {
+            const std::vector<double> *metric = &app_metric;
+            if (row_idx < num_region) {
+                auto it = region_metric.find(region_hash[row_idx]);
+                metric = it == region_metric.end() ? nullptr : &(it->second);
+            }
+            if (metric != nullptr) {
+                for (int metric_idx = 0; metric_idx < M_NUM_SUMMARY_METRIC; ++metric_idx) {
+                    double value = metric->at(metric_idx);
+                    local_sum[row_idx * sum_width + metric_idx] = value;
+                    local_max[row_idx * M_NUM_SUMMARY_METRIC + metric_idx] = value;
+                    local_neg_min[row_idx * M_NUM_SUMMARY_METRIC + metric_idx] = -value;
+                }
+                local_sum[row_idx * sum_width + M_NUM_SUMMARY_METRIC] = 1.0;
+            }
+        }
+        std::vector<double> total_sum(local_sum.size());
+        std::vector<double> total_max(local_max.size());
+        std::vector<double> total_neg_min(local_neg_min.size());
+        comm.reduce_sum(local_sum.data(), total_sum.data(), local_sum.size(), 0);
+        comm.reduce_max(local_max.data(), total_max.data(), local_max.size(), 0);
+        comm.reduce_max(local_neg_min.data(), total_neg_min.data(), local_neg_min.size(), 0);
+        if (rank) {
+            return "";
+        }
+
+        std::ostringstream result;
+        result << "Node Summary:" << std::endl;
+        for (size_t row_idx = 0; row_idx < num_row; ++row_idx) {
+            bool is_app = row_idx == num_region;
+            if (is_app) {
+                result << "    Application Totals:" << std::endl;
+            }
+            else if (region_hash[row_idx] == GEOPM_REGION_HASH_EPOCH) {
+                result << "    Epoch Totals:" << std::endl;
+            }
+            else {
+                result << "    Region " << region_name_hash[row_idx].first << " (0x"
+                       << std::hex << std::setfill('0') << std::setw(16)
+                       << region_hash[row_idx] << std::dec << "):"
+                       << std::setfill('\0') << std::setw(0) << std::endl;
+            }
+            double num_node = total_sum[row_idx * sum_width + M_NUM_SUMMARY_METRIC];
+            result << "        nodes: " << num_node << std::endl;
+            for (int metric_idx = 0; metric_idx < M_NUM_SUMMARY_METRIC; ++metric_idx) {
+                if (is_app && (metric_idx == M_SUMMARY_SYNC_RUNTIME ||
+                               metric_idx == M_SUMMARY_FREQUENCY ||
+                               metric_idx == M_SUMMARY_COUNT)) {
+                    continue;
+                }
+                size_t off = row_idx * M_NUM_SUMMARY_METRIC + metric_idx;
+                double mean = num_node == 0 ? 0 : total_sum[row_idx * sum_width + metric_idx] / num_node;
+                result << "        " << metric_name[metric_idx] << ": min " << -total_neg_min[off]
+                       << ", max " << total_max[off] << ", mean " << mean << std::endl;
+            }
         }
+        return result.str();
     }
 
     std::string ReporterImp::get_max_memory()
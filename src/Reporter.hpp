@@ -41,6 +41,8 @@
 #include <memory>
 #include <vector>
 
+#include "ReportModel.hpp"
+
 namespace geopm
 {
     class Comm;
@@ -68,7 +70,14 @@ namespace geopm
             ///        the root controller, format the header,
             ///        aggregate all other node reports, and write the
             ///        report to the file indicated in the
-            ///        environment.
+            ///        environment.  In per-node mode each node
+            ///        instead writes its own report file, and in
+            ///        summary mode the root controller also appends
+            ///        the cross-node min, max and mean of each region
+            ///        metric.  In json mode a structured copy of each
+            ///        report file is also written to the same path
+            ///        with a ".json" suffix.  This method is
+            ///        collective over the comm.
             /// @param [in] agent_name Name of the Agent.
             /// @param [in] agent_report_header Optional list of
             ///             key-value pairs from the agent to be added
@@ -115,7 +124,10 @@ namespace geopm
                         std::unique_ptr<RegionAggregator> agg,
                         const std::string &env_signal,
                         const std::string &policy_path,
-                        bool do_endpoint);
+                        bool do_endpoint,
+                        const std::string &report_mode,
+                        bool do_tree_auto_fan_out,
+                        bool do_tree_sparse);
             virtual ~ReporterImp() = default;
             void init(void) override;
             void update(void) override;
@@ -127,7 +139,40 @@ namespace geopm
                           std::shared_ptr<Comm> comm,
                           const TreeComm &tree_comm) override;
         private:
+            enum m_summary_metric_e {
+                M_SUMMARY_RUNTIME,
+                M_SUMMARY_SYNC_RUNTIME,
+                M_SUMMARY_ENERGY_PKG,
+                M_SUMMARY_ENERGY_DRAM,
+                M_SUMMARY_POWER,
+                M_SUMMARY_FREQUENCY,
+                M_SUMMARY_NETWORK_TIME,
+                M_SUMMARY_COUNT,
+                M_NUM_SUMMARY_METRIC,
+            };
             std::string get_max_memory(void);
+            void parse_report_mode(const std::string &report_mode);
+            /// @brief Reduce the per-node region metrics across the
+            ///        comm and format the summary section on the
+            ///        root controller.  The rows are the regions
+            ///        known to the root controller followed by the
+            ///        application totals.
+            /// @return Text of the summary section on rank zero and
+            ///         an empty string on all other ranks.
+            std::string summary(const std::vector<std::pair<std::string, uint64_t> > &region_name_hash,
+                                const std::map<uint64_t, std::vector<double> > &region_metric,
+                                const std::vector<double> &app_metric,
+                                const Comm &comm,
+                                int rank) const;
+            /// @brief Concatenate the report text of every rank on
+            ///        rank zero.
+            /// @return The concatenated text on rank zero and an
+            ///         empty string on all other ranks.
+            std::string gather_report(const std::string &report, const Comm &comm,
+                                      int rank, int num_rank) const;
+            void write_json(const std::string &path,
+                            const ReportModel::header_s &header_model,
+                            const std::string &host_list_json) const;
 
             std::string m_start_time;
             std::string m_report_name;
@@ -144,6 +189,11 @@ namespace geopm
             const std::string m_env_signals;
             const std::string m_policy_path;
             bool m_do_endpoint;
+            bool m_do_tree_auto_fan_out;
+            bool m_do_tree_sparse;
+            bool m_is_per_node;
+            bool m_is_summary;
+            bool m_is_json;
             int m_app_energy_pkg_idx;
             int m_app_energy_dram_idx;
             int m_app_time_signal_idx;
@@ -0,0 +1,694 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ThreadComm.hpp"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+#include "Exception.hpp"
+#include "config.h"
+
+#define GEOPM_THREAD_COMM_PLUGIN_NAME "ThreadComm"
+
+namespace geopm
+{
+    /// @brief State shared by the threads of one communicator.
+    class ThreadCommGroup
+    {
+        public:
+            ThreadCommGroup(int num_rank);
+            virtual ~ThreadCommGroup() = default;
+            int num_rank(void) const;
+            void barrier(void);
+            /// Buffers posted by each rank for a collective
+            std::vector<const void *> m_send;
+            /// Sizes or values posted by each rank for a collective
+            std::vector<size_t> m_size;
+            /// Color and key posted by each rank for a split
+            std::vector<int> m_color;
+            std::vector<int> m_key;
+            /// Result of a split for each rank
+            std::vector<std::shared_ptr<ThreadCommGroup> > m_split_group;
+            std::vector<int> m_split_rank;
+            /// Window created by the last call to window_create()
+            size_t m_window;
+        private:
+            const int m_num_rank;
+            std::mutex m_barrier_mutex;
+            std::condition_variable m_barrier_cond;
+            int m_barrier_count;
+            uint64_t m_barrier_generation;
+    };
+
+    /// @brief Memory exposed by each rank of a communicator.
+    class ThreadCommWindow
+    {
+        public:
+            ThreadCommWindow(const std::vector<const void *> &base,
+                             const std::vector<size_t> &size);
+            virtual ~ThreadCommWindow();
+            void lock(bool is_exclusive, int rank);
+            void unlock(int rank);
+            void put(const void *send_buf, size_t send_size, int rank, off_t disp);
+        private:
+            std::vector<char *> m_base;
+            std::vector<size_t> m_size;
+            std::vector<pthread_rwlock_t> m_lock;
+    };
+
+    namespace
+    {
+        // World communicator of threads started by ThreadComm::run()
+        thread_local std::shared_ptr<ThreadCommGroup> g_world_group;
+        thread_local int g_world_rank = 0;
+    }
+
+    ThreadCommGroup::ThreadCommGroup(int num_rank)
+        : m_send(num_rank, nullptr)
+        , m_size(num_rank, 0)
+        , m_color(num_rank, 0)
+        , m_key(num_rank, 0)
+        , m_split_group(num_rank)
+        , m_split_rank(num_rank, -1)
+        , m_window(0)
+        , m_num_rank(num_rank)
+        , m_barrier_count(0)
+        , m_barrier_generation(0)
+    {
+
+    }
+
+    int ThreadCommGroup::num_rank(void) const
+    {
+        return m_num_rank;
+    }
+
+    void ThreadCommGroup::barrier(void)
+    {
+        std::unique_lock<std::mutex> lock(m_barrier_mutex);
+        uint64_t generation = m_barrier_generation;
+        ++m_barrier_count;
+        if (m_barrier_count == m_num_rank) {
+            m_barrier_count = 0;
+            ++m_barrier_generation;
+            m_barrier_cond.notify_all();
+        }
+        else {
+            m_barrier_cond.wait(lock, [this, generation]
+                                      {return m_barrier_generation != generation;});
+        }
+    }
+
+    ThreadCommWindow::ThreadCommWindow(const std::vector<const void *> &base,
+                                       const std::vector<size_t> &size)
+        : m_size(size)
+        , m_lock(base.size())
+    {
+        for (const auto &it : base) {
+            m_base.push_back((char *)it);
+        }
+        for (auto &it : m_lock) {
+            pthread_rwlock_init(&it, NULL);
+        }
+    }
+
+    ThreadCommWindow::~ThreadCommWindow()
+    {
+        for (auto &it : m_lock) {
+            pthread_rwlock_destroy(&it);
+        }
+    }
+
+    void ThreadCommWindow::lock(bool is_exclusive, int rank)
+    {
+        int err = is_exclusive ? pthread_rwlock_wrlock(&m_lock[rank]) :
+                                 pthread_rwlock_rdlock(&m_lock[rank]);
+        if (err) {
+            throw Exception("ThreadCommWindow::lock(): pthread_rwlock_*lock() failed",
+                            err, __FILE__, __LINE__);
+        }
+    }
+
+    void ThreadCommWindow::unlock(int rank)
+    {
+        int err = pthread_rwlock_unlock(&m_lock[rank]);
+        if (err) {
+            throw Exception("ThreadCommWindow::unlock(): pthread_rwlock_unlock() failed",
+                            err, __FILE__, __LINE__);
+        }
+    }
+
+    void ThreadCommWindow::put(const void *send_buf, size_t send_size, int rank, off_t disp)
+    {
+        if (disp < 0 || disp + send_size > m_size[rank]) {
+            throw Exception("ThreadCommWindow::put(): put is outside of the window of the target rank",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        memcpy(m_base[rank] + disp, send_buf, send_size);
+    }
+
+    std::string ThreadComm::plugin_name(void)
+    {
+        return GEOPM_THREAD_COMM_PLUGIN_NAME;
+    }
+
+    std::unique_ptr<Comm> ThreadComm::make_plugin(void)
+    {
+        std::unique_ptr<Comm> result;
+        if (g_world_group) {
+            result = std::unique_ptr<Comm>(new ThreadComm(g_world_group, g_world_rank, {}));
+        }
+        else {
+            result = std::unique_ptr<Comm>(new ThreadComm());
+        }
+        return result;
+    }
+
+    void ThreadComm::run(int num_rank, std::function<void(std::shared_ptr<Comm>)> func)
+    {
+        if (num_rank < 1) {
+            throw Exception("ThreadComm::run(): num_rank must be positive",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        auto group = std::make_shared<ThreadCommGroup>(num_rank);
+        std::vector<std::exception_ptr> error(num_rank);
+        std::vector<std::thread> thread;
+        for (int rank = 0; rank < num_rank; ++rank) {
+            thread.emplace_back([group, rank, &func, &error] ()
+            {
+                g_world_group = group;
+                g_world_rank = rank;
+                try {
+                    func(std::shared_ptr<Comm>(new ThreadComm(group, rank, {})));
+                }
+                catch (...) {
+                    error[rank] = std::current_exception();
+                }
+                g_world_group.reset();
+            });
+        }
+        for (auto &it : thread) {
+            it.join();
+        }
+        for (const auto &it : error) {
+            if (it) {
+                std::rethrow_exception(it);
+            }
+        }
+    }
+
+    ThreadComm::ThreadComm()
+        : ThreadComm(std::make_shared<ThreadCommGroup>(1), 0, {})
+    {
+
+    }
+
+    ThreadComm::ThreadComm(std::shared_ptr<ThreadCommGroup> group, int rank,
+                           const std::vector<int> &dimension)
+        : m_group(group)
+        , m_rank(rank)
+        , m_dimension(dimension)
+    {
+
+    }
+
+    std::shared_ptr<ThreadComm> ThreadComm::split_group(int color, int key,
+                                                        const std::vector<int> &dimension) const
+    {
+        std::shared_ptr<ThreadComm> result;
+        if (!m_group) {
+            result = std::shared_ptr<ThreadComm>(new ThreadComm(nullptr, -1, {}));
+        }
+        else {
+            ThreadCommGroup &group = *m_group;
+            group.m_color[m_rank] = color;
+            group.m_key[m_rank] = key;
+            group.barrier();
+            if (m_rank == 0) {
+                int num_rank = group.num_rank();
+                std::vector<int> order(num_rank);
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(),
+                                 [&group](int aa, int bb)
+                                 {
+                                     return std::make_pair(group.m_color[aa], group.m_key[aa]) <
+                                            std::make_pair(group.m_color[bb], group.m_key[bb]);
+                                 });
+                auto begin = order.begin();
+                while (begin != order.end()) {
+                    int curr_color = group.m_color[*begin];
+                    auto end = std::find_if(begin, order.end(),
+                                            [&group, curr_color](int rank)
+                                            {return group.m_color[rank] != curr_color;});
+                    std::shared_ptr<ThreadCommGroup> split;
+                    if (curr_color != M_SPLIT_COLOR_UNDEFINED) {
+                        split = std::make_shared<ThreadCommGroup>(std::distance(begin, end));
+                    }
+                    int split_rank = split ? 0 : -1;
+                    for (auto it = begin; it != end; ++it) {
+                        group.m_split_group[*it] = split;
+                        group.m_split_rank[*it] = split ? split_rank++ : -1;
+                    }
+                    begin = end;
+                }
+            }
+            group.barrier();
+            std::shared_ptr<ThreadCommGroup> split = group.m_split_group[m_rank];
+            int split_rank = group.m_split_rank[m_rank];
+            if (split && !dimension.empty()) {
+                int num_cart = std::accumulate(dimension.begin(), dimension.end(),
+                                               1, std::multiplies<int>());
+                if (num_cart != split->num_rank()) {
+                    throw Exception("ThreadComm::split(): product of dimensions does not match the number of ranks",
+                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+            }
+            result = std::shared_ptr<ThreadComm>(new ThreadComm(split, split_rank, dimension));
+        }
+        return result;
+    }
+
+    std::shared_ptr<Comm> ThreadComm::split(void) const
+    {
+        return split_group(0, m_rank, m_dimension);
+    }
+
+    std::shared_ptr<Comm> ThreadComm::split(int color, int key) const
+    {
+        if (color < 0 && color != M_SPLIT_COLOR_UNDEFINED) {
+            throw Exception("ThreadComm::split(): color must be non-negative",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return split_group(color, key, {});
+    }
+
+    std::shared_ptr<Comm> ThreadComm::split(const std::string &tag, int split_type) const
+    {
+        std::shared_ptr<Comm> result;
+        switch (split_type) {
+            case M_COMM_SPLIT_TYPE_PPN1:
+                result = split_group(0, m_rank, {});
+                break;
+            case M_COMM_SPLIT_TYPE_SHARED:
+                result = split_group(m_rank, 0, {});
+                break;
+            default:
+                throw Exception("Invalid split_type.", GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    std::shared_ptr<Comm> ThreadComm::split(std::vector<int> dimensions, std::vector<int> periods, bool is_reorder) const
+    {
+        if (dimensions.empty() ||
+            std::any_of(dimensions.begin(), dimensions.end(),
+                        [](int dim) {return dim < 1;})) {
+            throw Exception("ThreadComm::split(): dimensions must be positive",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return split_group(0, m_rank, dimensions);
+    }
+
+    std::shared_ptr<Comm> ThreadComm::split_cart(std::vector<int> dimensions) const
+    {
+        return split(dimensions, std::vector<int>(dimensions.size(), 0), true);
+    }
+
+    bool ThreadComm::comm_supported(const std::string &description) const
+    {
+        return description == plugin_name();
+    }
+
+    int ThreadComm::cart_rank(const std::vector<int> &coords) const
+    {
+        if (m_dimension.empty() || coords.size() != m_dimension.size()) {
+            throw Exception("ThreadComm::cart_rank(): coordinate does not match the dimensions of the communicator",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        // Row major order as used by MPI
+        int result = 0;
+        for (size_t dim_idx = 0; dim_idx != m_dimension.size(); ++dim_idx) {
+            if (coords[dim_idx] < 0 || coords[dim_idx] >= m_dimension[dim_idx]) {
+                throw Exception("ThreadComm::cart_rank(): coordinate out of range",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            result = result * m_dimension[dim_idx] + coords[dim_idx];
+        }
+        return result;
+    }
+
+    int ThreadComm::rank(void) const
+    {
+        return m_rank;
+    }
+
+    int ThreadComm::num_rank(void) const
+    {
+        return m_group ? m_group->num_rank() : 0;
+    }
+
+    void ThreadComm::dimension_create(int num_ranks, std::vector<int> &dimension) const
+    {
+        int num_fixed = 1;
+        int num_free = 0;
+        for (const auto &dim : dimension) {
+            if (dim < 0) {
+                throw Exception("ThreadComm::dimension_create(): dimensions must not be negative",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            if (dim) {
+                num_fixed *= dim;
+            }
+            else {
+                ++num_free;
+            }
+        }
+        if (num_ranks < 1 || num_ranks % num_fixed ||
+            (num_free == 0 && num_fixed != num_ranks)) {
+            throw Exception("ThreadComm::dimension_create(): number of ranks is not divisible by the fixed dimensions",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (num_free) {
+            // Distribute the prime factors from the largest to the
+            // smallest onto the smallest free dimension to balance
+            // them as MPI_Dims_create() does.
+            std::vector<int> factor;
+            int remain = num_ranks / num_fixed;
+            for (int prime = 2; prime * prime <= remain; ++prime) {
+                while (remain % prime == 0) {
+                    factor.push_back(prime);
+                    remain /= prime;
+                }
+            }
+            if (remain > 1) {
+                factor.push_back(remain);
+            }
+            std::vector<int> free_dim(num_free, 1);
+            for (auto it = factor.rbegin(); it != factor.rend(); ++it) {
+                *std::min_element(free_dim.begin(), free_dim.end()) *= *it;
+            }
+            std::sort(free_dim.begin(), free_dim.end(), std::greater<int>());
+            auto free_it = free_dim.begin();
+            for (auto &dim : dimension) {
+                if (!dim) {
+                    dim = *free_it;
+                    ++free_it;
+                }
+            }
+        }
+    }
+
+    void ThreadComm::free_mem(void *base)
+    {
+        free(base);
+    }
+
+    void ThreadComm::alloc_mem(size_t size, void **base)
+    {
+        *base = malloc(size);
+        if (size && !*base) {
+            throw Exception("ThreadComm::alloc_mem(): malloc() failed",
+                            ENOMEM, __FILE__, __LINE__);
+        }
+    }
+
+    size_t ThreadComm::window_create(size_t size, void *base)
+    {
+        size_t result = 0;
+        if (m_group) {
+            ThreadCommGroup &group = *m_group;
+            group.m_send[m_rank] = base;
+            group.m_size[m_rank] = size;
+            group.barrier();
+            if (m_rank == 0) {
+                group.m_window = (size_t)(new ThreadCommWindow(group.m_send, group.m_size));
+            }
+            group.barrier();
+            result = group.m_window;
+            m_windows.insert(result);
+        }
+        return result;
+    }
+
+    void ThreadComm::window_destroy(size_t window_id)
+    {
+        if (m_group) {
+            check_window(window_id);
+            m_windows.erase(window_id);
+            m_group->barrier();
+            if (m_rank == 0) {
+                delete (ThreadCommWindow *)window_id;
+            }
+        }
+    }
+
+    void ThreadComm::window_lock(size_t window_id, bool is_exclusive, int rank, int assert) const
+    {
+        check_window(window_id);
+        check_rank(rank);
+        ((ThreadCommWindow *)window_id)->lock(is_exclusive, rank);
+    }
+
+    void ThreadComm::window_unlock(size_t window_id, int rank) const
+    {
+        check_window(window_id);
+        check_rank(rank);
+        ((ThreadCommWindow *)window_id)->unlock(rank);
+    }
+
+    void ThreadComm::window_lock_all(size_t window_id, int assert) const
+    {
+        check_window(window_id);
+    }
+
+    void ThreadComm::window_unlock_all(size_t window_id) const
+    {
+        check_window(window_id);
+    }
+
+    void ThreadComm::window_flush(size_t window_id, int rank) const
+    {
+        // Puts are complete when window_put() returns, the fence
+        // orders them with later puts.
+        check_window(window_id);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void ThreadComm::window_sync(size_t window_id) const
+    {
+        check_window(window_id);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void ThreadComm::coordinate(int rank, std::vector<int> &coord) const
+    {
+        if (m_dimension.empty()) {
+            throw Exception("ThreadComm::coordinate(): communicator is not Cartesian",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (coord.size() != m_dimension.size()) {
+            std::ostringstream ex_str;
+            ex_str << "ThreadComm::coordinate(): input coord size (" << coord.size()
+                   << ") != number of dimensions (" << m_dimension.size() << ")";
+            throw Exception(ex_str.str(), GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        check_rank(rank);
+        for (size_t dim_idx = m_dimension.size(); dim_idx != 0; --dim_idx) {
+            coord[dim_idx - 1] = rank % m_dimension[dim_idx - 1];
+            rank /= m_dimension[dim_idx - 1];
+        }
+    }
+
+    std::vector<int> ThreadComm::coordinate(int rank) const
+    {
+        std::vector<int> result(m_dimension.size(), 0);
+        coordinate(rank, result);
+        return result;
+    }
+
+    void ThreadComm::barrier(void) const
+    {
+        if (m_group) {
+            m_group->barrier();
+        }
+    }
+
+    void ThreadComm::broadcast(void *buffer, size_t size, int root) const
+    {
+        if (m_group) {
+            check_rank(root);
+            ThreadCommGroup &group = *m_group;
+            group.m_send[m_rank] = buffer;
+            group.barrier();
+            if (m_rank != root) {
+                memcpy(buffer, group.m_send[root], size);
+            }
+            group.barrier();
+        }
+    }
+
+    bool ThreadComm::test(bool is_true) const
+    {
+        bool result = is_true;
+        if (m_group) {
+            ThreadCommGroup &group = *m_group;
+            group.m_size[m_rank] = is_true;
+            group.barrier();
+            result = std::all_of(group.m_size.begin(), group.m_size.end(),
+                                 [](size_t val) {return val != 0;});
+            group.barrier();
+        }
+        return result;
+    }
+
+    void ThreadComm::reduce(double *send_buf, double *recv_buf, size_t count, int root,
+                            std::function<double(double, double)> op) const
+    {
+        if (m_group) {
+            check_rank(root);
+            ThreadCommGroup &group = *m_group;
+            group.m_send[m_rank] = send_buf;
+            group.barrier();
+            if (m_rank == root) {
+                std::vector<double> result((const double *)group.m_send[0],
+                                           (const double *)group.m_send[0] + count);
+                for (int rank = 1; rank < group.num_rank(); ++rank) {
+                    const double *rank_buf = (const double *)group.m_send[rank];
+                    std::transform(result.begin(), result.end(), rank_buf,
+                                   result.begin(), op);
+                }
+                std::copy(result.begin(), result.end(), recv_buf);
+            }
+            group.barrier();
+        }
+    }
+
+    void ThreadComm::reduce_max(double *send_buf, double *recv_buf, size_t count, int root) const
+    {
+        reduce(send_buf, recv_buf, count, root,
+               [](double aa, double bb) {return std::max(aa, bb);});
+    }
+
+    void ThreadComm::reduce_sum(double *send_buf, double *recv_buf, size_t count, int root) const
+    {
+        reduce(send_buf, recv_buf, count, root, std::plus<double>());
+    }
+
+    void ThreadComm::gather(const void *send_buf, size_t send_size, void *recv_buf,
+                            size_t recv_size, int root) const
+    {
+        if (m_group) {
+            std::vector<size_t> recv_sizes(num_rank(), recv_size);
+            std::vector<off_t> rank_offset(num_rank(), 0);
+            for (size_t rank = 1; rank < rank_offset.size(); ++rank) {
+                rank_offset[rank] = rank_offset[rank - 1] + recv_size;
+            }
+            gatherv(send_buf, send_size, recv_buf, recv_sizes, rank_offset, root);
+        }
+    }
+
+    void ThreadComm::gatherv(const void *send_buf, size_t send_size, void *recv_buf,
+                             const std::vector<size_t> &recv_sizes, const std::vector<off_t> &rank_offset, int root) const
+    {
+        if (m_group) {
+            check_rank(root);
+            ThreadCommGroup &group = *m_group;
+            int num_rank = group.num_rank();
+            if (m_rank == root &&
+                (recv_sizes.size() != (size_t)num_rank ||
+                 rank_offset.size() != (size_t)num_rank)) {
+                throw Exception("ThreadComm::gatherv(): receive sizes and offsets must be provided for each rank",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            group.m_send[m_rank] = send_buf;
+            group.m_size[m_rank] = send_size;
+            group.barrier();
+            bool is_truncated = false;
+            if (m_rank == root) {
+                for (int rank = 0; rank < num_rank; ++rank) {
+                    size_t copy_size = group.m_size[rank];
+                    if (copy_size > recv_sizes[rank]) {
+                        is_truncated = true;
+                        copy_size = recv_sizes[rank];
+                    }
+                    memcpy((char *)recv_buf + rank_offset[rank], group.m_send[rank], copy_size);
+                }
+            }
+            group.barrier();
+            if (is_truncated) {
+                throw Exception("ThreadComm::gatherv(): message is larger than the receive size",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+        }
+    }
+
+    void ThreadComm::window_put(const void *send_buf, size_t send_size, int rank, off_t disp, size_t window_id) const
+    {
+        check_window(window_id);
+        check_rank(rank);
+        ((ThreadCommWindow *)window_id)->put(send_buf, send_size, rank, disp);
+    }
+
+    void ThreadComm::tear_down(void)
+    {
+
+    }
+
+    void ThreadComm::check_window(size_t window_id) const
+    {
+        if (m_windows.find(window_id) == m_windows.end()) {
+            std::ostringstream ex_str;
+            ex_str << "ThreadComm: requested window handle " << window_id << " invalid";
+            throw Exception(ex_str.str(), GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+    }
+
+    void ThreadComm::check_rank(int rank) const
+    {
+        if (rank < 0 || rank >= num_rank()) {
+            throw Exception("ThreadComm: rank " + std::to_string(rank) + " is out of range",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+}
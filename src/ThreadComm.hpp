@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef THREADCOMM_HPP_INCLUDE
+#define THREADCOMM_HPP_INCLUDE
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Comm.hpp"
+
+namespace geopm
+{
+    class ThreadCommGroup;
+
+    /// @brief Implementation of the Comm interface for logical ranks
+    ///        that are threads of a single process.
+    ///
+    /// The ranks share the address space of the process, so windows
+    /// are plain memory and puts are copies into the memory of the
+    /// target rank.  Collective operations exchange pointers between
+    /// the threads of a communicator and synchronize with a barrier.
+    /// This allows the controller tree to be run and benchmarked
+    /// with many simulated nodes without MPI.  Each logical rank is
+    /// treated as a separate node, so a split with
+    /// M_COMM_SPLIT_TYPE_PPN1 includes every rank and a split with
+    /// M_COMM_SPLIT_TYPE_SHARED includes only the calling rank.
+    class ThreadComm : public Comm
+    {
+        public:
+            /// @brief Communicator with a single rank.
+            ThreadComm();
+            virtual ~ThreadComm() = default;
+
+            static std::string plugin_name(void);
+            /// @brief Returns the world communicator of the calling
+            ///        thread if it was started by run(), otherwise a
+            ///        communicator with a single rank.
+            static std::unique_ptr<Comm> make_plugin(void);
+            /// @brief Run a function on each of num_rank threads
+            ///        that form a world communicator.
+            ///
+            /// Returns after all threads have completed.  If a
+            /// function throws, the first exception is rethrown
+            /// after the other threads have been joined, so the
+            /// other ranks must not wait on the failed rank.
+            ///
+            /// @param [in] num_rank Number of ranks in the world
+            ///        communicator.
+            ///
+            /// @param [in] func Function called by each thread with
+            ///        its world communicator.
+            static void run(int num_rank, std::function<void(std::shared_ptr<Comm>)> func);
+
+            std::shared_ptr<Comm> split() const override;
+            std::shared_ptr<Comm> split(int color, int key) const override;
+            std::shared_ptr<Comm> split(const std::string &tag, int split_type) const override;
+            std::shared_ptr<Comm> split(std::vector<int> dimensions, std::vector<int> periods, bool is_reorder) const override;
+            std::shared_ptr<Comm> split_cart(std::vector<int> dimensions) const override;
+            bool comm_supported(const std::string &description) const override;
+            int cart_rank(const std::vector<int> &coords) const override;
+            int rank(void) const override;
+            int num_rank(void) const override;
+            void dimension_create(int num_ranks, std::vector<int> &dimension) const override;
+            void free_mem(void *base) override;
+            void alloc_mem(size_t size, void **base) override;
+            size_t window_create(size_t size, void *base) override;
+            void window_destroy(size_t window_id) override;
+            void window_lock(size_t window_id, bool is_exclusive, int rank, int assert) const override;
+            void window_unlock(size_t window_id, int rank) const override;
+            void window_lock_all(size_t window_id, int assert) const override;
+            void window_unlock_all(size_t window_id) const override;
+            void window_flush(size_t window_id, int rank) const override;
+            void window_sync(size_t window_id) const override;
+            void coordinate(int rank, std::vector<int> &coord) const override;
+            std::vector<int> coordinate(int rank) const override;
+            void barrier(void) const override;
+            void broadcast(void *buffer, size_t size, int root) const override;
+            bool test(bool is_true) const override;
+            void reduce_max(double *send_buf, double *recv_buf, size_t count, int root) const override;
+            void reduce_sum(double *send_buf, double *recv_buf, size_t count, int root) const override;
+            void gather(const void *send_buf, size_t send_size, void *recv_buf,
+                        size_t recv_size, int root) const override;
+            void gatherv(const void *send_buf, size_t send_size, void *recv_buf,
+                         const std::vector<size_t> &recv_sizes, const std::vector<off_t> &rank_offset, int root) const override;
+            void window_put(const void *send_buf, size_t send_size, int rank, off_t disp, size_t window_id) const override;
+            void tear_down(void) override;
+        private:
+            ThreadComm(std::shared_ptr<ThreadCommGroup> group, int rank,
+                       const std::vector<int> &dimension);
+            /// @brief Collective split of the communicator, ranks
+            ///        with the same color are ordered by key and
+            ///        then by rank.
+            std::shared_ptr<ThreadComm> split_group(int color, int key,
+                                                    const std::vector<int> &dimension) const;
+            void reduce(double *send_buf, double *recv_buf, size_t count, int root,
+                        std::function<double(double, double)> op) const;
+            void check_window(size_t window_id) const;
+            void check_rank(int rank) const;
+            std::shared_ptr<ThreadCommGroup> m_group;
+            int m_rank;
+            std::vector<int> m_dimension;
+            std::set<size_t> m_windows;
+    };
+}
+
+#endif
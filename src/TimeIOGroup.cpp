@@ -45,6 +45,7 @@ namespace geopm
     TimeIOGroup::TimeIOGroup()
         : m_is_signal_pushed(false)
         , m_is_batch_read(false)
+        , m_is_batch_start_set(false)
         , m_valid_signal_name{plugin_name() + "::ELAPSED",
                               "TIME"}
     {
@@ -114,11 +115,22 @@ namespace geopm
     void TimeIOGroup::read_batch(void)
     {
         if (m_is_signal_pushed) {
-            m_time_curr = geopm_time_since(&m_time_zero);
+            if (m_is_batch_start_set) {
+                m_time_curr = geopm_time_diff(&m_time_zero, &m_batch_start);
+            }
+            else {
+                m_time_curr = geopm_time_since(&m_time_zero);
+            }
         }
         m_is_batch_read = true;
     }
 
+    void TimeIOGroup::set_batch_time(const struct geopm_time_s &batch_time)
+    {
+        m_batch_start = batch_time;
+        m_is_batch_start_set = true;
+    }
+
     void TimeIOGroup::write_batch(void)
     {
 
@@ -56,6 +56,7 @@ namespace geopm
             int push_signal(const std::string &signal_name, int domain_type, int domain_idx)  override;
             int push_control(const std::string &control_name, int domain_type, int domain_idx) override;
             void read_batch(void) override;
+            void set_batch_time(const struct geopm_time_s &batch_time) override;
             void write_batch(void) override;
             double sample(int batch_idx) override;
             void adjust(int batch_idx, double setting) override;
@@ -74,6 +75,8 @@ namespace geopm
             bool m_is_batch_read;
             geopm_time_s m_time_zero;
             double m_time_curr;
+            bool m_is_batch_start_set;
+            geopm_time_s m_batch_start;
             const std::set<std::string> m_valid_signal_name;
     };
 }
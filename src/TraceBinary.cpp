@@ -0,0 +1,544 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TraceBinary.hpp"
+
+#include <string.h>
+#include <errno.h>
+
+#include <sstream>
+#include <algorithm>
+#include <map>
+
+#include "geopm_version.h"
+#include "Helper.hpp"
+#include "Exception.hpp"
+#include "Environment.hpp"
+#include "AsyncWriter.hpp"
+#include "NumberFormat.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    const std::string TraceBinaryImp::M_MAGIC = "GEOPMTRB";
+    constexpr uint32_t TraceBinaryImp::M_BLOCK_ROWS;
+    constexpr uint32_t TraceBinaryImp::M_VERSION;
+    constexpr size_t TraceBinaryImp::M_MAX_PENDING;
+
+    static void append_uint32(std::string &buffer, uint32_t value)
+    {
+        buffer.append((const char *)&value, sizeof(value));
+    }
+
+    static void append_string(std::string &buffer, const std::string &value)
+    {
+        append_uint32(buffer, value.size());
+        buffer.append(value);
+    }
+
+    TraceBinaryImp::TraceBinaryImp(const std::string &file_path,
+                                   const std::string &host_name,
+                                   const std::string &start_time,
+                                   size_t buffer_size,
+                                   bool is_compressed)
+        : m_is_compressed(is_compressed)
+        , m_file_path(file_path)
+        , m_file_handle(-1)
+        , m_buffer_limit(buffer_size)
+        , m_is_active(false)
+    {
+        if (host_name.size()) {
+            m_file_path += "-" + host_name;
+        }
+        try {
+            m_file_handle = async_writer().open(m_file_path, M_MAX_PENDING);
+        }
+        catch (const Exception &ex) {
+            throw Exception("Unable to open binary trace file '" + m_file_path + "'",
+                            ex.err_value(), __FILE__, __LINE__);
+        }
+        std::ostringstream meta_data;
+        meta_data << "# geopm_version: " << geopm_version() << "\n"
+                  << "# start_time: " << start_time << "\n"
+                  << "# profile_name: " << environment().profile() << "\n"
+                  << "# node_name: " << host_name << "\n"
+                  << "# agent: " << environment().agent() << "\n";
+        m_meta_data = meta_data.str();
+    }
+
+    TraceBinaryImp::~TraceBinaryImp()
+    {
+        try {
+            flush();
+        }
+        catch (...) {
+            exception_handler(std::current_exception(), true);
+        }
+        async_writer().close(m_file_handle);
+    }
+
+    void TraceBinaryImp::add_column(const std::string &name)
+    {
+        add_column(name, "double");
+    }
+
+    void TraceBinaryImp::add_column(const std::string &name, const std::string &format)
+    {
+        static const std::vector<std::string> type_names {"double", "float", "integer", "hex", "raw64"};
+        auto it = std::find(type_names.begin(), type_names.end(), format);
+        if (it == type_names.end()) {
+            throw Exception("TraceBinaryImp::add_column(), format is unknown: " + format,
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        add_column(name, column_format(it - type_names.begin()));
+    }
+
+    void TraceBinaryImp::add_column(const std::string &name, std::function<std::string(double)> format)
+    {
+        if (m_is_active) {
+            throw Exception("TraceBinaryImp::add_column() cannot be called after activate()",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        int type = column_type(format);
+        if (type == M_COLUMN_CUSTOM) {
+            m_custom_idx.push_back(m_column_name.size());
+            m_custom_format.push_back(format);
+        }
+        m_column_name.push_back(name);
+        m_column_type.push_back(type);
+    }
+
+    void TraceBinaryImp::add_meta_data(const std::string &key, const std::string &value)
+    {
+        if (m_is_active) {
+            throw Exception("TraceBinaryImp::add_meta_data() cannot be called after activate()",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_meta_data += "# " + key + ": " + value + "\n";
+    }
+
+    void TraceBinaryImp::activate(void)
+    {
+        if (m_is_active == false) {
+            m_is_active = true;
+            m_buffer.append(M_MAGIC);
+            append_uint32(m_buffer, M_VERSION);
+            append_uint32(m_buffer, m_is_compressed ? M_FLAG_COMPRESSED : 0);
+            append_string(m_buffer, m_meta_data);
+            append_uint32(m_buffer, m_column_name.size());
+            for (size_t col_idx = 0; col_idx != m_column_name.size(); ++col_idx) {
+                append_uint32(m_buffer, m_column_type[col_idx]);
+                append_string(m_buffer, m_column_name[col_idx]);
+            }
+            m_block.reserve(M_BLOCK_ROWS * m_column_name.size());
+        }
+    }
+
+    void TraceBinaryImp::update(const std::vector<double> &sample)
+    {
+        if (!m_is_active) {
+            throw Exception("TraceBinaryImp::activate() must be called prior to update",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (sample.size() != m_column_name.size()) {
+            throw Exception("TraceBinaryImp::update(): Input vector incorrectly sized",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        if (m_is_compressed) {
+            m_block.insert(m_block.end(), sample.begin(), sample.end());
+            for (size_t custom_idx = 0; custom_idx != m_custom_idx.size(); ++custom_idx) {
+                append_string(m_block_text, m_custom_format[custom_idx](sample[m_custom_idx[custom_idx]]));
+            }
+            if (m_block.size() == M_BLOCK_ROWS * m_column_name.size()) {
+                write_block();
+            }
+        }
+        else {
+            m_buffer.append((const char *)sample.data(), sample.size() * sizeof(double));
+            for (size_t custom_idx = 0; custom_idx != m_custom_idx.size(); ++custom_idx) {
+                append_string(m_buffer, m_custom_format[custom_idx](sample[m_custom_idx[custom_idx]]));
+            }
+        }
+        // if buffer is full, hand it to the I/O thread
+        if (m_buffer.size() > m_buffer_limit) {
+            async_writer().write(m_file_handle, m_buffer);
+        }
+    }
+
+    void TraceBinaryImp::flush(void)
+    {
+        if (m_is_compressed && m_block.size()) {
+            write_block();
+        }
+        async_writer().write(m_file_handle, m_buffer);
+        async_writer().flush(m_file_handle);
+    }
+
+    void TraceBinaryImp::write_block(void)
+    {
+        size_t num_column = m_column_name.size();
+        uint32_t num_row = num_column ? m_block.size() / num_column : 0;
+        std::string payload = compress_block(m_block, num_column);
+        append_uint32(m_buffer, num_row);
+        append_uint32(m_buffer, payload.size());
+        m_buffer.append(payload);
+        m_buffer.append(m_block_text);
+        m_block.clear();
+        m_block_text.clear();
+    }
+
+    int TraceBinaryImp::column_type(const std::function<std::string(double)> &format)
+    {
+        // Identify the format the same way that CSVImp does, so a
+        // column is printed by NumberFormat in both paths or by its
+        // own format function in both paths.
+        static const std::map<int, int> format_column_type {
+            {NumberFormat::M_FORMAT_DOUBLE, M_COLUMN_DOUBLE},
+            {NumberFormat::M_FORMAT_FLOAT, M_COLUMN_FLOAT},
+            {NumberFormat::M_FORMAT_INTEGER, M_COLUMN_INTEGER},
+            {NumberFormat::M_FORMAT_HEX, M_COLUMN_HEX},
+            {NumberFormat::M_FORMAT_RAW64, M_COLUMN_RAW64},
+            {NumberFormat::M_FORMAT_CUSTOM, M_COLUMN_CUSTOM},
+        };
+        return format_column_type.at(NumberFormat::format_type(format));
+    }
+
+    std::function<std::string(double)> TraceBinaryImp::column_format(int column_type)
+    {
+        std::function<std::string(double)> result;
+        switch (column_type) {
+            case M_COLUMN_DOUBLE:
+                result = string_format_double;
+                break;
+            case M_COLUMN_FLOAT:
+                result = string_format_float;
+                break;
+            case M_COLUMN_INTEGER:
+                result = string_format_integer;
+                break;
+            case M_COLUMN_HEX:
+                result = string_format_hex;
+                break;
+            case M_COLUMN_RAW64:
+                result = string_format_raw64;
+                break;
+            default:
+                throw Exception("TraceBinaryImp::column_format(): invalid column type: " +
+                                std::to_string(column_type),
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    std::string TraceBinaryImp::compress_block(const std::vector<double> &rows,
+                                               size_t num_column)
+    {
+        // XOR each value with the previous value in the same column
+        // and store the bytes of each column in planes: the lowest
+        // byte of every row, then the next byte of every row, and so
+        // on.  Bits that do not change from row to row then form long
+        // runs of zero bytes.
+        size_t num_row = num_column ? rows.size() / num_column : 0;
+        size_t num_byte = rows.size() * sizeof(uint64_t);
+        std::vector<uint8_t> bytes(num_byte);
+        for (size_t col_idx = 0; col_idx != num_column; ++col_idx) {
+            uint8_t *col_bytes = bytes.data() + col_idx * num_row * sizeof(uint64_t);
+            uint64_t prev = 0;
+            for (size_t row_idx = 0; row_idx != num_row; ++row_idx) {
+                uint64_t curr;
+                memcpy(&curr, &rows[row_idx * num_column + col_idx], sizeof(curr));
+                uint64_t delta = curr ^ prev;
+                for (size_t plane_idx = 0; plane_idx != sizeof(uint64_t); ++plane_idx) {
+                    col_bytes[plane_idx * num_row + row_idx] = (uint8_t)(delta >> (8 * plane_idx));
+                }
+                prev = curr;
+            }
+        }
+        // Run length encode the zero bytes: a control byte less than
+        // 128 is followed by that many plus one literal bytes, and a
+        // control byte of 128 or more stands for that many minus 127
+        // zero bytes.
+        std::string result;
+        result.reserve(num_byte / 4);
+        size_t byte_idx = 0;
+        while (byte_idx != num_byte) {
+            size_t run = 0;
+            if (bytes[byte_idx] == 0) {
+                while (byte_idx + run != num_byte && run != 128 &&
+                       bytes[byte_idx + run] == 0) {
+                    ++run;
+                }
+                result.push_back((char)(run + 127));
+            }
+            else {
+                while (byte_idx + run != num_byte && run != 128 &&
+                       bytes[byte_idx + run] != 0) {
+                    ++run;
+                }
+                result.push_back((char)(run - 1));
+                result.append((const char *)bytes.data() + byte_idx, run);
+            }
+            byte_idx += run;
+        }
+        return result;
+    }
+
+    void TraceBinaryImp::decompress_block(const std::string &payload,
+                                          size_t num_row,
+                                          size_t num_column,
+                                          std::vector<double> &rows)
+    {
+        size_t num_byte = num_row * num_column * sizeof(uint64_t);
+        std::vector<uint8_t> bytes(num_byte);
+        size_t byte_idx = 0;
+        size_t payload_idx = 0;
+        while (payload_idx != payload.size()) {
+            uint8_t control = payload[payload_idx];
+            ++payload_idx;
+            size_t run = control < 128 ? control + 1 : control - 127;
+            if (byte_idx + run > num_byte ||
+                (control < 128 && payload_idx + run > payload.size())) {
+                throw Exception("TraceBinaryImp::decompress_block(): corrupt block",
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            if (control < 128) {
+                memcpy(bytes.data() + byte_idx, payload.data() + payload_idx, run);
+                payload_idx += run;
+            }
+            else {
+                memset(bytes.data() + byte_idx, 0, run);
+            }
+            byte_idx += run;
+        }
+        if (byte_idx != num_byte) {
+            throw Exception("TraceBinaryImp::decompress_block(): corrupt block",
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        rows.resize(num_row * num_column);
+        for (size_t col_idx = 0; col_idx != num_column; ++col_idx) {
+            const uint8_t *col_bytes = bytes.data() + col_idx * num_row * sizeof(uint64_t);
+            uint64_t prev = 0;
+            for (size_t row_idx = 0; row_idx != num_row; ++row_idx) {
+                uint64_t delta = 0;
+                for (size_t plane_idx = 0; plane_idx != sizeof(uint64_t); ++plane_idx) {
+                    delta |= (uint64_t)col_bytes[plane_idx * num_row + row_idx] << (8 * plane_idx);
+                }
+                prev ^= delta;
+                memcpy(&rows[row_idx * num_column + col_idx], &prev, sizeof(prev));
+            }
+        }
+    }
+
+    TraceBinaryReader::TraceBinaryReader(const std::string &file_path)
+        : m_stream(file_path, std::ios::binary)
+        , m_file_path(file_path)
+        , m_is_compressed(false)
+        , m_block_num_row(0)
+        , m_block_row(0)
+    {
+        if (!m_stream.good()) {
+            throw Exception("TraceBinaryReader: Unable to open binary trace file '" + m_file_path + "'",
+                            errno ? errno : GEOPM_ERROR_RUNTIME, __FILE__, __LINE__);
+        }
+        std::string magic(TraceBinaryImp::M_MAGIC.size(), '\0');
+        m_stream.read(&magic[0], magic.size());
+        if (!m_stream.good() || magic != TraceBinaryImp::M_MAGIC) {
+            throw Exception("TraceBinaryReader: File is not a binary trace: " + m_file_path,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        uint32_t version = read_uint32();
+        if (version != TraceBinaryImp::M_VERSION) {
+            throw Exception("TraceBinaryReader: Unsupported binary trace version: " +
+                            std::to_string(version),
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        m_is_compressed = read_uint32() & TraceBinaryImp::M_FLAG_COMPRESSED;
+        m_meta_data = read_string();
+        uint32_t num_column = read_uint32();
+        for (uint32_t col_idx = 0; col_idx != num_column; ++col_idx) {
+            int type = read_uint32();
+            if (type < 0 || type >= TraceBinaryImp::M_NUM_COLUMN_TYPE) {
+                throw Exception("TraceBinaryReader: Invalid column type in binary trace: " +
+                                std::to_string(type),
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            if (type == TraceBinaryImp::M_COLUMN_CUSTOM) {
+                m_custom_idx.push_back(col_idx);
+            }
+            m_column_type.push_back(type);
+            m_column_name.push_back(read_string());
+        }
+    }
+
+    uint32_t TraceBinaryReader::read_uint32(void)
+    {
+        uint32_t result = 0;
+        m_stream.read((char *)&result, sizeof(result));
+        if (!m_stream.good()) {
+            throw Exception("TraceBinaryReader: Binary trace is truncated: " + m_file_path,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    std::string TraceBinaryReader::read_string(void)
+    {
+        std::string result(read_uint32(), '\0');
+        m_stream.read(&result[0], result.size());
+        if (!m_stream.good()) {
+            throw Exception("TraceBinaryReader: Binary trace is truncated: " + m_file_path,
+                            GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+        }
+        return result;
+    }
+
+    std::string TraceBinaryReader::meta_data(void) const
+    {
+        return m_meta_data;
+    }
+
+    std::vector<std::string> TraceBinaryReader::column_names(void) const
+    {
+        return m_column_name;
+    }
+
+    std::vector<int> TraceBinaryReader::column_types(void) const
+    {
+        return m_column_type;
+    }
+
+    bool TraceBinaryReader::is_compressed(void) const
+    {
+        return m_is_compressed;
+    }
+
+    bool TraceBinaryReader::next(std::vector<double> &row)
+    {
+        std::vector<std::string> text;
+        return next(row, text);
+    }
+
+    bool TraceBinaryReader::next(std::vector<double> &row, std::vector<std::string> &text)
+    {
+        size_t num_column = m_column_name.size();
+        if (num_column == 0) {
+            return false;
+        }
+        row.resize(num_column);
+        text.assign(num_column, "");
+        if (!m_is_compressed) {
+            m_stream.read((char *)row.data(), num_column * sizeof(double));
+            if (m_stream.gcount() == 0) {
+                return false;
+            }
+            if (!m_stream.good()) {
+                throw Exception("TraceBinaryReader::next(): Binary trace record is truncated: " + m_file_path,
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            for (size_t col_idx : m_custom_idx) {
+                text[col_idx] = read_string();
+            }
+            return true;
+        }
+        if (m_block_row == m_block_num_row) {
+            uint32_t header[2];
+            m_stream.read((char *)header, sizeof(header));
+            if (m_stream.gcount() == 0) {
+                return false;
+            }
+            if (!m_stream.good()) {
+                throw Exception("TraceBinaryReader::next(): Binary trace block is truncated: " + m_file_path,
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            std::string payload(header[1], '\0');
+            m_stream.read(&payload[0], payload.size());
+            if (!m_stream.good()) {
+                throw Exception("TraceBinaryReader::next(): Binary trace block is truncated: " + m_file_path,
+                                GEOPM_ERROR_FILE_PARSE, __FILE__, __LINE__);
+            }
+            TraceBinaryImp::decompress_block(payload, header[0], num_column, m_block);
+            m_block_text.resize(header[0] * m_custom_idx.size());
+            for (auto &block_text : m_block_text) {
+                block_text = read_string();
+            }
+            m_block_num_row = header[0];
+            m_block_row = 0;
+            if (m_block_num_row == 0) {
+                return next(row, text);
+            }
+        }
+        std::copy(m_block.begin() + m_block_row * num_column,
+                  m_block.begin() + (m_block_row + 1) * num_column,
+                  row.begin());
+        for (size_t custom_idx = 0; custom_idx != m_custom_idx.size(); ++custom_idx) {
+            text[m_custom_idx[custom_idx]] = m_block_text[m_block_row * m_custom_idx.size() + custom_idx];
+        }
+        ++m_block_row;
+        return true;
+    }
+
+    void TraceBinaryReader::write_csv(std::ostream &output)
+    {
+        std::vector<int> format;
+        for (const auto &type : m_column_type) {
+            if (type == TraceBinaryImp::M_COLUMN_CUSTOM) {
+                format.push_back(NumberFormat::M_FORMAT_CUSTOM);
+            }
+            else {
+                format.push_back(NumberFormat::format_type(TraceBinaryImp::column_format(type)));
+            }
+        }
+        output << m_meta_data;
+        output << string_join(m_column_name, "|") << "\n";
+        std::vector<double> row;
+        std::vector<std::string> text;
+        std::string line;
+        char value[NumberFormat::M_MAX_SIZE];
+        while (next(row, text)) {
+            line.clear();
+            for (size_t col_idx = 0; col_idx != row.size(); ++col_idx) {
+                if (col_idx) {
+                    line += '|';
+                }
+                if (format[col_idx] != NumberFormat::M_FORMAT_CUSTOM) {
+                    line.append(value, NumberFormat::format(format[col_idx], row[col_idx], value));
+                }
+                else {
+                    // Custom columns were printed by the writer
+                    line += text[col_idx];
+                }
+            }
+            line += '\n';
+            output << line;
+        }
+    }
+}
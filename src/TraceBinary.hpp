@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TRACEBINARY_HPP_INCLUDE
+#define TRACEBINARY_HPP_INCLUDE
+
+#include <stdint.h>
+
+#include <vector>
+#include <functional>
+#include <string>
+#include <fstream>
+
+#include "CSV.hpp"
+
+namespace geopm
+{
+    /// @brief Binary columnar alternative to the CSV trace file.
+    ///
+    /// The file begins with a header: the eight byte magic string
+    /// "GEOPMTRB", a 32 bit format version, 32 bit flags, the
+    /// length prefixed meta-data text (the same "# key: value"
+    /// lines that begin a CSV trace), the 32 bit number of columns
+    /// and then a typed schema entry for each column: the 32 bit
+    /// column type followed by the length prefixed column name.
+    /// All integers are stored in host byte order.
+    ///
+    /// Each row is a fixed width record of one 64 bit IEEE double per
+    /// column.  A column added with a format function that is not one
+    /// of the geopm::string_format_*() functions has the custom type;
+    /// its value is also printed when the row is written and the
+    /// length prefixed text follows the record, so the CSV text of
+    /// the column can be reproduced exactly.  Without compression the
+    /// records follow the header back to back.  With compression the
+    /// rows are grouped into blocks that begin with the 32 bit row
+    /// count and the 32 bit payload size, and the text of the custom
+    /// columns for every row of the block follows the payload.  Each
+    /// block payload is stored column by column, every value is
+    /// XORed with the value in the previous row of the same column,
+    /// the bytes of the column are split into eight planes by
+    /// significance, and runs of zero bytes in the result are run
+    /// length encoded.  Slowly varying telemetry leaves the
+    /// sign, exponent and leading mantissa bits unchanged from row to
+    /// row, so the high order planes are mostly zero.
+    ///
+    /// The file is written by the shared AsyncWriter I/O thread in
+    /// the same way as a CSVImp file.
+    class TraceBinaryImp : public CSV
+    {
+        public:
+            enum m_column_type_e {
+                M_COLUMN_DOUBLE,
+                M_COLUMN_FLOAT,
+                M_COLUMN_INTEGER,
+                M_COLUMN_HEX,
+                M_COLUMN_RAW64,
+                M_COLUMN_CUSTOM,
+                M_NUM_COLUMN_TYPE,
+            };
+            enum m_flag_e {
+                M_FLAG_COMPRESSED = 1,
+            };
+            /// @brief String at the start of every binary trace.
+            static const std::string M_MAGIC;
+            /// @brief Version of the format written.
+            static constexpr uint32_t M_VERSION = 1;
+            /// @brief Number of rows in a compressed block.
+            static constexpr uint32_t M_BLOCK_ROWS = 1024;
+
+            /// @param [in] file_path Path to the trace file; the host
+            ///        name is appended as it is for a CSV trace.
+            /// @param [in] host_name Name of the compute node.
+            /// @param [in] start_time Time string recorded in the
+            ///        meta-data.
+            /// @param [in] buffer_size Number of bytes to buffer
+            ///        before the buffer is written to the file.
+            /// @param [in] is_compressed Whether the rows are stored
+            ///        in compressed blocks.
+            TraceBinaryImp(const std::string &file_path,
+                           const std::string &host_name,
+                           const std::string &start_time,
+                           size_t buffer_size,
+                           bool is_compressed);
+            virtual ~TraceBinaryImp();
+            void add_column(const std::string &name) override;
+            void add_column(const std::string &name,
+                            const std::string &format) override;
+            /// @brief Add a column; the column type is determined by
+            ///        which of the geopm::string_format_*() functions
+            ///        is passed.  Any other format function makes a
+            ///        custom column that also stores the formatted
+            ///        text of each value.
+            void add_column(const std::string &name,
+                            std::function<std::string(double)> format) override;
+            void add_meta_data(const std::string &key,
+                               const std::string &value) override;
+            void activate(void) override;
+            void update(const std::vector<double> &sample) override;
+            void flush(void) override;
+            /// @brief Column type recorded in the schema for a format
+            ///        function.
+            static int column_type(const std::function<std::string(double)> &format);
+            /// @brief Format function used to print a column type
+            ///        other than M_COLUMN_CUSTOM.
+            static std::function<std::string(double)> column_format(int column_type);
+            /// @brief Compress one block of rows.
+            /// @param [in] rows Row major block of values.
+            /// @param [in] num_column Number of values in each row.
+            /// @return Compressed block payload.
+            static std::string compress_block(const std::vector<double> &rows,
+                                              size_t num_column);
+            /// @brief Inverse of compress_block().
+            /// @param [in] payload Compressed block payload.
+            /// @param [in] num_row Number of rows in the block.
+            /// @param [in] num_column Number of values in each row.
+            /// @param [out] rows Row major block of values.
+            static void decompress_block(const std::string &payload,
+                                         size_t num_row,
+                                         size_t num_column,
+                                         std::vector<double> &rows);
+        private:
+            void write_block(void);
+
+            static constexpr size_t M_MAX_PENDING = 2;
+            const bool m_is_compressed;
+            std::string m_file_path;
+            std::string m_meta_data;
+            std::vector<std::string> m_column_name;
+            std::vector<int> m_column_type;
+            std::vector<size_t> m_custom_idx;
+            std::vector<std::function<std::string(double)> > m_custom_format;
+            std::vector<double> m_block;
+            std::string m_block_text;
+            int m_file_handle;
+            std::string m_buffer;
+            size_t m_buffer_limit;
+            bool m_is_active;
+    };
+
+    /// @brief Reads a trace file written by TraceBinaryImp.
+    class TraceBinaryReader
+    {
+        public:
+            /// @param [in] file_path Full path to the binary trace,
+            ///        including the host name suffix.
+            TraceBinaryReader(const std::string &file_path);
+            virtual ~TraceBinaryReader() = default;
+            /// @brief Meta-data lines, each terminated by a newline.
+            std::string meta_data(void) const;
+            /// @brief Column names in schema order.
+            std::vector<std::string> column_names(void) const;
+            /// @brief Column types in schema order; one of the
+            ///        TraceBinaryImp::m_column_type_e values.
+            std::vector<int> column_types(void) const;
+            /// @brief Whether the rows are stored in compressed blocks.
+            bool is_compressed(void) const;
+            /// @brief Read the next row of the trace.
+            /// @param [out] row Values for each column.
+            /// @return False if there are no more rows.
+            bool next(std::vector<double> &row);
+            /// @brief Read the next row of the trace and the text
+            ///        stored for its custom columns.
+            /// @param [out] row Values for each column.
+            /// @param [out] text Formatted value for each
+            ///        M_COLUMN_CUSTOM column; empty for other columns.
+            /// @return False if there are no more rows.
+            bool next(std::vector<double> &row, std::vector<std::string> &text);
+            /// @brief Write the trace in the pipe delimited CSV
+            ///        format that CSVImp produces.
+            /// @param [in] output Stream to write the CSV text.
+            void write_csv(std::ostream &output);
+        private:
+            uint32_t read_uint32(void);
+            std::string read_string(void);
+
+            std::ifstream m_stream;
+            std::string m_file_path;
+            std::string m_meta_data;
+            std::vector<std::string> m_column_name;
+            std::vector<int> m_column_type;
+            std::vector<size_t> m_custom_idx;
+            bool m_is_compressed;
+            std::vector<double> m_block;
+            std::vector<std::string> m_block_text;
+            size_t m_block_num_row;
+            size_t m_block_row;
+    };
+}
+
+#endif
@@ -41,13 +41,17 @@
 #include <iostream>
 #include <algorithm>
 #include <time.h>
+#include <cmath>
 
 #include "PlatformIO.hpp"
 #include "PlatformTopo.hpp"
 #include "Exception.hpp"
 #include "Helper.hpp"
 #include "Environment.hpp"
+#include "LatencyHistogram.hpp"
+#include "TraceBinary.hpp"
 #include "geopm_hash.h"
+#include "geopm_time.h"
 #include "geopm_version.h"
 #include "geopm.h"
 #include "geopm_internal.h"
@@ -58,7 +62,8 @@ namespace geopm
     TracerImp::TracerImp(const std::string &start_time)
         : TracerImp(start_time, environment().trace(), hostname(),
                     environment().do_trace(), platform_io(), platform_topo(),
-                    environment().trace_signals())
+                    environment().trace_signals(), environment().trace_format(),
+                    environment().trace_mode())
     {
 
     }
@@ -69,15 +74,71 @@ namespace geopm
                          bool do_trace,
                          PlatformIO &platform_io,
                          const PlatformTopo &platform_topo,
-                         const std::string &env_column)
+                         const std::string &env_column,
+                         const std::string &format,
+                         const std::string &mode)
         : m_is_trace_enabled(do_trace)
         , m_platform_io(platform_io)
         , m_platform_topo(platform_topo)
         , m_env_column(env_column)
-        , M_BUFFER_SIZE(134217728) // 128 MiB
+        , M_BUFFER_SIZE(1048576) // 1 MiB
+        , m_is_mode_all(true)
+        , m_is_mode_region(false)
+        , m_mode_every(0)
+        , m_num_step(0)
+        , m_is_row_pending(false)
     {
         if (m_is_trace_enabled) {
-            m_csv = make_unique<CSVImp>(file_path, hostname, start_time, M_BUFFER_SIZE);
+            if (format == "" || format == "csv") {
+                m_csv = make_unique<CSVImp>(file_path, hostname, start_time, M_BUFFER_SIZE);
+            }
+            else if (format == "binary" || format == "binary-compressed") {
+                m_csv = make_unique<TraceBinaryImp>(file_path, hostname, start_time, M_BUFFER_SIZE,
+                                                    format == "binary-compressed");
+            }
+            else {
+                throw Exception("TracerImp::TracerImp(): unknown trace format: " + format,
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
+            parse_mode(mode);
+            if (!m_is_mode_all) {
+                m_csv->add_meta_data("trace_mode", mode);
+            }
+        }
+    }
+
+    void TracerImp::parse_mode(const std::string &mode)
+    {
+        if (mode == "" || mode == "all") {
+            return;
+        }
+        m_is_mode_all = false;
+        for (const auto &cond : string_split(mode, ",")) {
+            if (cond == "all") {
+                m_is_mode_all = true;
+            }
+            else if (cond == "region") {
+                m_is_mode_region = true;
+            }
+            else if (string_begins_with(cond, "every:")) {
+                try {
+                    m_mode_every = std::stoi(cond.substr(strlen("every:")));
+                }
+                catch (const std::exception &) {
+                    m_mode_every = 0;
+                }
+                if (m_mode_every <= 0) {
+                    throw Exception("TracerImp::parse_mode(): invalid step count in trace mode: " + cond,
+                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+            }
+            else if (string_begins_with(cond, "change:") && cond.size() > strlen("change:")) {
+                m_mode_change_name.push_back(cond.substr(strlen("change:")));
+            }
+            else {
+                throw Exception("TracerImp::parse_mode(): invalid trace mode condition: \"" + cond + "\"",
+                                GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+            }
         }
     }
 
@@ -147,6 +208,7 @@ namespace geopm
                 }
             }
             // set up columns to be sampled by TracerImp
+            std::vector<std::string> column_names;
             for (const auto &col : base_columns) {
                 m_column_idx.push_back(m_platform_io.push_signal(col.name,
                                                                  col.domain_type,
@@ -157,15 +219,25 @@ namespace geopm
                     column_name += "-" + std::to_string(col.domain_idx);
                 }
                 m_csv->add_column(column_name, col.format);
+                column_names.push_back(column_name);
             }
             // columns from agent; will be sampled by agent
             size_t num_col = agent_cols.size();
             for (size_t col_idx = 0; col_idx != num_col; ++col_idx) {
                 std::function<std::string(double)> format = col_formats.size() ? col_formats.at(col_idx) : string_format_double;
                 m_csv->add_column(agent_cols.at(col_idx), format);
+                column_names.push_back(agent_cols.at(col_idx));
             }
             m_csv->activate();
             m_last_telemetry.resize(base_columns.size() + num_col);
+            for (const auto &name : m_mode_change_name) {
+                auto it = std::find(column_names.begin(), column_names.end(), name);
+                if (it == column_names.end()) {
+                    throw Exception("TracerImp::columns(): trace mode refers to unknown column: " + name,
+                                    GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+                }
+                m_mode_change_idx.push_back(it - column_names.begin());
+            }
         }
     }
 
@@ -173,6 +245,8 @@ namespace geopm
                            std::list<geopm_region_info_s> region_entry_exit)
     {
         if (m_is_trace_enabled) {
+            struct geopm_time_s begin;
+            geopm_time(&begin);
 #ifdef GEOPM_DEBUG
             if (m_column_idx.size() == 0) {
                 throw Exception("TracerImp::update(): No columns added to trace.",
@@ -184,10 +258,9 @@ namespace geopm
             }
 #endif
             // save values to be reused for region entry/exit
-            size_t col_idx = 0;
-            for (; col_idx < m_column_idx.size(); ++col_idx) {
-                m_last_telemetry[col_idx] = m_platform_io.sample(m_column_idx[col_idx]);
-            }
+            m_platform_io.sample_all(m_column_idx, m_column_value);
+            std::copy(m_column_value.begin(), m_column_value.end(), m_last_telemetry.begin());
+            size_t col_idx = m_column_value.size();
             for (const auto &val : agent_values) {
                 m_last_telemetry[col_idx] = val;
                 ++col_idx;
@@ -226,13 +299,59 @@ namespace geopm
             m_last_telemetry[m_region_progress_idx] = region_progress;
             m_last_telemetry[m_region_runtime_idx] = region_runtime;
 #endif // GEOPM_TRACE_BLOAT
-            m_csv->update(m_last_telemetry);
+            if (is_row_selected(region_entry_exit)) {
+                write_row();
+            }
+            else {
+                m_is_row_pending = true;
+            }
+            ++m_num_step;
+            controller_latency().update(ControllerLatency::M_PHASE_TRACE_UPDATE,
+                                        geopm_time_since(&begin));
+        }
+    }
+
+    bool TracerImp::is_row_selected(const std::list<geopm_region_info_s> &region_entry_exit) const
+    {
+        if (m_is_mode_all || m_last_written.empty()) {
+            return true;
+        }
+        if (m_mode_every && m_num_step % (uint64_t)m_mode_every == 0) {
+            return true;
+        }
+        if (m_is_mode_region &&
+            (!region_entry_exit.empty() ||
+             m_last_telemetry[m_region_hash_idx] != m_last_written[m_region_hash_idx] ||
+             m_last_telemetry[m_region_hint_idx] != m_last_written[m_region_hint_idx])) {
+            return true;
+        }
+        for (const auto &idx : m_mode_change_idx) {
+            double curr = m_last_telemetry[idx];
+            double last = m_last_written[idx];
+            // NAN does not change into NAN
+            if (curr != last && !(std::isnan(curr) && std::isnan(last))) {
+                return true;
+            }
         }
+        return false;
+    }
+
+    void TracerImp::write_row(void)
+    {
+        m_csv->update(m_last_telemetry);
+        if (!m_is_mode_all) {
+            m_last_written = m_last_telemetry;
+        }
+        m_is_row_pending = false;
     }
 
     void TracerImp::flush(void)
     {
         if (m_is_trace_enabled) {
+            // the final state is always in the trace
+            if (m_is_row_pending) {
+                write_row();
+            }
             m_csv->flush();
         }
     }
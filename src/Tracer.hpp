@@ -33,6 +33,8 @@
 #ifndef TRACER_HPP_INCLUDE
 #define TRACER_HPP_INCLUDE
 
+#include <stdint.h>
+
 #include <fstream>
 #include <string>
 #include <vector>
@@ -69,6 +71,8 @@ namespace geopm
             ///        regions recorded by the application.  There may
             ///        be multiple entires and exits for each
             ///        telemetry sample.
+            ///        Depending on the trace mode the row may not be
+            ///        written.
             virtual void update(const std::vector<double> &agent_signals,
                                 std::list<geopm_region_info_s> region_entry_exit) = 0;
             /// @brief Write the remaining trace data to the file and
@@ -81,6 +85,19 @@ namespace geopm
     class CSV;
 
     /// @brief Class used to write a trace of the telemetry and policy.
+    ///
+    /// The trace mode selects which control loop steps produce a
+    /// row.  It is a comma separated list of conditions and a row is
+    /// written if any of them holds:
+    ///   - "all": every step; the default when the mode is empty.
+    ///   - "region": a region was entered or exited, or the region
+    ///     hash or hint changed.
+    ///   - "every:N": every Nth step.
+    ///   - "change:COLUMN": the value in the named trace column
+    ///     differs from the last row written.
+    /// The first step and the last step before flush() are always
+    /// written.  A mode other than "all" is recorded in the header
+    /// as "trace_mode".
     class TracerImp : public Tracer
     {
         public:
@@ -92,7 +109,9 @@ namespace geopm
                       bool do_trace,
                       PlatformIO &platform_io,
                       const PlatformTopo &platform_topo,
-                      const std::string &env_column);
+                      const std::string &env_column,
+                      const std::string &format,
+                      const std::string &mode);
             /// @brief TracerImp destructor, virtual.
             virtual ~TracerImp() = default;
             void columns(const std::vector<std::string> &agent_cols,
@@ -111,6 +130,9 @@ namespace geopm
             std::vector<std::string> env_signals(void);
             std::vector<int> env_domains(void);
             std::vector<std::function<std::string(double)> > env_formats(void);
+            void parse_mode(const std::string &mode);
+            bool is_row_selected(const std::list<geopm_region_info_s> &region_entry_exit) const;
+            void write_row(void);
 
             std::string m_file_path;
             std::string m_header;
@@ -121,6 +143,7 @@ namespace geopm
             const PlatformTopo &m_platform_topo;
             std::string m_env_column; // extra columns from environment
             std::vector<int> m_column_idx; // columns sampled by TracerImp
+            std::vector<double> m_column_value;
             std::vector<double> m_last_telemetry;
             const size_t M_BUFFER_SIZE;
             std::unique_ptr<CSV> m_csv;
@@ -128,6 +151,14 @@ namespace geopm
             int m_region_hint_idx;
             int m_region_progress_idx;
             int m_region_runtime_idx;
+            bool m_is_mode_all;
+            bool m_is_mode_region;
+            int m_mode_every;
+            std::vector<std::string> m_mode_change_name;
+            std::vector<size_t> m_mode_change_idx;
+            std::vector<double> m_last_written;
+            uint64_t m_num_step;
+            bool m_is_row_pending;
     };
 }
 
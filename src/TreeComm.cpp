@@ -37,7 +37,9 @@
 #include <algorithm>
 #include <memory>
 #include <cmath>
+#include <thread>
 
+#include "geopm_time.h"
 #include "Environment.hpp"
 
 #include "Exception.hpp"
@@ -51,7 +53,11 @@ namespace geopm
     TreeCommImp::TreeCommImp(std::shared_ptr<Comm> comm,
                              int num_send_down,
                              int num_send_up)
-        : TreeCommImp(comm, fan_out(comm), 0, num_send_down, num_send_up, {})
+        : TreeCommImp(comm,
+                      environment().do_tree_auto_fan_out() ?
+                          fan_out_tuned(comm, num_send_down, num_send_up) :
+                          fan_out(comm),
+                      0, num_send_down, num_send_up, {})
     {
 
     }
@@ -114,10 +120,12 @@ namespace geopm
         }
         for (; level < m_max_level; ++level) {
             parent_coords[root_level - 1 - level] = 0;
-            result.emplace_back(
-                new TreeCommLevelImp(comm_cart->split(
-                                         comm_cart->cart_rank(parent_coords), rank_cart),
-                                     m_num_send_up, m_num_send_down));
+            result.push_back(
+                TreeCommLevel::make_unique(comm_cart->split(
+                                               comm_cart->cart_rank(parent_coords), rank_cart),
+                                           m_num_send_up, m_num_send_down,
+                                           environment().do_tree_lock_free(),
+                                           environment().do_tree_sparse()));
         }
         for (; level < root_level; ++level) {
             comm_cart->split(Comm::M_SPLIT_COLOR_UNDEFINED, 0);
@@ -203,6 +211,15 @@ namespace geopm
         return result;
     }
 
+    size_t TreeCommImp::overhead_saved(void) const
+    {
+        size_t result = 0;
+        for (auto it = m_level_ctl.begin(); it != m_level_ctl.end(); ++it) {
+            result += (*it)->overhead_saved();
+        }
+        return result;
+    }
+
     std::vector<int> TreeComm::fan_out(const std::shared_ptr<Comm> &comm)
     {
         std::vector<int> fan_out;
@@ -228,4 +245,97 @@ namespace geopm
         }
         return fan_out;
     }
+
+    /// @brief Returns the mean time as seen by the calling rank for a
+    ///        round of messages through a tree of the given shape.
+    ///        In each round every rank sends a sample up to the
+    ///        root and waits for the policy that is sent back down
+    ///        once the samples of all of its children have arrived.
+    static double time_tree(const std::shared_ptr<Comm> &comm, const std::vector<int> &fan_out,
+                            int num_send_down, int num_send_up)
+    {
+        // Rounds are told apart by the value of the first element,
+        // so empty messages are timed with one element
+        num_send_down = std::max(num_send_down, 1);
+        num_send_up = std::max(num_send_up, 1);
+        const int num_round = 16;
+        TreeCommImp tree(comm, fan_out, 0, num_send_down, num_send_up, {});
+        const int num_level_ctl = tree.num_level_controlled();
+        std::vector<std::vector<std::vector<double> > > child_sample(num_level_ctl);
+        for (int level = 0; level < num_level_ctl; ++level) {
+            child_sample[level].resize(tree.level_size(level), std::vector<double>(num_send_up));
+        }
+        std::vector<double> sample(num_send_up);
+        std::vector<double> policy(num_send_down);
+        geopm_time_s begin;
+        geopm_time(&begin);
+        // The first round is not timed
+        for (int round = 0; round <= num_round; ++round) {
+            if (round == 1) {
+                geopm_time(&begin);
+            }
+            std::fill(sample.begin(), sample.end(), round);
+            for (int level = 0; level < num_level_ctl; ++level) {
+                tree.send_up(level, sample);
+                while (!tree.receive_up(level, child_sample[level])) {
+                    std::this_thread::yield();
+                }
+            }
+            if (num_level_ctl != tree.root_level()) {
+                tree.send_up(num_level_ctl, sample);
+                while (!tree.receive_down(num_level_ctl, policy) || policy[0] != round) {
+                    std::this_thread::yield();
+                }
+            }
+            else {
+                std::fill(policy.begin(), policy.end(), round);
+            }
+            for (int level = num_level_ctl - 1; level >= 0; --level) {
+                tree.send_down(level, std::vector<std::vector<double> >(tree.level_size(level), policy));
+                tree.receive_down(level, policy);
+            }
+        }
+        return geopm_time_since(&begin) / num_round;
+    }
+
+    std::vector<std::vector<int> > TreeComm::fan_out_candidate(const std::shared_ptr<Comm> &comm)
+    {
+        std::vector<std::vector<int> > result;
+        int num_node = comm->num_rank();
+        const int max_fan_out = environment().max_fan_out();
+        for (int num_level = 1; num_level <= num_node; ++num_level) {
+            std::vector<int> fan_out(num_level, 0);
+            comm->dimension_create(num_node, fan_out);
+            if (fan_out.back() == 1) {
+                // No more levels can be added
+                break;
+            }
+            if (fan_out.front() <= max_fan_out) {
+                std::reverse(fan_out.begin(), fan_out.end());
+                result.push_back(fan_out);
+            }
+        }
+        return result;
+    }
+
+    std::vector<int> TreeComm::fan_out_tuned(const std::shared_ptr<Comm> &comm,
+                                             int num_send_down,
+                                             int num_send_up)
+    {
+        std::vector<std::vector<int> > candidate = fan_out_candidate(comm);
+        if (candidate.empty()) {
+            return fan_out(comm);
+        }
+        std::vector<double> latency(candidate.size(), 0.0);
+        for (size_t idx = 0; idx != candidate.size(); ++idx) {
+            latency[idx] = time_tree(comm, candidate[idx], num_send_down, num_send_up);
+        }
+        // A round is as slow as the slowest rank, and every rank
+        // must choose the same tree
+        std::vector<double> max_latency(latency.size(), 0.0);
+        comm->reduce_max(latency.data(), max_latency.data(), latency.size(), 0);
+        comm->broadcast(max_latency.data(), sizeof(double) * max_latency.size(), 0);
+        auto min_it = std::min_element(max_latency.begin(), max_latency.end());
+        return candidate[std::distance(max_latency.begin(), min_it)];
+    }
 }
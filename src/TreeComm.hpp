@@ -77,8 +77,38 @@ namespace geopm
             /// @brief Returns the total number of bytes sent from the
             ///        entire tree.
             virtual size_t overhead_send(void) const = 0;
+            /// @brief Returns the total number of bytes that were not
+            ///        sent from the entire tree because they were
+            ///        unchanged since the previous message.
+            virtual size_t overhead_saved(void) const = 0;
             /// @brief Returns the number of children at each level.
             static std::vector<int> fan_out(const std::shared_ptr<Comm> &comm);
+            /// @brief Returns the number of children at each level
+            ///        chosen to minimize the latency of messages
+            ///        between the root and the leaves.
+            ///
+            /// Each of the trees given by fan_out_candidate() is
+            /// built and timed while samples and policies of the
+            /// given sizes are passed between the root and the
+            /// leaves, and the fastest is chosen.  Must be called by
+            /// all ranks of comm.  Falls back to fan_out() if there
+            /// is no candidate.
+            ///
+            /// @param [in] comm Communicator with one rank per node.
+            ///
+            /// @param [in] num_send_down Number of policy values
+            ///        sent to each child.
+            ///
+            /// @param [in] num_send_up Number of samples sent to the
+            ///        parent.
+            static std::vector<int> fan_out_tuned(const std::shared_ptr<Comm> &comm,
+                                                  int num_send_down,
+                                                  int num_send_up);
+            /// @brief Returns the balanced tree for each number of
+            ///        levels in which no level is larger than
+            ///        GEOPM_MAX_FAN_OUT, in the same order as
+            ///        fan_out().
+            static std::vector<std::vector<int> > fan_out_candidate(const std::shared_ptr<Comm> &comm);
     };
 
     class TreeCommLevel;
@@ -106,6 +136,7 @@ namespace geopm
             bool receive_down(int level, std::vector<double> &policy) override;
             bool receive_up(int level, std::vector<std::vector<double> > &sample) override;
             size_t overhead_send(void) const override;
+            size_t overhead_saved(void) const override;
         private:
             int num_level_controlled(std::vector<int> coords);
             std::vector<std::unique_ptr<TreeCommLevel> > init_level(
@@ -38,11 +38,55 @@
 
 #include "Comm.hpp"
 #include "Exception.hpp"
+#include "Helper.hpp"
 #include "config.h"
 
 namespace geopm
 {
-    TreeCommLevelImp::TreeCommLevelImp(std::shared_ptr<Comm> comm, int num_send_up, int num_send_down)
+    std::unique_ptr<TreeCommLevel> TreeCommLevel::make_unique(std::shared_ptr<Comm> comm,
+                                                              int num_send_up,
+                                                              int num_send_down,
+                                                              bool is_lock_free,
+                                                              bool is_sparse)
+    {
+        std::unique_ptr<TreeCommLevel> result;
+        if (is_lock_free) {
+            result = geopm::make_unique<TreeCommLevelSequenceImp>(comm, num_send_up, num_send_down, is_sparse);
+        }
+        else {
+            result = geopm::make_unique<TreeCommLevelImp>(comm, num_send_up, num_send_down, is_sparse);
+        }
+        return result;
+    }
+
+    /// @brief Returns the [begin, end) index ranges of the values in
+    ///        a message that differ from the copy held by the
+    ///        receiver.
+    ///
+    /// Values are compared bit for bit so that a NAN which was
+    /// already sent is not sent again.  Ranges separated by a single
+    /// unchanged value are joined because an extra put costs more
+    /// than one value.
+    static std::vector<std::pair<size_t, size_t> > changed_range(const std::vector<double> &message,
+                                                                 const std::vector<double> &remote)
+    {
+        std::vector<std::pair<size_t, size_t> > result;
+        size_t num_value = message.size();
+        for (size_t idx = 0; idx != num_value; ++idx) {
+            if (memcmp(&message[idx], &remote[idx], sizeof(double)) != 0) {
+                if (!result.empty() && idx - result.back().second <= 1) {
+                    result.back().second = idx + 1;
+                }
+                else {
+                    result.emplace_back(idx, idx + 1);
+                }
+            }
+        }
+        return result;
+    }
+
+    TreeCommLevelImp::TreeCommLevelImp(std::shared_ptr<Comm> comm, int num_send_up, int num_send_down,
+                                       bool is_sparse)
         : m_comm(comm)
         , m_size(comm->num_rank())
         , m_rank(comm->rank())
@@ -51,12 +95,21 @@ namespace geopm
         , m_sample_window(0)
         , m_policy_window(0)
         , m_overhead_send(0)
+        , m_overhead_saved(0)
         , m_num_send_up(num_send_up)
         , m_num_send_down(num_send_down)
+        , m_is_sparse(is_sparse)
     {
         if (!m_rank) {
             m_policy_last.resize(m_size, std::vector<double>(num_send_down, NAN));
         }
+        if (m_is_sparse) {
+            // Mailboxes are zero filled when they are created
+            m_sample_remote.resize(num_send_up, 0.0);
+            if (!m_rank) {
+                m_policy_remote.resize(m_size, std::vector<double>(num_send_down, 0.0));
+            }
+        }
         create_window();
     }
 
@@ -92,9 +145,11 @@ namespace geopm
             size_t base_off = m_rank * (msg_size + sizeof(double));
             m_comm->window_lock(m_sample_window, true, 0, 0);
             m_comm->window_put(&is_ready, sizeof(double), 0, base_off, m_sample_window);
-            m_comm->window_put(sample.data(), msg_size, 0, base_off + sizeof(double), m_sample_window);
+            size_t put_size = put_message(m_sample_window, 0, base_off + sizeof(double),
+                                          sample, m_sample_remote);
             m_comm->window_unlock(m_sample_window, 0);
-            m_overhead_send += sizeof(double) + msg_size;
+            m_overhead_send += sizeof(double) + put_size;
+            m_overhead_saved += msg_size - put_size;
         }
         else {
             m_sample_mailbox[0] = 1.0;
@@ -128,9 +183,11 @@ namespace geopm
             if (policy[child_rank] != m_policy_last[child_rank]) {
                 m_comm->window_lock(m_policy_window, true, child_rank, 0);
                 m_comm->window_put(&is_ready, sizeof(double), child_rank, 0, m_policy_window);
-                m_comm->window_put(policy[child_rank].data(), msg_size, child_rank, sizeof(double), m_policy_window);
+                size_t put_size = put_message(m_policy_window, child_rank, sizeof(double),
+                                              policy[child_rank], m_policy_remote[child_rank]);
                 m_comm->window_unlock(m_policy_window, child_rank);
-                m_overhead_send += sizeof(double) + msg_size;
+                m_overhead_send += sizeof(double) + put_size;
+                m_overhead_saved += msg_size - put_size;
                 m_policy_last[child_rank] = policy[child_rank];
             }
         }
@@ -207,6 +264,30 @@ namespace geopm
         return m_overhead_send;
     }
 
+    size_t TreeCommLevelImp::overhead_saved(void) const
+    {
+        return m_overhead_saved;
+    }
+
+    size_t TreeCommLevelImp::put_message(size_t window, int target, size_t offset,
+                                         const std::vector<double> &message,
+                                         std::vector<double> &remote)
+    {
+        std::vector<std::pair<size_t, size_t> > range {{0, message.size()}};
+        if (m_is_sparse) {
+            range = changed_range(message, remote);
+            remote = message;
+        }
+        size_t result = 0;
+        for (const auto &rr : range) {
+            size_t put_size = sizeof(double) * (rr.second - rr.first);
+            m_comm->window_put(message.data() + rr.first, put_size, target,
+                               offset + sizeof(double) * rr.first, window);
+            result += put_size;
+        }
+        return result;
+    }
+
     void TreeCommLevelImp::create_window()
     {
         // Create policy window
@@ -231,4 +312,248 @@ namespace geopm
             m_sample_window = m_comm->window_create(0, NULL);
         }
     }
+
+    TreeCommLevelSequenceImp::TreeCommLevelSequenceImp(std::shared_ptr<Comm> comm, int num_send_up, int num_send_down,
+                                                       bool is_sparse)
+        : m_comm(comm)
+        , m_size(comm->num_rank())
+        , m_rank(comm->rank())
+        , m_sample_mailbox(nullptr)
+        , m_policy_mailbox(nullptr)
+        , m_sample_window(0)
+        , m_policy_window(0)
+        , m_overhead_send(0)
+        , m_overhead_saved(0)
+        , m_num_send_up(num_send_up)
+        , m_num_send_down(num_send_down)
+        , m_is_sparse(is_sparse)
+        , m_sample_sequence(0.0)
+        , m_policy_sequence(0.0)
+    {
+        if (!m_rank) {
+            m_policy_last.resize(m_size, std::vector<double>(num_send_down, NAN));
+            m_sample_received.resize(m_size, 0.0);
+        }
+        if (m_is_sparse) {
+            // Mailboxes are zero filled when they are created
+            m_sample_remote.resize(num_send_up, 0.0);
+            if (!m_rank) {
+                m_policy_remote.resize(m_size, std::vector<double>(num_send_down, 0.0));
+            }
+        }
+        create_window();
+    }
+
+    TreeCommLevelSequenceImp::~TreeCommLevelSequenceImp()
+    {
+        m_comm->barrier();
+        m_comm->window_unlock_all(m_sample_window);
+        m_comm->window_destroy(m_sample_window);
+        if (m_sample_mailbox) {
+            m_comm->free_mem(m_sample_mailbox);
+        }
+        m_comm->window_unlock_all(m_policy_window);
+        m_comm->window_destroy(m_policy_window);
+        if (m_policy_mailbox) {
+            m_comm->free_mem(m_policy_mailbox);
+        }
+    }
+
+    int TreeCommLevelSequenceImp::level_rank(void) const
+    {
+        return m_rank;
+    }
+
+    void TreeCommLevelSequenceImp::send_up(const std::vector<double> &sample)
+    {
+        if (sample.size() != m_num_send_up) {
+            throw Exception("TreeCommLevelSequenceImp::send_up(): sample vector is not sized correctly.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_sample_sequence += 1.0;
+        if (m_rank) {
+            size_t slot_size = sizeof(double) * (m_num_send_up + 2);
+            size_t put_size = slot_put(m_sample_window, 0, m_rank * slot_size,
+                                       m_sample_sequence, sample, m_sample_remote);
+            m_overhead_send += put_size;
+            m_overhead_saved += slot_size - put_size;
+        }
+        else {
+            slot_write(m_sample_mailbox, m_sample_sequence, sample);
+        }
+    }
+
+    void TreeCommLevelSequenceImp::send_down(const std::vector<std::vector<double> > &policy)
+    {
+#ifdef GEOPM_DEBUG
+        if (m_rank != 0) {
+            throw Exception("TreeCommLevelSequenceImp::send_down() called from rank not at root of level",
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+#endif
+        size_t num_down = m_num_send_down;
+        if (m_size != (int)policy.size() ||
+            std::any_of(policy.begin(), policy.end(),
+                        [num_down](const std::vector<double> &it)
+                        {return it.size() != num_down;})) {
+            throw Exception("TreeCommLevelSequenceImp::send_down(): policy vector is not sized correctly.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        m_policy_sequence += 1.0;
+        // Copy message to self for rank zero
+        slot_write(m_policy_mailbox, m_policy_sequence, policy[0]);
+        for (int child_rank = 1; child_rank != m_size; ++child_rank) {
+            if (policy[child_rank] != m_policy_last[child_rank]) {
+                size_t put_size = slot_put(m_policy_window, child_rank, 0, m_policy_sequence,
+                                           policy[child_rank], m_policy_remote[child_rank]);
+                m_overhead_send += put_size;
+                m_overhead_saved += sizeof(double) * (m_num_send_down + 2) - put_size;
+                m_policy_last[child_rank] = policy[child_rank];
+            }
+        }
+    }
+
+    bool TreeCommLevelSequenceImp::receive_up(std::vector<std::vector<double> > &sample)
+    {
+#ifdef GEOPM_DEBUG
+        if (m_rank != 0) {
+            throw Exception("TreeCommLevelSequenceImp::receive_up(): Only zero rank of the level can call receive_up()",
+                            GEOPM_ERROR_LOGIC, __FILE__, __LINE__);
+        }
+#endif
+        size_t num_up = m_num_send_up;
+        if (m_size != (int)sample.size() ||
+            std::any_of(sample.begin(), sample.end(),
+                        [num_up](const std::vector<double> &it)
+                        {return it.size() != num_up;})) {
+            throw Exception("TreeCommLevelSequenceImp::receive_up(): sample vector is not sized correctly.",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+        size_t slot_len = m_num_send_up + 2;
+        bool is_complete = true;
+        m_comm->window_sync(m_sample_window);
+        for (int child_rank = 0; is_complete && child_rank < m_size; ++child_rank) {
+            const double *slot = m_sample_mailbox + child_rank * slot_len;
+            if (slot[slot_len - 1] == m_sample_received[child_rank]) {
+                is_complete = false;
+            }
+        }
+        if (is_complete) {
+            for (int child_rank = 0; child_rank != m_size; ++child_rank) {
+                m_sample_received[child_rank] =
+                    slot_read(m_sample_window, m_sample_mailbox + child_rank * slot_len,
+                              sample[child_rank]);
+            }
+        }
+        is_complete = is_complete &&
+                      std::none_of(sample.begin(), sample.end(),
+                                   [](const std::vector<double> &vec)
+                                   {
+                                       return std::any_of(vec.begin(), vec.end(),
+                                                          [](double val){return std::isnan(val);});
+                                   });
+        return is_complete;
+    }
+
+    bool TreeCommLevelSequenceImp::receive_down(std::vector<double> &policy)
+    {
+        bool is_complete = false;
+        m_comm->window_sync(m_policy_window);
+        if (m_policy_mailbox[m_num_send_down + 1] != 0.0) {
+            is_complete = true;
+            policy.resize(m_num_send_down);
+            slot_read(m_policy_window, m_policy_mailbox, policy);
+        }
+        is_complete = is_complete &&
+                      std::none_of(policy.begin(), policy.end(),
+                                   [](double val){return std::isnan(val);});
+        return is_complete;
+    }
+
+    size_t TreeCommLevelSequenceImp::overhead_send(void) const
+    {
+        return m_overhead_send;
+    }
+
+    size_t TreeCommLevelSequenceImp::overhead_saved(void) const
+    {
+        return m_overhead_saved;
+    }
+
+    void TreeCommLevelSequenceImp::slot_write(double *slot, double sequence,
+                                              const std::vector<double> &message)
+    {
+        slot[0] = sequence;
+        std::copy(message.begin(), message.end(), slot + 1);
+        slot[message.size() + 1] = sequence;
+    }
+
+    size_t TreeCommLevelSequenceImp::slot_put(size_t window, int target, size_t offset,
+                                              double sequence,
+                                              const std::vector<double> &message,
+                                              std::vector<double> &remote)
+    {
+        std::vector<std::pair<size_t, size_t> > range {{0, message.size()}};
+        if (m_is_sparse) {
+            range = changed_range(message, remote);
+            remote = message;
+        }
+        // Puts to the same target are not ordered, so the message
+        // is flushed before and after it is written.
+        size_t msg_size = sizeof(double) * message.size();
+        size_t result = 2 * sizeof(double);
+        m_comm->window_put(&sequence, sizeof(double), target, offset, window);
+        m_comm->window_flush(window, target);
+        for (const auto &rr : range) {
+            size_t put_size = sizeof(double) * (rr.second - rr.first);
+            m_comm->window_put(message.data() + rr.first, put_size, target,
+                               offset + sizeof(double) * (rr.first + 1), window);
+            result += put_size;
+        }
+        m_comm->window_flush(window, target);
+        m_comm->window_put(&sequence, sizeof(double), target, offset + sizeof(double) + msg_size, window);
+        m_comm->window_flush(window, target);
+        return result;
+    }
+
+    double TreeCommLevelSequenceImp::slot_read(size_t window, const double *slot,
+                                               std::vector<double> &message) const
+    {
+        size_t num_value = message.size();
+        double sequence_begin = 0.0;
+        double sequence_end = 0.0;
+        do {
+            sequence_end = slot[num_value + 1];
+            m_comm->window_sync(window);
+            std::copy(slot + 1, slot + 1 + num_value, message.begin());
+            m_comm->window_sync(window);
+            sequence_begin = slot[0];
+        } while (sequence_begin != sequence_end);
+        return sequence_end;
+    }
+
+    void TreeCommLevelSequenceImp::create_window(void)
+    {
+        // Each slot is framed by two sequence numbers
+        size_t mem_size = sizeof(double) * (m_num_send_down + 2);
+        m_comm->alloc_mem(mem_size, (void **)(&m_policy_mailbox));
+        memset(m_policy_mailbox, 0, mem_size);
+        if (m_rank) {
+            m_policy_window = m_comm->window_create(mem_size, (void *)(m_policy_mailbox));
+        }
+        else {
+            m_policy_window = m_comm->window_create(0, NULL);
+        }
+        mem_size = sizeof(double) * m_size * (m_num_send_up + 2);
+        m_comm->alloc_mem(mem_size, (void **)(&m_sample_mailbox));
+        memset(m_sample_mailbox, 0, mem_size);
+        if (!m_rank) {
+            m_sample_window = m_comm->window_create(mem_size, (void *)(m_sample_mailbox));
+        }
+        else {
+            m_sample_window = m_comm->window_create(0, NULL);
+        }
+        m_comm->window_lock_all(m_policy_window, 0);
+        m_comm->window_lock_all(m_sample_window, 0);
+    }
 }
@@ -38,6 +38,8 @@
 
 namespace geopm
 {
+    class Comm;
+
     class TreeCommLevel
     {
         public:
@@ -56,14 +58,45 @@ namespace geopm
             /// @brief Returns the total number of bytes sent at this
             ///        level.
             virtual size_t overhead_send(void) const = 0;
+            /// @brief Returns the total number of bytes at this
+            ///        level that were not sent because they were
+            ///        unchanged since the previous message.
+            virtual size_t overhead_saved(void) const = 0;
+            /// @brief Returns a unique_ptr to a concrete object
+            ///        constructed using the underlying implementation
+            ///        selected by the is_lock_free parameter.
+            ///
+            /// @param [in] comm Communicator for the ranks in the
+            ///        level.
+            ///
+            /// @param [in] num_send_up Number of samples sent to the
+            ///        parent.
+            ///
+            /// @param [in] num_send_down Number of policy values
+            ///        sent to each child.
+            ///
+            /// @param [in] is_lock_free If true messages are posted
+            ///        to sequence numbered mailboxes under a single
+            ///        epoch held for the lifetime of the level,
+            ///        otherwise each message is sent and received
+            ///        under its own window lock.
+            ///
+            /// @param [in] is_sparse If true only the values that
+            ///        differ from the previous message sent to a
+            ///        rank are written to its mailbox, otherwise
+            ///        every message is written in full.
+            static std::unique_ptr<TreeCommLevel> make_unique(std::shared_ptr<Comm> comm,
+                                                              int num_send_up,
+                                                              int num_send_down,
+                                                              bool is_lock_free,
+                                                              bool is_sparse);
     };
 
-    class Comm;
-
     class TreeCommLevelImp : public TreeCommLevel
     {
         public:
-            TreeCommLevelImp(std::shared_ptr<Comm> comm, int num_send_up, int num_send_down);
+            TreeCommLevelImp(std::shared_ptr<Comm> comm, int num_send_up, int num_send_down,
+                             bool is_sparse);
             virtual ~TreeCommLevelImp();
             int level_rank(void) const override;
             void send_up(const std::vector<double> &sample) override;
@@ -71,7 +104,15 @@ namespace geopm
             bool receive_up(std::vector<std::vector<double> > &sample) override;
             bool receive_down(std::vector<double> &policy) override;
             size_t overhead_send(void) const override;
+            size_t overhead_saved(void) const override;
         private:
+            /// @brief Write a message to the window of the target
+            ///        rank.
+            ///
+            /// @return Number of bytes written.
+            size_t put_message(size_t window, int target, size_t offset,
+                               const std::vector<double> &message,
+                               std::vector<double> &remote);
             void create_window();
             std::shared_ptr<Comm> m_comm;
             int m_size;
@@ -81,9 +122,88 @@ namespace geopm
             size_t m_sample_window;
             size_t m_policy_window;
             size_t m_overhead_send;
+            size_t m_overhead_saved;
+            std::vector<std::vector<double> > m_policy_last;
+            size_t m_num_send_up;
+            size_t m_num_send_down;
+            bool m_is_sparse;
+            /// Copy of the message held in the mailbox of the parent
+            std::vector<double> m_sample_remote;
+            /// Copy of the message held in the mailbox of each child
+            std::vector<std::vector<double> > m_policy_remote;
+    };
+
+    /// @brief TreeCommLevel implementation that does not lock the
+    ///        RMA windows for each message.
+    ///
+    /// Every rank holds a shared epoch on both windows from
+    /// construction until destruction.  Each mailbox slot is framed
+    /// by a leading and a trailing sequence number.  The sender
+    /// writes the leading number, the message and the trailing
+    /// number with separate puts, flushing after each so that they
+    /// arrive at the target in order.  The receiver reads the
+    /// trailing number, the message and then the leading number,
+    /// and retries the copy if the two numbers differ because the
+    /// slot was overwritten during the read.  A slot holds a new
+    /// message when its trailing number differs from the last one
+    /// that was received, so the receiver never writes to the
+    /// window.
+    class TreeCommLevelSequenceImp : public TreeCommLevel
+    {
+        public:
+            TreeCommLevelSequenceImp(std::shared_ptr<Comm> comm, int num_send_up, int num_send_down,
+                                     bool is_sparse);
+            virtual ~TreeCommLevelSequenceImp();
+            int level_rank(void) const override;
+            void send_up(const std::vector<double> &sample) override;
+            void send_down(const std::vector<std::vector<double> > &policy) override;
+            bool receive_up(std::vector<std::vector<double> > &sample) override;
+            bool receive_down(std::vector<double> &policy) override;
+            size_t overhead_send(void) const override;
+            size_t overhead_saved(void) const override;
+        private:
+            /// @brief Write a message to a slot in local memory.
+            void slot_write(double *slot, double sequence,
+                            const std::vector<double> &message);
+            /// @brief Write a message to a slot in the window of the
+            ///        target rank.
+            ///
+            /// @return Number of bytes written.
+            size_t slot_put(size_t window, int target, size_t offset,
+                            double sequence,
+                            const std::vector<double> &message,
+                            std::vector<double> &remote);
+            /// @brief Copy a consistent message out of a slot.
+            ///
+            /// @return The sequence number of the copied message,
+            ///         zero if nothing has been written to the slot.
+            double slot_read(size_t window, const double *slot,
+                             std::vector<double> &message) const;
+            void create_window(void);
+            std::shared_ptr<Comm> m_comm;
+            int m_size;
+            int m_rank;
+            double *m_sample_mailbox;
+            double *m_policy_mailbox;
+            size_t m_sample_window;
+            size_t m_policy_window;
+            size_t m_overhead_send;
+            size_t m_overhead_saved;
             std::vector<std::vector<double> > m_policy_last;
             size_t m_num_send_up;
             size_t m_num_send_down;
+            bool m_is_sparse;
+            /// Copy of the message held in the mailbox of the parent
+            std::vector<double> m_sample_remote;
+            /// Copy of the message held in the mailbox of each child
+            std::vector<std::vector<double> > m_policy_remote;
+            /// Sequence number of the last message sent up
+            double m_sample_sequence;
+            /// Sequence number of the last message sent down
+            double m_policy_sequence;
+            /// Sequence number of the last message received from
+            /// each child
+            std::vector<double> m_sample_received;
     };
 }
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Waiter.hpp"
+
+#include <errno.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include "Helper.hpp"
+#include "Exception.hpp"
+#include "config.h"
+
+namespace geopm
+{
+    // Default Linux timer slack is 50 us; spin for twice that
+    static const double GEOPM_WAITER_SPIN_SEC = 0.0001;
+
+    // Waiter schedules on CLOCK_MONOTONIC, the clock that
+    // clock_nanosleep() supports for absolute deadlines.
+    static void waiter_time(struct geopm_time_s *time)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &(time->t));
+    }
+
+    std::unique_ptr<Waiter> Waiter::make_unique(double period)
+    {
+        return geopm::make_unique<SleepWaiter>(period, GEOPM_WAITER_SPIN_SEC);
+    }
+
+    SleepWaiter::SleepWaiter(double period, double spin_sec)
+        : M_PERIOD(period)
+        , M_SPIN_SEC(spin_sec)
+        , m_is_started(false)
+        , m_num_wait(0)
+        , m_num_missed(0)
+        , m_jitter_total(0.0)
+        , m_jitter_max(0.0)
+    {
+        if (!(period > 0.0) || spin_sec < 0.0) {
+            throw Exception("SleepWaiter::SleepWaiter(): period must be positive and spin_sec must not be negative",
+                            GEOPM_ERROR_INVALID, __FILE__, __LINE__);
+        }
+    }
+
+    void SleepWaiter::reset(void)
+    {
+        struct geopm_time_s now;
+        waiter_time(&now);
+        geopm_time_add(&now, M_PERIOD, &m_deadline);
+        m_is_started = true;
+    }
+
+    void SleepWaiter::wait(void)
+    {
+        if (!m_is_started) {
+            // Setup time before the control loop starts is not
+            // counted against the first deadline
+            reset();
+        }
+        struct geopm_time_s now;
+        waiter_time(&now);
+        ++m_num_wait;
+        if (!geopm_time_comp(&now, &m_deadline)) {
+            // The loop body overran the period
+            ++m_num_missed;
+            geopm_time_add(&now, M_PERIOD, &m_deadline);
+            return;
+        }
+        // Sleep until shortly before the deadline, then spin the
+        // remainder to hide timer slack and wake up latency.
+        struct geopm_time_s wake = m_deadline;
+        long spin_nsec = M_SPIN_SEC * 1E9;
+        wake.t.tv_sec -= spin_nsec / 1000000000;
+        wake.t.tv_nsec -= spin_nsec % 1000000000;
+        if (wake.t.tv_nsec < 0) {
+            wake.t.tv_nsec += 1000000000;
+            --(wake.t.tv_sec);
+        }
+        int err = 0;
+        if (geopm_time_comp(&now, &wake)) {
+            do {
+                err = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &(wake.t), NULL);
+            } while (err == EINTR);
+        }
+        do {
+            waiter_time(&now);
+        } while (geopm_time_comp(&now, &m_deadline));
+        double jitter = geopm_time_diff(&m_deadline, &now);
+        m_jitter_total += jitter;
+        m_jitter_max = std::max(m_jitter_max, jitter);
+        struct geopm_time_s next = m_deadline;
+        geopm_time_add(&next, M_PERIOD, &m_deadline);
+    }
+
+    double SleepWaiter::period(void) const
+    {
+        return M_PERIOD;
+    }
+
+    size_t SleepWaiter::num_wait(void) const
+    {
+        return m_num_wait;
+    }
+
+    size_t SleepWaiter::num_missed(void) const
+    {
+        return m_num_missed;
+    }
+
+    double SleepWaiter::jitter_mean(void) const
+    {
+        size_t num_met = m_num_wait - m_num_missed;
+        return num_met ? m_jitter_total / num_met : 0.0;
+    }
+
+    double SleepWaiter::jitter_max(void) const
+    {
+        return m_jitter_max;
+    }
+
+    std::vector<std::pair<std::string, std::string> > SleepWaiter::report(void) const
+    {
+        return {
+            {"Wait period (s)", string_format_double(M_PERIOD)},
+            {"Wait count", std::to_string(m_num_wait)},
+            {"Wait missed deadlines", std::to_string(m_num_missed)},
+            {"Wait jitter mean (s)", string_format_double(jitter_mean())},
+            {"Wait jitter max (s)", string_format_double(jitter_max())},
+        };
+    }
+}
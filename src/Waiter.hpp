@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WAITER_HPP_INCLUDE
+#define WAITER_HPP_INCLUDE
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "geopm_time.h"
+
+namespace geopm
+{
+    /// @brief Paces a periodic control loop.  Each call to wait()
+    ///        returns at the next multiple of the period, measured
+    ///        from the first call to wait() or the last reset().
+    class Waiter
+    {
+        public:
+            Waiter() = default;
+            virtual ~Waiter() = default;
+            /// @brief Restart the schedule so that the next deadline
+            ///        is one period from now.
+            virtual void reset(void) = 0;
+            /// @brief Block until the next deadline.  If the deadline
+            ///        has already passed the call returns immediately,
+            ///        is counted as missed, and the schedule restarts
+            ///        from the current time.
+            virtual void wait(void) = 0;
+            /// @brief Returns the period in seconds.
+            virtual double period(void) const = 0;
+            /// @brief Returns jitter and missed deadline statistics
+            ///        formatted as report key/value pairs.
+            virtual std::vector<std::pair<std::string, std::string> > report(void) const = 0;
+            /// @brief Returns a Waiter that sleeps until shortly
+            ///        before each deadline and spins for the rest.
+            /// @param [in] period Period of the control loop in
+            ///        seconds.
+            static std::unique_ptr<Waiter> make_unique(double period);
+    };
+
+    class SleepWaiter : public Waiter
+    {
+        public:
+            /// @param [in] period Period of the control loop in
+            ///        seconds.
+            /// @param [in] spin_sec Time before each deadline that is
+            ///        spent spinning rather than sleeping, to hide the
+            ///        wake up latency of the kernel timer.
+            SleepWaiter(double period, double spin_sec);
+            virtual ~SleepWaiter() = default;
+            void reset(void) override;
+            void wait(void) override;
+            double period(void) const override;
+            std::vector<std::pair<std::string, std::string> > report(void) const override;
+            /// @brief Number of calls to wait().
+            size_t num_wait(void) const;
+            /// @brief Number of calls to wait() made after their
+            ///        deadline had passed.
+            size_t num_missed(void) const;
+            /// @brief Mean delay between each met deadline and the
+            ///        return from wait(), in seconds.
+            double jitter_mean(void) const;
+            /// @brief Largest delay between a met deadline and the
+            ///        return from wait(), in seconds.
+            double jitter_max(void) const;
+        private:
+            const double M_PERIOD;
+            const double M_SPIN_SEC;
+            bool m_is_started;
+            struct geopm_time_s m_deadline;
+            size_t m_num_wait;
+            size_t m_num_missed;
+            double m_jitter_total;
+            double m_jitter_max;
+    };
+}
+
+#endif
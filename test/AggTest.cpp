@@ -33,11 +33,14 @@
 #include "geopm_test.hpp"
 
 #include "Agg.hpp"
+#include "Agent.hpp"
+#include "Exception.hpp"
 #include "geopm.h"
 #include "geopm_internal.h"
 #include "geopm_hash.h"
 
 using geopm::Agg;
+using geopm::Agent;
 
 TEST(AggTest, agg_function)
 {
@@ -85,3 +88,116 @@ TEST(AggTest, agg_function)
     EXPECT_EQ(5,
               Agg::region_hint({5, 5, 5}));
 }
+
+TEST(AggTest, aggregate_column)
+{
+    // Seven columns so that the wide, narrow and scalar paths of
+    // each kernel are all exercised.
+    std::vector<std::vector<double> > column {
+        {16, 2, 4, 9, 128, 32, 4, 64},
+        {-1.5, 2.25, NAN, -0.0, 8.0, 1e9, -1e9, 3.0},
+        {NAN, 1, 2, 3, 4, 5, 6, 7},
+        {1, 1, 1, 1, 1, 1, 1, 1},
+        {1, 1, 0, 1, 1, 1, 1, 1},
+        {0, 0, 0, 0, 0, 0, 0, NAN},
+        {0, 0, 0, 0, 0, 0, 0, 0},
+    };
+    size_t num_col = column.size();
+    size_t num_row = column[0].size();
+    std::vector<double> matrix(num_row * num_col);
+    for (size_t row_idx = 0; row_idx < num_row; ++row_idx) {
+        for (size_t col_idx = 0; col_idx < num_col; ++col_idx) {
+            matrix[row_idx * num_col + col_idx] = column[col_idx][row_idx];
+        }
+    }
+    std::vector<std::pair<int, std::function<double(const std::vector<double>&)> > > agg {
+        {Agg::M_COLUMN_SUM, Agg::sum},
+        {Agg::M_COLUMN_AVERAGE, Agg::average},
+        {Agg::M_COLUMN_MIN, Agg::min},
+        {Agg::M_COLUMN_MAX, Agg::max},
+        {Agg::M_COLUMN_LOGICAL_AND, Agg::logical_and},
+        {Agg::M_COLUMN_LOGICAL_OR, Agg::logical_or},
+    };
+    std::vector<double> result(num_col);
+    for (const auto &agg_it : agg) {
+        // Same aggregation for every column
+        std::vector<int> agg_type(num_col, agg_it.first);
+        Agg::aggregate_column(matrix.data(), num_row, num_col, agg_type.data(), result.data());
+        for (size_t col_idx = 0; col_idx < num_col; ++col_idx) {
+            double expect = agg_it.second(column[col_idx]);
+            if (std::isnan(expect)) {
+                EXPECT_TRUE(std::isnan(result[col_idx])) << "type: " << agg_it.first << " column: " << col_idx;
+            }
+            else {
+                EXPECT_EQ(expect, result[col_idx]) << "type: " << agg_it.first << " column: " << col_idx;
+            }
+        }
+        // Only the first row
+        Agg::aggregate_column(matrix.data(), 1, num_col, agg_type.data(), result.data());
+        for (size_t col_idx = 0; col_idx < num_col; ++col_idx) {
+            double expect = agg_it.second({column[col_idx][0]});
+            if (std::isnan(expect)) {
+                EXPECT_TRUE(std::isnan(result[col_idx]));
+            }
+            else {
+                EXPECT_EQ(expect, result[col_idx]);
+            }
+        }
+        // No rows
+        Agg::aggregate_column(matrix.data(), 0, num_col, agg_type.data(), result.data());
+        for (const auto &rr : result) {
+            EXPECT_TRUE(std::isnan(rr));
+        }
+    }
+    // Different aggregation for each column
+    std::vector<int> agg_type {
+        Agg::M_COLUMN_MIN,
+        Agg::M_COLUMN_MAX,
+        Agg::M_COLUMN_LOGICAL_AND,
+        Agg::M_COLUMN_LOGICAL_AND,
+        Agg::M_COLUMN_LOGICAL_AND,
+        Agg::M_COLUMN_LOGICAL_OR,
+        Agg::M_COLUMN_SUM,
+    };
+    std::vector<double> expect {2, 1e9, 1, 1, 0, 1, 0};
+    Agg::aggregate_column(matrix.data(), num_row, num_col, agg_type.data(), result.data());
+    EXPECT_EQ(expect, result);
+
+    agg_type[3] = -1;
+    GEOPM_EXPECT_THROW_MESSAGE(Agg::aggregate_column(matrix.data(), num_row, num_col,
+                                                     agg_type.data(), result.data()),
+                               GEOPM_ERROR_INVALID, "invalid aggregation type");
+}
+
+TEST(AggTest, aggregate_column_agent)
+{
+    std::vector<std::vector<double> > in_sample;
+    for (int child_idx = 0; child_idx < 64; ++child_idx) {
+        in_sample.push_back({100.0 + child_idx, child_idx % 3 != 0 ? 1.0 : 0.0,
+                             child_idx * 0.5, 7.0 - child_idx, 1.0});
+    }
+    std::vector<std::function<double(const std::vector<double>&)> > agg_func {
+        Agg::average, Agg::logical_and, Agg::sum, Agg::min, Agg::max
+    };
+    std::vector<double> expect(agg_func.size());
+    Agent::aggregate_sample(in_sample, agg_func, expect);
+
+    std::vector<double> sample_matrix;
+    std::vector<double> result(agg_func.size());
+    Agent::aggregate_sample<Agg::M_COLUMN_AVERAGE,
+                            Agg::M_COLUMN_LOGICAL_AND,
+                            Agg::M_COLUMN_SUM,
+                            Agg::M_COLUMN_MIN,
+                            Agg::M_COLUMN_MAX>(in_sample, sample_matrix, result);
+    EXPECT_EQ(expect, result);
+    EXPECT_EQ(in_sample.size() * agg_func.size(), sample_matrix.size());
+    // Matrix storage is reused when fewer children report
+    in_sample.resize(2);
+    Agent::aggregate_sample(in_sample, agg_func, expect);
+    Agent::aggregate_sample<Agg::M_COLUMN_AVERAGE,
+                            Agg::M_COLUMN_LOGICAL_AND,
+                            Agg::M_COLUMN_SUM,
+                            Agg::M_COLUMN_MIN,
+                            Agg::M_COLUMN_MAX>(in_sample, sample_matrix, result);
+    EXPECT_EQ(expect, result);
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "geopm_error.h"
+#include "geopm_test.hpp"
+#include "AsyncWriter.hpp"
+#include "Helper.hpp"
+
+using geopm::AsyncWriter;
+
+class AsyncWriterTest : public ::testing::Test
+{
+    protected:
+        void TearDown(void);
+        std::vector<std::string> m_path = {"AsyncWriterTest-0",
+                                           "AsyncWriterTest-1"};
+};
+
+void AsyncWriterTest::TearDown(void)
+{
+    for (const auto &path : m_path) {
+        unlink(path.c_str());
+    }
+}
+
+TEST_F(AsyncWriterTest, write_order)
+{
+    AsyncWriter writer;
+    std::vector<int> handle {writer.open(m_path[0], 2),
+                             writer.open(m_path[1], 2)};
+    std::vector<std::string> expect(2);
+    std::string chunk;
+    for (int idx = 0; idx != 100; ++idx) {
+        for (int file_idx = 0; file_idx != 2; ++file_idx) {
+            chunk = "file " + std::to_string(file_idx) + " chunk " + std::to_string(idx) + "\n";
+            expect[file_idx] += chunk;
+            writer.write(handle[file_idx], chunk);
+            EXPECT_TRUE(chunk.empty());
+        }
+    }
+    // Empty chunks are not queued
+    writer.write(handle[0], chunk);
+    writer.flush(handle[0]);
+    EXPECT_EQ(expect[0], geopm::read_file(m_path[0]));
+    writer.close(handle[1]);
+    EXPECT_EQ(expect[1], geopm::read_file(m_path[1]));
+    GEOPM_EXPECT_THROW_MESSAGE(writer.flush(handle[1]),
+                               GEOPM_ERROR_INVALID, "invalid file handle");
+}
+
+TEST_F(AsyncWriterTest, backpressure)
+{
+    std::string expect;
+    {
+        AsyncWriter writer;
+        int handle = writer.open(m_path[0], 1);
+        std::string chunk;
+        for (int idx = 0; idx != 1000; ++idx) {
+            chunk.assign(4096, 'a' + idx % 26);
+            expect += chunk;
+            writer.write(handle, chunk);
+        }
+        // destructor writes the remaining chunks
+    }
+    EXPECT_EQ(expect, geopm::read_file(m_path[0]));
+}
+
+TEST_F(AsyncWriterTest, errors)
+{
+    AsyncWriter writer;
+    GEOPM_EXPECT_THROW_MESSAGE(writer.open("AsyncWriterTest-no-dir/file", 1),
+                               ENOENT, "Unable to open file");
+    GEOPM_EXPECT_THROW_MESSAGE(writer.open(m_path[0], 0),
+                               GEOPM_ERROR_INVALID, "max_pending must be positive");
+    int handle = writer.open("/dev/full", 1);
+    std::string chunk = "data";
+    writer.write(handle, chunk);
+    GEOPM_EXPECT_THROW_MESSAGE(writer.flush(handle),
+                               ENOSPC, "Unable to write to file '/dev/full'");
+    // the error is reported once
+    writer.flush(handle);
+    writer.close(handle);
+}
@@ -67,6 +67,7 @@ TEST_F(CSVTest, header)
     std::string output_path = "CSVTest-header-output";
     {
         std::unique_ptr<geopm::CSV> tmp = geopm::make_unique<geopm::CSVImp>(output_path, m_host_name, m_start_time, m_buffer_size);
+        tmp->add_meta_data("extra_key", "extra value");
     }
     output_path += "-" + m_host_name;
 
@@ -77,6 +78,7 @@ TEST_F(CSVTest, header)
     EXPECT_TRUE(geopm::string_begins_with(output_lines[2], "# profile_name:"));
     EXPECT_TRUE(geopm::string_begins_with(output_lines[3], "# node_name:"));
     EXPECT_TRUE(geopm::string_begins_with(output_lines[4], "# agent:"));
+    EXPECT_EQ("# extra_key: extra value", output_lines[5]);
     EXPECT_EQ(geopm_version(), geopm::string_split(output_lines[0], ": ")[1]);
     EXPECT_EQ(m_start_time, geopm::string_split(output_lines[1], ": ")[1]);
     EXPECT_EQ(m_host_name, geopm::string_split(output_lines[3], ": ")[1]);
@@ -216,6 +218,8 @@ TEST_F(CSVTest, negative)
     csv->activate();
     GEOPM_EXPECT_THROW_MESSAGE(csv->add_column("another"),
                                GEOPM_ERROR_INVALID, "cannot be called after activate");
+    GEOPM_EXPECT_THROW_MESSAGE(csv->add_meta_data("key", "value"),
+                               GEOPM_ERROR_INVALID, "cannot be called after activate");
     GEOPM_EXPECT_THROW_MESSAGE(csv->update({1.0, 2.0}),
                                GEOPM_ERROR_INVALID, "incorrectly sized");
     csv->update({1.0});
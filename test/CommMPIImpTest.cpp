@@ -48,6 +48,7 @@ typedef int MPI_Info;
 typedef int MPI_Win;
 
 #define MPI_MAX                 (MPI_Op)(0x58000001)
+#define MPI_SUM                 (MPI_Op)(0x58000003)
 #define MPI_LAND                (MPI_Op)(0x58000005)
 #define MPI_UNDEFINED           (-32766)
 #define MPI_COMM_WORLD          ((MPI_Comm)0x44000000)
@@ -312,6 +313,44 @@ extern "C"
 #define MPI_Win_unlock(p0, p1) mock_win_unlock(p0, p1)
 #define PMPI_Win_unlock(p0, p1) mock_win_unlock(p0, p1)
 
+    static int mock_win_lock_all(int param0, MPI_Win param1)
+    {
+        memcpy(g_params[0], &param0, g_sizes[0]);
+        memcpy(g_params[1], &param1, g_sizes[1]);
+        return 0;
+    }
+
+#define MPI_Win_lock_all(p0, p1) mock_win_lock_all(p0, p1)
+#define PMPI_Win_lock_all(p0, p1) mock_win_lock_all(p0, p1)
+
+    static int mock_win_unlock_all(MPI_Win param0)
+    {
+        memcpy(g_params[0], &param0, g_sizes[0]);
+        return 0;
+    }
+
+#define MPI_Win_unlock_all(p0) mock_win_unlock_all(p0)
+#define PMPI_Win_unlock_all(p0) mock_win_unlock_all(p0)
+
+    static int mock_win_flush(int param0, MPI_Win param1)
+    {
+        memcpy(g_params[0], &param0, g_sizes[0]);
+        memcpy(g_params[1], &param1, g_sizes[1]);
+        return 0;
+    }
+
+#define MPI_Win_flush(p0, p1) mock_win_flush(p0, p1)
+#define PMPI_Win_flush(p0, p1) mock_win_flush(p0, p1)
+
+    static int mock_win_sync(MPI_Win param0)
+    {
+        memcpy(g_params[0], &param0, g_sizes[0]);
+        return 0;
+    }
+
+#define MPI_Win_sync(p0) mock_win_sync(p0)
+#define PMPI_Win_sync(p0) mock_win_sync(p0)
+
     static int mock_put(const void *param0, int param1, MPI_Datatype param2, int param3, MPI_Aint param4,
             int param5, MPI_Datatype param6, MPI_Win param7)
     {
@@ -571,6 +610,46 @@ TEST_F(CommMPIImpTest, mpi_reduce)
     check_params();
 }
 
+TEST_F(CommMPIImpTest, mpi_reduce_sum)
+{
+    MPICommTestHelper tmp_comm;
+    void *send = NULL;
+    void *recv = NULL;
+    size_t count = 1;
+    MPI_Datatype dt = MPI_DOUBLE; // used beneath API
+    MPI_Op op = MPI_SUM; // used beneath API
+    int root = 0;
+
+    g_sizes.push_back(sizeof(size_t));
+    g_params.push_back(malloc(g_sizes[0]));
+    g_sizes.push_back(sizeof(size_t));
+    g_params.push_back(malloc(g_sizes[1]));
+    g_sizes.push_back(sizeof(int));
+    g_params.push_back(malloc(g_sizes[2]));
+    g_sizes.push_back(sizeof(MPI_Datatype));
+    g_params.push_back(malloc(g_sizes[3]));
+    g_sizes.push_back(sizeof(MPI_Op));
+    g_params.push_back(malloc(g_sizes[4]));
+    g_sizes.push_back(sizeof(int));
+    g_params.push_back(malloc(g_sizes[5]));
+    g_sizes.push_back(sizeof(MPI_Comm));
+    g_params.push_back(malloc(g_sizes[6]));
+
+    size_t tmp_send = (size_t) send;
+    m_params.push_back(&tmp_send);
+    size_t tmp_recv = (size_t) recv;
+    m_params.push_back(&tmp_recv);
+    m_params.push_back(&count);
+    m_params.push_back(&dt);
+    m_params.push_back(&op);
+    m_params.push_back(&root);
+    m_params.push_back(tmp_comm.get_comm_ref());
+
+    tmp_comm.reduce_sum((double *) send, (double *) recv, count, root);
+
+    check_params();
+}
+
 TEST_F(CommMPIImpTest, mpi_allreduce)
 {
     MPICommTestHelper tmp_comm;
@@ -970,6 +1049,62 @@ TEST_F(CommMPIImpTest, mpi_win_ops)
     reset();
     m_params.clear();
 
+    // lock all
+    for (int assert = 0; assert < 2; assert++) {
+        g_sizes.push_back(sizeof(int));
+        g_params.push_back(malloc(g_sizes[0]));
+        g_sizes.push_back(sizeof(MPI_Win));
+        g_params.push_back(malloc(g_sizes[1]));
+
+        tmp_comm.window_lock_all(win_handle, assert);
+
+        m_params.push_back(&assert);
+        m_params.push_back((void *) tmp2);
+
+        check_params();
+        reset();
+        m_params.clear();
+    }
+
+    // flush
+    g_sizes.push_back(sizeof(int));
+    g_params.push_back(malloc(g_sizes[0]));
+    g_sizes.push_back(sizeof(MPI_Win));
+    g_params.push_back(malloc(g_sizes[1]));
+
+    tmp_comm.window_flush(win_handle, rank);
+
+    m_params.push_back(&rank);
+    m_params.push_back((void *) tmp2);
+
+    check_params();
+    reset();
+    m_params.clear();
+
+    // sync
+    g_sizes.push_back(sizeof(MPI_Win));
+    g_params.push_back(malloc(g_sizes[0]));
+
+    tmp_comm.window_sync(win_handle);
+
+    m_params.push_back((void *) tmp2);
+
+    check_params();
+    reset();
+    m_params.clear();
+
+    // unlock all
+    g_sizes.push_back(sizeof(MPI_Win));
+    g_params.push_back(malloc(g_sizes[0]));
+
+    tmp_comm.window_unlock_all(win_handle);
+
+    m_params.push_back((void *) tmp2);
+
+    check_params();
+    reset();
+    m_params.clear();
+
     // win destroy
     g_sizes.push_back(sizeof(size_t));
     g_params.push_back(malloc(g_sizes[0]));
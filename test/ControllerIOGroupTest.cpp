@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "ControllerIOGroup.hpp"
+#include "LatencyHistogram.hpp"
+#include "PlatformTopo.hpp"
+#include "Exception.hpp"
+#include "geopm_test.hpp"
+
+using geopm::ControllerIOGroup;
+using geopm::ControllerLatency;
+
+class ControllerIOGroupTest : public :: testing :: Test
+{
+    protected:
+        ControllerIOGroupTest();
+
+        ControllerLatency m_latency;
+        ControllerIOGroup m_group;
+};
+
+ControllerIOGroupTest::ControllerIOGroupTest()
+    : m_group(m_latency)
+{
+
+}
+
+TEST_F(ControllerIOGroupTest, valid_signals)
+{
+    auto names = m_group.signal_names();
+    EXPECT_EQ(4 * ControllerLatency::phase_names().size(), names.size());
+    for (const auto &phase : ControllerLatency::phase_names()) {
+        for (const auto &suffix : {"", "_P50", "_P99", "_MAX"}) {
+            std::string name = "CONTROLLER::" + phase + "_LATENCY" + suffix;
+            EXPECT_TRUE(m_group.is_valid_signal(name)) << name;
+            EXPECT_EQ(1u, names.count(name)) << name;
+            EXPECT_EQ(GEOPM_DOMAIN_BOARD, m_group.signal_domain_type(name));
+            EXPECT_NE("", m_group.signal_description(name));
+        }
+    }
+    EXPECT_FALSE(m_group.is_valid_signal("CONTROLLER::INVALID"));
+    EXPECT_EQ(GEOPM_DOMAIN_INVALID, m_group.signal_domain_type("CONTROLLER::INVALID"));
+    EXPECT_TRUE(m_group.control_names().empty());
+    EXPECT_FALSE(m_group.is_valid_control("CONTROLLER::READ_BATCH_LATENCY"));
+}
+
+TEST_F(ControllerIOGroupTest, push_sample)
+{
+    int last_idx = m_group.push_signal("CONTROLLER::READ_BATCH_LATENCY", GEOPM_DOMAIN_BOARD, 0);
+    int max_idx = m_group.push_signal("CONTROLLER::READ_BATCH_LATENCY_MAX", GEOPM_DOMAIN_BOARD, 0);
+    int p50_idx = m_group.push_signal("CONTROLLER::WALK_UP_LATENCY_P50", GEOPM_DOMAIN_BOARD, 0);
+    EXPECT_NE(last_idx, max_idx);
+    EXPECT_EQ(max_idx, m_group.push_signal("CONTROLLER::READ_BATCH_LATENCY_MAX", GEOPM_DOMAIN_BOARD, 0));
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.sample(last_idx), GEOPM_ERROR_INVALID,
+                               "signal has not been read");
+
+    m_group.read_batch();
+    EXPECT_TRUE(std::isnan(m_group.sample(last_idx)));
+    EXPECT_TRUE(std::isnan(m_group.sample(p50_idx)));
+
+    m_latency.update(ControllerLatency::M_PHASE_READ_BATCH, 0.004);
+    m_latency.update(ControllerLatency::M_PHASE_READ_BATCH, 0.002);
+    m_latency.update(ControllerLatency::M_PHASE_WALK_UP, 0.001);
+    // values do not change until the next batch
+    EXPECT_TRUE(std::isnan(m_group.sample(last_idx)));
+    m_group.read_batch();
+    EXPECT_DOUBLE_EQ(0.002, m_group.sample(last_idx));
+    EXPECT_DOUBLE_EQ(0.004, m_group.sample(max_idx));
+    EXPECT_NEAR(0.001, m_group.sample(p50_idx), 0.001 / 32);
+    EXPECT_DOUBLE_EQ(0.004, m_group.read_signal("CONTROLLER::READ_BATCH_LATENCY_P99",
+                                                GEOPM_DOMAIN_BOARD, 0));
+
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.sample(3), GEOPM_ERROR_INVALID,
+                               "batch_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.push_signal("CONTROLLER::WALK_DOWN_LATENCY",
+                                                   GEOPM_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "cannot push signal after call to read_batch");
+}
+
+TEST_F(ControllerIOGroupTest, errors)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.push_signal("CONTROLLER::INVALID", GEOPM_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "not valid for ControllerIOGroup");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.push_signal("CONTROLLER::READ_BATCH_LATENCY", GEOPM_DOMAIN_CPU, 0),
+                               GEOPM_ERROR_INVALID, "not defined for domain");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.read_signal("CONTROLLER::READ_BATCH_LATENCY", GEOPM_DOMAIN_PACKAGE, 0),
+                               GEOPM_ERROR_INVALID, "not defined for domain");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.push_control("CONTROLLER::READ_BATCH_LATENCY", GEOPM_DOMAIN_BOARD, 0),
+                               GEOPM_ERROR_INVALID, "no controls supported");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.adjust(0, 1.0),
+                               GEOPM_ERROR_INVALID, "no controls supported");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.agg_function("CONTROLLER::INVALID"),
+                               GEOPM_ERROR_INVALID, "CONTROLLER::INVALID not valid for ControllerIOGroup");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.format_function("CONTROLLER::INVALID"),
+                               GEOPM_ERROR_INVALID, "CONTROLLER::INVALID not valid for ControllerIOGroup");
+    GEOPM_EXPECT_THROW_MESSAGE(m_group.signal_description("CONTROLLER::INVALID"),
+                               GEOPM_ERROR_INVALID, "CONTROLLER::INVALID not valid for ControllerIOGroup");
+}
@@ -64,6 +64,7 @@ using testing::_;
 using testing::Return;
 using testing::AtLeast;
 using testing::ContainerEq;
+using testing::Contains;
 using testing::SetArgReferee;
 
 class ControllerTestMockPlatformIO : public MockPlatformIO
@@ -223,7 +224,8 @@ TEST_F(ControllerTest, construct_with_file_policy)
                           std::move(m_agents),
                           {"A", "B"},
                           m_file_policy_path, true,
-                          nullptr, "", false // endpoint
+                          nullptr, "", false, // endpoint
+                          false  // pipeline
                           );
 }
 
@@ -263,7 +265,8 @@ TEST_F(ControllerTest, run_with_no_policy)
                           std::move(m_agents),
                           {"A", "B"},
                           "", false,  // false
-                          nullptr, "", false // endpoint
+                          nullptr, "", false, // endpoint
+                          false  // pipeline
                           );
 
 
@@ -370,7 +373,8 @@ TEST_F(ControllerTest, get_hostnames)
                           std::move(m_agents),
                           {}, "", false, // file policy
                           std::unique_ptr<MockEndpointUser>(m_endpoint),
-                          "", true  // endpoint
+                          "", true, // endpoint
+                          false  // pipeline
                           );
 
     EXPECT_CALL(*multi_node_comm, rank());
@@ -401,7 +405,8 @@ TEST_F(ControllerTest, single_node)
                           std::move(m_agents),
                           {}, "", false,  // file policy
                           std::unique_ptr<MockEndpointUser>(m_endpoint),
-                          "", true  // endpoint
+                          "", true, // endpoint
+                          false  // pipeline
                           );
 
     // setup trace
@@ -459,6 +464,93 @@ TEST_F(ControllerTest, single_node)
     EXPECT_EQ(0, m_tree_comm->num_recv());
 }
 
+TEST_F(ControllerTest, single_node_pipeline)
+{
+    int num_level_ctl = 0;
+    int root_level = 0;
+    auto agent = new MockAgent();
+    m_agents.emplace_back(agent);
+
+    // constructor
+    EXPECT_CALL(*m_tree_comm, num_level_controlled())
+        .WillOnce(Return(num_level_ctl));
+    EXPECT_CALL(*m_tree_comm, root_level())
+        .WillOnce(Return(root_level));
+
+    Controller controller(m_comm, m_platform_io,
+                          m_agent_name, m_num_send_down, m_num_send_up,
+                          std::unique_ptr<MockTreeComm>(m_tree_comm),
+                          m_application_io,
+                          std::unique_ptr<MockReporter>(m_reporter),
+                          std::unique_ptr<MockTracer>(m_tracer),
+                          std::unique_ptr<MockEndpointPolicyTracer>(m_policy_tracer),
+                          std::move(m_agents),
+                          {}, "", false,  // file policy
+                          std::unique_ptr<MockEndpointUser>(m_endpoint),
+                          "", true, // endpoint
+                          true  // pipeline
+                          );
+
+    // setup trace
+    std::vector<std::string> trace_names = {"COL1", "COL2"};
+    std::vector<std::function<std::string(double)> > trace_formats = {
+        geopm::string_format_double, geopm::string_format_float
+    };
+    EXPECT_CALL(*agent, trace_names()).WillOnce(Return(trace_names));
+    EXPECT_CALL(*agent, trace_formats()).WillOnce(Return(trace_formats));
+    EXPECT_CALL(*m_tracer, columns(_, _));
+    controller.setup_trace();
+
+    // the first step reads the platform an extra time to fill the
+    // pipeline
+    int num_read = m_num_step + 1;
+    EXPECT_CALL(m_platform_io, read_batch()).Times(num_read);
+    EXPECT_CALL(m_platform_io, write_batch()).Times(m_num_step);
+    EXPECT_CALL(*m_application_io, update(_)).Times(num_read);
+    EXPECT_CALL(*m_application_io, region_info()).Times(num_read)
+        .WillRepeatedly(Return(m_region_info));
+    EXPECT_CALL(*m_application_io, clear_region_info()).Times(num_read);
+    std::vector<double> endpoint_policy = {8.8, 9.9};
+    ASSERT_EQ(m_num_send_down, (int)endpoint_policy.size());
+    EXPECT_CALL(*m_endpoint, read_policy(_)).Times(m_num_step)
+        .WillRepeatedly(DoAll(SetArgReferee<0>(endpoint_policy), Return(0)));
+    EXPECT_CALL(*m_reporter, update()).Times(num_read);
+    EXPECT_CALL(*m_tracer, update(_, _)).Times(num_read);
+    EXPECT_CALL(*m_policy_tracer, update(_)).Times(1);
+    EXPECT_CALL(*agent, trace_values(_)).Times(num_read);
+    EXPECT_CALL(*agent, validate_policy(_)).Times(m_num_step);
+    EXPECT_CALL(*agent, adjust_platform(_)).Times(m_num_step);
+    EXPECT_CALL(*agent, do_write_batch())
+        .WillRepeatedly(Return(true));
+    std::vector<double> agent_sample = {1.1, 2.2, 3.3, 4.4};
+    ASSERT_EQ(m_num_send_up, (int)agent_sample.size());
+    EXPECT_CALL(*agent, sample_platform(_)).Times(num_read)
+        .WillRepeatedly(SetArgReferee<0>(agent_sample));
+    EXPECT_CALL(*agent, do_send_sample()).Times(num_read)
+        .WillRepeatedly(Return(true));
+    EXPECT_CALL(*m_endpoint, write_sample(agent_sample)).Times(m_num_step);
+    EXPECT_CALL(*agent, wait()).Times(m_num_step);
+    EXPECT_CALL(*agent, aggregate_sample(_, _)).Times(0);
+    EXPECT_CALL(*agent, split_policy(_, _)).Times(0);
+
+    for (int step = 0; step < m_num_step; ++step) {
+        controller.step();
+    }
+
+    // step count and phase timing are added to the host report
+    EXPECT_CALL(*agent, report_header()).WillOnce(Return(m_agent_report));
+    EXPECT_CALL(*agent, report_host()).WillOnce(Return(m_agent_report));
+    EXPECT_CALL(*agent, report_region()).WillOnce(Return(m_region_names));
+    std::pair<std::string, std::string> step_count {"Controller step count",
+                                                    std::to_string(m_num_step)};
+    EXPECT_CALL(*m_reporter, generate(_, _, Contains(step_count), _, _, _, _));
+    EXPECT_CALL(*m_tracer, flush());
+    controller.generate();
+
+    EXPECT_EQ(0, m_tree_comm->num_send());
+    EXPECT_EQ(0, m_tree_comm->num_recv());
+}
+
 // controller with only leaf responsibilities
 TEST_F(ControllerTest, two_level_controller_1)
 {
@@ -482,7 +574,8 @@ TEST_F(ControllerTest, two_level_controller_1)
                           std::move(m_agents),
                           {}, "", false, // file policy
                           std::unique_ptr<MockEndpointUser>(m_endpoint),
-                          "", true  // endpoint
+                          "", true, // endpoint
+                          false  // pipeline
                           );
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
@@ -583,7 +676,8 @@ TEST_F(ControllerTest, two_level_controller_2)
                           std::move(m_agents),
                           {}, "", false, // file policy
                           std::unique_ptr<MockEndpointUser>(m_endpoint),
-                          "", true // endpoint
+                          "", true, // endpoint
+                          false  // pipeline
                           );
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
@@ -693,7 +787,8 @@ TEST_F(ControllerTest, two_level_controller_0)
                           std::move(m_agents),
                           {}, "", false, // file policy
                           std::unique_ptr<MockEndpointUser>(m_endpoint),
-                          "", true // endpoint
+                          "", true, // endpoint
+                          false  // pipeline
                           );
 
     std::vector<std::string> trace_names = {"COL1", "COL2"};
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "DerivativeHistory.hpp"
+#include "geopm_test.hpp"
+
+using geopm::DerivativeHistory;
+
+TEST(DerivativeHistoryTest, slope)
+{
+    for (int mode : {DerivativeHistory::M_MODE_EXACT,
+                     DerivativeHistory::M_MODE_RUNNING}) {
+        DerivativeHistory history(8, mode);
+        EXPECT_TRUE(std::isnan(history.insert(0.0, 5.0)));
+        EXPECT_DOUBLE_EQ(0.0, history.insert(1.0, 5.0));
+        EXPECT_DOUBLE_EQ(0.0, history.insert(2.0, 5.0));
+        history.clear();
+        EXPECT_TRUE(std::isnan(history.insert(10.0, 0.0)));
+        double result = NAN;
+        for (int ii = 1; ii < 20; ++ii) {
+            result = history.insert(10.0 + ii, 3.0 * ii);
+        }
+        EXPECT_NEAR(3.0, result, 1e-12);
+        // should have slope of .238 with least squares fit
+        std::vector<double> sample_values = {0, 1, 2, 3, 0, 1, 2, 3};
+        for (size_t ii = 0; ii < sample_values.size(); ++ii) {
+            result = history.insert(100.0 + ii, sample_values[ii]);
+        }
+        EXPECT_NEAR(0.238, result, 0.001);
+    }
+}
+
+TEST(DerivativeHistoryTest, running_matches_exact)
+{
+    // Energy counter sampled every 5 ms with jitter and noise, far
+    // from the origin to stress cancellation in the running sums.
+    DerivativeHistory exact(8, DerivativeHistory::M_MODE_EXACT);
+    DerivativeHistory running(8, DerivativeHistory::M_MODE_RUNNING);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> jitter(-0.0005, 0.0005);
+    std::normal_distribution<double> noise(0.0, 0.5);
+    double time = 1.0e5;
+    double energy = 1.0e9;
+    for (int ii = 0; ii < 10000; ++ii) {
+        time += 0.005 + jitter(gen);
+        energy += 200.0 * 0.005 + noise(gen);
+        double expect = exact.insert(time, energy);
+        double actual = running.insert(time, energy);
+        if (ii == 0) {
+            EXPECT_TRUE(std::isnan(expect));
+            EXPECT_TRUE(std::isnan(actual));
+        }
+        else {
+            ASSERT_NEAR(expect, actual, 1e-6 * std::fabs(expect)) << "at sample " << ii;
+        }
+    }
+}
+
+TEST(DerivativeHistoryTest, single_sample_window)
+{
+    DerivativeHistory history(1, DerivativeHistory::M_MODE_RUNNING);
+    EXPECT_TRUE(std::isnan(history.insert(0.0, 1.0)));
+    EXPECT_TRUE(std::isnan(history.insert(1.0, 2.0)));
+}
+
+TEST(DerivativeHistoryTest, errors)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(DerivativeHistory(0, DerivativeHistory::M_MODE_RUNNING),
+                               GEOPM_ERROR_INVALID, "num_history must be positive");
+    GEOPM_EXPECT_THROW_MESSAGE(DerivativeHistory(8, -1),
+                               GEOPM_ERROR_INVALID, "invalid mode");
+}
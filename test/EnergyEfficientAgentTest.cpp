@@ -45,6 +45,7 @@
 #include "MockPlatformTopo.hpp"
 #include "MockFrequencyGovernor.hpp"
 #include "MockEnergyEfficientRegion.hpp"
+#include "MockWaiter.hpp"
 #include "Helper.hpp"
 #include "geopm_test.hpp"
 #include "config.h"
@@ -257,3 +258,19 @@ TEST_F(EnergyEfficientAgentTest, enforce_policy)
 
     EXPECT_THROW(m_agent0->enforce_policy(bad_policy), geopm::Exception);
 }
+
+TEST_F(EnergyEfficientAgentTest, report_host)
+{
+    std::vector<std::pair<std::string, std::string> > wait_report {{"Wait count", "7"}};
+    auto waiter = geopm::make_unique<MockWaiter>();
+    EXPECT_CALL(*waiter, report()).WillOnce(Return(wait_report));
+    EXPECT_CALL(m_topo, num_domain(M_FREQ_DOMAIN));
+    EXPECT_CALL(*m_gov, frequency_domain_type());
+    EnergyEfficientAgent agent(m_platio, m_topo, m_gov,
+                               std::map<uint64_t, std::shared_ptr<EnergyEfficientRegion> >(),
+                               std::move(waiter));
+    std::vector<std::pair<std::string, std::string> > report = agent.report_host();
+    ASSERT_EQ(2u, report.size());
+    EXPECT_EQ("Final online freq map", report[0].first);
+    EXPECT_EQ(wait_report[0], report[1]);
+}
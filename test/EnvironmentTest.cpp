@@ -117,8 +117,17 @@ void EnvironmentTest::expect_vars(std::map<std::string, std::string> exp_vars) c
     EXPECT_EQ(exp_vars["GEOPM_TIMEOUT"], std::to_string(m_env->timeout()));
     EXPECT_EQ(exp_vars["GEOPM_DEBUG_ATTACH"], std::to_string(m_env->debug_attach()));
     EXPECT_EQ(exp_vars["GEOPM_TRACE_SIGNALS"], m_env->trace_signals());
+    EXPECT_EQ(exp_vars["GEOPM_TRACE_FORMAT"], m_env->trace_format());
+    EXPECT_EQ(exp_vars["GEOPM_TRACE_MODE"], m_env->trace_mode());
     EXPECT_EQ(exp_vars["GEOPM_REPORT_SIGNALS"], m_env->report_signals());
+    EXPECT_EQ(exp_vars["GEOPM_REPORT_MODE"], m_env->report_mode());
     EXPECT_EQ(exp_vars.find("GEOPM_REGION_BARRIER") != exp_vars.end(), m_env->do_region_barrier());
+    EXPECT_EQ(exp_vars.find("GEOPM_PROFILE_LOCK_FREE") != exp_vars.end(), m_env->do_profile_lock_free());
+    EXPECT_EQ(exp_vars.find("GEOPM_TREE_LOCK_FREE") != exp_vars.end(), m_env->do_tree_lock_free());
+    EXPECT_EQ(exp_vars.find("GEOPM_TREE_SPARSE") != exp_vars.end(), m_env->do_tree_sparse());
+    EXPECT_EQ(exp_vars.find("GEOPM_TREE_AUTO_FAN_OUT") != exp_vars.end(), m_env->do_tree_auto_fan_out());
+    EXPECT_EQ(exp_vars.find("GEOPM_MSR_PREFETCH") != exp_vars.end(), m_env->do_msr_prefetch());
+    EXPECT_EQ(exp_vars.find("GEOPM_CTL_PIPELINE") != exp_vars.end(), m_env->do_ctl_pipeline());
 }
 
 void EnvironmentTest::SetUp()
@@ -139,8 +148,17 @@ void EnvironmentTest::SetUp()
               {"GEOPM_MAX_FAN_OUT", "16"},
               {"GEOPM_DEBUG_ATTACH", "1"},
               {"GEOPM_TRACE_SIGNALS", "test1,test2,test3"},
+              {"GEOPM_TRACE_FORMAT", "binary-compressed"},
+              {"GEOPM_TRACE_MODE", "region,every:100"},
               {"GEOPM_REPORT_SIGNALS", "best1,best2,best3"},
+              {"GEOPM_REPORT_MODE", "per-node,summary"},
               {"GEOPM_REGION_BARRIER", std::to_string(false)},
+              {"GEOPM_PROFILE_LOCK_FREE", std::to_string(true)},
+              {"GEOPM_TREE_LOCK_FREE", std::to_string(true)},
+              {"GEOPM_TREE_SPARSE", std::to_string(true)},
+              {"GEOPM_TREE_AUTO_FAN_OUT", std::to_string(true)},
+              {"GEOPM_MSR_PREFETCH", std::to_string(true)},
+              {"GEOPM_CTL_PIPELINE", std::to_string(true)},
              };
 
     m_pmpi_ctl_map["process"] = (int)GEOPM_CTL_PROCESS;
@@ -402,8 +420,17 @@ TEST_F(EnvironmentTest, user_default_and_override)
         {"GEOPM_TIMEOUT", default_vars["GEOPM_TIMEOUT"]},
         {"GEOPM_DEBUG_ATTACH", m_user["GEOPM_DEBUG_ATTACH"]},
         {"GEOPM_TRACE_SIGNALS", m_user["GEOPM_TRACE_SIGNALS"]},
+        {"GEOPM_TRACE_FORMAT", m_user["GEOPM_TRACE_FORMAT"]},
+        {"GEOPM_TRACE_MODE", m_user["GEOPM_TRACE_MODE"]},
         {"GEOPM_REPORT_SIGNALS", m_user["GEOPM_REPORT_SIGNALS"]},
+        {"GEOPM_REPORT_MODE", m_user["GEOPM_REPORT_MODE"]},
         {"GEOPM_REGION_BARRIER", m_user["GEOPM_REGION_BARRIER"]},
+        {"GEOPM_PROFILE_LOCK_FREE", m_user["GEOPM_PROFILE_LOCK_FREE"]},
+        {"GEOPM_TREE_LOCK_FREE", m_user["GEOPM_TREE_LOCK_FREE"]},
+        {"GEOPM_TREE_SPARSE", m_user["GEOPM_TREE_SPARSE"]},
+        {"GEOPM_TREE_AUTO_FAN_OUT", m_user["GEOPM_TREE_AUTO_FAN_OUT"]},
+        {"GEOPM_MSR_PREFETCH", m_user["GEOPM_MSR_PREFETCH"]},
+        {"GEOPM_CTL_PIPELINE", m_user["GEOPM_CTL_PIPELINE"]},
     };
     expect_vars(exp_vars);
 }
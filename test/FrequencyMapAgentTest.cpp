@@ -52,6 +52,7 @@
 #include "Agg.hpp"
 #include "MockPlatformIO.hpp"
 #include "MockPlatformTopo.hpp"
+#include "MockWaiter.hpp"
 #include "PlatformTopo.hpp"
 #include "geopm.h"
 #include "geopm_test.hpp"
@@ -485,3 +486,15 @@ TEST_F(FrequencyMapAgentTest, validate_policy)
     GEOPM_EXPECT_THROW_MESSAGE(m_agent->validate_policy(policy), GEOPM_ERROR_INVALID,
                                "policy maps a NaN region with frequency");
 }
+
+TEST_F(FrequencyMapAgentTest, report_host)
+{
+    std::vector<std::pair<std::string, std::string> > wait_report {{"Wait count", "7"}};
+    auto waiter = geopm::make_unique<MockWaiter>();
+    EXPECT_CALL(*waiter, report()).WillOnce(Return(wait_report));
+    FrequencyMapAgent agent(*m_platform_io, *m_platform_topo, std::move(waiter));
+    std::vector<std::pair<std::string, std::string> > report = agent.report_host();
+    ASSERT_EQ(2u, report.size());
+    EXPECT_EQ("Frequency map", report[0].first);
+    EXPECT_EQ(wait_report[0], report[1]);
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "LatencyHistogram.hpp"
+#include "Exception.hpp"
+#include "geopm_test.hpp"
+
+using geopm::LatencyHistogram;
+using geopm::ControllerLatency;
+
+TEST(LatencyHistogramTest, empty)
+{
+    LatencyHistogram hist;
+    EXPECT_EQ(0ULL, hist.count());
+    EXPECT_TRUE(std::isnan(hist.last()));
+    EXPECT_TRUE(std::isnan(hist.max()));
+    EXPECT_TRUE(std::isnan(hist.percentile(0.5)));
+    GEOPM_EXPECT_THROW_MESSAGE(hist.percentile(1.5), GEOPM_ERROR_INVALID,
+                               "quantile must be between 0 and 1");
+    GEOPM_EXPECT_THROW_MESSAGE(hist.percentile(NAN), GEOPM_ERROR_INVALID,
+                               "quantile must be between 0 and 1");
+}
+
+TEST(LatencyHistogramTest, small_values_exact)
+{
+    LatencyHistogram hist;
+    // values below 32 ns each have their own bucket
+    for (int nsec = 1; nsec <= 20; ++nsec) {
+        hist.update(nsec * 1E-9);
+    }
+    EXPECT_EQ(20ULL, hist.count());
+    EXPECT_DOUBLE_EQ(20E-9, hist.last());
+    EXPECT_DOUBLE_EQ(20E-9, hist.max());
+    EXPECT_DOUBLE_EQ(10E-9, hist.percentile(0.5));
+    EXPECT_DOUBLE_EQ(1E-9, hist.percentile(0.0));
+    EXPECT_DOUBLE_EQ(20E-9, hist.percentile(1.0));
+}
+
+TEST(LatencyHistogramTest, percentile)
+{
+    LatencyHistogram hist;
+    // 1 us to 10 ms in 1 us steps
+    int num_sample = 10000;
+    for (int idx = 1; idx <= num_sample; ++idx) {
+        hist.update(idx * 1E-6);
+    }
+    EXPECT_EQ((size_t)num_sample, hist.count());
+    EXPECT_NEAR(0.010, hist.max(), 1E-12);
+    for (double quantile : {0.10, 0.50, 0.90, 0.99, 0.999}) {
+        double expect = quantile * num_sample * 1E-6;
+        double actual = hist.percentile(quantile);
+        // never under reports, and is within one sub-bucket
+        EXPECT_LE(expect - 1E-9, actual);
+        EXPECT_GE(expect * (1.0 + 1.0 / 32), actual);
+    }
+    EXPECT_DOUBLE_EQ(hist.max(), hist.percentile(1.0));
+}
+
+TEST(LatencyHistogramTest, out_of_range)
+{
+    LatencyHistogram hist;
+    hist.update(-1.0);
+    EXPECT_EQ(0.0, hist.max());
+    hist.update(NAN);
+    EXPECT_EQ(0.0, hist.max());
+    // beyond the last bucket: percentile is clamped to the max
+    hist.update(7200.0);
+    EXPECT_EQ(3ULL, hist.count());
+    EXPECT_DOUBLE_EQ(7200.0, hist.max());
+    EXPECT_DOUBLE_EQ(7200.0, hist.percentile(1.0));
+    EXPECT_EQ(0.0, hist.percentile(0.5));
+    hist.reset();
+    EXPECT_EQ(0ULL, hist.count());
+    EXPECT_TRUE(std::isnan(hist.max()));
+}
+
+TEST(LatencyHistogramTest, concurrent_update)
+{
+    LatencyHistogram hist;
+    int num_thread = 4;
+    int num_update = 10000;
+    std::vector<std::thread> threads;
+    for (int tidx = 0; tidx < num_thread; ++tidx) {
+        threads.emplace_back([&hist, num_update, tidx]() {
+            for (int idx = 0; idx < num_update; ++idx) {
+                hist.update((tidx + 1) * 1E-3);
+            }
+        });
+    }
+    for (auto &it : threads) {
+        it.join();
+    }
+    EXPECT_EQ((size_t)(num_thread * num_update), hist.count());
+    EXPECT_DOUBLE_EQ(num_thread * 1E-3, hist.max());
+}
+
+TEST(LatencyHistogramTest, controller_latency_report)
+{
+    ControllerLatency latency;
+    auto names = ControllerLatency::phase_names();
+    ASSERT_EQ((size_t)ControllerLatency::M_NUM_PHASE, names.size());
+    EXPECT_EQ("READ_BATCH", names[ControllerLatency::M_PHASE_READ_BATCH]);
+    EXPECT_TRUE(latency.report().empty());
+
+    latency.update(ControllerLatency::M_PHASE_READ_BATCH, 0.001);
+    latency.update(ControllerLatency::M_PHASE_READ_BATCH, 0.003);
+    EXPECT_EQ(2ULL, latency.histogram(ControllerLatency::M_PHASE_READ_BATCH).count());
+    EXPECT_EQ(0ULL, latency.histogram(ControllerLatency::M_PHASE_WALK_UP).count());
+    auto report = latency.report();
+    ASSERT_EQ(3ULL, report.size());
+    EXPECT_EQ("Controller read batch latency p50 (s)", report[0].first);
+    EXPECT_NEAR(0.001, std::stod(report[0].second), 0.001 / 32);
+    EXPECT_EQ("Controller read batch latency p99 (s)", report[1].first);
+    EXPECT_NEAR(0.003, std::stod(report[1].second), 0.003 / 32);
+    EXPECT_EQ("Controller read batch latency max (s)", report[2].first);
+    EXPECT_DOUBLE_EQ(0.003, std::stod(report[2].second));
+
+    GEOPM_EXPECT_THROW_MESSAGE(latency.histogram(ControllerLatency::M_NUM_PHASE),
+                               GEOPM_ERROR_INVALID, "phase out of range");
+    latency.reset();
+    EXPECT_TRUE(latency.report().empty());
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "MSRBatchDecoder.hpp"
+#include "MSRFieldSignal.hpp"
+#include "MSR.hpp"
+#include "Helper.hpp"
+#include "geopm_hash.h"
+#include "MockMSRIO.hpp"
+#include "MockSignal.hpp"
+#include "geopm_test.hpp"
+
+using geopm::MSRBatchDecoder;
+using geopm::MSRFieldSignal;
+using geopm::MSR;
+using testing::Return;
+
+class MSRBatchDecoderTest : public ::testing::Test
+{
+    protected:
+        void SetUp();
+
+        MockMSRIO m_msrio;
+        std::unique_ptr<MSRBatchDecoder> m_decoder;
+};
+
+void MSRBatchDecoderTest::SetUp()
+{
+    m_decoder = geopm::make_unique<MSRBatchDecoder>();
+}
+
+TEST_F(MSRBatchDecoderTest, decode_once)
+{
+    // Three fields and one raw signal from two MSRs
+    int raw_idx = m_decoder->push_raw(3);
+    int low_idx = m_decoder->push_field(3, 0, 7, MSR::M_FUNCTION_SCALE, 2.0);
+    int high_idx = m_decoder->push_field(3, 8, 15, MSR::M_FUNCTION_SCALE, 0.5);
+    int other_idx = m_decoder->push_field(5, 16, 23, MSR::M_FUNCTION_SCALE, 1.0);
+    EXPECT_EQ(0, raw_idx);
+    EXPECT_EQ(1, low_idx);
+    EXPECT_EQ(2, high_idx);
+    EXPECT_EQ(3, other_idx);
+    EXPECT_EQ(4, m_decoder->num_value());
+
+    // Each MSR is sampled once per decode
+    EXPECT_CALL(m_msrio, sample(3)).WillOnce(Return(0xF1452310));
+    EXPECT_CALL(m_msrio, sample(5)).WillOnce(Return(0xF1678321));
+    m_decoder->decode(m_msrio);
+    EXPECT_EQ(0xF1452310ULL, geopm_signal_to_field(m_decoder->value(raw_idx)));
+    EXPECT_EQ(0x10 * 2.0, m_decoder->value(low_idx));
+    EXPECT_EQ(0x23 * 0.5, m_decoder->value(high_idx));
+    EXPECT_EQ(0x67, m_decoder->value(other_idx));
+    // Values are stable until the next decode
+    EXPECT_EQ(0x10 * 2.0, m_decoder->value(low_idx));
+}
+
+TEST_F(MSRBatchDecoderTest, functions)
+{
+    // field is 0x02
+    int log_half_idx = m_decoder->push_field(0, 16, 23, MSR::M_FUNCTION_LOG_HALF, 1.0);
+    // field is 0x41
+    int float_idx = m_decoder->push_field(1, 16, 23, MSR::M_FUNCTION_7_BIT_FLOAT, 3.0);
+    EXPECT_CALL(m_msrio, sample(0)).WillOnce(Return(0xF1028321));
+    EXPECT_CALL(m_msrio, sample(1)).WillOnce(Return(0xF1418321));
+    m_decoder->decode(m_msrio);
+    EXPECT_EQ(0.25, m_decoder->value(log_half_idx));
+    EXPECT_EQ(9.0, m_decoder->value(float_idx));
+}
+
+TEST_F(MSRBatchDecoderTest, overflow)
+{
+    int idx = m_decoder->push_field(0, 0, 3, MSR::M_FUNCTION_OVERFLOW, 1.0);
+    std::vector<uint64_t> raw {0x5, 0x6, 0x2, 0xA, 0x1};
+    std::vector<double> expected {5.0, 6.0, 18.0, 26.0, 33.0};
+    for (size_t ii = 0; ii < raw.size(); ++ii) {
+        EXPECT_CALL(m_msrio, sample(0)).WillOnce(Return(raw[ii]));
+        m_decoder->decode(m_msrio);
+        EXPECT_DOUBLE_EQ(expected[ii], m_decoder->value(idx));
+    }
+}
+
+TEST_F(MSRBatchDecoderTest, match_field_signal)
+{
+    // Decoded values must be bit for bit equal to MSRFieldSignal
+    std::vector<int> functions {MSR::M_FUNCTION_SCALE,
+                                MSR::M_FUNCTION_LOG_HALF,
+                                MSR::M_FUNCTION_7_BIT_FLOAT,
+                                MSR::M_FUNCTION_OVERFLOW};
+    std::vector<double> scalars {1.0 / 3.0, 0.1, 1e-6, 6.103515625e-05};
+    uint64_t raw_val = 0x123456789ABCDEF1;
+    for (auto function : functions) {
+        for (auto scalar : scalars) {
+            auto raw = std::make_shared<MockSignal>();
+            MSRFieldSignal sig(raw, 8, 14, function, scalar);
+            EXPECT_CALL(*raw, read())
+                .WillOnce(Return(geopm_field_to_signal(raw_val)));
+            MSRBatchDecoder decoder;
+            int idx = decoder.push_field(0, 8, 14, function, scalar);
+            EXPECT_CALL(m_msrio, sample(0)).WillOnce(Return(raw_val));
+            decoder.decode(m_msrio);
+            EXPECT_EQ(sig.read(), decoder.value(idx));
+        }
+    }
+}
+
+TEST_F(MSRBatchDecoderTest, errors)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(m_decoder->push_field(0, 0, 3, -1, 1.0),
+                               GEOPM_ERROR_INVALID, "invalid encoding function");
+    GEOPM_EXPECT_THROW_MESSAGE(m_decoder->push_field(0, 8, 3, MSR::M_FUNCTION_SCALE, 1.0),
+                               GEOPM_ERROR_INVALID, "invalid bit range");
+    GEOPM_EXPECT_THROW_MESSAGE(m_decoder->push_field(0, 0, 63, MSR::M_FUNCTION_SCALE, 1.0),
+                               GEOPM_ERROR_INVALID, "invalid bit range");
+}
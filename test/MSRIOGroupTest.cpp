@@ -88,9 +88,11 @@ void MSRIOGroupTest::SetUp()
     m_topo = make_topo(m_num_package, m_num_core, m_num_cpu);
     m_msrio = std::make_shared<MockMSRIO>();
 
-    // suppress warnings about num_domain and domain_nested calls
+    // suppress warnings about num_domain, domain_nested and
+    // domain_cpu_list calls
     EXPECT_CALL(*m_topo, num_domain(_)).Times(AtLeast(0));
     EXPECT_CALL(*m_topo, domain_nested(_, _, _)).Times(AtLeast(0));
+    EXPECT_CALL(*m_topo, domain_cpu_list(_, _)).Times(AtLeast(0));
     // suppress mock calls from initalizing counter enables
     EXPECT_CALL(*m_msrio, write_msr(_, _, _, _)).Times(AtLeast(0));
     m_msrio_group = geopm::make_unique<MSRIOGroup>(*m_topo, m_msrio,
@@ -399,14 +401,14 @@ TEST_F(MSRIOGroupTest, sample)
     GEOPM_EXPECT_THROW_MESSAGE(m_msrio_group->sample(freq_idx_0),
                                GEOPM_ERROR_RUNTIME, "sample() called before signal was read");
 
-    // first batch
+    // first batch: each MSR is decoded once by read_batch()
     {
     EXPECT_CALL(*m_msrio, read_batch());
-    m_msrio_group->read_batch();
-
     EXPECT_CALL(*m_msrio, sample(PERF_STATUS_0)).WillOnce(Return(0xB00));
     EXPECT_CALL(*m_msrio, sample(INST_RET_0)).WillOnce(Return(1234));
     EXPECT_CALL(*m_msrio, sample(INST_RET_1)).WillOnce(Return(5678));
+    m_msrio_group->read_batch();
+
     double freq_0 = m_msrio_group->sample(freq_idx_0);
     double inst_0 = m_msrio_group->sample(inst_idx_0);
     double inst_1 = m_msrio_group->sample(inst_idx_1);
@@ -417,9 +419,7 @@ TEST_F(MSRIOGroupTest, sample)
 
     // sample again without read should get same value
     {
-    EXPECT_CALL(*m_msrio, sample(PERF_STATUS_0)).WillOnce(Return(0xB00));
-    EXPECT_CALL(*m_msrio, sample(INST_RET_0)).WillOnce(Return(1234));
-    EXPECT_CALL(*m_msrio, sample(INST_RET_1)).WillOnce(Return(5678));
+    EXPECT_CALL(*m_msrio, sample(_)).Times(0);
     double freq_0 = m_msrio_group->sample(freq_idx_0);
     double inst_0 = m_msrio_group->sample(inst_idx_0);
     double inst_1 = m_msrio_group->sample(inst_idx_1);
@@ -431,11 +431,11 @@ TEST_F(MSRIOGroupTest, sample)
     // second batch
     {
     EXPECT_CALL(*m_msrio, read_batch());
-    m_msrio_group->read_batch();
-
     EXPECT_CALL(*m_msrio, sample(PERF_STATUS_0)).WillOnce(Return(0xC00));
     EXPECT_CALL(*m_msrio, sample(INST_RET_0)).WillOnce(Return(87654));
     EXPECT_CALL(*m_msrio, sample(INST_RET_1)).WillOnce(Return(65432));
+    m_msrio_group->read_batch();
+
     double freq_0 = m_msrio_group->sample(freq_idx_0);
     double inst_0 = m_msrio_group->sample(inst_idx_0);
     double inst_1 = m_msrio_group->sample(inst_idx_1);
@@ -459,10 +459,10 @@ TEST_F(MSRIOGroupTest, sample_raw)
                                                 GEOPM_DOMAIN_CPU, 1);
 
     EXPECT_CALL(*m_msrio, read_batch());
-    m_msrio_group->read_batch();
-
     EXPECT_CALL(*m_msrio, sample(0)).WillOnce(Return(0xB000D000F0001234));
     EXPECT_CALL(*m_msrio, sample(1)).WillOnce(Return(0xB000D000F0001235));
+    m_msrio_group->read_batch();
+
     uint64_t inst_0 = geopm_signal_to_field(m_msrio_group->sample(inst_idx_0));
     uint64_t inst_1 = geopm_signal_to_field(m_msrio_group->sample(inst_idx_1));
     EXPECT_EQ(0xB000D000F0001234, inst_0);
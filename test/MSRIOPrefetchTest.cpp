@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "MSRIOPrefetch.hpp"
+#include "MockMSRIO.hpp"
+#include "Exception.hpp"
+#include "Helper.hpp"
+#include "geopm_test.hpp"
+
+using geopm::MSRIOPrefetchImp;
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+class MSRIOPrefetchTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        // Call read_batch() until the value of the first sample
+        // changes or the timeout expires.
+        bool wait_for_snapshot(uint64_t prev_value);
+        std::shared_ptr<MockMSRIO> m_msrio;
+        std::unique_ptr<MSRIOPrefetchImp> m_prefetch;
+        std::atomic<uint64_t> m_num_read;
+};
+
+void MSRIOPrefetchTest::SetUp(void)
+{
+    m_msrio = std::make_shared<MockMSRIO>();
+    m_num_read = 0;
+    ON_CALL(*m_msrio, add_read(0, 0x10)).WillByDefault(Return(0));
+    ON_CALL(*m_msrio, add_read(1, 0x10)).WillByDefault(Return(1));
+    ON_CALL(*m_msrio, read_batch())
+        .WillByDefault(Invoke([this]() {
+            ++m_num_read;
+        }));
+    // Value encodes the number of batch reads and the batch index
+    ON_CALL(*m_msrio, sample(_))
+        .WillByDefault(Invoke([this](int batch_idx) {
+            return 10 * m_num_read + batch_idx;
+        }));
+    m_prefetch = geopm::make_unique<MSRIOPrefetchImp>(m_msrio, 0.0001, -1);
+}
+
+bool MSRIOPrefetchTest::wait_for_snapshot(uint64_t prev_value)
+{
+    bool result = false;
+    for (int iter = 0; !result && iter < 10000; ++iter) {
+        m_prefetch->read_batch();
+        result = m_prefetch->sample(0) != prev_value;
+        if (!result) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    return result;
+}
+
+TEST_F(MSRIOPrefetchTest, read_batch)
+{
+    EXPECT_CALL(*m_msrio, add_read(_, _)).Times(2);
+    EXPECT_CALL(*m_msrio, read_batch()).Times(testing::AtLeast(2));
+    EXPECT_CALL(*m_msrio, sample(_)).Times(testing::AtLeast(4));
+    EXPECT_EQ(0, m_prefetch->add_read(0, 0x10));
+    EXPECT_EQ(1, m_prefetch->add_read(1, 0x10));
+    GEOPM_EXPECT_THROW_MESSAGE(m_prefetch->sample(0), GEOPM_ERROR_INVALID,
+                               "cannot call sample() before read_batch()");
+    // First batch is read synchronously
+    m_prefetch->read_batch();
+    EXPECT_EQ(10ULL, m_prefetch->sample(0));
+    EXPECT_EQ(11ULL, m_prefetch->sample(1));
+    struct geopm_time_s first_time = m_prefetch->sample_time();
+    GEOPM_EXPECT_THROW_MESSAGE(m_prefetch->add_read(2, 0x10), GEOPM_ERROR_INVALID,
+                               "cannot add a read after read_batch()");
+    GEOPM_EXPECT_THROW_MESSAGE(m_prefetch->sample(2), GEOPM_ERROR_INVALID,
+                               "batch_idx out of range");
+    // Later batches come from the helper thread
+    ASSERT_TRUE(wait_for_snapshot(10));
+    uint64_t value = m_prefetch->sample(0);
+    EXPECT_LT(10ULL, value);
+    // Both values in a snapshot come from the same batch read
+    EXPECT_EQ(value + 1, m_prefetch->sample(1));
+    struct geopm_time_s second_time = m_prefetch->sample_time();
+    EXPECT_LT(0.0, geopm_time_diff(&first_time, &second_time));
+}
+
+TEST_F(MSRIOPrefetchTest, read_batch_error)
+{
+    EXPECT_CALL(*m_msrio, add_read(_, _)).Times(2);
+    m_prefetch->add_read(0, 0x10);
+    m_prefetch->add_read(1, 0x10);
+    EXPECT_CALL(*m_msrio, read_batch())
+        .WillOnce(Invoke([this]() {
+            ++m_num_read;
+        }))
+        .WillRepeatedly(testing::Throw(geopm::Exception("MockMSRIO::read_batch(): failed",
+                                                        GEOPM_ERROR_MSR_READ, __FILE__, __LINE__)));
+    EXPECT_CALL(*m_msrio, sample(_)).Times(2);
+    m_prefetch->read_batch();
+    // Error on the helper thread is raised by a later call
+    bool is_thrown = false;
+    for (int iter = 0; !is_thrown && iter < 10000; ++iter) {
+        try {
+            m_prefetch->read_batch();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        catch (const geopm::Exception &ex) {
+            EXPECT_EQ(GEOPM_ERROR_MSR_READ, ex.err_value());
+            is_thrown = true;
+        }
+    }
+    EXPECT_TRUE(is_thrown);
+}
+
+TEST_F(MSRIOPrefetchTest, forward)
+{
+    EXPECT_CALL(*m_msrio, read_msr(2, 0x20)).WillOnce(Return(42));
+    EXPECT_CALL(*m_msrio, write_msr(2, 0x20, 0x4, 0xF));
+    EXPECT_CALL(*m_msrio, add_write(3, 0x30)).WillOnce(Return(0));
+    EXPECT_CALL(*m_msrio, adjust(0, 0x8, 0xF));
+    EXPECT_CALL(*m_msrio, write_batch());
+    EXPECT_EQ(42ULL, m_prefetch->read_msr(2, 0x20));
+    m_prefetch->write_msr(2, 0x20, 0x4, 0xF);
+    EXPECT_EQ(0, m_prefetch->add_write(3, 0x30));
+    m_prefetch->adjust(0, 0x8, 0xF);
+    m_prefetch->write_batch();
+}
@@ -39,6 +39,12 @@
 #include <sstream>
 #include <vector>
 #include <string>
+#include <map>
+#include <set>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include "gtest/gtest.h"
 
 #include "MSRIOImp.hpp"
@@ -782,6 +788,27 @@ TEST_F(MSRIOTest, read_batch)
     }
 }
 
+TEST_F(MSRIOTest, add_read_repeated)
+{
+    int idx_0 = m_msrio->add_read(0, 0x0);
+    int idx_1 = m_msrio->add_read(1, 0x0);
+    int idx_2 = m_msrio->add_read(0, 0x8);
+    EXPECT_NE(idx_0, idx_1);
+    EXPECT_NE(idx_0, idx_2);
+    EXPECT_NE(idx_1, idx_2);
+    // Same CPU and offset shares the batch op
+    EXPECT_EQ(idx_0, m_msrio->add_read(0, 0x0));
+    EXPECT_EQ(idx_2, m_msrio->add_read(0, 0x8));
+    m_msrio->read_batch();
+    uint64_t expected;
+    memcpy(&expected, "abstract", 8);
+    EXPECT_EQ(expected, m_msrio->sample(idx_2));
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio->add_read(-1, 0x0),
+                               GEOPM_ERROR_INVALID, "out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(m_msrio->add_read(m_num_cpu, 0x0),
+                               GEOPM_ERROR_INVALID, "out of range");
+}
+
 TEST_F(MSRIOTest, write_batch)
 {
     std::vector<int> cpu_idx;
@@ -827,3 +854,200 @@ TEST_F(MSRIOTest, write_batch)
         }
     }
 }
+
+/// MSRIOImp that records which thread reads each CPU, optionally
+/// failing all reads from one CPU.  The first read on each thread
+/// blocks until a given number of threads are reading at the same
+/// time, so concurrency is checked without timing the reads.
+class ThreadMSRIO : public MSRIOImp
+{
+    public:
+        ThreadMSRIO(int num_cpu, std::shared_ptr<MSRPath> path,
+                    int num_worker, int num_rendezvous)
+            : MSRIOImp(num_cpu, path, num_worker)
+            , m_num_rendezvous(num_rendezvous)
+            , m_is_rendezvous(num_rendezvous <= 1)
+            , m_num_read(0)
+            , m_error_cpu(-1)
+        {
+
+        }
+        uint64_t read_msr(int cpu_idx, uint64_t offset) override
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cpu_thread[cpu_idx].insert(std::this_thread::get_id());
+                ++m_num_read;
+                if (!m_is_rendezvous) {
+                    m_rendezvous_thread.insert(std::this_thread::get_id());
+                    if ((int)m_rendezvous_thread.size() == m_num_rendezvous) {
+                        m_is_rendezvous = true;
+                        m_rendezvous_cond.notify_all();
+                    }
+                    // The timeout only bounds a failing test; a passing
+                    // run never waits for it.
+                    m_rendezvous_cond.wait_for(lock, std::chrono::seconds(10),
+                                               [this]{ return m_is_rendezvous; });
+                }
+                if (cpu_idx == m_error_cpu) {
+                    throw geopm::Exception("ThreadMSRIO::read_msr(): injected failure",
+                                           GEOPM_ERROR_MSR_READ, __FILE__, __LINE__);
+                }
+            }
+            return MSRIOImp::read_msr(cpu_idx, offset);
+        }
+        /// @brief Number of threads that were reading at the same
+        ///        time before the first read returned.
+        int num_rendezvous(void)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_rendezvous_thread.size();
+        }
+        /// @brief Threads that read each CPU since the last call.
+        std::map<int, std::set<std::thread::id> > cpu_thread(void)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::map<int, std::set<std::thread::id> > result;
+            result.swap(m_cpu_thread);
+            return result;
+        }
+        int num_read(void)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_num_read;
+        }
+        void error_cpu(int cpu_idx)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_error_cpu = cpu_idx;
+        }
+    private:
+        const int m_num_rendezvous;
+        std::mutex m_mutex;
+        std::condition_variable m_rendezvous_cond;
+        std::set<std::thread::id> m_rendezvous_thread;
+        bool m_is_rendezvous;
+        std::map<int, std::set<std::thread::id> > m_cpu_thread;
+        int m_num_read;
+        int m_error_cpu;
+};
+
+class MSRIOThreadTest : public :: testing :: Test
+{
+    protected:
+        void SetUp(void);
+        std::unique_ptr<ThreadMSRIO> make_msrio(int num_worker, int num_rendezvous);
+        /// @brief Add reads for every CPU and return the expected values.
+        std::vector<uint64_t> add_reads(ThreadMSRIO &msrio);
+        /// @brief Check that each CPU was read by exactly one thread
+        ///        and return the set of threads that did the reads.
+        std::set<std::thread::id> check_cpu_thread(ThreadMSRIO &msrio);
+        const int m_num_cpu = 16;
+        std::unique_ptr<MSRIOMockFiles> m_files;
+        std::shared_ptr<MockMSRPath> m_path;
+        std::vector<uint64_t> m_offsets {0xd28, 0x520};
+        std::vector<std::string> m_words {"software", "engineer"};
+};
+
+void MSRIOThreadTest::SetUp(void)
+{
+    m_files = geopm::make_unique<MSRIOMockFiles>(m_num_cpu);
+    m_path = std::make_shared<MockMSRPath>();
+}
+
+std::unique_ptr<ThreadMSRIO> MSRIOThreadTest::make_msrio(int num_worker, int num_rendezvous)
+{
+    for (int cpu_idx = 0; cpu_idx != m_num_cpu; ++cpu_idx) {
+        EXPECT_CALL(*m_path, msr_path(cpu_idx, 0))
+            .WillOnce(Return(m_files->test_dev_path()[cpu_idx]));
+    }
+    EXPECT_CALL(*m_path, msr_batch_path())
+        .WillOnce(Return("NO_FILE_HERE"));
+    return geopm::make_unique<ThreadMSRIO>(m_num_cpu, m_path, num_worker, num_rendezvous);
+}
+
+std::vector<uint64_t> MSRIOThreadTest::add_reads(ThreadMSRIO &msrio)
+{
+    std::vector<uint64_t> expected;
+    // Interleave CPUs so that grouping by CPU is exercised
+    for (size_t oi = 0; oi != m_offsets.size(); ++oi) {
+        for (int ci = 0; ci != m_num_cpu; ++ci) {
+            int idx = msrio.add_read(ci, m_offsets[oi]);
+            EXPECT_EQ((int)expected.size(), idx);
+            uint64_t result;
+            memcpy(&result, m_words[oi].data(), 8);
+            expected.push_back(result);
+        }
+    }
+    return expected;
+}
+
+std::set<std::thread::id> MSRIOThreadTest::check_cpu_thread(ThreadMSRIO &msrio)
+{
+    std::set<std::thread::id> result;
+    auto cpu_thread = msrio.cpu_thread();
+    EXPECT_EQ((size_t)m_num_cpu, cpu_thread.size());
+    for (const auto &kv : cpu_thread) {
+        EXPECT_EQ(1ULL, kv.second.size()) << "cpu_idx=" << kv.first;
+        result.insert(kv.second.begin(), kv.second.end());
+    }
+    return result;
+}
+
+TEST_F(MSRIOThreadTest, serial)
+{
+    auto msrio = make_msrio(1, 1);
+    std::vector<uint64_t> expected = add_reads(*msrio);
+    msrio->read_batch();
+    EXPECT_EQ((int)expected.size(), msrio->num_read());
+    std::set<std::thread::id> expected_thread {std::this_thread::get_id()};
+    EXPECT_EQ(expected_thread, check_cpu_thread(*msrio));
+    for (size_t idx = 0; idx != expected.size(); ++idx) {
+        EXPECT_EQ(expected[idx], msrio->sample(idx));
+    }
+}
+
+TEST_F(MSRIOThreadTest, parallel)
+{
+    const int num_worker = 8;
+    auto msrio = make_msrio(num_worker, num_worker);
+    std::vector<uint64_t> expected = add_reads(*msrio);
+    const int num_rep = 3;
+    for (int rep = 0; rep != num_rep; ++rep) {
+        msrio->read_batch();
+        for (size_t idx = 0; idx != expected.size(); ++idx) {
+            EXPECT_EQ(expected[idx], msrio->sample(idx));
+        }
+        std::set<std::thread::id> thread = check_cpu_thread(*msrio);
+        EXPECT_GE((size_t)num_worker, thread.size());
+        if (rep == 0) {
+            // The caller and every pool thread were reading at once
+            EXPECT_EQ(num_worker, msrio->num_rendezvous());
+            EXPECT_EQ((size_t)num_worker, thread.size());
+            EXPECT_EQ(1ULL, thread.count(std::this_thread::get_id()));
+        }
+    }
+    EXPECT_EQ(num_rep * (int)expected.size(), msrio->num_read());
+
+    // Reads added after the first batch are picked up
+    int idx = msrio->add_read(0, 0x0);
+    msrio->read_batch();
+    uint64_t result;
+    memcpy(&result, "absolute", 8);
+    EXPECT_EQ(result, msrio->sample(idx));
+}
+
+TEST_F(MSRIOThreadTest, parallel_error)
+{
+    auto msrio = make_msrio(4, 1);
+    std::vector<uint64_t> expected = add_reads(*msrio);
+    msrio->error_cpu(m_num_cpu - 1);
+    GEOPM_EXPECT_THROW_MESSAGE(msrio->read_batch(), GEOPM_ERROR_MSR_READ,
+                               "injected failure");
+    // Pool recovers once the failing CPU is readable again
+    msrio->error_cpu(-1);
+    msrio->read_batch();
+    for (size_t idx = 0; idx != expected.size(); ++idx) {
+        EXPECT_EQ(expected[idx], msrio->sample(idx));
+    }
+}
@@ -53,10 +53,15 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/AgentFactoryTest.static_info_energy_efficient \
               test/gtest_links/AgentFactoryTest.static_info_frequency_map \
               test/gtest_links/AggTest.agg_function \
+              test/gtest_links/AggTest.aggregate_column \
+              test/gtest_links/AggTest.aggregate_column_agent \
               test/gtest_links/ApplicationSamplerTest.one_enter_exit \
               test/gtest_links/ApplicationSamplerTest.with_mpi \
               test/gtest_links/ApplicationSamplerTest.with_epoch \
               test/gtest_links/ApplicationIOTest.passthrough \
+              test/gtest_links/AsyncWriterTest.backpressure \
+              test/gtest_links/AsyncWriterTest.errors \
+              test/gtest_links/AsyncWriterTest.write_order \
               test/gtest_links/CircularBufferTest.buffer_capacity \
               test/gtest_links/CircularBufferTest.buffer_size \
               test/gtest_links/CircularBufferTest.buffer_values \
@@ -74,6 +79,7 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/CommMPIImpTest.mpi_gatherv \
               test/gtest_links/CommMPIImpTest.mpi_mem_ops \
               test/gtest_links/CommMPIImpTest.mpi_reduce \
+              test/gtest_links/CommMPIImpTest.mpi_reduce_sum \
               test/gtest_links/CommMPIImpTest.mpi_win_ops \
               test/gtest_links/CNLIOGroupTest.valid_signals \
               test/gtest_links/CNLIOGroupTest.read_signal \
@@ -89,10 +95,14 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/ControlMessageTest.loop_begin_1 \
               test/gtest_links/ControlMessageTest.step \
               test/gtest_links/ControlMessageTest.wait \
+              test/gtest_links/ControllerIOGroupTest.errors \
+              test/gtest_links/ControllerIOGroupTest.push_sample \
+              test/gtest_links/ControllerIOGroupTest.valid_signals \
               test/gtest_links/ControllerTest.construct_with_file_policy \
               test/gtest_links/ControllerTest.get_hostnames \
               test/gtest_links/ControllerTest.run_with_no_policy \
               test/gtest_links/ControllerTest.single_node \
+              test/gtest_links/ControllerTest.single_node_pipeline \
               test/gtest_links/ControllerTest.two_level_controller_0 \
               test/gtest_links/ControllerTest.two_level_controller_1 \
               test/gtest_links/ControllerTest.two_level_controller_2 \
@@ -118,6 +128,10 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/DebugIOGroupTest.read_signal \
               test/gtest_links/DebugIOGroupTest.register_signal_error \
               test/gtest_links/DebugIOGroupTest.sample \
+              test/gtest_links/DerivativeHistoryTest.errors \
+              test/gtest_links/DerivativeHistoryTest.running_matches_exact \
+              test/gtest_links/DerivativeHistoryTest.single_sample_window \
+              test/gtest_links/DerivativeHistoryTest.slope \
               test/gtest_links/DerivativeSignalTest.errors \
               test/gtest_links/DerivativeSignalTest.read_batch_flat \
               test/gtest_links/DerivativeSignalTest.read_batch_first \
@@ -161,6 +175,7 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/EnergyEfficientAgentTest.aggregate_sample \
               test/gtest_links/EnergyEfficientAgentTest.do_write_batch \
               test/gtest_links/EnergyEfficientAgentTest.enforce_policy \
+              test/gtest_links/EnergyEfficientAgentTest.report_host \
               test/gtest_links/EnergyEfficientAgentTest.split_policy_changed \
               test/gtest_links/EnergyEfficientAgentTest.split_policy_errors \
               test/gtest_links/EnergyEfficientAgentTest.split_policy_unchanged \
@@ -207,6 +222,7 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/FrequencyMapAgentTest.name \
               test/gtest_links/FrequencyMapAgentTest.enforce_policy \
               test/gtest_links/FrequencyMapAgentTest.policy_to_json \
+              test/gtest_links/FrequencyMapAgentTest.report_host \
               test/gtest_links/FrequencyMapAgentTest.split_policy \
               test/gtest_links/FrequencyMapAgentTest.validate_policy \
               test/gtest_links/HelperTest.string_begins_with \
@@ -219,6 +235,12 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/IOGroupTest.signals_have_agg_functions \
               test/gtest_links/IOGroupTest.signals_have_descriptions \
               test/gtest_links/IOGroupTest.signals_have_format_functions \
+              test/gtest_links/LatencyHistogramTest.concurrent_update \
+              test/gtest_links/LatencyHistogramTest.controller_latency_report \
+              test/gtest_links/LatencyHistogramTest.empty \
+              test/gtest_links/LatencyHistogramTest.out_of_range \
+              test/gtest_links/LatencyHistogramTest.percentile \
+              test/gtest_links/LatencyHistogramTest.small_values_exact \
               test/gtest_links/MSRIOGroupTest.adjust \
               test/gtest_links/MSRIOGroupTest.control_error \
               test/gtest_links/MSRIOGroupTest.cpuid \
@@ -244,11 +266,23 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/MSRIOGroupTest.valid_signal_names \
               test/gtest_links/MSRIOGroupTest.whitelist \
               test/gtest_links/MSRIOGroupTest.write_control \
+              test/gtest_links/MSRIOPrefetchTest.forward \
+              test/gtest_links/MSRIOPrefetchTest.read_batch \
+              test/gtest_links/MSRIOPrefetchTest.read_batch_error \
+              test/gtest_links/MSRIOTest.add_read_repeated \
               test/gtest_links/MSRIOTest.read_aligned \
               test/gtest_links/MSRIOTest.read_batch \
               test/gtest_links/MSRIOTest.read_unaligned \
               test/gtest_links/MSRIOTest.write \
               test/gtest_links/MSRIOTest.write_batch \
+              test/gtest_links/MSRIOThreadTest.parallel \
+              test/gtest_links/MSRIOThreadTest.parallel_error \
+              test/gtest_links/MSRIOThreadTest.serial \
+              test/gtest_links/MSRBatchDecoderTest.decode_once \
+              test/gtest_links/MSRBatchDecoderTest.errors \
+              test/gtest_links/MSRBatchDecoderTest.functions \
+              test/gtest_links/MSRBatchDecoderTest.match_field_signal \
+              test/gtest_links/MSRBatchDecoderTest.overflow \
               test/gtest_links/MSRFieldControlTest.errors \
               test/gtest_links/MSRFieldControlTest.save_restore \
               test/gtest_links/MSRFieldControlTest.setup_batch \
@@ -270,7 +304,12 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/MSRFieldSignalTest.setup_batch \
               test/gtest_links/ModelApplicationTest.parse_config_errors \
               test/gtest_links/MonitorAgentTest.policy_names \
+              test/gtest_links/MonitorAgentTest.report_host \
               test/gtest_links/MonitorAgentTest.sample_names \
+              test/gtest_links/NumberFormatTest.double_layout \
+              test/gtest_links/NumberFormatTest.double_round_trip \
+              test/gtest_links/NumberFormatTest.format_type \
+              test/gtest_links/NumberFormatTest.match_string_format \
               test/gtest_links/OptionParserTest.get_invalid \
               test/gtest_links/OptionParserTest.parse_errors \
               test/gtest_links/OptionParserTest.add_option_errors \
@@ -296,6 +335,7 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/PlatformIOTest.read_signal_override \
               test/gtest_links/PlatformIOTest.sample \
               test/gtest_links/PlatformIOTest.sample_agg \
+              test/gtest_links/PlatformIOTest.sample_all \
               test/gtest_links/PlatformIOTest.signal_control_description \
               test/gtest_links/PlatformIOTest.signal_control_names \
               test/gtest_links/PlatformIOTest.write_control \
@@ -318,6 +358,7 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/PlatformTopoTest.call_c_wrappers \
               test/gtest_links/PowerBalancerAgentTest.leaf_agent \
               test/gtest_links/PowerBalancerAgentTest.power_balancer_agent \
+              test/gtest_links/PowerBalancerAgentTest.report_host \
               test/gtest_links/PowerBalancerAgentTest.tree_agent \
               test/gtest_links/PowerBalancerAgentTest.tree_root_agent \
               test/gtest_links/PowerBalancerAgentTest.enforce_policy \
@@ -328,6 +369,7 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/PowerGovernorAgentTest.adjust_platform \
               test/gtest_links/PowerGovernorAgentTest.aggregate_sample \
               test/gtest_links/PowerGovernorAgentTest.enforce_policy \
+              test/gtest_links/PowerGovernorAgentTest.report_host \
               test/gtest_links/PowerGovernorAgentTest.split_policy \
               test/gtest_links/PowerGovernorAgentTest.sample_platform \
               test/gtest_links/PowerGovernorAgentTest.trace \
@@ -339,11 +381,21 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/ProfileTableTest.name_set_fill_long \
               test/gtest_links/ProfileTableTest.name_set_fill_short \
               test/gtest_links/ProfileTableTest.overfill \
+              test/gtest_links/ProfileTableTest.overfill_boundary \
+              test/gtest_links/ProfileTableTest.overfill_coalesce \
+              test/gtest_links/ProfileTableTest.ring_flush \
+              test/gtest_links/ProfileTableTest.ring_name_set_fill_short \
+              test/gtest_links/ProfileTableTest.ring_order \
+              test/gtest_links/ProfileTableTest.ring_overfill \
+              test/gtest_links/ProfileTableTest.ring_overfill_backlog \
+              test/gtest_links/ProfileTableTest.ring_producer_consumer \
               test/gtest_links/ProfileTest.enter_exit \
               test/gtest_links/ProfileTest.epoch \
               test/gtest_links/ProfileTest.progress \
               test/gtest_links/ProfileTest.region \
               test/gtest_links/ProfileTest.shutdown \
+              test/gtest_links/ProfileTest.shutdown_flush \
+              test/gtest_links/ProfileTest.shutdown_flush_timeout \
               test/gtest_links/ProfileTest.tprof_table \
               test/gtest_links/ProfileTestIntegration.config \
               test/gtest_links/ProfileTestIntegration.cpu_set_size \
@@ -358,8 +410,17 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/RawMSRSignalTest.read_batch \
               test/gtest_links/RawMSRSignalTest.setup_batch \
               test/gtest_links/RegionAggregatorTest.epoch_total \
+              test/gtest_links/RegionAggregatorTest.many_regions \
               test/gtest_links/RegionAggregatorTest.sample_total \
+              test/gtest_links/ReportModelTest.json_round_trip \
+              test/gtest_links/ReportModelTest.json_round_trip_text \
+              test/gtest_links/ReportModelTest.load_invalid \
+              test/gtest_links/ReportModelTest.text \
               test/gtest_links/ReporterTest.generate \
+              test/gtest_links/ReporterTest.generate_json \
+              test/gtest_links/ReporterTest.generate_per_node \
+              test/gtest_links/ReporterTest.generate_sparse \
+              test/gtest_links/ReporterTest.generate_summary \
               test/gtest_links/RuntimeRegulatorTest.all_in_and_out \
               test/gtest_links/RuntimeRegulatorTest.all_reenter \
               test/gtest_links/RuntimeRegulatorTest.check_start_count \
@@ -384,6 +445,13 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/SharedMemoryTest.lock_shmem_u \
               test/gtest_links/SharedMemoryTest.share_data \
               test/gtest_links/SharedMemoryTest.share_data_ipc \
+              test/gtest_links/ThreadCommTest.collective \
+              test/gtest_links/ThreadCommTest.fan_out_candidate \
+              test/gtest_links/ThreadCommTest.fan_out_tuned \
+              test/gtest_links/ThreadCommTest.make_plugin \
+              test/gtest_links/ThreadCommTest.split \
+              test/gtest_links/ThreadCommTest.tree_comm \
+              test/gtest_links/ThreadCommTest.window \
               test/gtest_links/TimeIOGroupTest.adjust \
               test/gtest_links/TimeIOGroupTest.is_valid \
               test/gtest_links/TimeIOGroupTest.push \
@@ -391,9 +459,23 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/TimeIOGroupTest.read_signal \
               test/gtest_links/TimeIOGroupTest.read_signal_and_batch \
               test/gtest_links/TimeIOGroupTest.sample \
+              test/gtest_links/TraceBinaryTest.bad_file \
+              test/gtest_links/TraceBinaryTest.compress_block \
+              test/gtest_links/TraceBinaryTest.compressed_csv \
+              test/gtest_links/TraceBinaryTest.custom_format \
+              test/gtest_links/TraceBinaryTest.schema \
+              test/gtest_links/TraceBinaryTest.uncompressed_csv \
               test/gtest_links/TracerTest.columns \
+              test/gtest_links/TracerTest.mode_every_change \
+              test/gtest_links/TracerTest.mode_invalid \
+              test/gtest_links/TracerTest.mode_region \
               test/gtest_links/TracerTest.region_entry_exit \
               test/gtest_links/TracerTest.update_samples \
+              test/gtest_links/TreeCommLevelSequenceTest.receive_up_retry \
+              test/gtest_links/TreeCommLevelSequenceTest.send_down_receive_down \
+              test/gtest_links/TreeCommLevelSequenceTest.send_up_receive_up \
+              test/gtest_links/TreeCommLevelSparseTest.send_down_receive_down \
+              test/gtest_links/TreeCommLevelSparseTest.send_up_receive_up \
               test/gtest_links/TreeCommLevelTest.level_rank \
               test/gtest_links/TreeCommLevelTest.receive_down_complete \
               test/gtest_links/TreeCommLevelTest.receive_down_incomplete \
@@ -402,10 +484,17 @@ GTEST_TESTS = test/gtest_links/AdminTest.agent_no_policy \
               test/gtest_links/TreeCommLevelTest.send_down \
               test/gtest_links/TreeCommLevelTest.send_down_zero_value \
               test/gtest_links/TreeCommLevelTest.send_up \
+              test/gtest_links/TreeCommLevelTest.send_up_sparse \
               test/gtest_links/TreeCommTest.geometry \
               test/gtest_links/TreeCommTest.geometry_nonroot \
+              test/gtest_links/TreeCommTest.overhead_saved \
               test/gtest_links/TreeCommTest.overhead_send \
               test/gtest_links/TreeCommTest.send_receive \
+              test/gtest_links/WaiterTest.invalid \
+              test/gtest_links/WaiterTest.first_wait \
+              test/gtest_links/WaiterTest.missed \
+              test/gtest_links/WaiterTest.period \
+              test/gtest_links/WaiterTest.report \
               # end
 
 if ENABLE_BETA
@@ -449,15 +538,18 @@ test_geopm_test_SOURCES = test/AdminTest.cpp \
                           test/AggTest.cpp \
                           test/ApplicationIOTest.cpp \
                           test/ApplicationSamplerTest.cpp \
+                          test/AsyncWriterTest.cpp \
                           test/CircularBufferTest.cpp \
                           test/CNLIOGroupTest.cpp \
                           test/CombinedSignalTest.cpp \
                           test/CommMPIImpTest.cpp \
                           test/ControlMessageTest.cpp \
+                          test/ControllerIOGroupTest.cpp \
                           test/ControllerTest.cpp \
                           test/CpuinfoIOGroupTest.cpp \
                           test/CSVTest.cpp \
                           test/DebugIOGroupTest.cpp \
+                          test/DerivativeHistoryTest.cpp \
                           test/DerivativeSignalTest.cpp \
                           test/DifferenceSignalTest.cpp \
                           test/DomainControlTest.cpp \
@@ -474,8 +566,11 @@ test_geopm_test_SOURCES = test/AdminTest.cpp \
                           test/FrequencyMapAgentTest.cpp \
                           test/HelperTest.cpp \
                           test/IOGroupTest.cpp \
+                          test/LatencyHistogramTest.cpp \
                           test/MSRIOGroupTest.cpp \
+                          test/MSRIOPrefetchTest.cpp \
                           test/MSRIOTest.cpp \
+                          test/MSRBatchDecoderTest.cpp \
                           test/MSRFieldControlTest.cpp \
                           test/MSRFieldSignalTest.cpp \
                           test/MockAgent.hpp \
@@ -510,8 +605,10 @@ test_geopm_test_SOURCES = test/AdminTest.cpp \
                           test/MockTracer.hpp \
                           test/MockTreeComm.hpp \
                           test/MockTreeCommLevel.hpp \
+                          test/MockWaiter.hpp \
                           test/ModelApplicationTest.cpp \
                           test/MonitorAgentTest.cpp \
+                          test/NumberFormatTest.cpp \
                           test/OptionParserTest.cpp \
                           test/PlatformIOTest.cpp \
                           test/PlatformTopoTest.cpp \
@@ -524,15 +621,19 @@ test_geopm_test_SOURCES = test/AdminTest.cpp \
                           test/ProfileTracerTest.cpp \
                           test/RawMSRSignalTest.cpp \
                           test/RegionAggregatorTest.cpp \
+                          test/ReportModelTest.cpp \
                           test/ReporterTest.cpp \
                           test/RuntimeRegulatorTest.cpp \
                           test/SampleRegulatorTest.cpp \
                           test/SchedTest.cpp \
                           test/SharedMemoryTest.cpp \
+                          test/ThreadCommTest.cpp \
                           test/TimeIOGroupTest.cpp \
+                          test/TraceBinaryTest.cpp \
                           test/TracerTest.cpp \
                           test/TreeCommLevelTest.cpp \
                           test/TreeCommTest.cpp \
+                          test/WaiterTest.cpp \
                           test/geopm_test.cpp \
                           test/geopm_test_helper.cpp \
                           test/geopm_test.hpp \
@@ -72,6 +72,10 @@ class MockApplicationIO : public geopm::ApplicationIO
                            int(void));
         MOCK_CONST_METHOD1(total_count,
                            int(uint64_t region_id));
+        MOCK_CONST_METHOD0(profile_table_coalesced,
+                           std::vector<uint64_t>(void));
+        MOCK_CONST_METHOD0(profile_table_dropped,
+                           std::vector<uint64_t>(void));
         MOCK_METHOD1(update,
                      void(std::shared_ptr<geopm::Comm> comm));
         MOCK_CONST_METHOD0(region_info,
@@ -36,6 +36,7 @@
 #include "gmock/gmock.h"
 
 #include "IOGroup.hpp"
+#include "geopm_time.h"
 
 class MockIOGroup : public geopm::IOGroup
 {
@@ -58,6 +59,10 @@ class MockIOGroup : public geopm::IOGroup
                      int (const std::string &control_name, int domain_type, int domain_idx));
         MOCK_METHOD0(read_batch,
                      void (void));
+        MOCK_METHOD1(set_batch_time,
+                     void (const struct geopm_time_s &batch_time));
+        MOCK_CONST_METHOD0(is_batch_independent,
+                           bool (void));
         MOCK_METHOD0(write_batch,
                      void (void));
         MOCK_METHOD1(sample,
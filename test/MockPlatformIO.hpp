@@ -68,6 +68,8 @@ class MockPlatformIO : public geopm::PlatformIO
                            int(void));
         MOCK_METHOD1(sample,
                      double(int signal_idx));
+        MOCK_METHOD2(sample_all,
+                     void(const std::vector<int> &signal_idx, std::vector<double> &sample));
         MOCK_METHOD2(adjust,
                      void(int control_idx, double setting));
         MOCK_METHOD0(read_batch,
@@ -36,6 +36,7 @@
 
 using geopm::Exception;
 using ::testing::Return;
+using ::testing::ReturnRefOfCopy;
 
 std::shared_ptr<MockPlatformTopo> make_topo(int num_package, int num_core, int num_cpu)
 {
@@ -123,5 +124,26 @@ std::shared_ptr<MockPlatformTopo> make_topo(int num_package, int num_core, int n
             .WillByDefault(Return(std::set<int>{cpu_idx}));
     }
 
+    // expectations for domain_cpu_list
+    ON_CALL(*topo, domain_cpu_list(GEOPM_DOMAIN_BOARD, 0))
+        .WillByDefault(ReturnRefOfCopy(std::vector<int>(all_cpus.begin(), all_cpus.end())));
+    for (int package_idx = 0; package_idx < num_package; ++package_idx) {
+        std::vector<int> cpus(package_cpus[package_idx].begin(),
+                              package_cpus[package_idx].end());
+        ON_CALL(*topo, domain_cpu_list(GEOPM_DOMAIN_PACKAGE, package_idx))
+            .WillByDefault(ReturnRefOfCopy(cpus));
+        ON_CALL(*topo, domain_cpu_list(GEOPM_DOMAIN_BOARD_MEMORY, package_idx))
+            .WillByDefault(ReturnRefOfCopy(cpus));
+    }
+    for (int core_idx = 0; core_idx < num_core; ++core_idx) {
+        ON_CALL(*topo, domain_cpu_list(GEOPM_DOMAIN_CORE, core_idx))
+            .WillByDefault(ReturnRefOfCopy(std::vector<int>(core_cpus[core_idx].begin(),
+                                                                     core_cpus[core_idx].end())));
+    }
+    for (int cpu_idx = 0; cpu_idx < num_cpu; ++cpu_idx) {
+        ON_CALL(*topo, domain_cpu_list(GEOPM_DOMAIN_CPU, cpu_idx))
+            .WillByDefault(ReturnRefOfCopy(std::vector<int>{cpu_idx}));
+    }
+
     return topo;
 }
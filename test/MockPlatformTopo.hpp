@@ -50,6 +50,8 @@ class MockPlatformTopo : public geopm::PlatformTopo
                            bool(int inner_domain, int outer_domain));
         MOCK_CONST_METHOD3(domain_nested,
                            std::set<int>(int inner_domain, int outer_domain, int outer_idx));
+        MOCK_CONST_METHOD2(domain_cpu_list,
+                           const std::vector<int> &(int domain_type, int domain_idx));
 };
 
 /// Create a MockPlatformTopo and set up expectations for the system hierarchy.
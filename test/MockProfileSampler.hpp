@@ -74,6 +74,10 @@ class MockProfileSampler : public geopm::ProfileSampler
                      void(void));
         MOCK_METHOD0(sample_cache,
                      std::vector<struct geopm_prof_message_s> (void));
+        MOCK_CONST_METHOD0(rank_num_coalesced,
+                           std::vector<uint64_t> (void));
+        MOCK_CONST_METHOD0(rank_num_dropped,
+                           std::vector<uint64_t> (void));
 
 };
 
@@ -55,6 +55,12 @@ class MockProfileTable : public geopm::ProfileTable
                      bool (size_t header_offset));
         MOCK_METHOD2(name_set,
                      bool (size_t header_offset, std::set<std::string> &name));
+        MOCK_CONST_METHOD0(num_coalesced,
+                           uint64_t (void));
+        MOCK_CONST_METHOD0(num_dropped,
+                           uint64_t (void));
+        MOCK_METHOD0(flush,
+                     bool (void));
 };
 
 #endif
@@ -105,6 +105,8 @@ class MockTreeComm : public geopm::TreeComm
         }
         MOCK_CONST_METHOD0(overhead_send,
                            size_t(void));
+        MOCK_CONST_METHOD0(overhead_saved,
+                           size_t(void));
         MOCK_METHOD1(broadcast_string,
                      void(const std::string &str));
         MOCK_METHOD0(broadcast_string,
@@ -51,6 +51,8 @@ class MockTreeCommLevel : public geopm::TreeCommLevel {
                      bool(std::vector<double> &policy));
         MOCK_CONST_METHOD0(overhead_send,
                            size_t(void));
+        MOCK_CONST_METHOD0(overhead_saved,
+                           size_t(void));
 };
 
 #endif
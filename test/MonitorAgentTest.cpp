@@ -36,6 +36,7 @@
 #include "MonitorAgent.hpp"
 #include "MockPlatformIO.hpp"
 #include "MockPlatformTopo.hpp"
+#include "MockWaiter.hpp"
 #include "Helper.hpp"
 #include "Agg.hpp"
 
@@ -69,3 +70,12 @@ TEST_F(MonitorAgentTest, policy_names)
     std::vector<std::string> expected_policy_names = {};
     EXPECT_EQ(expected_policy_names, m_agent->policy_names());
 }
+
+TEST_F(MonitorAgentTest, report_host)
+{
+    std::vector<std::pair<std::string, std::string> > wait_report {{"Wait count", "7"}};
+    auto waiter = geopm::make_unique<MockWaiter>();
+    EXPECT_CALL(*waiter, report()).WillOnce(Return(wait_report));
+    m_agent = geopm::make_unique<MonitorAgent>(m_platform_io, m_platform_topo, std::move(waiter));
+    EXPECT_EQ(wait_report, m_agent->report_host());
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "geopm_error.h"
+#include "geopm_hash.h"
+#include "geopm_test.hpp"
+#include "Helper.hpp"
+#include "NumberFormat.hpp"
+
+using geopm::NumberFormat;
+
+static std::string format_double(double value)
+{
+    char buffer[NumberFormat::M_MAX_SIZE];
+    return std::string(buffer, NumberFormat::format_double(value, buffer));
+}
+
+TEST(NumberFormatTest, double_layout)
+{
+    EXPECT_EQ("0", format_double(0.0));
+    EXPECT_EQ("-0", format_double(-0.0));
+    EXPECT_EQ("nan", format_double(NAN));
+    EXPECT_EQ("-nan", format_double(-NAN));
+    EXPECT_EQ("inf", format_double(INFINITY));
+    EXPECT_EQ("-inf", format_double(-INFINITY));
+    EXPECT_EQ("0.5", format_double(0.5));
+    EXPECT_EQ("88.8", format_double(88.8));
+    EXPECT_EQ("-2.2", format_double(-2.2));
+    EXPECT_EQ("1024", format_double(1024));
+    EXPECT_EQ("0.000244140625", format_double(0.000244140625));
+    EXPECT_EQ("1e-05", format_double(1e-5));
+    EXPECT_EQ("1.5e-300", format_double(1.5e-300));
+    EXPECT_EQ("1234567890123456", format_double(1234567890123456.0));
+    EXPECT_EQ("1e+16", format_double(1e16));
+    EXPECT_EQ("1.7976931348623157e+308", format_double(1.7976931348623157e308));
+    EXPECT_EQ("5e-324", format_double(5e-324));
+    // "%.16g" prints 0.3 for this value
+    EXPECT_EQ("0.30000000000000004", format_double(0.1 + 0.2));
+}
+
+TEST(NumberFormatTest, double_round_trip)
+{
+    std::mt19937_64 generator(42);
+    std::uniform_real_distribution<double> uniform(0.0, 1000.0);
+    for (int idx = 0; idx != 100000; ++idx) {
+        // Random bit patterns cover every exponent; also check values
+        // in the range of typical telemetry.
+        double value = geopm_field_to_signal(generator());
+        if (isnan(value)) {
+            continue;
+        }
+        std::string result = format_double(value);
+        ASSERT_EQ(value, strtod(result.c_str(), NULL)) << result;
+        ASSERT_LE(result.size(), 24u);
+        value = uniform(generator);
+        result = format_double(value);
+        ASSERT_EQ(value, strtod(result.c_str(), NULL)) << result;
+        // Never longer than the 17 digits that always round trip
+        char longest[NumberFormat::M_MAX_SIZE];
+        snprintf(longest, sizeof(longest), "%.17g", value);
+        EXPECT_LE(result.size(), strlen(longest));
+    }
+}
+
+TEST(NumberFormatTest, match_string_format)
+{
+    std::mt19937_64 generator(7);
+    std::uniform_real_distribution<double> uniform(-1e6, 1e6);
+    std::uniform_int_distribution<uint64_t> uniform_int;
+    char buffer[NumberFormat::M_MAX_SIZE];
+    for (int idx = 0; idx != 10000; ++idx) {
+        double value = uniform(generator);
+        EXPECT_EQ(geopm::string_format_float(value),
+                  std::string(buffer, NumberFormat::format_float(value, buffer)));
+        EXPECT_EQ(geopm::string_format_integer(value),
+                  std::string(buffer, NumberFormat::format_integer(value, buffer)));
+        EXPECT_EQ(geopm::string_format_raw64(value),
+                  std::string(buffer, NumberFormat::format_raw64(value, buffer)));
+        double hash = (double)(uniform_int(generator) >> 11);
+        EXPECT_EQ(geopm::string_format_hex(hash),
+                  std::string(buffer, NumberFormat::format_hex(hash, buffer)));
+        EXPECT_EQ(geopm::string_format_integer(hash),
+                  std::string(buffer, NumberFormat::format_integer(hash, buffer)));
+    }
+    for (double value : {0.0, -1.0, 9.0, 10.0, -9223372036854775808.0}) {
+        EXPECT_EQ(geopm::string_format_integer(value),
+                  std::string(buffer, NumberFormat::format_integer(value, buffer)));
+    }
+}
+
+TEST(NumberFormatTest, format_type)
+{
+    EXPECT_EQ(NumberFormat::M_FORMAT_DOUBLE, NumberFormat::format_type(geopm::string_format_double));
+    EXPECT_EQ(NumberFormat::M_FORMAT_FLOAT, NumberFormat::format_type(geopm::string_format_float));
+    EXPECT_EQ(NumberFormat::M_FORMAT_INTEGER, NumberFormat::format_type(geopm::string_format_integer));
+    EXPECT_EQ(NumberFormat::M_FORMAT_HEX, NumberFormat::format_type(geopm::string_format_hex));
+    EXPECT_EQ(NumberFormat::M_FORMAT_RAW64, NumberFormat::format_type(geopm::string_format_raw64));
+    EXPECT_EQ(NumberFormat::M_FORMAT_CUSTOM, NumberFormat::format_type([](double value) {
+        return std::to_string(value);
+    }));
+    char buffer[NumberFormat::M_MAX_SIZE];
+    EXPECT_EQ(3u, NumberFormat::format(NumberFormat::M_FORMAT_INTEGER, 123.4, buffer));
+    EXPECT_EQ("123", std::string(buffer, 3));
+    GEOPM_EXPECT_THROW_MESSAGE(NumberFormat::format(NumberFormat::M_FORMAT_CUSTOM, 1.0, buffer),
+                               GEOPM_ERROR_INVALID, "invalid format type");
+}
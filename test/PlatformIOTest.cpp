@@ -36,6 +36,7 @@
 #include <string>
 #include <algorithm>
 #include <cmath>
+#include <thread>
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -61,6 +62,9 @@ using ::testing::_;
 using ::testing::Return;
 using ::testing::SetArgReferee;
 using ::testing::AtLeast;
+using ::testing::Invoke;
+using ::testing::SaveArg;
+using ::testing::Throw;
 
 class PlatformIOTestMockIOGroup : public MockIOGroup
 {
@@ -75,6 +79,9 @@ class PlatformIOTestMockIOGroup : public MockIOGroup
             //  registered plugins
             EXPECT_CALL(*this, is_valid_signal(_)).Times(AtLeast(0));
             EXPECT_CALL(*this, is_valid_control(_)).Times(AtLeast(0));
+            // Called by PlatformIO::read_batch() for every IOGroup
+            EXPECT_CALL(*this, set_batch_time(_)).Times(AtLeast(0));
+            EXPECT_CALL(*this, is_batch_independent()).Times(AtLeast(0));
         }
 
         // Set up mock behavior for the IOGroup to provide a set of signals for specific domains
@@ -268,7 +275,7 @@ TEST_F(PlatformIOTest, push_signal_agg)
 {
     EXPECT_CALL(*m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
                                          GEOPM_DOMAIN_PACKAGE));
-    EXPECT_CALL(*m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_topo, domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 0));
 
     EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
     for (auto cpu : m_cpu_set0) {
@@ -301,7 +308,7 @@ TEST_F(PlatformIOTest, push_control_agg)
 {
     EXPECT_CALL(*m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
                                          GEOPM_DOMAIN_PACKAGE));
-    EXPECT_CALL(*m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_topo, domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 0));
     EXPECT_EQ(0, m_platio->num_control_pushed());
     EXPECT_CALL(*m_control_iogroup, control_domain_type("FREQ")).Times(AtLeast(1));
     for (auto cpu : m_cpu_set0) {
@@ -341,11 +348,73 @@ TEST_F(PlatformIOTest, sample)
     GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample(10), GEOPM_ERROR_INVALID, "signal_idx out of range");
 }
 
+TEST_F(PlatformIOTest, read_batch_time)
+{
+    std::vector<struct geopm_time_s> batch_time(m_iogroup_ptr.size());
+    int group_idx = 0;
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, set_batch_time(_))
+            .WillOnce(SaveArg<0>(&batch_time[group_idx]));
+        EXPECT_CALL(*iog, read_batch());
+        ++group_idx;
+    }
+    struct geopm_time_s before;
+    struct geopm_time_s after;
+    geopm_time(&before);
+    m_platio->read_batch();
+    geopm_time(&after);
+    // Every IOGroup is given the same batch start time
+    for (const auto &it : batch_time) {
+        EXPECT_EQ(0.0, geopm_time_diff(&batch_time[0], &it));
+    }
+    EXPECT_LE(0.0, geopm_time_diff(&before, &batch_time[0]));
+    EXPECT_LE(0.0, geopm_time_diff(&batch_time[0], &after));
+}
+
+TEST_F(PlatformIOTest, read_batch_parallel)
+{
+    ON_CALL(*m_control_iogroup, is_batch_independent())
+        .WillByDefault(Return(true));
+    ON_CALL(*m_override_iogroup, is_batch_independent())
+        .WillByDefault(Return(true));
+    std::thread::id time_thread;
+    std::thread::id control_thread;
+    std::thread::id override_thread;
+    EXPECT_CALL(*m_time_iogroup, read_batch())
+        .WillOnce(Invoke([&time_thread]() {time_thread = std::this_thread::get_id();}));
+    EXPECT_CALL(*m_control_iogroup, read_batch())
+        .WillOnce(Invoke([&control_thread]() {control_thread = std::this_thread::get_id();}));
+    EXPECT_CALL(*m_override_iogroup, read_batch())
+        .WillOnce(Invoke([&override_thread]() {override_thread = std::this_thread::get_id();}));
+    m_platio->read_batch();
+    // Dependent IOGroups are read by the caller, independent
+    // IOGroups each on a worker thread
+    EXPECT_EQ(std::this_thread::get_id(), time_thread);
+    EXPECT_NE(std::this_thread::get_id(), control_thread);
+    EXPECT_NE(std::this_thread::get_id(), override_thread);
+    EXPECT_NE(control_thread, override_thread);
+
+    // An error on a worker is raised by read_batch() once all
+    // IOGroups have finished
+    EXPECT_CALL(*m_time_iogroup, read_batch());
+    EXPECT_CALL(*m_control_iogroup, read_batch())
+        .WillOnce(Throw(geopm::Exception("control read failed",
+                                         GEOPM_ERROR_RUNTIME, __FILE__, __LINE__)));
+    EXPECT_CALL(*m_override_iogroup, read_batch());
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->read_batch(), GEOPM_ERROR_RUNTIME,
+                               "control read failed");
+
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch());
+    }
+    m_platio->read_batch();
+}
+
 TEST_F(PlatformIOTest, sample_agg)
 {
     EXPECT_CALL(*m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
                                          GEOPM_DOMAIN_PACKAGE));
-    EXPECT_CALL(*m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_topo, domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 0));
     EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
     EXPECT_CALL(*m_control_iogroup, agg_function("FREQ"))
         .WillOnce(Return(geopm::Agg::average));
@@ -372,6 +441,76 @@ TEST_F(PlatformIOTest, sample_agg)
     EXPECT_DOUBLE_EQ(sum / m_cpu_set0.size(), freq);
 }
 
+TEST_F(PlatformIOTest, sample_all)
+{
+    EXPECT_CALL(*m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
+                                         GEOPM_DOMAIN_PACKAGE));
+    EXPECT_CALL(*m_topo, domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
+    EXPECT_CALL(*m_control_iogroup, agg_function("FREQ"))
+        .WillOnce(Return(geopm::Agg::average));
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, push_signal("FREQ", GEOPM_DOMAIN_CPU, cpu))
+            .WillOnce(Return(cpu));
+    }
+    EXPECT_CALL(*m_time_iogroup, signal_domain_type("TIME"));
+    EXPECT_CALL(*m_time_iogroup, push_signal("TIME", _, _));
+    int freq_idx = m_platio->push_signal("FREQ", GEOPM_DOMAIN_PACKAGE, 0);
+    int time_idx = m_platio->push_signal("TIME", GEOPM_DOMAIN_BOARD, 0);
+    int num_signal = m_platio->num_signal_pushed();
+    EXPECT_EQ((int)m_cpu_set0.size() + 2, num_signal);
+
+    std::vector<double> sample;
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample_all(sample), GEOPM_ERROR_RUNTIME,
+                               "read_batch() not called");
+
+    for (auto iog : m_iogroup_ptr) {
+        EXPECT_CALL(*iog, read_batch());
+    }
+    m_platio->read_batch();
+
+    // Each IOGroup signal is sampled once, even when it is also an
+    // operand of a combined signal
+    double sum = 0;
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, sample(cpu)).WillOnce(Return(cpu));
+        sum += cpu;
+    }
+    EXPECT_CALL(*m_time_iogroup, sample(0)).WillOnce(Return(1.0));
+    m_platio->sample_all(sample);
+    ASSERT_EQ((size_t)num_signal, sample.size());
+    EXPECT_DOUBLE_EQ(sum / m_cpu_set0.size(), sample[freq_idx]);
+    EXPECT_DOUBLE_EQ(1.0, sample[time_idx]);
+
+    // Subset only samples the requested signals
+    EXPECT_CALL(*m_time_iogroup, sample(0)).WillOnce(Return(2.0));
+    m_platio->sample_all({time_idx}, sample);
+    ASSERT_EQ(1u, sample.size());
+    EXPECT_DOUBLE_EQ(2.0, sample[0]);
+
+    for (auto cpu : m_cpu_set0) {
+        EXPECT_CALL(*m_control_iogroup, sample(cpu)).WillOnce(Return(2 * cpu));
+    }
+    EXPECT_CALL(*m_time_iogroup, sample(0)).Times(2)
+        .WillRepeatedly(Return(3.0));
+    m_platio->sample_all({time_idx, freq_idx, time_idx}, sample);
+    ASSERT_EQ(3u, sample.size());
+    EXPECT_DOUBLE_EQ(3.0, sample[0]);
+    EXPECT_DOUBLE_EQ(2 * sum / m_cpu_set0.size(), sample[1]);
+    EXPECT_DOUBLE_EQ(3.0, sample[2]);
+
+    // Default implementation for other PlatformIO classes
+    EXPECT_CALL(*m_time_iogroup, sample(0)).WillOnce(Return(4.0));
+    m_platio->PlatformIO::sample_all({time_idx}, sample);
+    ASSERT_EQ(1u, sample.size());
+    EXPECT_DOUBLE_EQ(4.0, sample[0]);
+
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample_all({-1}, sample),
+                               GEOPM_ERROR_INVALID, "signal_idx out of range");
+    GEOPM_EXPECT_THROW_MESSAGE(m_platio->sample_all({num_signal}, sample),
+                               GEOPM_ERROR_INVALID, "signal_idx out of range");
+}
+
 TEST_F(PlatformIOTest, adjust)
 {
     EXPECT_CALL(*m_control_iogroup, control_domain_type("FREQ"));
@@ -394,7 +533,7 @@ TEST_F(PlatformIOTest, adjust_agg)
 {
     EXPECT_CALL(*m_topo, is_nested_domain(GEOPM_DOMAIN_CPU,
                                          GEOPM_DOMAIN_PACKAGE));
-    EXPECT_CALL(*m_topo, domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_PACKAGE, 0));
+    EXPECT_CALL(*m_topo, domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 0));
     double value = 1.23e9;
     EXPECT_CALL(*m_control_iogroup, control_domain_type("FREQ")).Times(AtLeast(1));
     for (auto cpu : m_cpu_set0) {
@@ -438,7 +577,7 @@ TEST_F(PlatformIOTest, read_signal)
 TEST_F(PlatformIOTest, read_signal_agg)
 {
     EXPECT_CALL(*m_topo, is_nested_domain(_, _));
-    EXPECT_CALL(*m_topo, domain_nested(_, _, _));
+    EXPECT_CALL(*m_topo, domain_cpu_list(_, _));
     EXPECT_CALL(*m_control_iogroup, signal_domain_type("FREQ")).Times(AtLeast(1));
     EXPECT_CALL(*m_control_iogroup, agg_function("FREQ")).WillOnce(Return(Agg::average));
     for (auto cpu : m_cpu_set0) {
@@ -475,7 +614,7 @@ TEST_F(PlatformIOTest, write_control_agg)
 
     double value = 3e9;
     EXPECT_CALL(*m_topo, is_nested_domain(_, _));
-    EXPECT_CALL(*m_topo, domain_nested(_, _, _));
+    EXPECT_CALL(*m_topo, domain_cpu_list(_, _));
     EXPECT_CALL(*m_control_iogroup, control_domain_type("FREQ")).Times(AtLeast(1));
     for (auto cpu : m_cpu_set0) {
         EXPECT_CALL(*m_control_iogroup, write_control("FREQ", GEOPM_DOMAIN_CPU, cpu, value));
@@ -32,6 +32,7 @@
 
 #include <unistd.h>
 #include <limits.h>
+#include <sys/stat.h>
 
 #include <fstream>
 #include <string>
@@ -52,6 +53,17 @@ class PlatformTopoTest : public :: testing :: Test
         void SetUp();
         void TearDown();
         void write_lscpu(const std::string &lscpu_str);
+        /// Create a fake sysfs tree with Linux CPU numbering
+        /// where CPU c is core c % num_core and the given NUMA
+        /// node CPU lists.
+        void write_sysfs(int num_package, int core_per_package, int thread_per_core,
+                         const std::vector<std::string> &numa_cpu_list);
+        void write_sysfs_file(const std::string &path, const std::string &contents);
+        void make_sysfs_dir(const std::string &path);
+        const std::string m_sysfs_path = "PlatformTopoTest_sysfs";
+        const std::string m_binary_cache_path = "PlatformTopoTest-geopm-topo-cache.bin";
+        std::vector<std::string> m_sysfs_file;
+        std::vector<std::string> m_sysfs_dir;
         void spoof_lscpu(void);
         std::string m_path_env_save;
         std::string m_lscpu_file_name;
@@ -243,6 +255,51 @@ void PlatformTopoTest::TearDown()
     (void)unlink("lscpu");
     (void)setenv("PATH", m_path_env_save.c_str(), 1);
     unsetenv("PLATFORM_TOPO_TEST_LSCPU_ERROR");
+    for (const auto &path : m_sysfs_file) {
+        (void)unlink(path.c_str());
+    }
+    for (auto it = m_sysfs_dir.rbegin(); it != m_sysfs_dir.rend(); ++it) {
+        (void)rmdir(it->c_str());
+    }
+    (void)unlink(m_binary_cache_path.c_str());
+}
+
+void PlatformTopoTest::make_sysfs_dir(const std::string &path)
+{
+    mkdir(path.c_str(), S_IRWXU);
+    m_sysfs_dir.push_back(path);
+}
+
+void PlatformTopoTest::write_sysfs_file(const std::string &path, const std::string &contents)
+{
+    std::ofstream(path) << contents;
+    m_sysfs_file.push_back(path);
+}
+
+void PlatformTopoTest::write_sysfs(int num_package, int core_per_package, int thread_per_core,
+                                   const std::vector<std::string> &numa_cpu_list)
+{
+    int num_core = num_package * core_per_package;
+    int num_cpu = num_core * thread_per_core;
+    make_sysfs_dir(m_sysfs_path);
+    make_sysfs_dir(m_sysfs_path + "/cpu");
+    write_sysfs_file(m_sysfs_path + "/cpu/online", "0-" + std::to_string(num_cpu - 1) + "\n");
+    for (int cpu_idx = 0; cpu_idx != num_cpu; ++cpu_idx) {
+        std::string cpu_path = m_sysfs_path + "/cpu/cpu" + std::to_string(cpu_idx);
+        int core_idx = cpu_idx % num_core;
+        make_sysfs_dir(cpu_path);
+        make_sysfs_dir(cpu_path + "/topology");
+        write_sysfs_file(cpu_path + "/topology/physical_package_id",
+                         std::to_string(core_idx / core_per_package) + "\n");
+        write_sysfs_file(cpu_path + "/topology/core_id",
+                         std::to_string(core_idx % core_per_package) + "\n");
+    }
+    make_sysfs_dir(m_sysfs_path + "/node");
+    for (size_t node_idx = 0; node_idx != numa_cpu_list.size(); ++node_idx) {
+        std::string node_path = m_sysfs_path + "/node/node" + std::to_string(node_idx);
+        make_sysfs_dir(node_path);
+        write_sysfs_file(node_path + "/cpulist", numa_cpu_list[node_idx] + "\n");
+    }
 }
 
 void PlatformTopoTest::write_lscpu(const std::string &lscpu_str)
@@ -579,6 +636,42 @@ TEST_F(PlatformTopoTest, bdx_domain_nested)
                                     GEOPM_DOMAIN_BOARD_ACCELERATOR, 0), Exception);
 }
 
+TEST_F(PlatformTopoTest, bdx_domain_cpu_list)
+{
+    write_lscpu(m_bdx_lscpu_str);
+    PlatformTopoImp topo(m_lscpu_file_name);
+    for (int domain_type = GEOPM_DOMAIN_BOARD; domain_type <= GEOPM_DOMAIN_BOARD_MEMORY; ++domain_type) {
+        for (int domain_idx = 0; domain_idx != topo.num_domain(domain_type); ++domain_idx) {
+            std::set<int> cpus = topo.domain_nested(GEOPM_DOMAIN_CPU, domain_type, domain_idx);
+            EXPECT_EQ(std::vector<int>(cpus.begin(), cpus.end()),
+                      topo.domain_cpu_list(domain_type, domain_idx));
+            // default implementation for other PlatformTopo classes
+            EXPECT_EQ(std::vector<int>(cpus.begin(), cpus.end()),
+                      topo.PlatformTopo::domain_cpu_list(domain_type, domain_idx));
+        }
+    }
+    std::vector<int> cpus_expect = {1, 37};
+    EXPECT_EQ(cpus_expect, topo.domain_cpu_list(GEOPM_DOMAIN_CORE, 1));
+    // The same array is returned on every call
+    EXPECT_EQ(&topo.domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 1),
+              &topo.domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 1));
+    EXPECT_EQ(&topo.PlatformTopo::domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 1),
+              &topo.PlatformTopo::domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 1));
+
+    EXPECT_THROW(topo.domain_cpu_list(GEOPM_DOMAIN_PACKAGE, 2), Exception);
+    EXPECT_THROW(topo.domain_cpu_list(GEOPM_DOMAIN_CPU, -1), Exception);
+    EXPECT_THROW(topo.domain_cpu_list(GEOPM_DOMAIN_INVALID, 0), Exception);
+    EXPECT_THROW(topo.domain_cpu_list(GEOPM_NUM_DOMAIN, 0), Exception);
+}
+
+TEST_F(PlatformTopoTest, knl_package_memory_cpu_list)
+{
+    write_lscpu(m_knl_lscpu_str);
+    PlatformTopoImp topo(m_lscpu_file_name);
+    ASSERT_EQ(1, topo.num_domain(GEOPM_DOMAIN_PACKAGE_MEMORY));
+    EXPECT_THROW(topo.domain_cpu_list(GEOPM_DOMAIN_PACKAGE_MEMORY, 0), Exception);
+}
+
 TEST_F(PlatformTopoTest, parse_error)
 {
     std::string lscpu_missing_cpu =
@@ -706,6 +799,87 @@ TEST_F(PlatformTopoTest, create_cache)
 }
 
 
+TEST_F(PlatformTopoTest, sysfs_num_domain)
+{
+    // 2 packages, 2 cores per package, 2 threads per core, plus a
+    // memory only NUMA node
+    write_sysfs(2, 2, 2, {"0-1,4-5", "2-3,6-7", ""});
+    PlatformTopoImp topo("", m_sysfs_path);
+    EXPECT_EQ(1, topo.num_domain(GEOPM_DOMAIN_BOARD));
+    EXPECT_EQ(2, topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+    EXPECT_EQ(4, topo.num_domain(GEOPM_DOMAIN_CORE));
+    EXPECT_EQ(8, topo.num_domain(GEOPM_DOMAIN_CPU));
+    EXPECT_EQ(2, topo.num_domain(GEOPM_DOMAIN_BOARD_MEMORY));
+    EXPECT_EQ(1, topo.num_domain(GEOPM_DOMAIN_PACKAGE_MEMORY));
+    EXPECT_EQ(1, topo.domain_idx(GEOPM_DOMAIN_PACKAGE, 6));
+    EXPECT_EQ(2, topo.domain_idx(GEOPM_DOMAIN_CORE, 6));
+    EXPECT_EQ(1, topo.domain_idx(GEOPM_DOMAIN_BOARD_MEMORY, 6));
+    std::set<int> cpus = {1, 5};
+    EXPECT_EQ(cpus, topo.domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_CORE, 1));
+}
+
+TEST_F(PlatformTopoTest, sysfs_matches_lscpu)
+{
+    write_lscpu(m_bdx_lscpu_str);
+    PlatformTopoImp lscpu_topo(m_lscpu_file_name);
+    write_sysfs(2, 18, 2, {"0-17,36-53", "18-35,54-71"});
+    PlatformTopoImp sysfs_topo("", m_sysfs_path);
+    for (int domain_type = GEOPM_DOMAIN_BOARD; domain_type <= GEOPM_DOMAIN_BOARD_MEMORY; ++domain_type) {
+        ASSERT_EQ(lscpu_topo.num_domain(domain_type), sysfs_topo.num_domain(domain_type));
+        for (int cpu_idx = 0; cpu_idx != lscpu_topo.num_domain(GEOPM_DOMAIN_CPU); ++cpu_idx) {
+            EXPECT_EQ(lscpu_topo.domain_idx(domain_type, cpu_idx),
+                      sysfs_topo.domain_idx(domain_type, cpu_idx));
+        }
+    }
+}
+
+TEST_F(PlatformTopoTest, binary_cache)
+{
+    write_lscpu(m_knl_lscpu_str);
+    PlatformTopoImp lscpu_topo(m_lscpu_file_name);
+    lscpu_topo.write_binary_cache(m_binary_cache_path);
+    struct stat cache_stat;
+    ASSERT_EQ(0, stat(m_binary_cache_path.c_str(), &cache_stat));
+    EXPECT_EQ((mode_t)0666, cache_stat.st_mode & 0777);
+
+    PlatformTopoImp cache_topo(m_binary_cache_path, "");
+    for (int domain_type = GEOPM_DOMAIN_BOARD; domain_type <= GEOPM_DOMAIN_PACKAGE_MEMORY; ++domain_type) {
+        EXPECT_EQ(lscpu_topo.num_domain(domain_type), cache_topo.num_domain(domain_type));
+    }
+    for (int numa_idx = 0; numa_idx != lscpu_topo.num_domain(GEOPM_DOMAIN_BOARD_MEMORY); ++numa_idx) {
+        EXPECT_EQ(lscpu_topo.domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_BOARD_MEMORY, numa_idx),
+                  cache_topo.domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_BOARD_MEMORY, numa_idx));
+    }
+
+    // A truncated or foreign cache file is ignored in favor of sysfs
+    write_sysfs(1, 2, 1, {"0-1"});
+    ASSERT_EQ(0, truncate(m_binary_cache_path.c_str(), cache_stat.st_size - 1));
+    PlatformTopoImp truncated_topo(m_binary_cache_path, m_sysfs_path);
+    EXPECT_EQ(2, truncated_topo.num_domain(GEOPM_DOMAIN_CPU));
+    std::ofstream(m_binary_cache_path) << m_knl_lscpu_str;
+    PlatformTopoImp text_topo(m_binary_cache_path, m_sysfs_path);
+    EXPECT_EQ(2, text_topo.num_domain(GEOPM_DOMAIN_CPU));
+}
+
+TEST_F(PlatformTopoTest, create_binary_cache)
+{
+    unlink(m_binary_cache_path.c_str());
+    write_sysfs(2, 2, 1, {"0,2", "1,3"});
+    PlatformTopoImp::create_binary_cache(m_binary_cache_path, m_sysfs_path);
+    PlatformTopoImp cache_topo(m_binary_cache_path, "");
+    EXPECT_EQ(2, cache_topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+    EXPECT_EQ(4, cache_topo.num_domain(GEOPM_DOMAIN_CPU));
+    std::set<int> cpus = {1, 3};
+    EXPECT_EQ(cpus, cache_topo.domain_nested(GEOPM_DOMAIN_CPU, GEOPM_DOMAIN_BOARD_MEMORY, 1));
+
+    // An existing cache file is left in place
+    write_lscpu(m_hsw_lscpu_str);
+    PlatformTopoImp(m_lscpu_file_name).write_binary_cache(m_binary_cache_path);
+    PlatformTopoImp::create_binary_cache(m_binary_cache_path, m_sysfs_path);
+    PlatformTopoImp existing_topo(m_binary_cache_path, "");
+    EXPECT_EQ(1, existing_topo.num_domain(GEOPM_DOMAIN_PACKAGE));
+}
+
 TEST_F(PlatformTopoTest, call_c_wrappers)
 {
     spoof_lscpu();
@@ -39,6 +39,7 @@
 #include "MockPowerBalancer.hpp"
 #include "MockPlatformIO.hpp"
 #include "MockPlatformTopo.hpp"
+#include "MockWaiter.hpp"
 #include "PowerBalancerAgent.hpp"
 #include "Helper.hpp"
 #include "geopm_test.hpp"
@@ -660,3 +661,14 @@ TEST_F(PowerBalancerAgentTest, validate_policy)
     EXPECT_EQ(M_POWER_PACKAGE_MAX, policy[0]);
 
 }
+
+TEST_F(PowerBalancerAgentTest, report_host)
+{
+    std::vector<std::pair<std::string, std::string> > wait_report {{"Wait count", "7"}};
+    auto waiter = geopm::make_unique<MockWaiter>();
+    EXPECT_CALL(*waiter, report()).WillOnce(Return(wait_report));
+    m_agent = geopm::make_unique<PowerBalancerAgent>(m_platform_io, m_platform_topo,
+                                                     std::move(m_power_gov), std::move(m_power_bal),
+                                                     std::move(waiter));
+    EXPECT_EQ(wait_report, m_agent->report_host());
+}
@@ -40,6 +40,7 @@
 #include "MockPowerGovernor.hpp"
 #include "MockPlatformIO.hpp"
 #include "MockPlatformTopo.hpp"
+#include "MockWaiter.hpp"
 #include "Helper.hpp"
 
 using geopm::PowerGovernorAgent;
@@ -322,3 +323,13 @@ TEST_F(PowerGovernorAgentTest, validate_policy)
     m_agent->validate_policy(policy);
     EXPECT_EQ(m_power_max, policy[0]);
 }
+
+TEST_F(PowerGovernorAgentTest, report_host)
+{
+    std::vector<std::pair<std::string, std::string> > wait_report {{"Wait count", "7"}};
+    auto waiter = geopm::make_unique<MockWaiter>();
+    EXPECT_CALL(*waiter, report()).WillOnce(Return(wait_report));
+    m_agent = geopm::make_unique<PowerGovernorAgent>(m_platform_io, m_platform_topo, nullptr,
+                                                     std::move(waiter));
+    EXPECT_EQ(wait_report, m_agent->report_host());
+}
@@ -33,6 +33,7 @@
 #include <stdlib.h>
 
 #include <memory>
+#include <thread>
 
 #include "gtest/gtest.h"
 
@@ -43,28 +44,45 @@
 
 using geopm::ProfileTable;
 using geopm::ProfileTableImp;
+using geopm::ProfileRingTableImp;
 
 class ProfileTableTest: public :: testing :: Test
 {
     public:
         ProfileTableTest();
-        virtual ~ProfileTableTest() = default;
+        virtual ~ProfileTableTest();
         void overfill_small(void);
     protected:
         size_t m_size;
         size_t m_small_size;
+        size_t m_ring_size;
         char m_ptr[5192];
         char m_small_ptr[256];
+        void *m_ring_ptr;
         std::unique_ptr<ProfileTable> m_table;
         std::unique_ptr<ProfileTable> m_table_small;
+        std::unique_ptr<ProfileTable> m_table_ring;
 };
 
 ProfileTableTest::ProfileTableTest()
     : m_size(sizeof(m_ptr))
     , m_small_size(sizeof(m_small_ptr))
+    , m_ring_size(sizeof(m_ptr))
+    , m_ring_ptr(nullptr)
 {
     m_table = geopm::make_unique<ProfileTableImp>(m_size, (void *)m_ptr);
     m_table_small = geopm::make_unique<ProfileTableImp>(m_small_size, (void *)m_small_ptr);
+    // Shared memory is page aligned, match the alignment here
+    int err = posix_memalign(&m_ring_ptr, 4096, m_ring_size);
+    if (!err) {
+        m_table_ring = ProfileTable::make_unique(m_ring_size, m_ring_ptr, true);
+    }
+}
+
+ProfileTableTest::~ProfileTableTest()
+{
+    m_table_ring.reset();
+    free(m_ring_ptr);
 }
 
 
@@ -81,9 +99,71 @@ void ProfileTableTest::overfill_small(void)
 TEST_F(ProfileTableTest, overfill)
 {
     overfill_small();
+    size_t capacity = m_table_small->capacity();
     struct geopm_prof_message_s message;
     message.progress = 0.5;
     message.region_id = 1234;
+    // Oldest progress record is dropped to make room
+    EXPECT_NO_THROW(m_table_small->insert(message));
+    EXPECT_EQ(capacity, m_table_small->size());
+    EXPECT_EQ(0ULL, m_table_small->num_coalesced());
+    EXPECT_EQ(1ULL, m_table_small->num_dropped());
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(capacity);
+    size_t length = 0;
+    m_table_small->dump(contents.begin(), length);
+    ASSERT_EQ(capacity, length);
+    // Region 1 has progress 1.0 and is kept as a boundary, region 2 is dropped
+    EXPECT_EQ(1ULL, contents[0].first);
+    EXPECT_EQ(3ULL, contents[1].first);
+    EXPECT_EQ(1234ULL, contents[capacity - 1].first);
+}
+
+TEST_F(ProfileTableTest, overfill_coalesce)
+{
+    size_t capacity = m_table_small->capacity();
+    ASSERT_LT(3ULL, capacity);
+    struct geopm_prof_message_s message {0, 0, {{0, 0}}, 0.0};
+    // Alternate progress between two regions so that nothing is
+    // coalesced at insert time
+    for (size_t idx = 0; idx < capacity; ++idx) {
+        message.region_id = 1 + idx % 2;
+        message.progress = 0.5;
+        message.timestamp.t.tv_sec = idx;
+        m_table_small->insert(message);
+    }
+    EXPECT_EQ(capacity, m_table_small->size());
+    message.region_id = 3;
+    message.progress = 0.0;
+    m_table_small->insert(message);
+    EXPECT_EQ(3ULL, m_table_small->size());
+    EXPECT_EQ(capacity - 2, m_table_small->num_coalesced());
+    EXPECT_EQ(0ULL, m_table_small->num_dropped());
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(capacity);
+    size_t length = 0;
+    m_table_small->dump(contents.begin(), length);
+    ASSERT_EQ(3ULL, length);
+    // Only the latest progress record for each region remains
+    EXPECT_EQ(capacity - 2, (size_t)contents[0].second.timestamp.t.tv_sec);
+    EXPECT_EQ(capacity - 1, (size_t)contents[1].second.timestamp.t.tv_sec);
+    EXPECT_EQ(3ULL, contents[2].first);
+}
+
+TEST_F(ProfileTableTest, overfill_boundary)
+{
+    size_t capacity = m_table_small->capacity();
+    struct geopm_prof_message_s message {0, 0, {{0, 0}}, 0.0};
+    for (size_t idx = 0; idx < capacity; ++idx) {
+        message.region_id = idx + 1;
+        message.progress = (idx % 2) ? 1.0 : 0.0;
+        m_table_small->insert(message);
+    }
+    // New progress is discarded when only boundaries are held
+    message.progress = 0.5;
+    EXPECT_NO_THROW(m_table_small->insert(message));
+    EXPECT_EQ(1ULL, m_table_small->num_dropped());
+    EXPECT_EQ(capacity, m_table_small->size());
+    // Region entry and exit records can not be dropped
+    message.progress = 1.0;
     EXPECT_THROW(m_table_small->insert(message), geopm::Exception);
 }
 
@@ -300,3 +380,194 @@ TEST_F(ProfileTableTest, name_set_fill_long)
     ASSERT_EQ(input_set, output_set);
     ASSERT_LT(1, count);
 }
+
+TEST_F(ProfileTableTest, ring_overfill)
+{
+    ASSERT_TRUE(m_table_ring != nullptr);
+    EXPECT_THROW(ProfileRingTableImp(0, NULL), geopm::Exception);
+    EXPECT_THROW(ProfileRingTableImp(64, m_ring_ptr), geopm::Exception);
+    struct geopm_prof_message_s message {0, 0, {{0, 0}}, 0.0};
+    size_t capacity = m_table_ring->capacity();
+    EXPECT_LT(0ULL, capacity);
+    for (size_t idx = 0; idx < capacity; ++idx) {
+        message.region_id = idx + 1;
+        message.progress = 0.5;
+        m_table_ring->insert(message);
+    }
+    EXPECT_EQ(capacity, m_table_ring->size());
+    // Progress messages are not coalesced in the ring, so further
+    // records are held in the backlog
+    message.region_id = capacity + 1;
+    m_table_ring->insert(message);
+    message.progress = 0.75;
+    m_table_ring->insert(message);
+    EXPECT_EQ(capacity, m_table_ring->size());
+    EXPECT_EQ(1ULL, m_table_ring->num_coalesced());
+    EXPECT_EQ(0ULL, m_table_ring->num_dropped());
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(capacity);
+    size_t length = 0;
+    m_table_ring->dump(contents.begin(), length);
+    EXPECT_EQ(capacity, length);
+    EXPECT_EQ(0ULL, m_table_ring->size());
+    // Backlog is published before the next record
+    message.region_id = capacity + 2;
+    m_table_ring->insert(message);
+    EXPECT_EQ(2ULL, m_table_ring->size());
+    m_table_ring->dump(contents.begin(), length);
+    ASSERT_EQ(2ULL, length);
+    EXPECT_EQ(capacity + 1, contents[0].first);
+    EXPECT_EQ(0.75, contents[0].second.progress);
+    EXPECT_EQ(capacity + 2, contents[1].first);
+}
+
+TEST_F(ProfileTableTest, ring_overfill_backlog)
+{
+    ASSERT_TRUE(m_table_ring != nullptr);
+    size_t capacity = m_table_ring->capacity();
+    struct geopm_prof_message_s message {0, 0, {{0, 0}}, 0.0};
+    // Fill the ring and then the backlog with boundary records
+    for (size_t idx = 0; idx < 2 * capacity; ++idx) {
+        message.region_id = idx + 1;
+        message.progress = (idx % 2) ? 1.0 : 0.0;
+        m_table_ring->insert(message);
+    }
+    message.progress = 0.5;
+    EXPECT_NO_THROW(m_table_ring->insert(message));
+    EXPECT_EQ(1ULL, m_table_ring->num_dropped());
+    message.progress = 1.0;
+    EXPECT_THROW(m_table_ring->insert(message), geopm::Exception);
+    // Backlog is published once the consumer makes room
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(capacity);
+    size_t length = 0;
+    m_table_ring->dump(contents.begin(), length);
+    EXPECT_EQ(capacity, length);
+    EXPECT_TRUE(m_table_ring->flush());
+    m_table_ring->dump(contents.begin(), length);
+    ASSERT_EQ(capacity, length);
+    EXPECT_EQ(capacity + 1, contents[0].first);
+    EXPECT_EQ(2 * capacity, contents[capacity - 1].first);
+}
+
+TEST_F(ProfileTableTest, ring_flush)
+{
+    ASSERT_TRUE(m_table_ring != nullptr);
+    // The mutex protected table never holds records back
+    EXPECT_TRUE(m_table->flush());
+    size_t capacity = m_table_ring->capacity();
+    struct geopm_prof_message_s message {0, 0, {{0, 0}}, 0.0};
+    // Region entries and exits that overflow the ring, followed by
+    // no further inserts from the application
+    size_t num_insert = 2 * capacity;
+    for (size_t idx = 0; idx < num_insert; ++idx) {
+        message.region_id = idx + 1;
+        message.progress = (idx % 2) ? 1.0 : 0.0;
+        m_table_ring->insert(message);
+    }
+    EXPECT_EQ(capacity, m_table_ring->size());
+    // Flushing while the consumer reads the table, as the
+    // application does before shutdown, delivers every record
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(capacity);
+    std::vector<uint64_t> received;
+    bool is_flushed = false;
+    while (!is_flushed) {
+        is_flushed = m_table_ring->flush();
+        size_t length = 0;
+        m_table_ring->dump(contents.begin(), length);
+        for (size_t idx = 0; idx < length; ++idx) {
+            received.push_back(contents[idx].first);
+        }
+    }
+    size_t length = 0;
+    m_table_ring->dump(contents.begin(), length);
+    EXPECT_EQ(0ULL, length);
+    ASSERT_EQ(num_insert, received.size());
+    for (size_t idx = 0; idx < num_insert; ++idx) {
+        EXPECT_EQ(idx + 1, received[idx]);
+    }
+    EXPECT_EQ(0ULL, m_table_ring->num_dropped());
+    EXPECT_EQ(0ULL, m_table_ring->num_coalesced());
+}
+
+TEST_F(ProfileTableTest, ring_order)
+{
+    ASSERT_TRUE(m_table_ring != nullptr);
+    size_t capacity = m_table_ring->capacity();
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(capacity);
+    struct geopm_prof_message_s message {0, 0, {{0, 0}}, 0.0};
+    uint64_t region_id = 1;
+    // Insert more than capacity in total to exercise wrap around
+    for (int iter = 0; iter < 3; ++iter) {
+        uint64_t first_id = region_id;
+        size_t num_insert = capacity / 2 + 1;
+        for (size_t idx = 0; idx < num_insert; ++idx) {
+            message.region_id = region_id;
+            message.progress = (double)region_id;
+            m_table_ring->insert(message);
+            ++region_id;
+        }
+        size_t length = 0;
+        m_table_ring->dump(contents.begin(), length);
+        ASSERT_EQ(num_insert, length);
+        for (size_t idx = 0; idx < length; ++idx) {
+            EXPECT_EQ(first_id + idx, contents[idx].first);
+            EXPECT_EQ(first_id + idx, contents[idx].second.region_id);
+            EXPECT_EQ((double)(first_id + idx), contents[idx].second.progress);
+        }
+    }
+}
+
+TEST_F(ProfileTableTest, ring_name_set_fill_short)
+{
+    ASSERT_TRUE(m_table_ring != nullptr);
+    std::set<std::string> input_set = {"hello", "goodbye"};
+    std::set<std::string> output_set;
+    for (const auto &name : input_set) {
+        m_table_ring->key(name);
+    }
+    EXPECT_EQ(m_table->key("hello"), m_table_ring->key("hello"));
+    bool is_in_done = m_table_ring->name_fill(0);
+    bool is_out_done = m_table_ring->name_set(0, output_set);
+    ASSERT_EQ(input_set, output_set);
+    ASSERT_EQ(is_in_done, is_out_done);
+}
+
+TEST_F(ProfileTableTest, ring_producer_consumer)
+{
+    ASSERT_TRUE(m_table_ring != nullptr);
+    const uint64_t num_message = 100000;
+    std::thread producer([this, num_message]() {
+        struct geopm_prof_message_s message {0, 0, {{0, 0}}, 0.0};
+        for (uint64_t region_id = 1; region_id <= num_message; ++region_id) {
+            message.region_id = region_id;
+            bool is_inserted = false;
+            while (!is_inserted) {
+                try {
+                    m_table_ring->insert(message);
+                    is_inserted = true;
+                }
+                catch (const geopm::Exception &) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        // Publish any records held back while the ring was full
+        while (!m_table_ring->flush()) {
+            std::this_thread::yield();
+        }
+    });
+    std::vector<std::pair<uint64_t, struct geopm_prof_message_s> > contents(m_table_ring->capacity());
+    uint64_t expect_id = 1;
+    bool is_ordered = true;
+    while (expect_id <= num_message) {
+        size_t length = 0;
+        m_table_ring->dump(contents.begin(), length);
+        for (size_t idx = 0; idx < length; ++idx) {
+            is_ordered = is_ordered && (contents[idx].second.region_id == expect_id);
+            ++expect_id;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(is_ordered);
+    EXPECT_EQ(num_message + 1, expect_id);
+    EXPECT_EQ(0ULL, m_table_ring->num_dropped());
+}
@@ -155,6 +155,8 @@ class ProfileTestProfileTable : public MockProfileTable
                 .WillRepeatedly(testing::Invoke(insert_lambda));
             EXPECT_CALL(*this, name_fill(testing::_))
                 .WillRepeatedly(testing::Return(true));
+            EXPECT_CALL(*this, flush())
+                .WillRepeatedly(testing::Return(true));
         }
 };
 
@@ -481,6 +483,88 @@ TEST_F(ProfileTest, shutdown)
     m_profile->shutdown();
 }
 
+TEST_F(ProfileTest, shutdown_flush)
+{
+    int shm_rank = 0;
+    int world_rank = 0;
+    double timeout = 10.0;
+    int num_held = 0;
+
+    auto key_lambda = [] (const std::string &name)
+    {
+        return (uint64_t) 0;
+    };
+    auto insert_lambda = [] (const struct geopm_prof_message_s &value)
+    {
+    };
+
+    m_table = geopm::make_unique<ProfileTestProfileTable>(key_lambda, insert_lambda);
+    // Each flush publishes one of the records held back by a full
+    // table as the controller makes room
+    EXPECT_CALL(*m_table, flush())
+        .WillRepeatedly(testing::Invoke([&num_held] () {
+            if (num_held) {
+                --num_held;
+            }
+            return num_held == 0;
+        }));
+    m_tprof = geopm::make_unique<ProfileTestProfileThreadTable>(M_NUM_CPU);
+
+    m_ctl_msg = geopm::make_unique<ProfileTestControlMessage>();
+    // Every record is published before the final handshake
+    EXPECT_CALL(*m_ctl_msg, step())
+        .WillRepeatedly(testing::Invoke([&num_held] () {
+            EXPECT_EQ(0, num_held);
+        }));
+    m_shm_comm = std::make_shared<ProfileTestComm>(shm_rank, M_SHM_COMM_SIZE);
+    m_world_comm = geopm::make_unique<ProfileTestComm>(world_rank, m_shm_comm);
+    m_scheduler = geopm::make_unique<ProfileTestSampleScheduler>();
+
+    m_profile = geopm::make_unique<ProfileImp>(M_PROF_NAME, M_SHM_KEY, M_REPORT, timeout, M_DO_REGION_BARRIER,
+                                               std::move(m_world_comm),
+                                               std::move(m_ctl_msg), m_topo, std::move(m_table),
+                                               std::move(m_tprof), std::move(m_scheduler), m_comm);
+    m_profile->init();
+    num_held = 3;
+    m_profile->shutdown();
+    EXPECT_EQ(0, num_held);
+}
+
+TEST_F(ProfileTest, shutdown_flush_timeout)
+{
+    int shm_rank = 0;
+    int world_rank = 0;
+
+    auto key_lambda = [] (const std::string &name)
+    {
+        return (uint64_t) 0;
+    };
+    auto insert_lambda = [] (const struct geopm_prof_message_s &value)
+    {
+    };
+
+    m_table = geopm::make_unique<ProfileTestProfileTable>(key_lambda, insert_lambda);
+    EXPECT_CALL(*m_table, flush())
+        .WillOnce(testing::Return(false))
+        .WillRepeatedly(testing::Return(true));
+    m_tprof = geopm::make_unique<ProfileTestProfileThreadTable>(M_NUM_CPU);
+
+    m_ctl_msg = geopm::make_unique<ProfileTestControlMessage>();
+    m_shm_comm = std::make_shared<ProfileTestComm>(shm_rank, M_SHM_COMM_SIZE);
+    m_world_comm = geopm::make_unique<ProfileTestComm>(world_rank, m_shm_comm);
+    m_scheduler = geopm::make_unique<ProfileTestSampleScheduler>();
+
+    m_profile = geopm::make_unique<ProfileImp>(M_PROF_NAME, M_SHM_KEY, M_REPORT, M_TIMEOUT, M_DO_REGION_BARRIER,
+                                               std::move(m_world_comm),
+                                               std::move(m_ctl_msg), m_topo, std::move(m_table),
+                                               std::move(m_tprof), std::move(m_scheduler), m_comm);
+    m_profile->init();
+    GEOPM_EXPECT_THROW_MESSAGE(m_profile->shutdown(), GEOPM_ERROR_RUNTIME,
+                               "Timed out waiting for the controller");
+    // Shutdown completes once the records are published
+    m_profile->shutdown();
+}
+
 TEST_F(ProfileTest, tprof_table)
 {
     int shm_rank = 0;
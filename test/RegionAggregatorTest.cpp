@@ -328,3 +328,44 @@ TEST_F(RegionAggregatorTest, epoch_total)
     // First epoch observed at step == 2, app finished at step == 4.  4 - 2 = 2
     EXPECT_DOUBLE_EQ(2.0, m_agg->sample_total(M_SIGNAL_TIME, GEOPM_REGION_HASH_EPOCH));
 }
+
+TEST_F(RegionAggregatorTest, many_regions)
+{
+    const int num_region = 1000;
+    const int num_pass = 3;
+    int step = 0;
+    // hashes differ only in the upper 32 bits
+    auto region_hash = [](int region_idx) {
+        return 0x1234ULL + ((uint64_t)region_idx << 32);
+    };
+
+    EXPECT_CALL(m_platio, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0));
+    EXPECT_CALL(m_platio, push_signal("REGION_HASH", GEOPM_DOMAIN_BOARD, 0));
+    m_agg->push_signal_total("TIME", GEOPM_DOMAIN_BOARD, 0);
+    EXPECT_CALL(m_platio, sample(M_SIGNAL_TIME))
+        .WillRepeatedly(testing::Invoke([&step](int) {
+            return (double)step;
+        }));
+    EXPECT_CALL(m_platio, sample(M_SIGNAL_R_HASH_BOARD))
+        .WillRepeatedly(testing::Invoke([&step, &region_hash](int) {
+            return (double)region_hash(step % num_region);
+        }));
+    EXPECT_CALL(m_platio, sample(M_SIGNAL_EPOCH_COUNT))
+        .WillRepeatedly(Return(-1));
+    for (step = 0; step < num_region * num_pass; ++step) {
+        m_agg->read_batch();
+    }
+    --step;
+
+    // every visit lasts one step, and the last visit to the last
+    // region is still in progress
+    std::set<uint64_t> exp_regions;
+    for (int region_idx = 0; region_idx < num_region; ++region_idx) {
+        double expected = region_idx == num_region - 1 ? num_pass - 1 : num_pass;
+        EXPECT_EQ(expected, m_agg->sample_total(M_SIGNAL_TIME, region_hash(region_idx)))
+            << "region_idx: " << region_idx;
+        exp_regions.insert(region_hash(region_idx));
+    }
+    EXPECT_EQ(exp_regions, m_agg->tracked_region_hash());
+    EXPECT_EQ(0.0, m_agg->sample_total(M_SIGNAL_TIME, region_hash(num_region)));
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <math.h>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "ReportModel.hpp"
+#include "geopm_internal.h"
+#include "geopm_error.h"
+#include "geopm_test.hpp"
+
+using geopm::ReportModel;
+
+class ReportModelTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        ReportModel::header_s m_header;
+        ReportModel::host_s m_host;
+};
+
+void ReportModelTest::SetUp(void)
+{
+    m_header.version = "1.0.0";
+    m_header.start_time = "Tue Nov  6 08:00:00 2018";
+    m_header.profile = "my profile";
+    m_header.agent = "my_agent";
+    m_header.policy = "{\"POWER\": 100}";
+    m_header.fan_out = {4, 16};
+    m_header.agent_header = {{"one", "1"}, {"two", "2"}};
+
+    m_host.host = "node0";
+    m_host.agent_host = {{"three", "3"}};
+    m_host.region.push_back({"dgemm", 0x1234, {}});
+    m_host.region.back().field = {
+        {"runtime (sec)", 0.1 + 0.2},
+        {"count", 20, ReportModel::M_FIELD_INTEGER},
+        {"agent stat", "say \"hi\"\n"},
+    };
+    m_host.region.push_back({"epoch", GEOPM_REGION_HASH_EPOCH, {}});
+    m_host.region.back().field = {
+        {"runtime (sec)", 70.0},
+        {"power (watts)", NAN},
+    };
+    m_host.app_totals = {
+        {"runtime (sec)", 56.0},
+        {"profile-table-dropped (max per-rank)", 4, ReportModel::M_FIELD_INTEGER},
+        {"geopmctl memory HWM", "1234 kB"},
+    };
+}
+
+TEST_F(ReportModelTest, text)
+{
+    EXPECT_EQ("##### geopm 1.0.0 #####\n"
+              "Start Time: Tue Nov  6 08:00:00 2018\n"
+              "Profile: my profile\n"
+              "Agent: my_agent\n"
+              "Policy: {\"POWER\": 100}\n"
+              "Tree Fan Out: 4, 16\n"
+              "one: 1\n"
+              "two: 2\n", ReportModel::text_header(m_header));
+    m_header.fan_out.clear();
+    EXPECT_EQ("##### geopm 1.0.0 #####\n"
+              "Start Time: Tue Nov  6 08:00:00 2018\n"
+              "Profile: my profile\n"
+              "Agent: my_agent\n"
+              "Policy: {\"POWER\": 100}\n"
+              "one: 1\n"
+              "two: 2\n", ReportModel::text_header(m_header));
+    EXPECT_EQ("\nHost: node0\n"
+              "three: 3\n"
+              "Region dgemm (0x0000000000001234):\n"
+              "    runtime (sec): 0.3\n"
+              "    count: 20\n"
+              "    agent stat: say \"hi\"\n\n"
+              "Epoch Totals:\n"
+              "    runtime (sec): 70\n"
+              "    power (watts): nan\n"
+              "Application Totals:\n"
+              "    runtime (sec): 56\n"
+              "    profile-table-dropped (max per-rank): 4\n"
+              "    geopmctl memory HWM: 1234 kB\n", ReportModel::text_host(m_host));
+}
+
+TEST_F(ReportModelTest, json_round_trip)
+{
+    ReportModel::host_s other = m_host;
+    other.host = "node1";
+    other.region.pop_back();
+    std::string json = ReportModel::json_report(ReportModel::json_header(m_header),
+                                                ReportModel::json_host(m_host) + "," +
+                                                ReportModel::json_host(other));
+    EXPECT_THAT(json, ::testing::HasSubstr("{\"name\": \"runtime (sec)\", \"value\": 0.30000000000000004}"));
+    EXPECT_THAT(json, ::testing::HasSubstr("{\"name\": \"power (watts)\", \"value\": null}"));
+    EXPECT_THAT(json, ::testing::HasSubstr("{\"name\": \"count\", \"value\": 20, \"type\": \"integer\"}"));
+
+    ReportModel::header_s header;
+    std::vector<ReportModel::host_s> host;
+    ReportModel::load_json(json, header, host);
+    EXPECT_EQ(m_header.version, header.version);
+    EXPECT_EQ(m_header.start_time, header.start_time);
+    EXPECT_EQ(m_header.profile, header.profile);
+    EXPECT_EQ(m_header.agent, header.agent);
+    EXPECT_EQ(m_header.policy, header.policy);
+    EXPECT_EQ(m_header.fan_out, header.fan_out);
+    EXPECT_EQ(m_header.agent_header, header.agent_header);
+    ASSERT_EQ(2u, host.size());
+    EXPECT_EQ("node0", host[0].host);
+    EXPECT_EQ("node1", host[1].host);
+    EXPECT_EQ(m_host.agent_host, host[0].agent_host);
+    ASSERT_EQ(2u, host[0].region.size());
+    ASSERT_EQ(1u, host[1].region.size());
+    EXPECT_EQ("dgemm", host[0].region[0].name);
+    EXPECT_EQ(0x1234ULL, host[0].region[0].hash);
+    EXPECT_EQ("epoch", host[0].region[1].name);
+    EXPECT_EQ((uint64_t)GEOPM_REGION_HASH_EPOCH, host[0].region[1].hash);
+
+    // fields are loaded in report order
+    const std::vector<ReportModel::field_s> &field = host[0].region[0].field;
+    ASSERT_EQ(3u, field.size());
+    EXPECT_EQ("runtime (sec)", field[0].name);
+    EXPECT_EQ(ReportModel::M_FIELD_DOUBLE, field[0].type);
+    EXPECT_EQ(0.1 + 0.2, field[0].value);
+    EXPECT_EQ("count", field[1].name);
+    EXPECT_EQ(ReportModel::M_FIELD_INTEGER, field[1].type);
+    EXPECT_EQ(20.0, field[1].value);
+    EXPECT_EQ("agent stat", field[2].name);
+    EXPECT_EQ(ReportModel::M_FIELD_STRING, field[2].type);
+    EXPECT_EQ("say \"hi\"\n", field[2].text);
+    const std::vector<ReportModel::field_s> &epoch_field = host[0].region[1].field;
+    ASSERT_EQ(2u, epoch_field.size());
+    EXPECT_EQ("power (watts)", epoch_field[1].name);
+    EXPECT_TRUE(isnan(epoch_field[1].value));
+    ASSERT_EQ(3u, host[1].app_totals.size());
+    EXPECT_EQ("geopmctl memory HWM", host[1].app_totals[2].name);
+    EXPECT_EQ("1234 kB", host[1].app_totals[2].text);
+
+    // reports without a tree fan out can be loaded
+    size_t fan_out_pos = json.find(", \"fan_out\": [4, 16]");
+    ASSERT_NE(std::string::npos, fan_out_pos);
+    json.erase(fan_out_pos, std::string(", \"fan_out\": [4, 16]").size());
+    ReportModel::load_json(json, header, host);
+    EXPECT_TRUE(header.fan_out.empty());
+    EXPECT_EQ(m_header.policy, header.policy);
+}
+
+TEST_F(ReportModelTest, json_round_trip_text)
+{
+    // Unsorted and repeated names, and an integer too large for the
+    // default stream precision, must survive the round trip.
+    m_header.agent_header = {{"zeta", "1"}, {"alpha", "2"}, {"zeta", "3"}};
+    m_host.agent_host = {{"b", "x"}, {"a", "y"}};
+    m_host.region[0].field.emplace_back("count", 123456789, ReportModel::M_FIELD_INTEGER);
+    m_host.app_totals.emplace_back("runtime (sec)", 1e-7);
+    ReportModel::host_s other = m_host;
+    other.host = "node1";
+    other.region.pop_back();
+    std::string json = ReportModel::json_report(ReportModel::json_header(m_header),
+                                                ReportModel::json_host(m_host) + "," +
+                                                ReportModel::json_host(other));
+    ReportModel::header_s header;
+    std::vector<ReportModel::host_s> host;
+    ReportModel::load_json(json, header, host);
+    ASSERT_EQ(2u, host.size());
+    EXPECT_EQ(ReportModel::text_header(m_header) +
+              ReportModel::text_host(m_host) +
+              ReportModel::text_host(other),
+              ReportModel::text_header(header) +
+              ReportModel::text_host(host[0]) +
+              ReportModel::text_host(host[1]));
+}
+
+TEST_F(ReportModelTest, load_invalid)
+{
+    ReportModel::header_s header;
+    std::vector<ReportModel::host_s> host;
+    std::string header_json = ReportModel::json_header(m_header);
+    GEOPM_EXPECT_THROW_MESSAGE(ReportModel::load_json("{\"header\": ", header, host),
+                               GEOPM_ERROR_FILE_PARSE, "not valid JSON");
+    GEOPM_EXPECT_THROW_MESSAGE(ReportModel::load_json("{\"header\": " + header_json + "}", header, host),
+                               GEOPM_ERROR_FILE_PARSE, "\"hosts\"");
+    std::string bad_hash = ReportModel::json_host(m_host);
+    bad_hash.replace(bad_hash.find("0x0000000000001234"), 18, "0x12zz");
+    GEOPM_EXPECT_THROW_MESSAGE(ReportModel::load_json(ReportModel::json_report(header_json, bad_hash), header, host),
+                               GEOPM_ERROR_FILE_PARSE, "invalid region hash");
+    std::string bad_field = ReportModel::json_host(m_host);
+    bad_field.replace(bad_field.find("20"), 2, "[20]");
+    GEOPM_EXPECT_THROW_MESSAGE(ReportModel::load_json(ReportModel::json_report(header_json, bad_field), header, host),
+                               GEOPM_ERROR_FILE_PARSE, "not a number or string: \"count\"");
+}
@@ -33,12 +33,14 @@
 
 #include <sstream>
 #include <fstream>
+#include <algorithm>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
 #include "PlatformTopo.hpp"
 #include "Reporter.hpp"
+#include "ReportModel.hpp"
 #include "MockPlatformIO.hpp"
 #include "MockPlatformTopo.hpp"
 #include "MockRegionAggregator.hpp"
@@ -52,6 +54,7 @@
 
 using geopm::Reporter;
 using geopm::ReporterImp;
+using geopm::ReportModel;
 using geopm::PlatformTopo;
 using testing::HasSubstr;
 using testing::Return;
@@ -74,6 +77,18 @@ class ReporterTestMockComm : public MockComm
         {
             memcpy(recv_buf, send_buf, send_size);
         }
+        void broadcast(void *buffer, size_t size, int root) const override
+        {
+
+        }
+        void reduce_max(double *send_buf, double *recv_buf, size_t count, int root) const override
+        {
+            std::copy(send_buf, send_buf + count, recv_buf);
+        }
+        void reduce_sum(double *send_buf, double *recv_buf, size_t count, int root) const override
+        {
+            std::copy(send_buf, send_buf + count, recv_buf);
+        }
 };
 
 class ReporterTest : public testing::Test
@@ -90,7 +105,15 @@ class ReporterTest : public testing::Test
         };
         ReporterTest();
         void TearDown(void);
+        void create_reporter(const std::string &report_mode,
+                             bool do_tree_auto_fan_out = false,
+                             bool do_tree_sparse = false);
+        void expect_generate(void);
+        void generate(void);
         std::string m_report_name = "test_reporter.out";
+        std::string m_host_report_name = m_report_name + "-" + geopm::hostname();
+        std::string m_expected_header;
+        std::string m_expected_host;
 
         MockPlatformIO m_platform_io;
         MockPlatformTopo m_platform_topo;
@@ -179,6 +202,91 @@ ReporterTest::ReporterTest()
         .WillOnce(Return(M_ENERGY_PKG_ENV_IDX_1));
 
     m_comm = std::make_shared<ReporterTestMockComm>();
+
+    // Check for labels at start of line but ignore numbers
+    // Note that region lines start with tab
+    m_expected_header = "#####\n"
+        "Start Time: " + m_start_time + "\n"
+        "Profile: " + m_profile_name + "\n"
+        "Agent: my_agent\n"
+        "Policy: \n"
+        "one: 1\n"
+        "two: 2\n";
+    m_expected_host = "\n"
+        "Host:\n"
+        "three: 3\n"
+        "four: 4\n"
+        "Region all2all (\n"
+        "    runtime (sec): 33.33\n"
+        "    sync-runtime (sec): 555\n"
+        "    package-energy (joules): 388.5\n"
+        "    dram-energy (joules): 388.5\n"
+        "    power (watts): 0.7\n"
+        "    frequency (%): 81.81\n"
+        "    frequency (Hz): 0.818182\n"
+        "    network-time (sec): 3.4\n"
+        "    count: 20\n"
+        "    ENERGY_PACKAGE@package-0: 194.25\n"
+        "    ENERGY_PACKAGE@package-1: 194.25\n"
+        "    agent stat: 1\n"
+        "    agent other stat: 2\n"
+        "Region model-init (\n"
+        "    runtime (sec): 22.11\n"
+        "    sync-runtime (sec): 333\n"
+        "    package-energy (joules): 444\n"
+        "    dram-energy (joules): 444\n"
+        "    power (watts): 1.33333\n"
+        "    frequency (%): 84.84\n"
+        "    frequency (Hz): 0.848485\n"
+        "    network-time (sec): 5.6\n"
+        "    count: 1\n"
+        "    ENERGY_PACKAGE@package-0: 222\n"
+        "    ENERGY_PACKAGE@package-1: 222\n"
+        "    agent stat: 2\n"
+        "Region unmarked-region (\n"
+        "    runtime (sec): 12.13\n"
+        "    sync-runtime (sec): 444\n"
+        "    package-energy (joules): 111\n"
+        "    dram-energy (joules): 111\n"
+        "    power (watts): 0.25\n"
+        "    frequency (%): 77.2727\n"
+        "    frequency (Hz): 0.772727\n"
+        "    network-time (sec): 1.2\n"
+        "    count: 0\n"
+        "    ENERGY_PACKAGE@package-0: 55.5\n"
+        "    ENERGY_PACKAGE@package-1: 55.5\n"
+        "    agent stat: 3\n"
+        "Epoch Totals:\n"
+        "    runtime (sec): 70\n"
+        "    sync-runtime (sec): 666\n"
+        "    package-energy (joules): 167\n"
+        "    dram-energy (joules): 167\n"
+        "    power (watts): 0.250751\n"
+        "    frequency (%): 88.6364\n"
+        "    frequency (Hz): 0.886364\n"
+        "    network-time (sec): 4.2\n"
+        "    count: 0\n"
+        "    ENERGY_PACKAGE@package-0: 83.5\n"
+        "    ENERGY_PACKAGE@package-1: 83.5\n"
+        "    epoch-runtime-ignore (sec): 0.7\n"
+        "Application Totals:\n"
+        "    runtime (sec): 56\n"
+        "    package-energy (joules): 2222\n"
+        "    dram-energy (joules): 1111\n"
+        "    power (watts): 39.6786\n"
+        "    network-time (sec): 45\n"
+        "    ignore-time (sec): 0.7\n"
+        "    profile-table-coalesced (max per-rank): 12\n"
+        "    profile-table-dropped (max per-rank): 4\n"
+        "    geopmctl memory HWM:\n"
+        "    geopmctl network BW (B/sec): 678\n\n";
+
+}
+
+void ReporterTest::create_reporter(const std::string &report_mode,
+                                   bool do_tree_auto_fan_out,
+                                   bool do_tree_sparse)
+{
     m_reporter = geopm::make_unique<ReporterImp>(m_start_time,
                                                  m_report_name,
                                                  m_platform_io,
@@ -187,7 +295,10 @@ ReporterTest::ReporterTest()
                                                  std::unique_ptr<MockRegionAggregator>(m_agg),
                                                  "ENERGY_PACKAGE@package",
                                                  "",
-                                                 true);
+                                                 true,
+                                                 report_mode,
+                                                 do_tree_auto_fan_out,
+                                                 do_tree_sparse);
     EXPECT_CALL(m_platform_io, push_signal("TIME", GEOPM_DOMAIN_BOARD, 0))
         .WillOnce(Return(M_TIME_IDX));
     EXPECT_CALL(m_platform_io, push_signal("ENERGY_PACKAGE", GEOPM_DOMAIN_BOARD, 0))
@@ -200,11 +311,13 @@ ReporterTest::ReporterTest()
 void ReporterTest::TearDown(void)
 {
     std::remove(m_report_name.c_str());
+    std::remove(m_host_report_name.c_str());
+    std::remove((m_report_name + ".json").c_str());
 }
 
 void check_report(std::istream &expected, std::istream &result);
 
-TEST_F(ReporterTest, generate)
+void ReporterTest::expect_generate(void)
 {
     EXPECT_CALL(m_application_io, report_name()).WillOnce(Return(m_report_name));
     EXPECT_CALL(m_application_io, profile_name());
@@ -213,6 +326,10 @@ TEST_F(ReporterTest, generate)
     EXPECT_CALL(m_application_io, total_app_runtime_ignore()).WillOnce(Return(0.7));
     EXPECT_CALL(m_application_io, total_epoch_runtime_ignore()).WillRepeatedly(Return(0.7));
     EXPECT_CALL(m_application_io, total_epoch_runtime()).WillOnce(Return(70.0));
+    EXPECT_CALL(m_application_io, profile_table_coalesced())
+        .WillOnce(Return(std::vector<uint64_t>{0, 12, 3}));
+    EXPECT_CALL(m_application_io, profile_table_dropped())
+        .WillOnce(Return(std::vector<uint64_t>{4, 0, 1}));
     EXPECT_CALL(*m_agg, read_batch);
     EXPECT_CALL(m_platform_io, sample(M_TIME_IDX))
         .WillOnce(Return(1))
@@ -227,6 +344,10 @@ TEST_F(ReporterTest, generate)
         .Times(4)
         .WillRepeatedly(Return(1.0));
     EXPECT_CALL(m_tree_comm, overhead_send()).WillOnce(Return(678 * 56));
+    EXPECT_CALL(m_tree_comm, overhead_saved()).WillRepeatedly(Return(12 * 56));
+    EXPECT_CALL(m_tree_comm, root_level()).WillRepeatedly(Return(2));
+    EXPECT_CALL(m_tree_comm, level_size(0)).WillRepeatedly(Return(8));
+    EXPECT_CALL(m_tree_comm, level_size(1)).WillRepeatedly(Return(4));
     for (auto rid : m_region_runtime) {
         EXPECT_CALL(m_application_io, total_region_runtime(rid.first))
             .WillOnce(Return(rid.second));
@@ -273,9 +394,10 @@ TEST_F(ReporterTest, generate)
         EXPECT_CALL(*m_agg, sample_total(M_CLK_REF_IDX, rid.first))
             .WillOnce(Return(rid.second));
     }
-    EXPECT_CALL(*m_comm, rank()).WillOnce(Return(0));
-    EXPECT_CALL(*m_comm, num_rank()).WillOnce(Return(1));
+}
 
+void ReporterTest::generate(void)
+{
     std::vector<std::pair<std::string, std::string> >  agent_header {
         {"one", "1"},
         {"two", "2"} };
@@ -283,88 +405,184 @@ TEST_F(ReporterTest, generate)
         {"three", "3"},
         {"four", "4"} };
 
-    // Check for labels at start of line but ignore numbers
-    // Note that region lines start with tab
-    std::string expected = "#####\n"
-        "Start Time: " + m_start_time + "\n"
-        "Profile: " + m_profile_name + "\n"
-        "Agent: my_agent\n"
-        "Policy: \n"
-        "one: 1\n"
-        "two: 2\n"
-        "\n"
-        "Host:\n"
-        "three: 3\n"
-        "four: 4\n"
-        "Region all2all (\n"
-        "    runtime (sec): 33.33\n"
-        "    sync-runtime (sec): 555\n"
-        "    package-energy (joules): 388.5\n"
-        "    dram-energy (joules): 388.5\n"
-        "    power (watts): 0.7\n"
-        "    frequency (%): 81.81\n"
-        "    frequency (Hz): 0.818182\n"
-        "    network-time (sec): 3.4\n"
-        "    count: 20\n"
-        "    ENERGY_PACKAGE@package-0: 194.25\n"
-        "    ENERGY_PACKAGE@package-1: 194.25\n"
-        "    agent stat: 1\n"
-        "    agent other stat: 2\n"
-        "Region model-init (\n"
-        "    runtime (sec): 22.11\n"
-        "    sync-runtime (sec): 333\n"
-        "    package-energy (joules): 444\n"
-        "    dram-energy (joules): 444\n"
-        "    power (watts): 1.33333\n"
-        "    frequency (%): 84.84\n"
-        "    frequency (Hz): 0.848485\n"
-        "    network-time (sec): 5.6\n"
-        "    count: 1\n"
-        "    ENERGY_PACKAGE@package-0: 222\n"
-        "    ENERGY_PACKAGE@package-1: 222\n"
-        "    agent stat: 2\n"
-        "Region unmarked-region (\n"
-        "    runtime (sec): 12.13\n"
-        "    sync-runtime (sec): 444\n"
-        "    package-energy (joules): 111\n"
-        "    dram-energy (joules): 111\n"
-        "    power (watts): 0.25\n"
-        "    frequency (%): 77.2727\n"
-        "    frequency (Hz): 0.772727\n"
-        "    network-time (sec): 1.2\n"
-        "    count: 0\n"
-        "    ENERGY_PACKAGE@package-0: 55.5\n"
-        "    ENERGY_PACKAGE@package-1: 55.5\n"
-        "    agent stat: 3\n"
-        "Epoch Totals:\n"
-        "    runtime (sec): 70\n"
-        "    sync-runtime (sec): 666\n"
-        "    package-energy (joules): 167\n"
-        "    dram-energy (joules): 167\n"
-        "    power (watts): 0.250751\n"
-        "    frequency (%): 88.6364\n"
-        "    frequency (Hz): 0.886364\n"
-        "    network-time (sec): 4.2\n"
-        "    count: 0\n"
-        "    ENERGY_PACKAGE@package-0: 83.5\n"
-        "    ENERGY_PACKAGE@package-1: 83.5\n"
-        "    epoch-runtime-ignore (sec): 0.7\n"
-        "Application Totals:\n"
-        "    runtime (sec): 56\n"
-        "    package-energy (joules): 2222\n"
-        "    dram-energy (joules): 1111\n"
-        "    power (watts): 39.6786\n"
-        "    network-time (sec): 45\n"
-        "    ignore-time (sec): 0.7\n"
-        "    geopmctl memory HWM:\n"
-        "    geopmctl network BW (B/sec): 678\n\n";
-
-    std::istringstream exp_stream(expected);
-
     m_reporter->update();
     m_reporter->generate("my_agent", agent_header, agent_node_report, m_region_agent_detail,
                          m_application_io,
                          m_comm, m_tree_comm);
+}
+
+TEST_F(ReporterTest, generate)
+{
+    create_reporter("");
+    expect_generate();
+    EXPECT_CALL(*m_comm, rank()).WillOnce(Return(0));
+    EXPECT_CALL(*m_comm, num_rank()).WillOnce(Return(1));
+    generate();
+
+    std::istringstream exp_stream(m_expected_header + m_expected_host);
+    std::ifstream report(m_report_name);
+    check_report(exp_stream, report);
+}
+
+TEST_F(ReporterTest, generate_sparse)
+{
+    create_reporter("", false, true);
+    expect_generate();
+    EXPECT_CALL(*m_comm, rank()).WillOnce(Return(0));
+    EXPECT_CALL(*m_comm, num_rank()).WillOnce(Return(1));
+    generate();
+
+    // bytes saved by GEOPM_TREE_SPARSE are reported before the BW
+    std::string expected_host = m_expected_host;
+    expected_host.insert(expected_host.find("    geopmctl network BW"),
+                         "    geopmctl network saved (B/sec): 12\n");
+    std::istringstream exp_stream(m_expected_header + expected_host);
+    std::ifstream report(m_report_name);
+    check_report(exp_stream, report);
+}
+
+TEST_F(ReporterTest, generate_json)
+{
+    create_reporter("json", true);
+    expect_generate();
+    EXPECT_CALL(*m_comm, rank()).WillOnce(Return(0));
+    EXPECT_CALL(*m_comm, num_rank()).WillOnce(Return(1));
+    generate();
+
+    // the text report is unchanged apart from the tree shape chosen
+    // by GEOPM_TREE_AUTO_FAN_OUT
+    std::string expected_header = m_expected_header;
+    expected_header.insert(expected_header.find("one: 1\n"), "Tree Fan Out: 4, 8\n");
+    std::istringstream exp_stream(expected_header + m_expected_host);
+    std::ifstream report(m_report_name);
+    check_report(exp_stream, report);
+
+    ReportModel::header_s header;
+    std::vector<ReportModel::host_s> host;
+    ReportModel::load_json(geopm::read_file(m_report_name + ".json"), header, host);
+    EXPECT_EQ(m_start_time, header.start_time);
+    EXPECT_EQ(m_profile_name, header.profile);
+    EXPECT_EQ("my_agent", header.agent);
+    EXPECT_EQ("DYNAMIC", header.policy);
+    EXPECT_EQ(std::vector<int>({4, 8}), header.fan_out);
+    std::vector<std::pair<std::string, std::string> > agent_header {{"one", "1"}, {"two", "2"}};
+    EXPECT_EQ(agent_header, header.agent_header);
+    ASSERT_EQ(1u, host.size());
+    EXPECT_EQ(geopm::hostname(), host[0].host);
+    std::vector<std::string> region_name;
+    for (const auto &region : host[0].region) {
+        region_name.push_back(region.name);
+    }
+    EXPECT_EQ((std::vector<std::string>{"all2all", "model-init", "unmarked-region", "epoch"}),
+              region_name);
+    EXPECT_EQ(geopm_crc32_str("all2all"), host[0].region[0].hash);
+    std::map<std::string, ReportModel::field_s> field;
+    for (const auto &ff : host[0].region[0].field) {
+        field.emplace(ff.name, ff);
+    }
+    EXPECT_EQ(33.33, field.at("runtime (sec)").value);
+    EXPECT_EQ(555, field.at("sync-runtime (sec)").value);
+    EXPECT_EQ(388.5, field.at("package-energy (joules)").value);
+    EXPECT_EQ(20, field.at("count").value);
+    EXPECT_EQ("2", field.at("agent other stat").text);
+    field.clear();
+    for (const auto &ff : host[0].region[3].field) {
+        field.emplace(ff.name, ff);
+    }
+    EXPECT_EQ(0.7, field.at("epoch-runtime-ignore (sec)").value);
+    field.clear();
+    for (const auto &ff : host[0].app_totals) {
+        field.emplace(ff.name, ff);
+    }
+    EXPECT_EQ(56, field.at("runtime (sec)").value);
+    EXPECT_EQ(12, field.at("profile-table-coalesced (max per-rank)").value);
+    EXPECT_EQ(ReportModel::M_FIELD_STRING, field.at("geopmctl memory HWM").type);
+
+    // the text printed from the loaded model matches the text report,
+    // which the Reporter ends with a blank line
+    std::istringstream loaded_stream(ReportModel::text_header(header) +
+                                     ReportModel::text_host(host[0]) + "\n");
+    std::ifstream report_again(m_report_name);
+    check_report(loaded_stream, report_again);
+}
+
+TEST_F(ReporterTest, generate_per_node)
+{
+    create_reporter("per-node");
+    expect_generate();
+    EXPECT_CALL(*m_comm, rank()).WillOnce(Return(0));
+    EXPECT_CALL(*m_comm, num_rank()).Times(0);
+    generate();
+
+    // root report holds only the header
+    std::istringstream exp_stream(m_expected_header + "\n");
+    std::ifstream report(m_report_name);
+    check_report(exp_stream, report);
+    // host report is complete on its own
+    std::istringstream exp_host_stream(m_expected_header + m_expected_host);
+    std::ifstream host_report(m_host_report_name);
+    ASSERT_TRUE(host_report.good());
+    check_report(exp_host_stream, host_report);
+}
+
+TEST_F(ReporterTest, generate_summary)
+{
+    create_reporter("summary");
+    expect_generate();
+    EXPECT_CALL(*m_comm, rank()).WillOnce(Return(0));
+    EXPECT_CALL(*m_comm, num_rank()).WillOnce(Return(1));
+    generate();
+
+    // with a single node the min, max and mean all match the host report
+    std::string expected_summary = "Node Summary:\n"
+        "    Region all2all (\n"
+        "        nodes: 1\n"
+        "        runtime (sec): min 33.33, max 33.33, mean 33.33\n"
+        "        sync-runtime (sec): min 555, max 555, mean 555\n"
+        "        package-energy (joules): min 388.5, max 388.5, mean 388.5\n"
+        "        dram-energy (joules): min 388.5, max 388.5, mean 388.5\n"
+        "        power (watts): min 0.7, max 0.7, mean 0.7\n"
+        "        frequency (%): min 81.8182, max 81.8182, mean 81.8182\n"
+        "        network-time (sec): min 3.4, max 3.4, mean 3.4\n"
+        "        count: min 20, max 20, mean 20\n"
+        "    Region model-init (\n"
+        "        nodes: 1\n"
+        "        runtime (sec): min 22.11, max 22.11, mean 22.11\n"
+        "        sync-runtime (sec): min 333\n"
+        "        package-energy (joules): min 444\n"
+        "        dram-energy (joules): min 444\n"
+        "        power (watts): min 1.33333\n"
+        "        frequency (%): min 84.8485\n"
+        "        network-time (sec): min 5.6\n"
+        "        count: min 1, max 1, mean 1\n"
+        "    Region unmarked-region (\n"
+        "        nodes: 1\n"
+        "        runtime (sec): min 12.13\n"
+        "        sync-runtime (sec): min 444\n"
+        "        package-energy (joules): min 111\n"
+        "        dram-energy (joules): min 111\n"
+        "        power (watts): min 0.25\n"
+        "        frequency (%): min 77.2727\n"
+        "        network-time (sec): min 1.2\n"
+        "        count: min 0, max 0, mean 0\n"
+        "    Epoch Totals:\n"
+        "        nodes: 1\n"
+        "        runtime (sec): min 70\n"
+        "        sync-runtime (sec): min 666\n"
+        "        package-energy (joules): min 167\n"
+        "        dram-energy (joules): min 167\n"
+        "        power (watts): min 0.250751\n"
+        "        frequency (%): min 88.6364\n"
+        "        network-time (sec): min 4.2\n"
+        "        count: min 0\n"
+        "    Application Totals:\n"
+        "        nodes: 1\n"
+        "        runtime (sec): min 56, max 56, mean 56\n"
+        "        package-energy (joules): min 2222, max 2222, mean 2222\n"
+        "        dram-energy (joules): min 1111, max 1111, mean 1111\n"
+        "        power (watts): min 39.6786, max 39.6786, mean 39.6786\n"
+        "        network-time (sec): min 45, max 45, mean 45\n";
+    std::istringstream exp_stream(m_expected_header + m_expected_host + expected_summary);
     std::ifstream report(m_report_name);
     check_report(exp_stream, report);
 }
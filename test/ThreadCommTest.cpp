@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "ThreadComm.hpp"
+#include "TreeComm.hpp"
+#include "TreeCommLevel.hpp"
+#include "geopm_test.hpp"
+#include "config.h"
+
+using geopm::Comm;
+using geopm::ThreadComm;
+using geopm::TreeComm;
+using geopm::TreeCommImp;
+
+class ThreadCommTest : public ::testing::Test
+{
+    protected:
+        int m_num_rank = 4;
+};
+
+TEST_F(ThreadCommTest, make_plugin)
+{
+    std::unique_ptr<Comm> comm = Comm::make_unique(ThreadComm::plugin_name());
+    EXPECT_EQ(0, comm->rank());
+    EXPECT_EQ(1, comm->num_rank());
+    EXPECT_TRUE(comm->comm_supported("ThreadComm"));
+    EXPECT_FALSE(comm->comm_supported("MPIComm"));
+    comm->barrier();
+    double value = 4.5;
+    double result = 0.0;
+    comm->reduce_sum(&value, &result, 1, 0);
+    EXPECT_EQ(4.5, result);
+
+    std::vector<int> world_rank(m_num_rank, -1);
+    ThreadComm::run(m_num_rank, [&world_rank, this] (std::shared_ptr<Comm> comm)
+    {
+        // the plugin returns the world of the calling thread
+        std::unique_ptr<Comm> world = Comm::make_unique(ThreadComm::plugin_name());
+        EXPECT_EQ(m_num_rank, world->num_rank());
+        EXPECT_EQ(comm->rank(), world->rank());
+        world_rank[comm->rank()] = world->rank();
+    });
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), world_rank);
+
+    GEOPM_EXPECT_THROW_MESSAGE(ThreadComm::run(0, [] (std::shared_ptr<Comm> comm) {}),
+                               GEOPM_ERROR_INVALID, "num_rank must be positive");
+    GEOPM_EXPECT_THROW_MESSAGE(ThreadComm::run(2, [] (std::shared_ptr<Comm> comm)
+                                               {
+                                                   if (comm->rank() == 1) {
+                                                       comm->broadcast(nullptr, 0, 7);
+                                                   }
+                                               }),
+                               GEOPM_ERROR_INVALID, "rank 7 is out of range");
+}
+
+TEST_F(ThreadCommTest, collective)
+{
+    std::vector<double> reduce_max(2, 0.0);
+    std::vector<double> reduce_sum(2, 0.0);
+    std::vector<int> gather(m_num_rank, -1);
+    std::vector<char> gatherv(10, '\0');
+    std::vector<std::string> broadcast(m_num_rank);
+    std::vector<bool> test_true(m_num_rank, false);
+    std::vector<bool> test_false(m_num_rank, true);
+    ThreadComm::run(m_num_rank, [&] (std::shared_ptr<Comm> comm)
+    {
+        int rank = comm->rank();
+        comm->barrier();
+        std::vector<double> value {(double)rank, -1.0 * rank};
+        std::vector<double> result(2, 0.0);
+        comm->reduce_max(value.data(), result.data(), 2, 1);
+        if (rank == 1) {
+            reduce_max = result;
+        }
+        comm->reduce_sum(value.data(), result.data(), 2, 0);
+        if (rank == 0) {
+            reduce_sum = result;
+        }
+        int gather_value = 10 * rank;
+        comm->gather(&gather_value, sizeof(int), gather.data(), sizeof(int), 2);
+        // rank N sends N + 1 characters
+        std::string gatherv_value(rank + 1, 'a' + rank);
+        std::vector<size_t> sizes {1, 2, 3, 4};
+        std::vector<off_t> offsets {0, 1, 3, 6};
+        comm->gatherv(gatherv_value.data(), gatherv_value.size(), gatherv.data(),
+                      sizes, offsets, 3);
+        char message[6] = "";
+        if (rank == 2) {
+            strncpy(message, "hello", sizeof(message));
+        }
+        comm->broadcast(message, sizeof(message), 2);
+        broadcast[rank] = message;
+        test_true[rank] = comm->test(true);
+        test_false[rank] = comm->test(rank != 3);
+    });
+    EXPECT_EQ(std::vector<double>({3.0, 0.0}), reduce_max);
+    EXPECT_EQ(std::vector<double>({6.0, -6.0}), reduce_sum);
+    EXPECT_EQ(std::vector<int>({0, 10, 20, 30}), gather);
+    EXPECT_EQ("abbcccdddd", std::string(gatherv.begin(), gatherv.end()));
+    EXPECT_EQ(std::vector<std::string>(m_num_rank, "hello"), broadcast);
+    EXPECT_EQ(std::vector<bool>(m_num_rank, true), test_true);
+    EXPECT_EQ(std::vector<bool>(m_num_rank, false), test_false);
+}
+
+TEST_F(ThreadCommTest, split)
+{
+    std::vector<int> split_rank(m_num_rank, -2);
+    std::vector<int> split_size(m_num_rank, -2);
+    std::vector<int> shared_size(m_num_rank, -2);
+    std::vector<int> ppn1_size(m_num_rank, -2);
+    std::vector<std::vector<int> > coord(m_num_rank);
+    ThreadComm::run(m_num_rank, [&] (std::shared_ptr<Comm> comm)
+    {
+        int rank = comm->rank();
+        // even ranks in reverse order, odd ranks are excluded
+        int color = rank % 2 ? Comm::M_SPLIT_COLOR_UNDEFINED : 0;
+        auto split = comm->split(color, -rank);
+        split_rank[rank] = split->rank();
+        split_size[rank] = split->num_rank();
+        // the excluded ranks do not take part in collectives
+        split->barrier();
+        shared_size[rank] = comm->split("tag", Comm::M_COMM_SPLIT_TYPE_SHARED)->num_rank();
+        ppn1_size[rank] = comm->split("tag", Comm::M_COMM_SPLIT_TYPE_PPN1)->num_rank();
+        auto cart = comm->split_cart({2, 2});
+        coord[rank] = cart->coordinate(cart->rank());
+        EXPECT_EQ(cart->rank(), cart->cart_rank(coord[rank]));
+    });
+    EXPECT_EQ(std::vector<int>({1, -1, 0, -1}), split_rank);
+    EXPECT_EQ(std::vector<int>({2, 0, 2, 0}), split_size);
+    EXPECT_EQ(std::vector<int>(m_num_rank, 1), shared_size);
+    EXPECT_EQ(std::vector<int>(m_num_rank, m_num_rank), ppn1_size);
+    std::vector<std::vector<int> > expected_coord {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    EXPECT_EQ(expected_coord, coord);
+
+    ThreadComm comm;
+    std::vector<int> dimension(2, 0);
+    comm.dimension_create(12, dimension);
+    EXPECT_EQ(std::vector<int>({4, 3}), dimension);
+    dimension = {0, 0, 0};
+    comm.dimension_create(8, dimension);
+    EXPECT_EQ(std::vector<int>({2, 2, 2}), dimension);
+    dimension = {0, 3};
+    comm.dimension_create(12, dimension);
+    EXPECT_EQ(std::vector<int>({4, 3}), dimension);
+    dimension = {0, 5};
+    GEOPM_EXPECT_THROW_MESSAGE(comm.dimension_create(12, dimension),
+                               GEOPM_ERROR_INVALID, "not divisible");
+    GEOPM_EXPECT_THROW_MESSAGE(comm.split_cart({2, 2}),
+                               GEOPM_ERROR_INVALID, "product of dimensions does not match");
+    GEOPM_EXPECT_THROW_MESSAGE(comm.coordinate(0),
+                               GEOPM_ERROR_INVALID, "communicator is not Cartesian");
+}
+
+TEST_F(ThreadCommTest, window)
+{
+    std::vector<std::vector<double> > mailbox(m_num_rank);
+    ThreadComm::run(m_num_rank, [&] (std::shared_ptr<Comm> comm)
+    {
+        int rank = comm->rank();
+        int num_rank = comm->num_rank();
+        double *mem = nullptr;
+        size_t mem_size = sizeof(double) * num_rank;
+        comm->alloc_mem(mem_size, (void **)&mem);
+        std::fill(mem, mem + num_rank, 0.0);
+        size_t window = comm->window_create(mem_size, mem);
+        comm->barrier();
+        // each rank writes its rank into its slot in every other rank
+        double value = rank + 1;
+        for (int target = 0; target < num_rank; ++target) {
+            comm->window_lock(window, true, target, 0);
+            comm->window_put(&value, sizeof(double), target, rank * sizeof(double), window);
+            comm->window_unlock(window, target);
+        }
+        GEOPM_EXPECT_THROW_MESSAGE(comm->window_put(&value, sizeof(double), 0, mem_size, window),
+                                   GEOPM_ERROR_INVALID, "outside of the window");
+        comm->barrier();
+        comm->window_lock(window, false, rank, 0);
+        mailbox[rank].assign(mem, mem + num_rank);
+        comm->window_unlock(window, rank);
+        comm->window_destroy(window);
+        comm->free_mem(mem);
+        GEOPM_EXPECT_THROW_MESSAGE(comm->window_lock(window, false, rank, 0),
+                                   GEOPM_ERROR_RUNTIME, "invalid");
+    });
+    for (const auto &it : mailbox) {
+        EXPECT_EQ(std::vector<double>({1.0, 2.0, 3.0, 4.0}), it);
+    }
+}
+
+TEST_F(ThreadCommTest, tree_comm)
+{
+    int num_rank = 8;
+    int num_round = 3;
+    std::vector<double> root_total;
+    ThreadComm::run(num_rank, [&] (std::shared_ptr<Comm> comm)
+    {
+        TreeCommImp tree(comm, {2, 4}, 0, 1, 1, {});
+        int num_level_ctl = tree.num_level_controlled();
+        bool is_root = num_level_ctl == tree.root_level();
+        for (int round = 1; round <= num_round; ++round) {
+            std::vector<double> sample {(double)round};
+            for (int level = 0; level < num_level_ctl; ++level) {
+                tree.send_up(level, sample);
+                std::vector<std::vector<double> > child(tree.level_size(level), {0.0});
+                while (!tree.receive_up(level, child)) {
+                    std::this_thread::yield();
+                }
+                sample[0] = 0.0;
+                for (const auto &it : child) {
+                    sample[0] += it[0];
+                }
+            }
+            std::vector<double> policy {(double)round};
+            if (is_root) {
+                root_total.push_back(sample[0]);
+            }
+            else {
+                tree.send_up(num_level_ctl, sample);
+                while (!tree.receive_down(num_level_ctl, policy) || policy[0] != round) {
+                    std::this_thread::yield();
+                }
+            }
+            for (int level = num_level_ctl - 1; level > -1; --level) {
+                tree.send_down(level, std::vector<std::vector<double> >(tree.level_size(level), policy));
+                EXPECT_TRUE(tree.receive_down(level, policy));
+                EXPECT_EQ(round, policy[0]);
+            }
+        }
+    });
+    EXPECT_EQ(std::vector<double>({8.0, 16.0, 24.0}), root_total);
+}
+
+TEST_F(ThreadCommTest, fan_out_candidate)
+{
+    std::vector<std::vector<int> > candidate;
+    ThreadComm::run(64, [&] (std::shared_ptr<Comm> comm)
+    {
+        if (comm->rank() == 0) {
+            candidate = TreeComm::fan_out_candidate(comm);
+        }
+    });
+    // a single level of 64 exceeds the default GEOPM_MAX_FAN_OUT
+    std::vector<std::vector<int> > expected {{8, 8},
+                                             {4, 4, 4},
+                                             {2, 2, 4, 4},
+                                             {2, 2, 2, 2, 4},
+                                             {2, 2, 2, 2, 2, 2}};
+    EXPECT_EQ(expected, candidate);
+}
+
+TEST_F(ThreadCommTest, fan_out_tuned)
+{
+    int num_rank = 8;
+    std::vector<std::vector<int> > fan_out(num_rank);
+    ThreadComm::run(num_rank, [&] (std::shared_ptr<Comm> comm)
+    {
+        fan_out[comm->rank()] = TreeComm::fan_out_tuned(comm, 2, 3);
+    });
+    // every rank chooses the same tree over all of the ranks
+    ASSERT_FALSE(fan_out[0].empty());
+    EXPECT_EQ(num_rank, std::accumulate(fan_out[0].begin(), fan_out[0].end(), 1,
+                                        std::multiplies<int>()));
+    for (const auto &it : fan_out) {
+        EXPECT_EQ(fan_out[0], it);
+    }
+}
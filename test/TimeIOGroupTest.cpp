@@ -150,6 +150,26 @@ TEST_F(TimeIOGroupTest, sample)
     EXPECT_THROW(m_group.sample(-1), Exception);
 }
 
+TEST_F(TimeIOGroupTest, batch_time)
+{
+    int signal_idx = m_group.push_signal("TIME", m_time_domain, 0);
+    struct geopm_time_s batch0;
+    struct geopm_time_s batch1;
+    geopm_time(&batch0);
+    geopm_time_add(&batch0, 2.5, &batch1);
+    // Elapsed time follows the batch start given by PlatformIO,
+    // not the time at which read_batch() was called.
+    m_group.set_batch_time(batch0);
+    m_group.read_batch();
+    double time0 = m_group.sample(signal_idx);
+    m_group.set_batch_time(batch1);
+    m_group.read_batch();
+    double time1 = m_group.sample(signal_idx);
+    EXPECT_DOUBLE_EQ(2.5, time1 - time0);
+    m_group.read_batch();
+    EXPECT_DOUBLE_EQ(time1, m_group.sample(signal_idx));
+}
+
 TEST_F(TimeIOGroupTest, adjust)
 {
     EXPECT_NO_THROW(m_group.write_batch());
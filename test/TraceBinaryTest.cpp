@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <math.h>
+#include <unistd.h>
+
+#include <memory>
+#include <functional>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+
+#include "gtest/gtest.h"
+#include "geopm_error.h"
+#include "geopm_test.hpp"
+#include "geopm_hash.h"
+#include "Helper.hpp"
+#include "CSV.hpp"
+#include "TraceBinary.hpp"
+
+using geopm::CSV;
+using geopm::CSVImp;
+using geopm::TraceBinaryImp;
+using geopm::TraceBinaryReader;
+
+class TraceBinaryTest : public ::testing::Test
+{
+    protected:
+        void SetUp(void);
+        void TearDown(void);
+        void write_trace(std::unique_ptr<CSV> trace);
+        /// @brief Size of the text stored for the custom POWER column.
+        size_t custom_text_size(void);
+        std::string m_host_name;
+        std::string m_start_time;
+        size_t m_buffer_size;
+        std::vector<std::string> m_paths;
+        std::vector<std::vector<double> > m_rows;
+};
+
+void TraceBinaryTest::SetUp(void)
+{
+    m_host_name = "trace-binary-test-host";
+    m_start_time = "Mon Jul  1 11:10:08 PDT 2019";
+    m_buffer_size = 256;
+    m_paths = {"TraceBinaryTest-csv",
+               "TraceBinaryTest-binary",
+               "TraceBinaryTest-compressed",
+               "TraceBinaryTest-bad",
+               "TraceBinaryTest-custom"};
+    // More than one compressed block of slowly changing telemetry
+    size_t num_row = TraceBinaryImp::M_BLOCK_ROWS + 100;
+    for (size_t row_idx = 0; row_idx != num_row; ++row_idx) {
+        m_rows.push_back({0.001 * row_idx,
+                          0.5 + 0.25 * (row_idx % 4),
+                          (double)(row_idx / 10),
+                          (double)(0x123 + row_idx % 3),
+                          geopm_field_to_signal(0xFFFFFFFF00000000ULL + row_idx),
+                          250.0 + sin(row_idx)});
+    }
+}
+
+void TraceBinaryTest::TearDown(void)
+{
+    for (const auto &path : m_paths) {
+        unlink((path + "-" + m_host_name).c_str());
+    }
+}
+
+void TraceBinaryTest::write_trace(std::unique_ptr<CSV> trace)
+{
+    trace->add_column("TIME", geopm::string_format_double);
+    trace->add_column("PROGRESS", "float");
+    trace->add_column("COUNT", geopm::string_format_integer);
+    trace->add_column("HASH", "hex");
+    trace->add_column("RAW", geopm::string_format_raw64);
+    trace->add_column("POWER", [](double value) {
+        return geopm::string_format_double(value);
+    });
+    trace->activate();
+    for (const auto &row : m_rows) {
+        trace->update(row);
+    }
+}
+
+size_t TraceBinaryTest::custom_text_size(void)
+{
+    size_t result = 0;
+    for (const auto &row : m_rows) {
+        result += sizeof(uint32_t) + geopm::string_format_double(row[5]).size();
+    }
+    return result;
+}
+
+TEST_F(TraceBinaryTest, schema)
+{
+    write_trace(geopm::make_unique<TraceBinaryImp>(m_paths[1], m_host_name, m_start_time,
+                                                   m_buffer_size, false));
+    TraceBinaryReader reader(m_paths[1] + "-" + m_host_name);
+    EXPECT_FALSE(reader.is_compressed());
+    std::vector<std::string> expect_names {"TIME", "PROGRESS", "COUNT", "HASH", "RAW", "POWER"};
+    EXPECT_EQ(expect_names, reader.column_names());
+    std::vector<int> expect_types {TraceBinaryImp::M_COLUMN_DOUBLE,
+                                   TraceBinaryImp::M_COLUMN_FLOAT,
+                                   TraceBinaryImp::M_COLUMN_INTEGER,
+                                   TraceBinaryImp::M_COLUMN_HEX,
+                                   TraceBinaryImp::M_COLUMN_RAW64,
+                                   TraceBinaryImp::M_COLUMN_CUSTOM};
+    EXPECT_EQ(expect_types, reader.column_types());
+    EXPECT_TRUE(geopm::string_begins_with(reader.meta_data(), "# geopm_version:"));
+    EXPECT_NE(std::string::npos, reader.meta_data().find("# node_name: " + m_host_name + "\n"));
+    std::vector<double> row;
+    std::vector<std::string> text;
+    for (const auto &expect_row : m_rows) {
+        ASSERT_TRUE(reader.next(row, text));
+        ASSERT_EQ(expect_row.size(), row.size());
+        ASSERT_EQ(expect_row.size(), text.size());
+        for (size_t col_idx = 0; col_idx != row.size(); ++col_idx) {
+            EXPECT_EQ(geopm_signal_to_field(expect_row[col_idx]),
+                      geopm_signal_to_field(row[col_idx]));
+        }
+        // Only the custom column stores text
+        EXPECT_EQ("", text[0]);
+        EXPECT_EQ(geopm::string_format_double(expect_row[5]), text[5]);
+    }
+    EXPECT_FALSE(reader.next(row));
+
+    // Fixed width records and the custom column text follow the header
+    size_t file_size = geopm::read_file(m_paths[1] + "-" + m_host_name).size();
+    size_t record_size = m_rows.size() * 6 * sizeof(double) + custom_text_size();
+    EXPECT_LT(record_size, file_size);
+    EXPECT_GT(record_size + 512, file_size);
+}
+
+TEST_F(TraceBinaryTest, uncompressed_csv)
+{
+    write_trace(geopm::make_unique<CSVImp>(m_paths[0], m_host_name, m_start_time,
+                                           m_buffer_size));
+    write_trace(geopm::make_unique<TraceBinaryImp>(m_paths[1], m_host_name, m_start_time,
+                                                   m_buffer_size, false));
+    std::ostringstream result;
+    TraceBinaryReader(m_paths[1] + "-" + m_host_name).write_csv(result);
+    EXPECT_EQ(geopm::read_file(m_paths[0] + "-" + m_host_name), result.str());
+}
+
+TEST_F(TraceBinaryTest, compressed_csv)
+{
+    write_trace(geopm::make_unique<CSVImp>(m_paths[0], m_host_name, m_start_time,
+                                           m_buffer_size));
+    write_trace(geopm::make_unique<TraceBinaryImp>(m_paths[2], m_host_name, m_start_time,
+                                                   m_buffer_size, true));
+    TraceBinaryReader reader(m_paths[2] + "-" + m_host_name);
+    EXPECT_TRUE(reader.is_compressed());
+    std::ostringstream result;
+    reader.write_csv(result);
+    EXPECT_EQ(geopm::read_file(m_paths[0] + "-" + m_host_name), result.str());
+
+    // The custom column text is stored uncompressed
+    size_t compressed_size = geopm::read_file(m_paths[2] + "-" + m_host_name).size();
+    EXPECT_GT(m_rows.size() * 6 * sizeof(double) / 2 + custom_text_size(), compressed_size);
+}
+
+TEST_F(TraceBinaryTest, custom_format)
+{
+    // Formats that are not one of the geopm::string_format_*()
+    // functions are stored as text and reproduced exactly
+    std::function<std::string(double)> watts = [](double value) {
+        return std::to_string((int)value) + " W";
+    };
+    std::function<std::string(double)> fixed = std::bind(geopm::string_format_float, std::placeholders::_1);
+    std::vector<std::vector<double> > rows {{1.0, 250.5, 0.1},
+                                            {2.0, 249.0, 0.2},
+                                            {3.0, 251.0, 1.0 / 3.0}};
+    for (bool is_compressed : {false, true}) {
+        std::vector<std::unique_ptr<CSV> > traces;
+        traces.push_back(geopm::make_unique<CSVImp>(m_paths[0], m_host_name, m_start_time,
+                                                    m_buffer_size));
+        traces.push_back(geopm::make_unique<TraceBinaryImp>(m_paths[4], m_host_name, m_start_time,
+                                                            m_buffer_size, is_compressed));
+        for (auto &trace : traces) {
+            trace->add_column("TIME");
+            trace->add_column("POWER", watts);
+            trace->add_column("RATIO", fixed);
+            trace->activate();
+            for (const auto &row : rows) {
+                trace->update(row);
+            }
+        }
+        traces.clear();
+        TraceBinaryReader reader(m_paths[4] + "-" + m_host_name);
+        std::vector<int> expect_types {TraceBinaryImp::M_COLUMN_DOUBLE,
+                                       TraceBinaryImp::M_COLUMN_CUSTOM,
+                                       TraceBinaryImp::M_COLUMN_CUSTOM};
+        EXPECT_EQ(expect_types, reader.column_types());
+        std::ostringstream result;
+        reader.write_csv(result);
+        std::string expect = geopm::read_file(m_paths[0] + "-" + m_host_name);
+        EXPECT_NE(std::string::npos, expect.find("|250 W|"));
+        EXPECT_EQ(expect, result.str());
+    }
+}
+
+TEST_F(TraceBinaryTest, compress_block)
+{
+    std::vector<double> rows {0.0, -0.0, NAN, INFINITY,
+                              1.0, -INFINITY, 1e-300, 0.0,
+                              1.0, 0.0, 1e300, 0.0};
+    std::vector<double> result;
+    std::string payload = TraceBinaryImp::compress_block(rows, 4);
+    TraceBinaryImp::decompress_block(payload, 3, 4, result);
+    ASSERT_EQ(rows.size(), result.size());
+    for (size_t idx = 0; idx != rows.size(); ++idx) {
+        EXPECT_EQ(geopm_signal_to_field(rows[idx]), geopm_signal_to_field(result[idx]));
+    }
+    // Long runs of zeros are split across control bytes
+    std::vector<double> zeros(1000, 0.0);
+    payload = TraceBinaryImp::compress_block(zeros, 10);
+    EXPECT_GT(100u, payload.size());
+    TraceBinaryImp::decompress_block(payload, 100, 10, result);
+    EXPECT_EQ(zeros, result);
+
+    GEOPM_EXPECT_THROW_MESSAGE(TraceBinaryImp::decompress_block(payload, 101, 10, result),
+                               GEOPM_ERROR_FILE_PARSE, "corrupt block");
+    GEOPM_EXPECT_THROW_MESSAGE(TraceBinaryImp::decompress_block(payload, 99, 10, result),
+                               GEOPM_ERROR_FILE_PARSE, "corrupt block");
+}
+
+TEST_F(TraceBinaryTest, bad_file)
+{
+    std::string bad_path = m_paths[3] + "-" + m_host_name;
+    {
+        std::ofstream bad_file(bad_path);
+        bad_file << "# geopm_version: 1.0\n";
+    }
+    GEOPM_EXPECT_THROW_MESSAGE(TraceBinaryReader reader(bad_path),
+                               GEOPM_ERROR_FILE_PARSE, "not a binary trace");
+    {
+        std::ofstream bad_file(bad_path);
+        bad_file << TraceBinaryImp::M_MAGIC;
+    }
+    GEOPM_EXPECT_THROW_MESSAGE(TraceBinaryReader reader(bad_path),
+                               GEOPM_ERROR_FILE_PARSE, "truncated");
+
+    std::unique_ptr<CSV> trace = geopm::make_unique<TraceBinaryImp>(m_paths[1], m_host_name, m_start_time,
+                                                                    m_buffer_size, true);
+    GEOPM_EXPECT_THROW_MESSAGE(trace->add_column("BAD", "octal"),
+                               GEOPM_ERROR_INVALID, "format is unknown");
+    GEOPM_EXPECT_THROW_MESSAGE(trace->update({1.0}),
+                               GEOPM_ERROR_INVALID, "must be called prior to update");
+    trace->add_column("GOOD");
+    trace->activate();
+    GEOPM_EXPECT_THROW_MESSAGE(trace->add_column("LATE"),
+                               GEOPM_ERROR_INVALID, "cannot be called after activate");
+    GEOPM_EXPECT_THROW_MESSAGE(trace->update({1.0, 2.0}),
+                               GEOPM_ERROR_INVALID, "incorrectly sized");
+}
@@ -54,6 +54,7 @@ using geopm::PlatformIO;
 using geopm::PlatformTopo;
 using testing::_;
 using testing::Return;
+using testing::Invoke;
 using testing::HasSubstr;
 
 class TracerTest : public ::testing::Test
@@ -140,8 +141,18 @@ void TracerTest::SetUp(void)
             .WillOnce(Return(column.format));
     }
 
+    // Route batch sampling through the per-signal expectations
+    ON_CALL(m_platform_io, sample_all(_, _))
+        .WillByDefault(Invoke([this](const std::vector<int> &signal_idx,
+                                     std::vector<double> &sample) {
+            sample.resize(signal_idx.size());
+            for (size_t ii = 0; ii < signal_idx.size(); ++ii) {
+                sample[ii] = m_platform_io.sample(signal_idx[ii]);
+            }
+        }));
+
     m_tracer = geopm::make_unique<TracerImp>(m_start_time, m_path, m_hostname, true,
-                                             m_platform_io, m_platform_topo, m_extra_cols_str);
+                                             m_platform_io, m_platform_topo, m_extra_cols_str, "csv", "");
 }
 
 void TracerTest::TearDown(void)
@@ -190,6 +201,7 @@ TEST_F(TracerTest, update_samples)
         ++idx;
     }
 
+    EXPECT_CALL(m_platform_io, sample_all(_, _));
     std::vector<std::string> agent_cols {"col1", "col2"};
     std::vector<double> agent_vals {88.8, 77.7};
 
@@ -215,6 +227,7 @@ TEST_F(TracerTest, region_entry_exit)
         .WillOnce(Return(0.0))  // progress; should cause one region entry to be skipped
         .WillOnce(Return(0.0))
         .WillRepeatedly(Return(2.2));
+    EXPECT_CALL(m_platform_io, sample_all(_, _));
 
     std::vector<std::string> agent_cols {"col1", "col2"};
     std::vector<double> agent_vals {88.8, 77.7};
@@ -247,6 +260,101 @@ TEST_F(TracerTest, region_entry_exit)
     check_trace(expected, result);
 }
 
+TEST_F(TracerTest, mode_every_change)
+{
+    m_tracer.reset();
+    m_tracer = geopm::make_unique<TracerImp>(m_start_time, m_path, m_hostname, true,
+                                             m_platform_io, m_platform_topo, m_extra_cols_str,
+                                             "csv", "every:4,change:col1");
+    const int num_step = 10;
+    EXPECT_CALL(m_platform_io, sample(_))
+        .WillRepeatedly(Return(1.0));
+    EXPECT_CALL(m_platform_io, sample_all(_, _)).Times(num_step);
+    std::vector<std::string> agent_cols {"col1", "col2"};
+    m_tracer->columns(agent_cols, {geopm::string_format_integer,
+                                   geopm::string_format_integer});
+    for (int step = 0; step < num_step; ++step) {
+        // col1 changes once at step 5, col2 tags each row with its step
+        m_tracer->update({step < 5 ? 1.0 : 2.0, (double)step}, {});
+    }
+    m_tracer->flush();
+
+    // step 0 is the first row, steps 4 and 8 are periodic, step 5
+    // changes col1 and step 9 is pending when the trace is flushed
+    std::string row = "1|1|0x0000000000000001|0x0000000000000001|1|1|1|1|1|1|1|1|1|1|1|1|1|1|";
+    std::string expected_str = "\n\n\n\n\n"
+        "# trace_mode: every:4,change:col1\n"
+        "\n" // header
+        + row + "1|0\n"
+        + row + "1|4\n"
+        + row + "2|5\n"
+        + row + "2|8\n"
+        + row + "2|9\n";
+    std::istringstream expected(expected_str);
+    std::ifstream result(m_path + "-" + m_hostname);
+    ASSERT_TRUE(result.good()) << strerror(errno);
+    check_trace(expected, result);
+}
+
+TEST_F(TracerTest, mode_region)
+{
+    m_tracer.reset();
+    m_tracer = geopm::make_unique<TracerImp>(m_start_time, m_path, m_hostname, true,
+                                             m_platform_io, m_platform_topo, m_extra_cols_str,
+                                             "csv", "region");
+    const int num_step = 6;
+    int step = 0;
+    // REGION_HASH is the third signal pushed
+    EXPECT_CALL(m_platform_io, sample(_))
+        .WillRepeatedly(Invoke([&step](int signal_idx) {
+            return signal_idx == 2 && step >= 3 ? 0x456 : 1.0;
+        }));
+    EXPECT_CALL(m_platform_io, sample_all(_, _)).Times(num_step);
+    std::vector<std::string> agent_cols {"col1", "col2"};
+    m_tracer->columns(agent_cols, {geopm::string_format_integer,
+                                   geopm::string_format_integer});
+    std::list<geopm_region_info_s> short_region = {
+        {0x123, GEOPM_REGION_HINT_UNKNOWN, 1.0, 0.5},
+    };
+    for (step = 0; step < num_step; ++step) {
+        m_tracer->update({1.0, (double)step}, step == 1 ? short_region :
+                                              std::list<geopm_region_info_s>{});
+    }
+    m_tracer->flush();
+
+    std::string expected_str = "\n\n\n\n\n"
+        "# trace_mode: region\n"
+        "\n" // header
+#ifdef GEOPM_TRACE_BLOAT
+        "1|1|0x0000000000000001|0x0000000000000001|1|1|1|1|1|1|1|1|1|1|1|1|1|1|1|0\n"
+        "1|1|0x0000000000000123|0x0000000100000000|1|1|0.5|1|1|1|1|1|1|1|1|1|1|1|1|1\n"
+#else
+        "1|1|0x0000000000000001|0x0000000000000001|1|1|1|1|1|1|1|1|1|1|1|1|1|1|1|0\n"
+#endif
+        "1|1|0x0000000000000001|0x0000000000000001|1|1|1|1|1|1|1|1|1|1|1|1|1|1|1|1\n"
+        "1|1|0x0000000000000456|0x0000000000000001|1|1|1|1|1|1|1|1|1|1|1|1|1|1|1|3\n"
+        "1|1|0x0000000000000456|0x0000000000000001|1|1|1|1|1|1|1|1|1|1|1|1|1|1|1|5\n";
+    std::istringstream expected(expected_str);
+    std::ifstream result(m_path + "-" + m_hostname);
+    ASSERT_TRUE(result.good()) << strerror(errno);
+    check_trace(expected, result);
+}
+
+TEST_F(TracerTest, mode_invalid)
+{
+    for (const auto &mode : {"every:0", "every:x", "sometimes"}) {
+        EXPECT_THROW(geopm::make_unique<TracerImp>(m_start_time, m_path, m_hostname, true,
+                                                   m_platform_io, m_platform_topo, m_extra_cols_str,
+                                                   "csv", mode),
+                     geopm::Exception) << mode;
+    }
+    m_tracer = geopm::make_unique<TracerImp>(m_start_time, m_path, m_hostname, true,
+                                             m_platform_io, m_platform_topo, m_extra_cols_str,
+                                             "csv", "change:col3");
+    GEOPM_EXPECT_THROW_MESSAGE(m_tracer->columns({"col1", "col2"}, {}),
+                               GEOPM_ERROR_INVALID, "unknown column: col3");
+}
+
 /// @todo This is shared with ReporterTest; can be put in common file
 void check_trace(std::istream &expected, std::istream &result)
 {
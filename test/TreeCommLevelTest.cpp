@@ -29,6 +29,7 @@
  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
+#include <map>
 #include <memory>
 #include <numeric>
 #include <cmath>
@@ -43,6 +44,8 @@
 
 using geopm::TreeCommLevel;
 using geopm::TreeCommLevelImp;
+using geopm::TreeCommLevelSequenceImp;
+using testing::NiceMock;
 using testing::Return;
 using testing::Invoke;
 using testing::SetArgPointee;
@@ -107,8 +110,8 @@ void TreeCommLevelTest::SetUp()
     EXPECT_CALL(*m_comm_1, window_create(0, NULL)).WillOnce(Return((size_t)m_sample_window[1])); // sample window
     EXPECT_CALL(*m_comm_1, window_create(policy_size, _)).WillOnce(Return((size_t)m_policy_window[1]));
 
-    m_level_rank_0 = std::make_shared<TreeCommLevelImp>(m_comm_0, m_num_up, m_num_down);
-    m_level_rank_1 = std::make_shared<TreeCommLevelImp>(m_comm_1, m_num_up, m_num_down);
+    m_level_rank_0 = std::make_shared<TreeCommLevelImp>(m_comm_0, m_num_up, m_num_down, false);
+    m_level_rank_1 = std::make_shared<TreeCommLevelImp>(m_comm_1, m_num_up, m_num_down, false);
 }
 
 void TreeCommLevelTest::TearDown()
@@ -162,7 +165,7 @@ TEST_F(TreeCommLevelTest, level_rank)
                          { free(base); }));
     // create and destroy level for rank 42
     {
-        TreeCommLevelImp level(comm, m_num_up, m_num_down);
+        TreeCommLevelImp level(comm, m_num_up, m_num_down, false);
         EXPECT_EQ(42, level.level_rank());
     }
 }
@@ -193,6 +196,44 @@ TEST_F(TreeCommLevelTest, send_up)
                                GEOPM_ERROR_INVALID, "sample vector is not sized correctly");
 }
 
+TEST_F(TreeCommLevelTest, send_up_sparse)
+{
+    auto comm = std::make_shared<NiceMock<MockComm> >();
+    ON_CALL(*comm, num_rank()).WillByDefault(Return(m_num_rank));
+    ON_CALL(*comm, rank()).WillByDefault(Return(1));
+    ON_CALL(*comm, alloc_mem(_, _))
+        .WillByDefault(Invoke([] (size_t size, void **base)
+                              { *base = malloc(size); }));
+    ON_CALL(*comm, free_mem(_))
+        .WillByDefault(Invoke([] (void *base) { free(base); }));
+    size_t base_off = sizeof(double) * (m_num_up + 1);
+    EXPECT_CALL(*comm, window_lock(_, _, _, _)).Times(4);
+    EXPECT_CALL(*comm, window_unlock(_, _)).Times(4);
+    EXPECT_CALL(*comm, window_put(_, sizeof(double), 0, base_off, _)).Times(4); // ready flag
+    EXPECT_CALL(*comm, window_put(_, 3 * sizeof(double), 0, base_off + sizeof(double), _)).Times(2);
+    EXPECT_CALL(*comm, window_put(_, sizeof(double), 0, base_off + 2 * sizeof(double), _)).Times(1);
+    {
+        TreeCommLevelImp level(comm, m_num_up, m_num_down, true);
+        // every value differs from the zero filled mailbox
+        level.send_up({5.5, 6.6, 7.7});
+        EXPECT_EQ(4 * sizeof(double), level.overhead_send());
+        EXPECT_EQ(0u, level.overhead_saved());
+        // only the changed value is sent
+        level.send_up({5.5, 8.8, 7.7});
+        EXPECT_EQ(6 * sizeof(double), level.overhead_send());
+        EXPECT_EQ(2 * sizeof(double), level.overhead_saved());
+        // values on either side of a single unchanged value are sent
+        // with one put
+        level.send_up({NAN, 8.8, 9.9});
+        EXPECT_EQ(10 * sizeof(double), level.overhead_send());
+        EXPECT_EQ(2 * sizeof(double), level.overhead_saved());
+        // a repeated NAN is not sent again
+        level.send_up({NAN, 8.8, 9.9});
+        EXPECT_EQ(11 * sizeof(double), level.overhead_send());
+        EXPECT_EQ(5 * sizeof(double), level.overhead_saved());
+    }
+}
+
 TEST_F(TreeCommLevelTest, send_down)
 {
     std::vector<std::vector<double> > policy {{2.2, 3.3}, {2.9, 3.9}, {2.1, 3.1}, {2.0, 3.0}};
@@ -207,6 +248,7 @@ TEST_F(TreeCommLevelTest, send_down)
     EXPECT_EQ(0u, m_level_rank_0->overhead_send());
     m_level_rank_0->send_down(policy);
     EXPECT_EQ((sizeof(double) + msg_size) * (m_num_rank - 1), m_level_rank_0->overhead_send());
+    EXPECT_EQ(0u, m_level_rank_0->overhead_saved());
 
     // errors
 #ifdef GEOPM_DEBUG
@@ -352,3 +394,255 @@ TEST_F(TreeCommLevelTest, receive_down_incomplete)
         EXPECT_TRUE(std::isnan(pp));
     }
 }
+
+class TreeCommLevelSequenceTest : public ::testing::Test
+{
+    protected:
+        void SetUp();
+        void TearDown();
+        int m_num_up = 3;
+        int m_num_down = 2;
+        int m_num_rank = 4;
+        bool m_is_sparse = false;
+        std::vector<std::shared_ptr<NiceMock<MockComm> > > m_comm;
+        std::vector<std::unique_ptr<TreeCommLevel> > m_level;
+        // memory backing the windows indexed by window handle and
+        // then by rank, windows are created in the same order on
+        // every rank
+        std::map<size_t, std::vector<double *> > m_window_mem;
+};
+
+void TreeCommLevelSequenceTest::SetUp()
+{
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        auto comm = std::make_shared<NiceMock<MockComm> >();
+        auto num_window = std::make_shared<size_t>(0);
+        ON_CALL(*comm, num_rank()).WillByDefault(Return(m_num_rank));
+        ON_CALL(*comm, rank()).WillByDefault(Return(rank));
+        ON_CALL(*comm, alloc_mem(_, _))
+            .WillByDefault(Invoke([] (size_t size, void **base)
+                                  { *base = malloc(size); }));
+        ON_CALL(*comm, free_mem(_))
+            .WillByDefault(Invoke([] (void *base) { free(base); }));
+        ON_CALL(*comm, window_create(_, _))
+            .WillByDefault(Invoke([this, rank, num_window] (size_t size, void *base)
+                                  {
+                                      ++(*num_window);
+                                      auto &mem = m_window_mem[*num_window];
+                                      mem.resize(m_num_rank, nullptr);
+                                      mem[rank] = (double *)base;
+                                      return *num_window;
+                                  }));
+        // puts are written directly into the memory of the target
+        ON_CALL(*comm, window_put(_, _, _, _, _))
+            .WillByDefault(Invoke([this] (const void *send_buf, size_t send_size,
+                                          int rank, off_t disp, size_t window_id)
+                                  {
+                                      char *target = (char *)m_window_mem.at(window_id).at(rank);
+                                      ASSERT_NE(nullptr, target);
+                                      memcpy(target + disp, send_buf, send_size);
+                                  }));
+        // the per message lock protocol is not used
+        EXPECT_CALL(*comm, window_lock(_, _, _, _)).Times(0);
+        EXPECT_CALL(*comm, window_unlock(_, _)).Times(0);
+        EXPECT_CALL(*comm, window_lock_all(_, _)).Times(2);
+        EXPECT_CALL(*comm, window_unlock_all(_)).Times(2);
+        m_comm.push_back(comm);
+    }
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        m_level.push_back(TreeCommLevel::make_unique(m_comm[rank], m_num_up, m_num_down, true, m_is_sparse));
+        ASSERT_NE(nullptr, dynamic_cast<TreeCommLevelSequenceImp *>(m_level.back().get()));
+    }
+}
+
+void TreeCommLevelSequenceTest::TearDown()
+{
+    m_level.clear();
+}
+
+TEST_F(TreeCommLevelSequenceTest, send_up_receive_up)
+{
+    std::vector<std::vector<double> > sample_out(m_num_rank, std::vector<double>(m_num_up, NAN));
+    for (int rank = 1; rank < m_num_rank; ++rank) {
+        EXPECT_CALL(*m_comm[rank], window_flush(_, 0)).Times(6);
+    }
+    EXPECT_CALL(*m_comm[0], window_flush(_, _)).Times(0);
+    std::vector<std::vector<double> > sample {{44.4, 33.3, 22.2},
+                                              {41.1, 31.1, 21.1},
+                                              {46.6, 36.6, 26.6},
+                                              {45.5, 35.5, 25.5}};
+    for (int rank = 1; rank < m_num_rank; ++rank) {
+        m_level[rank]->send_up(sample[rank]);
+    }
+    // message from rank 0 is missing
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+    for (const auto &ss : sample_out) {
+        for (auto tt : ss) {
+            EXPECT_TRUE(std::isnan(tt));
+        }
+    }
+    m_level[0]->send_up(sample[0]);
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+    // each message is only received once
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+
+    for (auto &ss : sample) {
+        for (auto &tt : ss) {
+            tt += 1.0;
+        }
+    }
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        m_level[rank]->send_up(sample[rank]);
+    }
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+
+    EXPECT_EQ(0u, m_level[0]->overhead_send());
+    for (int rank = 1; rank < m_num_rank; ++rank) {
+        EXPECT_EQ(2 * (m_num_up + 2) * sizeof(double), m_level[rank]->overhead_send());
+    }
+
+    // errors
+    GEOPM_EXPECT_THROW_MESSAGE(m_level[1]->send_up({8.8, 9.9}),
+                               GEOPM_ERROR_INVALID, "sample vector is not sized correctly");
+    sample_out.resize(2);
+    GEOPM_EXPECT_THROW_MESSAGE(m_level[0]->receive_up(sample_out),
+                               GEOPM_ERROR_INVALID, "sample vector is not sized correctly");
+}
+
+TEST_F(TreeCommLevelSequenceTest, send_down_receive_down)
+{
+    std::vector<double> policy_out;
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        EXPECT_FALSE(m_level[rank]->receive_down(policy_out));
+    }
+    std::vector<std::vector<double> > policy {{2.2, 3.3}, {2.9, 3.9}, {2.1, 3.1}, {2.0, 3.0}};
+    m_level[0]->send_down(policy);
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        EXPECT_TRUE(m_level[rank]->receive_down(policy_out));
+        EXPECT_EQ(policy[rank], policy_out);
+    }
+    size_t msg_size = sizeof(double) * (m_num_down + 2);
+    EXPECT_EQ(msg_size * (m_num_rank - 1), m_level[0]->overhead_send());
+    // only the policy that changed is sent
+    policy[2] = {0.0, 0.0};
+    m_level[0]->send_down(policy);
+    EXPECT_EQ(msg_size * m_num_rank, m_level[0]->overhead_send());
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        EXPECT_TRUE(m_level[rank]->receive_down(policy_out));
+        EXPECT_EQ(policy[rank], policy_out);
+    }
+    // NAN policy is not complete
+    policy[1] = {NAN, 1.0};
+    m_level[0]->send_down(policy);
+    EXPECT_FALSE(m_level[1]->receive_down(policy_out));
+
+    // errors
+    policy = {{7.7, 6.6}, {5.5, 4.4}};
+    GEOPM_EXPECT_THROW_MESSAGE(m_level[0]->send_down(policy),
+                               GEOPM_ERROR_INVALID, "policy vector is not sized correctly");
+}
+
+TEST_F(TreeCommLevelSequenceTest, receive_up_retry)
+{
+    std::vector<std::vector<double> > sample {{44.4, 33.3, 22.2},
+                                              {41.1, 31.1, 21.1},
+                                              {46.6, 36.6, 26.6},
+                                              {45.5, 35.5, 25.5}};
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        m_level[rank]->send_up(sample[rank]);
+    }
+    // rank 1 has started to write its second message: the leading
+    // sequence number and the message are written, but the
+    // trailing sequence number is not
+    double *slot = m_window_mem.at(2).at(0) + (m_num_up + 2);
+    slot[0] = 2.0;
+    slot[1] = 51.1;
+    // the write completes while rank 0 is reading the slot
+    int num_sync = 0;
+    EXPECT_CALL(*m_comm[0], window_sync(_))
+        .WillRepeatedly(Invoke([&num_sync, slot, this] (size_t window_id)
+                               {
+                                   ++num_sync;
+                                   if (num_sync == 4) {
+                                       slot[m_num_up + 1] = 2.0;
+                                   }
+                               }));
+    sample[1][0] = 51.1;
+    std::vector<std::vector<double> > sample_out(m_num_rank, std::vector<double>(m_num_up, NAN));
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+    // the completed message was received
+    EXPECT_FALSE(m_level[0]->receive_up(sample_out));
+}
+
+class TreeCommLevelSparseTest : public TreeCommLevelSequenceTest
+{
+    protected:
+        void SetUp();
+};
+
+void TreeCommLevelSparseTest::SetUp()
+{
+    m_is_sparse = true;
+    TreeCommLevelSequenceTest::SetUp();
+}
+
+TEST_F(TreeCommLevelSparseTest, send_up_receive_up)
+{
+    std::vector<std::vector<double> > sample {{44.4, 33.3, 22.2},
+                                              {41.1, 31.1, 21.1},
+                                              {46.6, 36.6, 26.6},
+                                              {45.5, 35.5, 25.5}};
+    std::vector<std::vector<double> > sample_out(m_num_rank, std::vector<double>(m_num_up, NAN));
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        m_level[rank]->send_up(sample[rank]);
+    }
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+    size_t slot_size = sizeof(double) * (m_num_up + 2);
+    for (int rank = 1; rank < m_num_rank; ++rank) {
+        EXPECT_EQ(slot_size, m_level[rank]->overhead_send());
+        EXPECT_EQ(0u, m_level[rank]->overhead_saved());
+    }
+
+    sample[1][2] = 51.1;
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        m_level[rank]->send_up(sample[rank]);
+    }
+    EXPECT_TRUE(m_level[0]->receive_up(sample_out));
+    EXPECT_EQ(sample, sample_out);
+    // only the sequence numbers and the changed value are sent
+    EXPECT_EQ(slot_size + 3 * sizeof(double), m_level[1]->overhead_send());
+    EXPECT_EQ(2 * sizeof(double), m_level[1]->overhead_saved());
+    for (int rank = 2; rank < m_num_rank; ++rank) {
+        EXPECT_EQ(slot_size + 2 * sizeof(double), m_level[rank]->overhead_send());
+        EXPECT_EQ(3 * sizeof(double), m_level[rank]->overhead_saved());
+    }
+    EXPECT_EQ(0u, m_level[0]->overhead_send());
+    EXPECT_EQ(0u, m_level[0]->overhead_saved());
+}
+
+TEST_F(TreeCommLevelSparseTest, send_down_receive_down)
+{
+    std::vector<double> policy_out;
+    std::vector<std::vector<double> > policy {{2.2, 3.3}, {2.9, 3.9}, {2.1, 3.1}, {2.0, 3.0}};
+    m_level[0]->send_down(policy);
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        EXPECT_TRUE(m_level[rank]->receive_down(policy_out));
+        EXPECT_EQ(policy[rank], policy_out);
+    }
+    size_t slot_size = sizeof(double) * (m_num_down + 2);
+    EXPECT_EQ(slot_size * (m_num_rank - 1), m_level[0]->overhead_send());
+    EXPECT_EQ(0u, m_level[0]->overhead_saved());
+
+    policy[2][1] = 4.1;
+    m_level[0]->send_down(policy);
+    for (int rank = 0; rank < m_num_rank; ++rank) {
+        EXPECT_TRUE(m_level[rank]->receive_down(policy_out));
+        EXPECT_EQ(policy[rank], policy_out);
+    }
+    EXPECT_EQ(slot_size * (m_num_rank - 1) + 3 * sizeof(double), m_level[0]->overhead_send());
+    EXPECT_EQ(sizeof(double), m_level[0]->overhead_saved());
+}
@@ -207,3 +207,17 @@ TEST_F(TreeCommTest, overhead_send)
 
     EXPECT_EQ(expected_overhead, m_tree_comm->overhead_send());
 }
+
+TEST_F(TreeCommTest, overhead_saved)
+{
+    root_setup();
+
+    std::vector<size_t> overhead{12, 23, 34, 45};
+    size_t expected_overhead = std::accumulate(overhead.begin(), overhead.end(), 0);
+    for (size_t level = 0; level < m_level_ptr.size(); ++level) {
+        EXPECT_CALL(*(m_level_ptr[level]), overhead_saved())
+            .WillOnce(Return(overhead[level]));
+    }
+
+    EXPECT_EQ(expected_overhead, m_tree_comm->overhead_saved());
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2015, 2016, 2017, 2018, 2019, 2020, Intel Corporation
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY LOG OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+#include <time.h>
+
+#include <map>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "Waiter.hpp"
+#include "Exception.hpp"
+#include "geopm_time.h"
+#include "geopm_test.hpp"
+
+using geopm::Waiter;
+using geopm::SleepWaiter;
+
+class WaiterTest : public :: testing :: Test
+{
+    protected:
+        const double M_PERIOD = 0.005;
+        const double M_SPIN_SEC = 0.0001;
+        const int M_NUM_WAIT = 20;
+};
+
+static double thread_cpu_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + 1E-9 * ts.tv_nsec;
+}
+
+TEST_F(WaiterTest, invalid)
+{
+    GEOPM_EXPECT_THROW_MESSAGE(SleepWaiter(0.0, M_SPIN_SEC),
+                               GEOPM_ERROR_INVALID, "period must be positive");
+    GEOPM_EXPECT_THROW_MESSAGE(SleepWaiter(-1.0, M_SPIN_SEC),
+                               GEOPM_ERROR_INVALID, "period must be positive");
+    GEOPM_EXPECT_THROW_MESSAGE(SleepWaiter(M_PERIOD, -1.0),
+                               GEOPM_ERROR_INVALID, "spin_sec must not be negative");
+}
+
+TEST_F(WaiterTest, period)
+{
+    SleepWaiter waiter(M_PERIOD, M_SPIN_SEC);
+    EXPECT_EQ(M_PERIOD, waiter.period());
+    geopm_time_s begin;
+    geopm_time(&begin);
+    double cpu_begin = thread_cpu_time();
+    waiter.reset();
+    for (int idx = 0; idx < M_NUM_WAIT; ++idx) {
+        waiter.wait();
+    }
+    double elapsed = geopm_time_since(&begin);
+    double cpu_elapsed = thread_cpu_time() - cpu_begin;
+    EXPECT_EQ((size_t)M_NUM_WAIT, waiter.num_wait());
+    EXPECT_LE(M_NUM_WAIT * M_PERIOD, elapsed);
+    EXPECT_GT(2 * M_NUM_WAIT * M_PERIOD, elapsed);
+    // The thread sleeps through most of each period
+    EXPECT_GT(0.5 * elapsed, cpu_elapsed);
+    if (waiter.num_missed() == 0) {
+        EXPECT_LE(0.0, waiter.jitter_mean());
+        EXPECT_LE(waiter.jitter_mean(), waiter.jitter_max());
+    }
+}
+
+TEST_F(WaiterTest, first_wait)
+{
+    // Time between construction and the first wait() is setup, not
+    // an overrun of the loop body
+    SleepWaiter waiter(M_PERIOD, M_SPIN_SEC);
+    usleep(3 * M_PERIOD * 1E6);
+    geopm_time_s begin;
+    geopm_time(&begin);
+    waiter.wait();
+    EXPECT_LE(M_PERIOD, geopm_time_since(&begin));
+    EXPECT_EQ(1ULL, waiter.num_wait());
+    EXPECT_EQ(0ULL, waiter.num_missed());
+}
+
+TEST_F(WaiterTest, missed)
+{
+    SleepWaiter waiter(M_PERIOD, M_SPIN_SEC);
+    waiter.wait();
+    usleep(3 * M_PERIOD * 1E6);
+    geopm_time_s begin;
+    geopm_time(&begin);
+    waiter.wait();
+    EXPECT_GT(M_PERIOD, geopm_time_since(&begin));
+    EXPECT_EQ(2ULL, waiter.num_wait());
+    EXPECT_EQ(1ULL, waiter.num_missed());
+    // Schedule restarts from the missed deadline
+    waiter.wait();
+    EXPECT_LE(M_PERIOD, geopm_time_since(&begin));
+    EXPECT_EQ(3ULL, waiter.num_wait());
+    EXPECT_EQ(1ULL, waiter.num_missed());
+}
+
+TEST_F(WaiterTest, report)
+{
+    std::unique_ptr<Waiter> waiter = Waiter::make_unique(M_PERIOD);
+    waiter->wait();
+    std::map<std::string, std::string> report;
+    for (const auto &kv : waiter->report()) {
+        report[kv.first] = kv.second;
+    }
+    EXPECT_EQ(5ULL, report.size());
+    EXPECT_EQ("1", report.at("Wait count"));
+    EXPECT_EQ(M_PERIOD, std::stod(report.at("Wait period (s)")));
+    EXPECT_EQ(1ULL, report.count("Wait missed deadlines"));
+    EXPECT_EQ(1ULL, report.count("Wait jitter mean (s)"));
+    EXPECT_EQ(1ULL, report.count("Wait jitter max (s)"));
+}